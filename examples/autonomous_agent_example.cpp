@@ -19,35 +19,35 @@ using namespace agents;
 
 // Custom callback to print detailed agent steps
 void detailedStepCallback(const AutonomousAgent::Step& step) {
-    Logger::info("\n=== STEP ===");
-    Logger::info("Description: {}", step.description);
-    Logger::info("Status: {}", step.status);
+    AGENTS_LOG_INFO("\n=== STEP ===");
+    AGENTS_LOG_INFO("Description: {}", step.description);
+    AGENTS_LOG_INFO("Status: {}", step.status);
 
     if (step.success) {
-        Logger::info("\nResult: {}", step.result.dump(2));
+        AGENTS_LOG_INFO("\nResult: {}", step.result.dump(2));
     } else {
-        Logger::error("\nFailed!");
+        AGENTS_LOG_ERROR("\nFailed!");
     }
 
-    Logger::info("\n------------------------------------");
+    AGENTS_LOG_INFO("\n------------------------------------");
 }
 
 // Custom callback for human-in-the-loop
 bool detailedHumanApproval(const std::string& message, const JsonObject& context, std::string& modifications) {
     if (!context.empty()) {
-        Logger::info("\nContext Information:");
-        Logger::info("{}", context.dump(2));
+        AGENTS_LOG_INFO("\nContext Information:");
+        AGENTS_LOG_INFO("{}", context.dump(2));
     }
 
-    Logger::info("\n🔔 HUMAN APPROVAL REQUIRED 🔔");
-    Logger::info("{}", message);
-    Logger::info("\nApprove this step? (y/n/m - y: approve, n: reject, m: modify): ");
+    std::cout << "\n🔔 HUMAN APPROVAL REQUIRED 🔔" << std::endl;
+    std::cout << message << std::endl;
+    std::cout << "\nApprove this step? (y/n/m - y: approve, n: reject, m: modify): " << std::flush;
     char response;
     std::cin >> response;
     std::cin.ignore(); // Clear the newline
 
     if (response == 'm' || response == 'M') {
-        Logger::info("Enter your modifications or instructions: ");
+        std::cout << "Enter your modifications or instructions: " << std::flush;
         std::string user_modifications;
         std::getline(std::cin, user_modifications);
 
@@ -55,7 +55,7 @@ bool detailedHumanApproval(const std::string& message, const JsonObject& context
         modifications = user_modifications;
 
         // Return true to continue with modifications
-        Logger::info("Continuing with your modifications...");
+        AGENTS_LOG_INFO("Continuing with your modifications...");
         return true;
     }
 
@@ -67,7 +67,7 @@ int main() {
     Logger::init(Logger::Level::INFO);
 
     // Get model choice from user
-    Logger::info("Select LLM provider (1 for OpenAI, 2 for Anthropic, 3 for Google): ");
+    std::cout << "Select LLM provider (1 for OpenAI, 2 for Anthropic, 3 for Google): " << std::flush;
     int provider_choice;
     std::cin >> provider_choice;
     std::cin.ignore(); // Clear the newline
@@ -87,12 +87,12 @@ int main() {
         } else if (provider_choice == 3) {
             llm = createLLM("google", config.get("GEMINI_API_KEY"), "gemini-2.5-flash");
         } else {
-            Logger::error("Invalid provider choice.");
+            AGENTS_LOG_ERROR("Invalid provider choice.");
             return EXIT_FAILURE;
         }
     } catch (const std::exception& e) {
-        Logger::error("Error creating LLM: {}", e.what());
-        Logger::error("Please ensure the appropriate API key is set in the environment.");
+        AGENTS_LOG_ERROR("Error creating LLM: {}", e.what());
+        AGENTS_LOG_ERROR("Please ensure the appropriate API key is set in the environment.");
         return EXIT_FAILURE;
     }
 
@@ -153,10 +153,10 @@ int main() {
     context->registerTool(summarize_tool);
 
     // Allow the user to choose planning strategy
-    Logger::info("Select planning strategy:");
-    Logger::info("1. ReAct (Open-ended, evolving task)");
-    Logger::info("2. Plan-and-Execute (Complex, structured task)");
-    Logger::info("Choice: ");
+    std::cout << "Select planning strategy:" << std::endl;
+    std::cout << "1. ReAct (Open-ended, evolving task)" << std::endl;
+    std::cout << "2. Plan-and-Execute (Complex, structured task)" << std::endl;
+    std::cout << "Choice: " << std::flush;
     int strategy_choice;
     std::cin >> strategy_choice;
     std::cin.ignore(); // Clear the newline
@@ -174,7 +174,7 @@ int main() {
             strategy = AutonomousAgent::PlanningStrategy::PLAN_AND_EXECUTE;
             break;
         default:
-            Logger::error("Invalid strategy choice.");
+            AGENTS_LOG_ERROR("Invalid strategy choice.");
             return EXIT_FAILURE;
     }
     agent.setPlanningStrategy(strategy);
@@ -192,7 +192,7 @@ int main() {
     agent_options.max_iterations = 15;
 
     // Ask user if they want human-in-the-loop mode
-    Logger::info("Enable human-in-the-loop mode? (y/n): ");
+    std::cout << "Enable human-in-the-loop mode? (y/n): " << std::flush;
     char human_loop_choice;
     std::cin >> human_loop_choice;
     std::cin.ignore(); // Clear the newline
@@ -211,14 +211,14 @@ int main() {
     agent.init();
 
     // Get user input
-    Logger::info("\n==================================================");
-    Logger::info("                AUTONOMOUS AGENT                  ");
-    Logger::info("==================================================");
-    Logger::info("Enter a question or task for the agent (or 'exit' to quit):");
+    AGENTS_LOG_INFO("\n==================================================");
+    AGENTS_LOG_INFO("                AUTONOMOUS AGENT                  ");
+    AGENTS_LOG_INFO("==================================================");
+    std::cout << "Enter a question or task for the agent (or 'exit' to quit):" << std::endl;
 
     std::string user_input;
     while (true) {
-        Logger::info("\n> ");
+        std::cout << "\n> " << std::flush;
         std::getline(std::cin, user_input);
 
         if (user_input == "exit" || user_input == "quit" || user_input == "q") {
@@ -241,23 +241,23 @@ int main() {
             auto duration = std::chrono::duration_cast<std::chrono::seconds>(end_time - start_time).count();
 
             // Display the final result
-            Logger::info("\n==================================================");
-            Logger::info("                  FINAL RESULT                    ");
-            Logger::info("==================================================");
-            Logger::info("{}", result["answer"].get<std::string>());
+            AGENTS_LOG_INFO("\n==================================================");
+            AGENTS_LOG_INFO("                  FINAL RESULT                    ");
+            AGENTS_LOG_INFO("==================================================");
+            AGENTS_LOG_INFO("{}", result["answer"].get<std::string>());
 
             // Display completion statistics
-            Logger::info("\n--------------------------------------------------");
-            Logger::info("Task completed in {} seconds", duration);
-            Logger::info("Total steps: {}", result["steps"].get<JsonArray>().size());
+            AGENTS_LOG_INFO("\n--------------------------------------------------");
+            AGENTS_LOG_INFO("Task completed in {} seconds", duration);
+            AGENTS_LOG_INFO("Total steps: {}", result["steps"].get<JsonArray>().size());
 
             if (result.contains("tool_calls")) {
-                Logger::info("Tool calls: {}", result["tool_calls"].get<int>());
+                AGENTS_LOG_INFO("Tool calls: {}", result["tool_calls"].get<int>());
             }
 
-            Logger::info("==================================================");
+            AGENTS_LOG_INFO("==================================================");
         } catch (const std::exception& e) {
-            Logger::error("Error: {}", e.what());
+            AGENTS_LOG_ERROR("Error: {}", e.what());
         }
     }
 
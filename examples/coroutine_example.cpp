@@ -18,24 +18,24 @@ using namespace agents;
 
 // Simple callback to print agent steps
 void stepCallback(const AutonomousAgent::Step& step) {
-    Logger::info("Step: {}", step.description);
-    Logger::info("Status: {}", step.status);
+    AGENTS_LOG_INFO("Step: {}", step.description);
+    AGENTS_LOG_INFO("Status: {}", step.status);
     if (step.success) {
-        Logger::info("Result: {}", step.result.dump(2));
+        AGENTS_LOG_INFO("Result: {}", step.result.dump(2));
     } else {
-        Logger::error("Failed!");
+        AGENTS_LOG_ERROR("Failed!");
     }
-    Logger::info("--------------------------------------");
+    AGENTS_LOG_INFO("--------------------------------------");
 }
 
 // Simple callback for human-in-the-loop
 bool humanApproval(const std::string& message, const JsonObject& context, std::string& modifications) {
     (void)modifications;
     if (!context.empty()) {
-        Logger::info("Context: {}", context.dump(2));
+        AGENTS_LOG_INFO("Context: {}", context.dump(2));
     }
-    Logger::info("\n{}", message);
-    Logger::info("Approve this step? (y/n): ");
+    std::cout << "\n" << message << std::endl;
+    std::cout << "Approve this step? (y/n): " << std::flush;
     char response;
     std::cin >> response;
     return (response == 'y' || response == 'Y');
@@ -43,24 +43,24 @@ bool humanApproval(const std::string& message, const JsonObject& context, std::s
 
 // Example coroutine that performs a multi-step task using tools
 Task<JsonObject> performResearchTask(std::shared_ptr<Context> context, const std::string& topic) {
-    Logger::info("Starting research on topic: {}", topic);
+    AGENTS_LOG_INFO("Starting research on topic: {}", topic);
 
     // Perform a search to get initial information
     auto search_tool = tools::createWebSearchTool();
     auto search_result = co_await context->executeTool("web_search", {{"query", topic}});
 
     // Extract key points from the search result
-    Logger::info("Extracting key points from search results...");
+    AGENTS_LOG_INFO("Extracting key points from search results...");
     auto extract_prompt = "Extract the key points from this search result about " + topic + ":\n\n" + search_result.content;
     auto extract_response = co_await context->chat(extract_prompt);
 
     // Get more detailed information from Wikipedia
-    Logger::info("Getting more information from Wikipedia...");
+    AGENTS_LOG_INFO("Getting more information from Wikipedia...");
     auto wiki_tool = tools::createWikipediaTool();
     auto wiki_result = co_await context->executeTool("wikipedia", {{"query", topic}});
 
     // Combine and summarize all information
-    Logger::info("Summarizing all information...");
+    AGENTS_LOG_INFO("Summarizing all information...");
     auto summarize_prompt = "Synthesize and summarize the following information about " + topic + ":\n\n";
     summarize_prompt += "Key Points:\n" + extract_response.content + "\n\n";
     summarize_prompt += "Wikipedia Information:\n" + wiki_result.content;
@@ -75,13 +75,13 @@ Task<JsonObject> performResearchTask(std::shared_ptr<Context> context, const std
         {"wiki_results", wiki_result.content}
     };
 
-    Logger::info("Research complete!");
+    AGENTS_LOG_INFO("Research complete!");
     co_return result;
 }
 
 // Example coroutine that generates content in parallel
 Task<JsonObject> generateContentInParallel(std::shared_ptr<Context> context, const std::string& topic) {
-    Logger::info("Generating content for topic: {}", topic);
+    AGENTS_LOG_INFO("Generating content for topic: {}", topic);
 
     // Create a prompt for the introduction
     std::string intro_prompt = "Write an introduction paragraph for an article about " + topic + ".";
@@ -118,13 +118,13 @@ Task<JsonObject> generateContentInParallel(std::shared_ptr<Context> context, con
         {"full_article", article}
     };
 
-    Logger::info("Content generation complete!");
+    AGENTS_LOG_INFO("Content generation complete!");
     co_return result;
 }
 
 // Example showing streaming text with coroutines
 Task<void> streamText(std::shared_ptr<Context> context, const std::string& prompt) {
-    Logger::info("Streaming response for prompt: {}", prompt);
+    AGENTS_LOG_INFO("Streaming response for prompt: {}", prompt);
 
     // Get a streaming generator
     auto generator = context->streamChat(prompt);
@@ -138,7 +138,7 @@ Task<void> streamText(std::shared_ptr<Context> context, const std::string& promp
     }
     std::cout << std::endl;
 
-    Logger::info("Streaming complete!");
+    AGENTS_LOG_INFO("Streaming complete!");
     co_return;
 }
 
@@ -160,10 +160,10 @@ int main(int argc, char* argv[]) {
 
     // Still not found, show error and exit
     if (api_key.empty()) {
-        Logger::error("API key not found. Please:");
-        Logger::error("1. Create a .env file with GEMINI_API_KEY=your_key, or");
-        Logger::error("2. Set the GEMINI_API_KEY environment variable, or");
-        Logger::error("3. Provide an API key as a command line argument");
+        std::cout << "API key not found. Please:" << std::endl;
+        std::cout << "1. Create a .env file with GEMINI_API_KEY=your_key, or" << std::endl;
+        std::cout << "2. Set the GEMINI_API_KEY environment variable, or" << std::endl;
+        std::cout << "3. Provide an API key as a command line argument" << std::endl;
         return EXIT_FAILURE;
     }
 
@@ -187,13 +187,13 @@ int main(int argc, char* argv[]) {
 
     // Menu-driven example to demonstrate various coroutines
     while (true) {
-        Logger::info("\n========== COROUTINE EXAMPLES ==========");
-        Logger::info("1. Run autonomous agent with coroutines");
-        Logger::info("2. Perform research with parallel tool use");
-        Logger::info("3. Generate content in parallel");
-        Logger::info("4. Stream text example");
-        Logger::info("5. Exit");
-        Logger::info("Enter your choice:");
+        std::cout << "\n========== COROUTINE EXAMPLES ==========" << std::endl;
+        std::cout << "1. Run autonomous agent with coroutines" << std::endl;
+        std::cout << "2. Perform research with parallel tool use" << std::endl;
+        std::cout << "3. Generate content in parallel" << std::endl;
+        std::cout << "4. Stream text example" << std::endl;
+        std::cout << "5. Exit" << std::endl;
+        std::cout << "Enter your choice:" << std::endl;
 
         int choice;
         std::cin >> choice;
@@ -206,7 +206,7 @@ int main(int argc, char* argv[]) {
         // Get topic from user
         std::string topic;
         if (choice >= 1 && choice <= 4) {
-            Logger::info("Enter a topic: ");
+            std::cout << "Enter a topic: " << std::flush;
             std::getline(std::cin, topic);
         }
 
@@ -214,7 +214,7 @@ int main(int argc, char* argv[]) {
             switch (choice) {
                 case 1: {
                     // Example 1: Autonomous agent with coroutines
-                    Logger::info("Running autonomous agent with coroutines");
+                    AGENTS_LOG_INFO("Running autonomous agent with coroutines");
 
                     // Create and configure agent
                     AutonomousAgent agent(context);
@@ -237,38 +237,38 @@ int main(int argc, char* argv[]) {
 
                     // Display result
                     if (result.contains("answer")) {
-                        Logger::info("\nFinal Answer: {}", result["answer"].get<std::string>());
+                        AGENTS_LOG_INFO("\nFinal Answer: {}", result["answer"].get<std::string>());
                     } else {
-                        Logger::info("\nResult: {}", result.dump(2));
+                        AGENTS_LOG_INFO("\nResult: {}", result.dump(2));
                     }
                     break;
                 }
                 case 2: {
                     // Example 2: Research task with parallel tool use
-                    Logger::info("Performing research with coroutines");
+                    AGENTS_LOG_INFO("Performing research with coroutines");
                     auto result = blockingWait(performResearchTask(context, topic));
-                    Logger::info("\nResearch Summary: {}", result["summary"].get<std::string>());
+                    AGENTS_LOG_INFO("\nResearch Summary: {}", result["summary"].get<std::string>());
                     break;
                 }
                 case 3: {
                     // Example 3: Generate content in parallel
-                    Logger::info("Generating content in parallel");
+                    AGENTS_LOG_INFO("Generating content in parallel");
                     auto result = blockingWait(generateContentInParallel(context, topic));
-                    Logger::info("\nTitle: {}", result["title"].get<std::string>());
-                    Logger::info("\nFull Article:\n{}", result["full_article"].get<std::string>());
+                    AGENTS_LOG_INFO("\nTitle: {}", result["title"].get<std::string>());
+                    AGENTS_LOG_INFO("\nFull Article:\n{}", result["full_article"].get<std::string>());
                     break;
                 }
                 case 4: {
                     // Example 4: Stream text
-                    Logger::info("Streaming text example");
+                    AGENTS_LOG_INFO("Streaming text example");
                     blockingWait(streamText(context, "Write a short story about " + topic));
                     break;
                 }
                 default:
-                    Logger::error("Invalid choice");
+                    AGENTS_LOG_ERROR("Invalid choice");
             }
         } catch (const std::exception& e) {
-            Logger::error("Error: {}", e.what());
+            AGENTS_LOG_ERROR("Error: {}", e.what());
         }
     }
 
@@ -0,0 +1,87 @@
+/**
+ * @example logging_benchmark.cpp
+ * @brief Logging throughput under contention, synchronous vs asynchronous
+ *
+ * Every mode writes to the colored stdout sink that Logger::init() installs,
+ * and the timer stops only once that sink has been flushed, so queued
+ * records are paid for. Results go to stderr; run it with stdout redirected,
+ * e.g. `logging_benchmark > /dev/null`.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025 Edge AI, LLC. All rights reserved.
+ *
+ */
+#include <agents-cpp/logger.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace agents;
+
+namespace {
+
+// Log from several threads at once and return the calls per second, counting until every record is written
+double measure(size_t threads, size_t calls_per_thread) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([t, calls_per_thread]() {
+            for (size_t i = 0; i < calls_per_thread; ++i) {
+                Logger::info("agent {} step {} completed with status {}", t, i, "ok");
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    Logger::flush();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return static_cast<double>(threads * calls_per_thread) / seconds;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t calls_per_thread = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    const std::vector<size_t> thread_counts{1, 4, 16, 64};
+
+    struct Mode {
+        std::string name;
+        bool async;
+        bool json;
+        Logger::OverflowPolicy overflow;
+    };
+    const std::vector<Mode> modes{
+        {"sync text (Logger::init)", false, false, Logger::OverflowPolicy::BLOCK},
+        {"async text (block)", true, false, Logger::OverflowPolicy::BLOCK},
+        {"async text (overrun oldest)", true, false, Logger::OverflowPolicy::OVERRUN_OLDEST},
+        {"async json (block)", true, true, Logger::OverflowPolicy::BLOCK},
+    };
+
+    std::cerr << "calls/s per mode and thread count (" << calls_per_thread << " calls per thread)" << std::endl;
+    for (const auto& mode : modes) {
+        if (mode.async) {
+            Logger::AsyncOptions options;
+            options.json = mode.json;
+            options.overflow = mode.overflow;
+            options.queue_size = 65536;
+            options.fields = JsonObject{{"session_id", "bench"}};
+            Logger::initAsync(options);
+        } else {
+            Logger::init(Logger::Level::INFO);
+        }
+
+        std::cerr << mode.name << ":";
+        for (size_t threads : thread_counts) {
+            std::cerr << "  " << threads << "T=" << static_cast<long long>(measure(threads, calls_per_thread));
+        }
+        std::cerr << std::endl;
+    }
+    spdlog::shutdown();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,64 @@
+/**
+ * @example mock_llm_server.cpp
+ * @brief Local mock LLM server for offline load tests
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025 Edge AI, LLC. All rights reserved.
+ *
+ * Usage: mock_llm_server [port] [first_token_ms] [tokens_per_second] [error_rate] [rate_limit_rate]
+ */
+#include <agents-cpp/logger.h>
+#include <agents-cpp/mock_llm_server.h>
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <thread>
+
+using namespace agents;
+
+namespace {
+
+std::atomic<bool> stopping{false};
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Logger::init(Logger::Level::INFO);
+
+    MockLLMServer::Options options;
+    int port = argc > 1 ? std::atoi(argv[1]) : 8089;
+    // Log-normal first-token latency gives the long tail real providers show
+    options.first_token_latency.distribution = MockLLMServer::Latency::Distribution::LOG_NORMAL;
+    options.first_token_latency.mean_ms = argc > 2 ? std::atof(argv[2]) : 300.0;
+    options.first_token_latency.stddev_ms = options.first_token_latency.mean_ms / 2;
+    options.tokens_per_second = argc > 3 ? std::atof(argv[3]) : 60.0;
+    options.error_rate = argc > 4 ? std::atof(argv[4]) : 0.0;
+    options.rate_limit_rate = argc > 5 ? std::atof(argv[5]) : 0.0;
+
+    MockLLMServer server(options);
+    // Agents asking for the weather get a tool call first, then a final answer
+    server.addScript({"weather", "", {{"weather", JsonObject{{"location", "Paris"}}}}, 200, true});
+
+    try {
+        server.start("127.0.0.1", port);
+    } catch (const std::exception& e) {
+        Logger::error("{}", e.what());
+        return EXIT_FAILURE;
+    }
+
+    Logger::info("Mock LLM server listening on port {}", server.port());
+    for (const char* provider : {"openai", "anthropic", "google", "ollama"}) {
+        Logger::info("  {:<10} setApiBase(\"{}\")", provider, server.apiBase(provider));
+    }
+
+    std::signal(SIGINT, [](int) { stopping = true; });
+    std::signal(SIGTERM, [](int) { stopping = true; });
+    while (!stopping) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    }
+    Logger::info("Served {} requests", server.requestCount());
+    return EXIT_SUCCESS;
+}
@@ -34,10 +34,10 @@ int main(int argc, char* argv[]) {
 
     // Still not found, show error and exit
     if (api_key.empty()) {
-        Logger::error("API key not found. Please:");
-        Logger::error("1. Create a .env file with GEMINI_API_KEY=your_key, or");
-        Logger::error("2. Set the GEMINI_API_KEY environment variable, or");
-        Logger::error("3. Provide an API key as a command line argument");
+        std::cout << "API key not found. Please:" << std::endl;
+        std::cout << "1. Create a .env file with GEMINI_API_KEY=your_key, or" << std::endl;
+        std::cout << "2. Set the GEMINI_API_KEY environment variable, or" << std::endl;
+        std::cout << "3. Provide an API key as a command line argument" << std::endl;
         return EXIT_FAILURE;
     }
 
@@ -96,13 +96,13 @@ int main(int argc, char* argv[]) {
 
     // Set a callback for intermediate steps
     chain.setStepCallback([](const std::string& step_name, const JsonObject& result) {
-        Logger::debug("Step result: {}", result.dump(2));
-        Logger::info("Completed step: {}", step_name);
-        Logger::info("--------------------------------------");
+        AGENTS_LOG_DEBUG("Step result: {}", result.dump(2));
+        AGENTS_LOG_INFO("Completed step: {}", step_name);
+        AGENTS_LOG_INFO("--------------------------------------");
     });
 
     // Get user input
-    Logger::info("Enter a topic for document generation:");
+    std::cout << "Enter a topic for document generation:" << std::endl;
     std::string user_input;
     std::getline(std::cin, user_input);
 
@@ -116,14 +116,14 @@ int main(int argc, char* argv[]) {
 
         // Display the final document
         if (result.contains("proofread") && result["proofread"].contains("response")) {
-            Logger::info("\nFinal Document:\n{}", result["proofread"]["response"].get<std::string>());
+            AGENTS_LOG_INFO("\nFinal Document:\n{}", result["proofread"]["response"].get<std::string>());
         } else if (result.contains("response")) {
-            Logger::info("\nFinal Document:\n{}", result["response"].get<std::string>());
+            AGENTS_LOG_INFO("\nFinal Document:\n{}", result["response"].get<std::string>());
         } else {
-            Logger::info("\nFinal Result:\n{}", result.dump());
+            AGENTS_LOG_INFO("\nFinal Result:\n{}", result.dump());
         }
     } catch (const std::exception& e) {
-        Logger::error("Error parsing result: {}", e.what());
+        AGENTS_LOG_ERROR("Error parsing result: {}", e.what());
     }
 
     return EXIT_SUCCESS;
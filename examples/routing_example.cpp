@@ -35,10 +35,10 @@ int main(int argc, char* argv[]) {
 
     // Still not found, show error and exit
     if (api_key.empty()) {
-        Logger::error("API key not found. Please:");
-        Logger::error("1. Create a .env file with GEMINI_API_KEY=your_key, or");
-        Logger::error("2. Set the GEMINI_API_KEY environment variable, or");
-        Logger::error("3. Provide an API key as a command line argument");
+        std::cout << "API key not found. Please:" << std::endl;
+        std::cout << "1. Create a .env file with GEMINI_API_KEY=your_key, or" << std::endl;
+        std::cout << "2. Set the GEMINI_API_KEY environment variable, or" << std::endl;
+        std::cout << "3. Provide an API key as a command line argument" << std::endl;
         return EXIT_FAILURE;
     }
 
@@ -73,8 +73,8 @@ int main(int argc, char* argv[]) {
         "factual_query",
         "Questions about facts, events, statistics, or general knowledge",
         [context](const std::string& input, const JsonObject& routing_info) -> JsonObject {
-            Logger::debug("Routing info: {}", routing_info.dump(2));
-            Logger::info("Handling factual query: {}", input);
+            AGENTS_LOG_DEBUG("Routing info: {}", routing_info.dump(2));
+            AGENTS_LOG_INFO("Handling factual query: {}", input);
 
             auto wiki_tool = tools::createWikipediaTool();
             ToolResult result = wiki_tool->execute({{"query", input}});
@@ -89,8 +89,8 @@ int main(int argc, char* argv[]) {
         "opinion_query",
         "Questions seeking opinions, evaluations, or judgments on topics",
         [context](const std::string& input, const JsonObject& routing_info) -> JsonObject {
-            Logger::debug("Routing info: {}", routing_info.dump(2));
-            Logger::info("Handling opinion query: {}", input);
+            AGENTS_LOG_DEBUG("Routing info: {}", routing_info.dump(2));
+            AGENTS_LOG_INFO("Handling opinion query: {}", input);
 
             // Create specific context for opinion handling
             auto opinion_context = std::make_shared<Context>(*context);
@@ -113,8 +113,8 @@ int main(int argc, char* argv[]) {
         "technical_query",
         "Questions about technical topics, programming, or specialized domains",
         [context](const std::string& input, const JsonObject& routing_info) -> JsonObject {
-            Logger::debug("Routing info: {}", routing_info.dump(2));
-            Logger::info("Handling technical query: {}", input);
+            AGENTS_LOG_DEBUG("Routing info: {}", routing_info.dump(2));
+            AGENTS_LOG_INFO("Handling technical query: {}", input);
 
             // Create specific context for technical handling
             auto technical_context = std::make_shared<Context>(*context);
@@ -135,8 +135,8 @@ int main(int argc, char* argv[]) {
 
     // Set default route
     router.setDefaultRoute([context](const std::string& input, const JsonObject& routing_info) -> JsonObject {
-        Logger::debug("Routing info: {}", routing_info.dump(2));
-        Logger::info("Handling with default route: {}", input);
+        AGENTS_LOG_DEBUG("Routing info: {}", routing_info.dump(2));
+        AGENTS_LOG_INFO("Handling with default route: {}", input);
 
         // Get response from LLM
         LLMResponse llm_response = context->getLLM()->chat(input);
@@ -148,10 +148,10 @@ int main(int argc, char* argv[]) {
     });
 
     // Process user inputs until exit
-    Logger::info("Enter queries (or 'exit' to quit):");
+    std::cout << "Enter queries (or 'exit' to quit):" << std::endl;
     std::string user_input;
     while (true) {
-        Logger::info("> ");
+        std::cout << "> " << std::flush;
         std::getline(std::cin, user_input);
 
         if (user_input == "exit" || user_input == "quit" || user_input == "q") {
@@ -167,10 +167,10 @@ int main(int argc, char* argv[]) {
             JsonObject result = router.run(user_input);
 
             // Display the result
-            Logger::info("\nResponse: {}", result["answer"].get<std::string>());
-            Logger::info("--------------------------------------");
+            AGENTS_LOG_INFO("\nResponse: {}", result["answer"].get<std::string>());
+            AGENTS_LOG_INFO("--------------------------------------");
         } catch (const std::exception& e) {
-            Logger::error("Error: {}", e.what());
+            AGENTS_LOG_ERROR("Error: {}", e.what());
         }
     }
 
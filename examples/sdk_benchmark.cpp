@@ -0,0 +1,349 @@
+/**
+ * @example sdk_benchmark.cpp
+ * @brief Google Benchmark suite for the SDK's hot paths
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025 Edge AI, LLC. All rights reserved.
+ *
+ * Results go to the console and, unless --benchmark_out is given, to
+ * sdk_benchmark.json in Google Benchmark's JSON format so runs can be
+ * compared release over release (for example with tools/compare.py from
+ * the Google Benchmark repository). No network access or API key is
+ * needed: providers are pointed at an in-process MockLLMServer.
+ */
+#include <agents-cpp/agents/actor_agent.h>
+#include <agents-cpp/context.h>
+#include <agents-cpp/coroutine_utils.h>
+#include <agents-cpp/http_client.h>
+#include <agents-cpp/logger.h>
+#include <agents-cpp/media_envelope.h>
+#include <agents-cpp/mock_llm_server.h>
+#include <agents-cpp/tool.h>
+#include <agents-cpp/tools/media_loader_tool.h>
+
+#include <benchmark/benchmark.h>
+#include <httplib.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace agents;
+
+namespace {
+
+const char* kProviders[] = {"openai", "anthropic", "google", "ollama"};
+
+// Shared zero-latency mock of the provider APIs
+MockLLMServer& mockServer() {
+    static MockLLMServer* server = []() {
+        MockLLMServer::Options options;
+        options.seed = 1;
+        options.worker_threads = 8;
+        std::string content;
+        for (int i = 0; i < 64; ++i) content += "token" + std::to_string(i) + " ";
+        options.default_content = content;
+        auto* mock = new MockLLMServer(options);
+        mock->addScript({"use the weather tool", "", {{"weather", JsonObject{{"location", "Paris"}}}}, 200, true});
+        mock->start();
+        return mock;
+    }();
+    return *server;
+}
+
+// Loopback server echoing POST bodies
+int echoPort() {
+    static int port = []() {
+        auto* server = new httplib::Server();
+        server->Post("/echo", [](const httplib::Request& req, httplib::Response& res) {
+            res.set_content(req.body, "application/octet-stream");
+        });
+        int bound = server->bind_to_any_port("127.0.0.1");
+        std::thread([server]() { server->listen_after_bind(); }).detach();
+        server->wait_until_ready();
+        return bound;
+    }();
+    return port;
+}
+
+std::shared_ptr<LLMInterface> mockLLM(const std::string& provider) {
+    auto llm = createLLM(provider, "bench-key", "mock-model");
+    llm->setApiBase(mockServer().apiBase(provider));
+    return llm;
+}
+
+std::vector<Message> conversation(size_t messages) {
+    std::vector<Message> history{{Message::Role::SYSTEM, "You are a helpful assistant."}};
+    for (size_t i = 1; i < messages; ++i) {
+        history.push_back({i % 2 ? Message::Role::USER : Message::Role::ASSISTANT,
+                           "Message " + std::to_string(i) + " of a conversation long enough to matter."});
+    }
+    return history;
+}
+
+std::shared_ptr<Tool> weatherTool() {
+    return createTool("weather", "Get weather information for a location",
+                      {{"location", "The location to get weather for", "string", true}},
+                      [](const JsonObject& params) {
+                          return ToolResult{true, "Weather in " + params.value("location", "") + ": sunny", {{"weather", "sunny"}}};
+                      });
+}
+
+// In-process LLM: asks for the weather tool, then answers once the tool result is in
+class ScriptedLLM : public LLMInterface {
+public:
+    std::vector<std::string> getAvailableModels() override { return {"scripted"}; }
+    void setModel(const std::string&) override {}
+    std::string getModel() const override { return "scripted"; }
+    void setApiKey(const std::string&) override {}
+    void setApiBase(const std::string&) override {}
+    void setOptions(const LLMOptions& options) override { options_ = options; }
+    LLMOptions getOptions() const override { return options_; }
+    LLMResponse chat(const std::string& prompt) override {
+        return chat(std::vector<Message>{{Message::Role::USER, prompt}});
+    }
+    LLMResponse chat(const std::vector<Message>& messages) override { return reply(messages); }
+    LLMResponse chatWithTools(const std::vector<Message>& messages, const std::vector<std::shared_ptr<Tool>>&) override {
+        return reply(messages);
+    }
+    void streamChat(const std::vector<Message>& messages, std::function<void(const std::string&, bool)> callback) override {
+        callback(reply(messages).content, true);
+    }
+
+private:
+    LLMOptions options_;
+
+    static LLMResponse reply(const std::vector<Message>& messages) {
+        LLMResponse response;
+        if (!messages.empty() && messages.back().role == Message::Role::TOOL) {
+            response.content = "It is sunny in Paris.";
+        } else {
+            response.tool_calls.push_back({"weather", JsonObject{{"location", "Paris"}}});
+        }
+        response.usage_metrics = {{"input_tokens", 100}, {"output_tokens", 10}};
+        return response;
+    }
+};
+
+std::shared_ptr<ActorAgent> weatherAgent(std::shared_ptr<LLMInterface> llm) {
+    auto context = std::make_shared<Context>();
+    context->setLLM(std::move(llm));
+    context->registerTool(weatherTool());
+    auto agent = std::make_shared<ActorAgent>(context);
+    Agent::Options options;
+    options.max_iterations = 4;
+    options.human_feedback_enabled = false;
+    agent->setOptions(options);
+    agent->init();
+    return agent;
+}
+
+Task<int> leaf(int value) {
+    co_return value;
+}
+
+Task<int> chain(int64_t depth) {
+    int sum = 0;
+    for (int64_t i = 0; i < depth; ++i) {
+        sum += co_await leaf(1);
+    }
+    co_return sum;
+}
+
+AsyncGenerator<int> counter(int64_t count) {
+    for (int64_t i = 0; i < count; ++i) {
+        co_yield static_cast<int>(i);
+    }
+}
+
+Task<int64_t> drain(int64_t count) {
+    auto generator = counter(count);
+    int64_t sum = 0;
+    while (auto item = co_await generator.next()) {
+        sum += *item;
+    }
+    co_return sum;
+}
+
+Task<int> hop() {
+    co_return co_await offload([]() { return 1; });
+}
+
+} // namespace
+
+// Awaiting an already-complete child Task
+static void BM_TaskAwait(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(blockingWait(chain(state.range(0))));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TaskAwait)->Arg(1)->Arg(64)->Arg(1024);
+
+// Pulling items through AsyncGenerator::next()
+static void BM_AsyncGeneratorNext(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(blockingWait(drain(state.range(0))));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AsyncGeneratorNext)->Arg(1)->Arg(64)->Arg(1024);
+
+// Round trip through the executor thread
+static void BM_OffloadHop(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(blockingWait(hop()));
+    }
+}
+BENCHMARK(BM_OffloadHop)->UseRealTime();
+
+static void BM_ToolValidateParameters(benchmark::State& state) {
+    std::vector<Parameter> parameters;
+    JsonObject params;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        std::string name = "param" + std::to_string(i);
+        parameters.push_back({name, "A parameter", i % 2 ? "string" : "number", true});
+        params[name] = i % 2 ? JsonObject("value") : JsonObject(i);
+    }
+    auto tool = createTool("bench", "Benchmark tool", parameters, [](const JsonObject&) { return ToolResult{true, "", {}}; });
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(tool->validateParameters(params));
+    }
+}
+BENCHMARK(BM_ToolValidateParameters)->Arg(1)->Arg(8)->Arg(32);
+
+// Normalizing an inline-data media envelope and re-parsing it from text
+static void BM_MediaEnvelope(benchmark::State& state) {
+    const std::string data(static_cast<size_t>(state.range(0)), 'A');
+    const std::string text = media::imageData(data, "image/png").dump();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(media::normalizeMediaPart(media::imageData(data, "image/png")));
+        benchmark::DoNotOptimize(media::tryParseEnvelopeFromString(text));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MediaEnvelope)->Arg(1 << 10)->Arg(64 << 10)->Arg(512 << 10);
+
+// Loading a local file into a base64 media envelope
+static void BM_MediaLoaderBase64(benchmark::State& state) {
+    auto path = std::filesystem::temp_directory_path() / ("agents_bench_" + std::to_string(state.range(0)) + ".png");
+    {
+        std::ofstream file(path, std::ios::binary);
+        std::string bytes(static_cast<size_t>(state.range(0)), '\0');
+        for (size_t i = 0; i < bytes.size(); ++i) bytes[i] = static_cast<char>(i * 131);
+        file << bytes;
+    }
+    tools::MediaLoaderTool loader(std::make_shared<ScriptedLLM>());
+    const JsonObject params{{"url", "file://" + path.string()}};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(loader.execute(params));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+    std::filesystem::remove(path);
+}
+BENCHMARK(BM_MediaLoaderBase64)->Arg(1 << 10)->Arg(64 << 10)->Arg(512 << 10);
+
+// HTTPClient POST against a loopback echo server
+static void BM_HTTPClientRoundTrip(benchmark::State& state) {
+    const std::string url = "http://127.0.0.1:" + std::to_string(echoPort()) + "/echo";
+    const std::string body(static_cast<size_t>(state.range(0)), 'x');
+    const std::map<std::string, std::string> headers{{"Content-Type", "application/octet-stream"}};
+    for (auto _ : state) {
+        auto response = HTTPClient::post(url, headers, body);
+        if (response.status_code != 200) {
+            state.SkipWithError("echo request failed");
+            break;
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * 2);
+}
+BENCHMARK(BM_HTTPClientRoundTrip)->Arg(64)->Arg(64 << 10)->UseRealTime();
+
+// Request formatting, HTTP round trip and response parsing of each provider
+static void BM_ProviderChat(benchmark::State& state, const std::string& provider) {
+    auto llm = mockLLM(provider);
+    const auto messages = conversation(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(llm->chat(messages));
+    }
+}
+
+static void BM_ProviderChatWithTools(benchmark::State& state, const std::string& provider) {
+    auto llm = mockLLM(provider);
+    auto messages = conversation(static_cast<size_t>(state.range(0)));
+    messages.push_back({Message::Role::USER, "Please use the weather tool for Paris."});
+    std::vector<std::shared_ptr<Tool>> tools;
+    for (int i = 0; i < 8; ++i) tools.push_back(weatherTool());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(llm->chatWithTools(messages, tools));
+    }
+}
+
+static void BM_ProviderStreamChat(benchmark::State& state, const std::string& provider) {
+    auto llm = mockLLM(provider);
+    const auto messages = conversation(static_cast<size_t>(state.range(0)));
+    size_t chunks = 0;
+    for (auto _ : state) {
+        llm->streamChat(messages, [&chunks](const std::string&, bool) { chunks++; });
+    }
+    state.counters["chunks_per_call"] = benchmark::Counter(static_cast<double>(chunks) / static_cast<double>(state.iterations()));
+}
+
+// Full agent loop (tool call, tool execution, final answer) on an in-process LLM
+static void BM_AgentLoopInProcess(benchmark::State& state) {
+    auto agent = weatherAgent(std::make_shared<ScriptedLLM>());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(blockingWait(agent->run("What is the weather in Paris?")));
+    }
+}
+BENCHMARK(BM_AgentLoopInProcess)->UseRealTime();
+
+// The same loop with a real provider talking HTTP to the mock server
+static void BM_AgentLoopMockServer(benchmark::State& state) {
+    auto agent = weatherAgent(mockLLM("openai"));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(blockingWait(agent->run("Please use the weather tool for Paris.")));
+    }
+}
+BENCHMARK(BM_AgentLoopMockServer)->UseRealTime();
+
+int main(int argc, char* argv[]) {
+    Logger::init(Logger::Level::WARN);
+
+    for (const char* provider : kProviders) {
+        benchmark::RegisterBenchmark((std::string("BM_ProviderChat/") + provider).c_str(), BM_ProviderChat, std::string(provider))
+            ->Arg(2)->Arg(16)->Arg(128)->UseRealTime();
+        benchmark::RegisterBenchmark((std::string("BM_ProviderChatWithTools/") + provider).c_str(), BM_ProviderChatWithTools, std::string(provider))
+            ->Arg(16)->UseRealTime();
+        benchmark::RegisterBenchmark((std::string("BM_ProviderStreamChat/") + provider).c_str(), BM_ProviderStreamChat, std::string(provider))
+            ->Arg(16)->UseRealTime();
+    }
+
+    // Default to a JSON report next to the console output
+    std::vector<char*> args(argv, argv + argc);
+    bool has_out = false;
+    for (int i = 1; i < argc; ++i) {
+        has_out = has_out || std::strncmp(argv[i], "--benchmark_out=", 16) == 0;
+    }
+    // Under `bazel run` the working directory is the runfiles tree
+    const char* workspace = std::getenv("BUILD_WORKING_DIRECTORY");
+    std::string out_flag = "--benchmark_out=" + (workspace ? std::string(workspace) + "/" : std::string()) + "sdk_benchmark.json";
+    std::string format_flag = "--benchmark_out_format=json";
+    if (!has_out) {
+        args.push_back(out_flag.data());
+        args.push_back(format_flag.data());
+    }
+    int count = static_cast<int>(args.size());
+    benchmark::Initialize(&count, args.data());
+    if (benchmark::ReportUnrecognizedArguments(count, args.data())) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
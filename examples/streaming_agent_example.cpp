@@ -0,0 +1,105 @@
+/**
+ * @example streaming_agent_example.cpp
+ * @brief Streaming ReAct Agent Example
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025 Edge AI, LLC. All rights reserved.
+ */
+#include <agents-cpp/agents/streaming_agent.h>
+#include <agents-cpp/config_loader.h>
+#include <agents-cpp/logger.h>
+#include <agents-cpp/tools/tool_registry.h>
+
+#include <iostream>
+
+using namespace agents;
+
+// Streaming agent loop with tool use
+Task<int> runStreamingAgent(int argc, char* argv[]) {
+    // Initialize the logger
+    Logger::init(Logger::Level::INFO);
+
+    // Get API key from .env, environment, or command line
+    std::string api_key;
+    auto& config = ConfigLoader::getInstance();
+
+    // Try to get API key from config or environment
+    api_key = config.get("GEMINI_API_KEY", "");
+
+    // If not found, check command line
+    if (api_key.empty() && argc > 1) {
+        api_key = argv[1];
+    }
+
+    // Still not found, show error and exit
+    if (api_key.empty()) {
+        Logger::error("API key not found. Please:");
+        Logger::error("1. Create a .env file with GEMINI_API_KEY=your_key, or");
+        Logger::error("2. Set the GEMINI_API_KEY environment variable, or");
+        Logger::error("3. Provide an API key as a command line argument");
+        co_return EXIT_FAILURE;
+    }
+
+    // Create the context with an LLM and a couple of tools
+    auto context = std::make_shared<Context>();
+    context->setLLM(createLLM("google", api_key, "gemini-2.0-flash"));
+    context->registerTool(tools::createWikipediaTool());
+    context->registerTool(tools::createWebSearchTool());
+
+    // Create the streaming agent
+    StreamingAgent agent(context);
+    agent.setAgentPrompt("You are a helpful research assistant.");
+    agent.init();
+
+    Logger::info("Enter a question or task for the agent (or 'exit' to quit):");
+    std::string user_input;
+    while (true) {
+        Logger::info("> ");
+        std::getline(std::cin, user_input);
+
+        if (user_input == "exit" || user_input == "quit" || user_input == "q") {
+            break;
+        }
+
+        if (user_input.empty()) {
+            continue;
+        }
+
+        // Render events as they arrive
+        auto events = agent.runStream(user_input);
+        while (auto event = co_await events.next()) {
+            switch (event->type) {
+                case AgentEvent::Type::TEXT_DELTA:
+                    std::cout << event->text << std::flush;
+                    break;
+                case AgentEvent::Type::TOOL_CALL_START:
+                    std::cout << "\n[calling " << event->tool_name << "...]" << std::flush;
+                    break;
+                case AgentEvent::Type::TOOL_CALL_END:
+                    std::cout << " " << event->data.dump() << std::endl;
+                    break;
+                case AgentEvent::Type::TOOL_RESULT:
+                    std::cout << "[" << event->tool_name << " returned "
+                              << event->text.size() << " characters]" << std::endl;
+                    break;
+                case AgentEvent::Type::DONE:
+                    std::cout << std::endl;
+                    break;
+                case AgentEvent::Type::ERROR:
+                    Logger::error("Error: {}", event->text);
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+    co_return EXIT_SUCCESS;
+}
+
+// Entry point
+int main(int argc, char* argv[]) {
+    // Use blockingWait to execute the coroutine
+    return blockingWait(runStreamingAgent(argc, argv));
+}
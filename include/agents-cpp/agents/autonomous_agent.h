@@ -123,10 +123,37 @@ public:
 
     /**
      * @brief Get the steps executed so far
+     * @note This copies every step held in memory. For long runs, record
+     * the steps with a StepHistory (agents/step_history.h), which trims this
+     * list to its capacity, and query the history by range.
      * @return The steps executed so far
      */
     std::vector<Step> getSteps() const;
 
+    /**
+     * @brief Visit the steps held in memory without copying them
+     * @param visitor Called with each step in execution order; return false to stop
+     */
+    void forEachStep(const std::function<bool(const Step&)>& visitor) const {
+        for (const auto& step : steps_) {
+            if (!visitor(step)) {
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief Drop all but the most recent steps held in memory
+     * @note StepHistory calls this once it has captured a step, so the
+     * agent's list stays bounded while the history keeps older steps.
+     * @param keep Number of most recent steps to keep
+     */
+    void trimSteps(size_t keep) {
+        if (steps_.size() > keep) {
+            steps_.erase(steps_.begin(), steps_.end() - static_cast<std::ptrdiff_t>(keep));
+        }
+    }
+
     /**
      * @brief Set a callback for when a step is completed
      * @param callback The callback
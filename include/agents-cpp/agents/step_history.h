@@ -0,0 +1,319 @@
+/**
+ * @file step_history.h
+ * @brief Bounded step history with disk spill for long-running agents
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025 Edge AI, LLC. All rights reserved.
+ *
+ */
+#pragma once
+
+#include <agents-cpp/agents/autonomous_agent.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace agents {
+
+/**
+ * @brief Bounded history of an AutonomousAgent's steps with disk spill
+ *
+ * The history is fed from the agent's step callback and keeps the most
+ * recent `capacity` steps in a ring buffer of its own, so recording a step is
+ * constant time. Older steps are appended to a file of size-prefixed
+ * MessagePack records, or dropped when no spill file is configured; only the
+ * file offset of each spilled step stays resident. The records are not
+ * compressed beyond MessagePack's binary encoding, as the SDK builds without
+ * a compression library; the spill file holds one record per evicted step.
+ *
+ * Once a step is captured, the agent's own step list is trimmed to the most
+ * recent `capacity` steps (AutonomousAgent::trimSteps()), so neither list
+ * grows with the run. Read older steps back from this history by range.
+ *
+ * Steps are addressed by their index in execution order; forEach() and
+ * getRange() read spilled steps back from disk and the rest from memory.
+ * All methods are thread-safe.
+ *
+ * @code
+ * AutonomousAgent agent(context);
+ * StepHistory history(agent, 128, "/tmp/agent_steps.bin", [](const AutonomousAgent::Step& step) {
+ *     AGENTS_LOG_INFO("{}", step.description);
+ * });
+ * @endcode
+ */
+class StepHistory {
+public:
+    /**
+     * @brief Step type recorded by the history
+     */
+    using Step = AutonomousAgent::Step;
+
+    /**
+     * @brief Constructor; records the agent's existing steps and takes over its step callback
+     * @param agent The agent whose steps to record; must outlive the history
+     * @param capacity Number of recent steps kept in memory (at least 1)
+     * @param spill_path Append-only file for older steps; empty drops them instead
+     * @param next Optional callback invoked with each step after it is recorded
+     * @throws std::runtime_error if the spill file cannot be opened
+     */
+    StepHistory(AutonomousAgent& agent,
+                size_t capacity = 256,
+                const std::string& spill_path = "",
+                std::function<void(const Step&)> next = nullptr)
+        : agent_(agent), capacity_(capacity == 0 ? 1 : capacity), spill_path_(spill_path), next_(std::move(next)) {
+        openSpillFile();
+        recent_.reserve(capacity_);
+        agent_.forEachStep([this](const Step& step) {
+            capture(step);
+            return true;
+        });
+        agent_.trimSteps(capacity_);
+        agent_.setStepCallback([this](const Step& step) {
+            capture(step);
+            if (next_) {
+                next_(step);
+            }
+            // Last, since `step` may refer into the agent's list
+            agent_.trimSteps(capacity_);
+        });
+    }
+
+    /**
+     * @brief Destructor; removes the step callback from the agent
+     */
+    ~StepHistory() { agent_.setStepCallback(nullptr); }
+
+    StepHistory(const StepHistory&) = delete;
+    StepHistory& operator=(const StepHistory&) = delete;
+
+    /**
+     * @brief Record a step and trim the agent's step list to the capacity
+     * @note The agent's steps are recorded through its step callback; call
+     * this for steps from elsewhere, not for references into the agent's list.
+     * @param step The step, copied into the history
+     * @throws std::runtime_error if an evicted step cannot be written to the spill file
+     */
+    void record(const Step& step) {
+        capture(step);
+        agent_.trimSteps(capacity_);
+    }
+
+    /**
+     * @brief Total number of steps recorded (in memory, spilled and dropped)
+     * @return The number of steps
+     */
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return first_recent_index_ + recent_.size();
+    }
+
+    /**
+     * @brief Index of the oldest step that can still be retrieved
+     * @return The index
+     */
+    size_t firstAvailable() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return spill_path_.empty() ? first_recent_index_ : 0;
+    }
+
+    /**
+     * @brief Visit steps in `[first, first + count)` in execution order
+     *
+     * Steps that were dropped (no spill file) are skipped. The history is
+     * locked while visiting, so the visitor must not call back into it.
+     *
+     * @param first Index of the first step
+     * @param count Maximum number of steps to visit
+     * @param visitor Called with each step's index and a reference to it; return false to stop
+     */
+    void forEach(size_t first, size_t count,
+                 const std::function<bool(size_t, const Step&)>& visitor) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        size_t total = first_recent_index_ + recent_.size();
+        size_t end = first >= total ? first : first + std::min(count, total - first);
+        size_t index = first;
+
+        if (index < first_recent_index_ && !spill_offsets_.empty()) {
+            std::ifstream in(spill_path_, std::ios::binary);
+            if (!in) {
+                throw std::runtime_error("Failed to open step spill file: " + spill_path_);
+            }
+            for (; index < first_recent_index_ && index < end; ++index) {
+                Step step = readSpilled(in, spill_offsets_[index]);
+                if (!visitor(index, step)) {
+                    return;
+                }
+            }
+        }
+        index = std::max(index, first_recent_index_);
+        for (; index < end; ++index) {
+            if (!visitor(index, recent_[(head_ + index - first_recent_index_) % capacity_])) {
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief Visit every retrievable step in execution order
+     * @param visitor Called with each step's index and a reference to it; return false to stop
+     */
+    void forEach(const std::function<bool(size_t, const Step&)>& visitor) const {
+        forEach(0, SIZE_MAX, visitor);
+    }
+
+    /**
+     * @brief Get a range of steps
+     * @param first Index of the first step
+     * @param count Maximum number of steps to return
+     * @return The steps in execution order
+     */
+    std::vector<Step> getRange(size_t first, size_t count) const {
+        std::vector<Step> steps;
+        forEach(first, count, [&steps](size_t, const Step& step) {
+            steps.push_back(step);
+            return true;
+        });
+        return steps;
+    }
+
+    /**
+     * @brief Get the most recent steps
+     * @param count Maximum number of steps to return
+     * @return The steps in execution order
+     */
+    std::vector<Step> getRecent(size_t count) const {
+        size_t total = size();
+        size_t first = total > count ? total - count : 0;
+        return getRange(first, count);
+    }
+
+/*! @cond PRIVATE */
+private:
+    /**
+     * @brief The agent whose steps are recorded
+     */
+    AutonomousAgent& agent_;
+
+    /**
+     * @brief Maximum number of steps kept in memory
+     */
+    size_t capacity_;
+
+    /**
+     * @brief Path of the spill file (empty when spilling is disabled)
+     */
+    std::string spill_path_;
+
+    /**
+     * @brief Callback chained after recording
+     */
+    std::function<void(const Step&)> next_;
+
+    /**
+     * @brief Ring buffer of the most recent steps
+     */
+    std::vector<Step> recent_;
+
+    /**
+     * @brief Position of the oldest step in recent_ once it is full
+     */
+    size_t head_ = 0;
+
+    /**
+     * @brief Execution index of the oldest in-memory step
+     */
+    size_t first_recent_index_ = 0;
+
+    /**
+     * @brief File offset of each spilled step, by execution index
+     */
+    std::vector<uint64_t> spill_offsets_;
+
+    /**
+     * @brief Current end of the spill file
+     */
+    uint64_t spill_end_ = 0;
+
+    /**
+     * @brief Append stream of the spill file
+     */
+    std::ofstream spill_out_;
+
+    /**
+     * @brief Guards all state
+     */
+    mutable std::mutex mutex_;
+
+    void capture(const Step& step) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (recent_.size() < capacity_) {
+            recent_.push_back(step);
+            return;
+        }
+        spill(recent_[head_]);
+        recent_[head_] = step;
+        head_ = (head_ + 1) % capacity_;
+        first_recent_index_++;
+    }
+
+    void openSpillFile() {
+        if (spill_path_.empty()) {
+            return;
+        }
+        spill_out_.open(spill_path_, std::ios::binary | std::ios::trunc);
+        if (!spill_out_) {
+            throw std::runtime_error("Failed to open step spill file: " + spill_path_);
+        }
+    }
+
+    // Record layout: 32-bit size, then the step as MessagePack
+    void spill(const Step& step) {
+        if (spill_path_.empty()) {
+            return;
+        }
+        JsonObject record = {
+            {"d", step.description},
+            {"s", step.status},
+            {"r", step.result},
+            {"ok", step.success}
+        };
+        std::vector<uint8_t> bytes = JsonObject::to_msgpack(record);
+        uint32_t size = static_cast<uint32_t>(bytes.size());
+        spill_out_.write(reinterpret_cast<const char*>(&size), sizeof(size));
+        spill_out_.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        spill_out_.flush();
+        if (!spill_out_) {
+            throw std::runtime_error("Failed to write step spill file: " + spill_path_);
+        }
+        spill_offsets_.push_back(spill_end_);
+        spill_end_ += sizeof(size) + bytes.size();
+    }
+
+    static Step readSpilled(std::ifstream& in, uint64_t offset) {
+        uint32_t size = 0;
+        in.seekg(static_cast<std::streamoff>(offset));
+        in.read(reinterpret_cast<char*>(&size), sizeof(size));
+        std::vector<uint8_t> bytes(size);
+        in.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        if (!in) {
+            throw std::runtime_error("Corrupt step spill file");
+        }
+        JsonObject record = JsonObject::from_msgpack(bytes);
+        Step step;
+        step.description = record.value("d", "");
+        step.status = record.value("s", "");
+        step.result = std::move(record["r"]);
+        step.success = record.value("ok", false);
+        return step;
+    }
+/*! @endcond */
+};
+
+} // namespace agents
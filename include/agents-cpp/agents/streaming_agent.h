@@ -0,0 +1,628 @@
+/**
+ * @file streaming_agent.h
+ * @brief Streaming ReAct Agent Definition
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025 Edge AI, LLC. All rights reserved.
+ *
+ */
+#pragma once
+
+#include <agents-cpp/agent.h>
+#include <agents-cpp/coroutine_utils.h>
+
+#include <atomic>
+#include <cctype>
+#include <string>
+#include <vector>
+
+namespace agents {
+
+/**
+ * @brief Typed event emitted by a streaming agent run
+ */
+struct AgentEvent {
+    /**
+     * @brief Event type
+     */
+    enum class Type {
+        /**
+         * @brief A reasoning step (one LLM call) started
+         */
+        STEP_START,
+        /**
+         * @brief Incremental model text; `is_answer` marks final-answer text
+         */
+        TEXT_DELTA,
+        /**
+         * @brief The model started a tool call; `tool_name` is known
+         */
+        TOOL_CALL_START,
+        /**
+         * @brief The tool call arguments are complete; `data` holds them
+         */
+        TOOL_CALL_END,
+        /**
+         * @brief A tool finished; `text` is its content, `data` its result
+         */
+        TOOL_RESULT,
+        /**
+         * @brief A reasoning step ended
+         */
+        STEP_END,
+        /**
+         * @brief The run finished; `text` is the final answer
+         */
+        DONE,
+        /**
+         * @brief The run failed; `text` is the error message
+         */
+        ERROR
+    };
+
+    /**
+     * @brief The event type
+     */
+    Type type;
+    /**
+     * @brief The step (LLM call) the event belongs to, starting at 1
+     */
+    int step = 0;
+    /**
+     * @brief Text payload (delta, tool content, answer or error)
+     */
+    std::string text;
+    /**
+     * @brief The tool name for tool events
+     */
+    std::string tool_name;
+    /**
+     * @brief Structured payload (tool arguments or tool result)
+     */
+    JsonObject data;
+    /**
+     * @brief Whether a TEXT_DELTA belongs to the final answer
+     */
+    bool is_answer = false;
+
+    /**
+     * @brief Constructor
+     * @param type The event type
+     * @param step The step the event belongs to
+     * @param text The text payload
+     */
+    AgentEvent(Type type, int step = 0, std::string text = "")
+        : type(type), step(step), text(std::move(text)) {}
+};
+
+/**
+ * @brief Incremental parser for ReAct-formatted model output
+ *
+ * Consumes streamed chunks of text in the format
+ * `Thought: ... / Action: <tool> / Action Input: <json>` or
+ * `Final Answer: ...` and turns them into AgentEvents as soon as each piece
+ * is unambiguous. Text is forwarded immediately unless the current line could
+ * still turn into a marker, so deltas lag the stream by at most one partial line.
+ */
+class ReActStreamParser {
+public:
+    /**
+     * @brief Feed the next chunk of model output
+     * @param chunk The chunk
+     * @param out Events produced by this chunk are appended here
+     */
+    void feed(const std::string& chunk, std::vector<AgentEvent>& out) {
+        pending_ += chunk;
+        process(out, false);
+    }
+
+    /**
+     * @brief Flush buffered text once the stream has ended
+     * @param out Events produced by the flush are appended here
+     */
+    void finish(std::vector<AgentEvent>& out) {
+        process(out, true);
+        if (state_ == State::ACTION_INPUT && !action_complete_) {
+            completeAction(out);
+        }
+    }
+
+    /**
+     * @brief Whether a tool call (name and arguments) has been fully parsed
+     * @return True when the tool should be executed
+     */
+    bool actionComplete() const { return action_complete_; }
+
+    /**
+     * @brief Whether the model started its final answer
+     * @return True after a `Final Answer:` marker
+     */
+    bool hasFinalAnswer() const { return state_ == State::ANSWER; }
+
+    /**
+     * @brief The parsed tool name
+     * @return The tool name
+     */
+    const std::string& toolName() const { return tool_name_; }
+
+    /**
+     * @brief The parsed tool arguments
+     * @return The arguments (an object with an `input` field when not JSON)
+     */
+    const JsonObject& toolInput() const { return tool_input_; }
+
+    /**
+     * @brief Final answer text received so far
+     * @return The final answer
+     */
+    const std::string& answer() const { return answer_; }
+
+    /**
+     * @brief Reasoning text received so far (outside the final answer)
+     * @return The thought text
+     */
+    const std::string& thought() const { return thought_; }
+
+    /**
+     * @brief All model text consumed so far, up to the end of a tool call
+     * @return The transcript for the assistant message
+     */
+    const std::string& transcript() const { return transcript_; }
+
+/*! @cond PRIVATE */
+private:
+    enum class State { THOUGHT, AWAIT_INPUT, ACTION_INPUT, ANSWER };
+
+    State state_ = State::THOUGHT;
+    std::string pending_;
+    bool line_start_ = true;
+    bool answer_started_ = false;
+    bool discarding_ = false;
+    bool action_complete_ = false;
+    std::string tool_name_;
+    std::string input_text_;
+    JsonObject tool_input_;
+    std::string answer_;
+    std::string thought_;
+    std::string transcript_;
+
+    static constexpr const char* kAction = "Action:";
+    static constexpr const char* kActionInput = "Action Input:";
+    static constexpr const char* kFinalAnswer = "Final Answer:";
+    static constexpr const char* kObservation = "Observation:";
+
+    static std::string_view ltrim(std::string_view s) {
+        size_t i = 0;
+        while (i < s.size() && (s[i] == ' ' || s[i] == '\t' || s[i] == '*')) ++i;
+        return s.substr(i);
+    }
+
+    static std::string trim(std::string_view s) {
+        s = ltrim(s);
+        while (!s.empty() && std::isspace(static_cast<unsigned char>(s.back()))) s.remove_suffix(1);
+        return std::string(s);
+    }
+
+    static bool startsWith(std::string_view s, std::string_view prefix) {
+        return s.substr(0, prefix.size()) == prefix;
+    }
+
+    // The partial line could still become `marker`
+    static bool couldBecome(std::string_view partial, std::string_view marker) {
+        return partial.size() < marker.size() && startsWith(marker, partial);
+    }
+
+    void consume(size_t n) {
+        transcript_.append(pending_, 0, n);
+        pending_.erase(0, n);
+    }
+
+    void emitText(std::string text, std::vector<AgentEvent>& out) {
+        if (text.empty()) {
+            return;
+        }
+        bool is_answer = state_ == State::ANSWER;
+        (is_answer ? answer_ : thought_) += text;
+        AgentEvent event{AgentEvent::Type::TEXT_DELTA};
+        event.text = std::move(text);
+        event.is_answer = is_answer;
+        out.push_back(std::move(event));
+    }
+
+    void completeAction(std::vector<AgentEvent>& out) {
+        action_complete_ = true;
+        std::string raw = trim(input_text_);
+        tool_input_ = JsonObject::parse(raw, nullptr, false);
+        if (tool_input_.is_discarded() || !tool_input_.is_object()) {
+            tool_input_ = JsonObject{{"input", raw}};
+        }
+        AgentEvent event{AgentEvent::Type::TOOL_CALL_END};
+        event.tool_name = tool_name_;
+        event.data = tool_input_;
+        out.push_back(std::move(event));
+    }
+
+    // Scan the action input for the end of a balanced JSON object
+    void processActionInput(std::vector<AgentEvent>& out, bool at_end) {
+        input_text_ += pending_;
+        consume(pending_.size());
+
+        size_t first = input_text_.find_first_not_of(" \t\r\n");
+        if (first == std::string::npos) {
+            return;
+        }
+        if (input_text_[first] != '{') {
+            // Plain-text input ends at the end of the line
+            size_t newline = input_text_.find('\n', first);
+            if (newline != std::string::npos || at_end) {
+                size_t cut = newline == std::string::npos ? input_text_.size() : newline;
+                giveBack(cut);
+                completeAction(out);
+            }
+            return;
+        }
+        int depth = 0;
+        bool in_string = false, escaped = false;
+        for (size_t i = first; i < input_text_.size(); ++i) {
+            char c = input_text_[i];
+            if (in_string) {
+                if (escaped) escaped = false;
+                else if (c == '\\') escaped = true;
+                else if (c == '"') in_string = false;
+                continue;
+            }
+            if (c == '"') in_string = true;
+            else if (c == '{') depth++;
+            else if (c == '}' && --depth == 0) {
+                giveBack(i + 1);
+                completeAction(out);
+                return;
+            }
+        }
+    }
+
+    // Return text after the action input to the pending buffer (it is not part of the call)
+    void giveBack(size_t cut) {
+        std::string rest = input_text_.substr(cut);
+        input_text_.resize(cut);
+        transcript_.resize(transcript_.size() - rest.size());
+        pending_ = std::move(rest) + pending_;
+    }
+
+    void process(std::vector<AgentEvent>& out, bool at_end) {
+        if (discarding_) {
+            pending_.clear();
+            return;
+        }
+        while (!pending_.empty() && !action_complete_) {
+            if (state_ == State::ACTION_INPUT) {
+                processActionInput(out, at_end);
+                return;
+            }
+            if (state_ == State::ANSWER) {
+                if (!answer_started_) {
+                    // Spaces after the marker may arrive in a later chunk
+                    size_t spaces = pending_.find_first_not_of(' ');
+                    consume(spaces == std::string::npos ? pending_.size() : spaces);
+                    if (pending_.empty()) return;
+                    answer_started_ = true;
+                }
+                std::string text = pending_;
+                consume(pending_.size());
+                emitText(std::move(text), out);
+                return;
+            }
+
+            size_t newline = pending_.find('\n');
+            bool complete_line = newline != std::string::npos;
+            size_t line_len = complete_line ? newline + 1 : pending_.size();
+
+            if (!line_start_) {
+                std::string text = pending_.substr(0, line_len);
+                consume(line_len);
+                line_start_ = complete_line;
+                if (state_ == State::THOUGHT) emitText(std::move(text), out);
+                continue;
+            }
+
+            std::string_view line = ltrim(std::string_view(pending_).substr(0, line_len));
+            size_t lead = line_len - line.size();
+
+            if (state_ == State::AWAIT_INPUT) {
+                if (startsWith(line, kActionInput)) {
+                    consume(lead + std::char_traits<char>::length(kActionInput));
+                    state_ = State::ACTION_INPUT;
+                } else if (!complete_line && !at_end && couldBecome(line, kActionInput)) {
+                    return;
+                } else if (trim(line).empty()) {
+                    consume(line_len);
+                } else {
+                    state_ = State::ACTION_INPUT; // arguments without the marker
+                }
+                continue;
+            }
+
+            // THOUGHT at the start of a line: look for markers
+            if (startsWith(line, kFinalAnswer)) {
+                consume(lead + std::char_traits<char>::length(kFinalAnswer));
+                state_ = State::ANSWER;
+                continue;
+            }
+            if (startsWith(line, kAction) && !startsWith(line, kActionInput)) {
+                if (!complete_line && !at_end) {
+                    return; // wait for the whole tool name
+                }
+                tool_name_ = trim(line.substr(std::char_traits<char>::length(kAction)));
+                consume(line_len);
+                state_ = State::AWAIT_INPUT;
+                AgentEvent event{AgentEvent::Type::TOOL_CALL_START};
+                event.tool_name = tool_name_;
+                out.push_back(std::move(event));
+                continue;
+            }
+            if (startsWith(line, kObservation)) {
+                // The model is hallucinating a tool result; drop the rest of the stream
+                discarding_ = true;
+                pending_.clear();
+                return;
+            }
+            if (!complete_line && !at_end &&
+                (couldBecome(line, kAction) || couldBecome(line, kFinalAnswer) || couldBecome(line, kObservation))) {
+                return;
+            }
+            std::string text = pending_.substr(0, line_len);
+            consume(line_len);
+            line_start_ = complete_line;
+            emitText(std::move(text), out);
+        }
+    }
+/*! @endcond */
+};
+
+/**
+ * @brief ReAct agent that streams its reasoning, tool calls and answer as typed events
+ *
+ * Each step streams one model response through
+ * `LLMInterface::streamChatAsync`. Text deltas are forwarded as they arrive;
+ * when the model emits a tool call the stream is cut at the end of the call
+ * arguments, the tool is executed through `Context::executeTool`, and its
+ * observation is fed into the next step. The loop ends at the model's final
+ * answer or after `Options::max_iterations` steps.
+ *
+ * @code
+ * StreamingAgent agent(context);
+ * auto events = agent.runStream("What is the weather in Paris?");
+ * while (auto event = co_await events.next()) {
+ *     if (event->type == AgentEvent::Type::TEXT_DELTA) std::cout << event->text << std::flush;
+ * }
+ * @endcode
+ */
+class StreamingAgent : public Agent {
+public:
+    /**
+     * @brief Constructor
+     * @param context The agent context
+     */
+    StreamingAgent(std::shared_ptr<Context> context) : Agent(std::move(context)) {}
+
+    /**
+     * @brief Destructor
+     */
+    ~StreamingAgent() override = default;
+
+    /**
+     * @brief Initialize the agent
+     */
+    void init() override {
+        should_stop_ = false;
+        setState(State::READY);
+    }
+
+    /**
+     * @brief Set the agent prompt (prepended to the ReAct instructions)
+     * @param agent_prompt The agent prompt
+     */
+    void setAgentPrompt(const std::string& agent_prompt) { agent_prompt_ = agent_prompt; }
+
+    /**
+     * @brief Run the agent and stream its events
+     * @param task The task to run
+     * @return Generator of events, ending with DONE or ERROR
+     */
+    AsyncGenerator<AgentEvent> runStream(std::string task) {
+        should_stop_ = false;
+        setState(State::RUNNING);
+        auto llm = context_->getLLM();
+        if (!llm) {
+            setState(State::FAILED);
+            co_yield AgentEvent{AgentEvent::Type::ERROR, 0, "No LLM configured on the context"};
+            co_return;
+        }
+
+        std::vector<Message> messages;
+        messages.push_back(Message{Message::Role::SYSTEM, createSystemPrompt()});
+        messages.push_back(Message{Message::Role::USER, "Task: " + task});
+
+        int consecutive_errors = 0;
+        for (int step = 1; step <= options_.max_iterations; ++step) {
+            if (should_stop_) {
+                setState(State::STOPPED);
+                co_yield AgentEvent{AgentEvent::Type::ERROR, step, "Stopped"};
+                co_return;
+            }
+            co_yield AgentEvent{AgentEvent::Type::STEP_START, step};
+
+            ReActStreamParser parser;
+            std::vector<AgentEvent> events;
+            std::string error;
+            try {
+                auto stream = llm->streamChatAsync(messages, {});
+                while (auto chunk = co_await stream.next()) {
+                    parser.feed(*chunk, events);
+                    for (auto& event : events) {
+                        event.step = step;
+                        co_yield std::move(event);
+                    }
+                    events.clear();
+                    if (parser.actionComplete() || should_stop_) {
+                        break; // cut the stream; the rest would be a guessed observation
+                    }
+                }
+                parser.finish(events);
+            } catch (const std::exception& e) {
+                error = e.what();
+            }
+            for (auto& event : events) {
+                event.step = step;
+                co_yield std::move(event);
+            }
+            if (!error.empty()) {
+                setState(State::FAILED);
+                co_yield AgentEvent{AgentEvent::Type::ERROR, step, error};
+                co_return;
+            }
+
+            if (!parser.actionComplete()) {
+                co_yield AgentEvent{AgentEvent::Type::STEP_END, step};
+                std::string answer = trimmed(parser.hasFinalAnswer() ? parser.answer() : stripThoughtMarkers(parser.thought()));
+                setState(State::COMPLETED);
+                logStatus("Completed in " + std::to_string(step) + " step(s)");
+                co_yield AgentEvent{AgentEvent::Type::DONE, step, answer};
+                co_return;
+            }
+
+            // Run the tool cycle, then continue with the observation
+            AgentEvent result_event{AgentEvent::Type::TOOL_RESULT, step};
+            result_event.tool_name = parser.toolName();
+            if (context_->getTool(parser.toolName())) {
+                ToolResult result = co_await context_->executeTool(parser.toolName(), parser.toolInput());
+                consecutive_errors = result.success ? 0 : consecutive_errors + 1;
+                result_event.text = result.content;
+                result_event.data = JsonObject{{"success", result.success}, {"data", result.data}};
+            } else {
+                consecutive_errors++;
+                result_event.text = "Unknown tool: " + parser.toolName();
+                result_event.data = JsonObject{{"success", false}};
+            }
+            std::string observation = "Observation: " + result_event.text;
+            co_yield std::move(result_event);
+            co_yield AgentEvent{AgentEvent::Type::STEP_END, step};
+
+            if (consecutive_errors >= options_.max_consecutive_errors) {
+                setState(State::FAILED);
+                co_yield AgentEvent{AgentEvent::Type::ERROR, step, "Too many consecutive tool errors"};
+                co_return;
+            }
+            messages.push_back(Message{Message::Role::ASSISTANT, parser.transcript()});
+            messages.push_back(Message{Message::Role::USER, observation});
+        }
+
+        setState(State::FAILED);
+        co_yield AgentEvent{AgentEvent::Type::ERROR, options_.max_iterations, "Maximum iterations reached without a final answer"};
+    }
+
+    /**
+     * @brief Run the agent with a task, consuming the event stream
+     * @param task The task to run
+     * @return The result with `answer`, `steps` and `tool_calls`
+     */
+    Task<JsonObject> run(const std::string& task) override {
+        return collect(task);
+    }
+
+    /**
+     * @brief Stop the agent at the next chunk or step boundary
+     */
+    void stop() override {
+        should_stop_ = true;
+    }
+
+/*! @cond PRIVATE */
+private:
+    /**
+     * @brief Agent prompt
+     */
+    std::string agent_prompt_;
+
+    /**
+     * @brief Stop flag
+     */
+    std::atomic<bool> should_stop_{false};
+
+    static std::string trimmed(const std::string& s) {
+        size_t begin = s.find_first_not_of(" \t\r\n");
+        if (begin == std::string::npos) return "";
+        size_t end = s.find_last_not_of(" \t\r\n");
+        return s.substr(begin, end - begin + 1);
+    }
+
+    // A reply without `Final Answer:` is answered by its reasoning, minus the `Thought:` markers
+    static std::string stripThoughtMarkers(const std::string& text) {
+        static constexpr std::string_view kThought = "Thought:";
+        std::string out;
+        size_t start = 0;
+        while (start <= text.size()) {
+            size_t end = text.find('\n', start);
+            std::string_view line(text.data() + start, (end == std::string::npos ? text.size() : end) - start);
+            size_t lead = line.find_first_not_of(" \t*");
+            if (lead != std::string_view::npos && line.substr(lead, kThought.size()) == kThought) {
+                line.remove_prefix(lead + kThought.size());
+                while (!line.empty() && (line.front() == ' ' || line.front() == '*')) line.remove_prefix(1);
+            }
+            out.append(line);
+            if (end == std::string::npos) break;
+            out += '\n';
+            start = end + 1;
+        }
+        return out;
+    }
+
+    std::string createSystemPrompt() const {
+        std::string prompt = context_->getSystemPrompt();
+        if (!agent_prompt_.empty()) {
+            prompt += (prompt.empty() ? "" : "\n\n") + agent_prompt_;
+        }
+        prompt += "\n\nYou have access to the following tools:\n";
+        for (const auto& tool : context_->getTools()) {
+            prompt += "- " + tool->getName() + ": " + tool->getDescription() +
+                      "\n  Parameters: " + tool->getSchema().dump() + "\n";
+        }
+        prompt +=
+            "\nRespond using this format:\n"
+            "Thought: your reasoning about what to do next\n"
+            "Action: the tool name\n"
+            "Action Input: the tool arguments as a JSON object\n"
+            "Then stop and wait for the Observation.\n"
+            "When you know the answer, respond with:\n"
+            "Thought: your final reasoning\n"
+            "Final Answer: the answer to the task\n";
+        return prompt;
+    }
+
+    Task<JsonObject> collect(std::string task) {
+        JsonObject result = {{"answer", ""}, {"steps", 0}, {"tool_calls", JsonObject::array()}};
+        auto events = runStream(std::move(task));
+        while (auto event = co_await events.next()) {
+            switch (event->type) {
+                case AgentEvent::Type::TOOL_CALL_END:
+                    result["tool_calls"].push_back({{"tool", event->tool_name}, {"params", event->data}});
+                    break;
+                case AgentEvent::Type::DONE:
+                    result["answer"] = event->text;
+                    result["steps"] = event->step;
+                    break;
+                case AgentEvent::Type::ERROR:
+                    result["error"] = event->text;
+                    result["steps"] = event->step;
+                    break;
+                default:
+                    break;
+            }
+        }
+        co_return result;
+    }
+/*! @endcond */
+};
+
+} // namespace agents
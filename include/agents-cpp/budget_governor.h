@@ -0,0 +1,614 @@
+/**
+ * @file budget_governor.h
+ * @brief Per-run token, cost and latency budgets for agents
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025 Edge AI, LLC. All rights reserved.
+ *
+ */
+#pragma once
+
+#include <agents-cpp/llm_interface.h>
+#include <agents-cpp/types.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace agents {
+
+/**
+ * @brief Price of a model in currency units per 1000 tokens
+ */
+struct ModelPricing {
+    /**
+     * @brief Cost per 1000 input (prompt) tokens
+     */
+    double input_per_1k_tokens = 0.0;
+    /**
+     * @brief Cost per 1000 output (completion) tokens
+     */
+    double output_per_1k_tokens = 0.0;
+};
+
+/**
+ * @brief Limits for a single agent run
+ * @note A limit of zero means the dimension is unbounded.
+ */
+struct Budget {
+    /**
+     * @brief The maximum number of input tokens across all calls
+     */
+    int64_t max_input_tokens = 0;
+    /**
+     * @brief The maximum number of output tokens across all calls
+     */
+    int64_t max_output_tokens = 0;
+    /**
+     * @brief The maximum estimated cost across all calls
+     */
+    double max_cost = 0.0;
+    /**
+     * @brief The maximum wall-clock time of the run in milliseconds
+     */
+    int64_t max_wall_time_ms = 0;
+    /**
+     * @brief Fraction (0.0 to 1.0) of any limit at which the soft threshold trips
+     */
+    double soft_threshold = 0.8;
+    /**
+     * @brief Pricing used for models that have no entry in `pricing`
+     */
+    ModelPricing default_pricing;
+    /**
+     * @brief Pricing per model name
+     */
+    std::map<std::string, ModelPricing> pricing;
+};
+
+/**
+ * @brief Resources consumed so far by a run
+ */
+struct BudgetUsage {
+    /**
+     * @brief Input tokens consumed
+     */
+    int64_t input_tokens = 0;
+    /**
+     * @brief Output tokens consumed
+     */
+    int64_t output_tokens = 0;
+    /**
+     * @brief Estimated cost
+     */
+    double cost = 0.0;
+    /**
+     * @brief Elapsed wall-clock time in milliseconds
+     */
+    int64_t elapsed_ms = 0;
+    /**
+     * @brief Number of LLM calls recorded
+     */
+    int calls = 0;
+};
+
+/**
+ * @brief Thrown when an LLM call is attempted after a hard budget limit was reached
+ */
+class BudgetExceededError : public std::runtime_error {
+public:
+    /**
+     * @brief Constructor
+     * @param message The error message
+     */
+    explicit BudgetExceededError(const std::string& message) : std::runtime_error(message) {}
+};
+
+/**
+ * @brief Tracks token, cost and wall-clock usage of a run against a Budget
+ *
+ * The governor is shared between every LLM used by a run and is safe to use
+ * from multiple threads. The wall clock starts at the first check after
+ * construction or `reset()`.
+ */
+class BudgetGovernor {
+public:
+    /**
+     * @brief Budget state
+     */
+    enum class Status {
+        /**
+         * @brief All limits below the soft threshold
+         */
+        OK,
+        /**
+         * @brief At least one limit above the soft threshold
+         */
+        SOFT_LIMIT,
+        /**
+         * @brief At least one limit reached
+         */
+        HARD_LIMIT
+    };
+
+    /**
+     * @brief Constructor
+     * @param budget The budget to enforce
+     */
+    explicit BudgetGovernor(const Budget& budget = Budget()) : budget_(budget) {}
+
+    /**
+     * @brief Set the budget to enforce
+     * @param budget The budget
+     */
+    void setBudget(const Budget& budget) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        budget_ = budget;
+    }
+
+    /**
+     * @brief Get the enforced budget
+     * @return The budget
+     */
+    Budget getBudget() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return budget_;
+    }
+
+    /**
+     * @brief Clear accumulated usage and restart the wall clock for a new run
+     */
+    void reset() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        usage_ = BudgetUsage();
+        started_ = false;
+    }
+
+    /**
+     * @brief Check the budget before an LLM call
+     * @return The current budget status
+     */
+    Status check() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!started_) {
+            started_ = true;
+            start_time_ = std::chrono::steady_clock::now();
+        }
+        double utilization = utilizationLocked();
+        if (utilization >= 1.0) {
+            return Status::HARD_LIMIT;
+        }
+        if (utilization >= budget_.soft_threshold) {
+            return Status::SOFT_LIMIT;
+        }
+        return Status::OK;
+    }
+
+    /**
+     * @brief Record the usage reported by an LLM response
+     * @param response The LLM response
+     * @param model The model that produced the response (selects pricing)
+     */
+    void record(const LLMResponse& response, const std::string& model) {
+        auto [input_tokens, output_tokens] = extractTokenUsage(response.usage_metrics);
+        record(input_tokens, output_tokens, model);
+    }
+
+    /**
+     * @brief Record token usage of an LLM call
+     * @param input_tokens The input tokens consumed
+     * @param output_tokens The output tokens consumed
+     * @param model The model used for the call (selects pricing)
+     */
+    void record(int64_t input_tokens, int64_t output_tokens, const std::string& model) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const ModelPricing& price = pricingFor(model);
+        usage_.input_tokens += input_tokens;
+        usage_.output_tokens += output_tokens;
+        usage_.cost += (static_cast<double>(input_tokens) * price.input_per_1k_tokens +
+                        static_cast<double>(output_tokens) * price.output_per_1k_tokens) / 1000.0;
+        usage_.calls++;
+    }
+
+    /**
+     * @brief Get the usage accumulated so far
+     * @return The usage
+     */
+    BudgetUsage getUsage() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        BudgetUsage usage = usage_;
+        usage.elapsed_ms = elapsedMsLocked();
+        return usage;
+    }
+
+    /**
+     * @brief Get the highest fraction of any limit used so far
+     * @return The utilization (1.0 means a limit was reached)
+     */
+    double getUtilization() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return utilizationLocked();
+    }
+
+    /**
+     * @brief Get the usage as a JSON object (for step logs and results)
+     * @return The usage report
+     */
+    JsonObject toJson() const {
+        BudgetUsage usage = getUsage();
+        return JsonObject{
+            {"input_tokens", usage.input_tokens},
+            {"output_tokens", usage.output_tokens},
+            {"cost", usage.cost},
+            {"elapsed_ms", usage.elapsed_ms},
+            {"calls", usage.calls},
+            {"utilization", getUtilization()}
+        };
+    }
+
+    /**
+     * @brief Normalize provider-specific usage metrics into input and output token counts
+     *
+     * Understands the OpenAI, Anthropic, Google and Ollama usage keys.
+     *
+     * @param usage_metrics The usage metrics of an LLM response
+     * @return Pair of input and output tokens
+     */
+    static std::pair<int64_t, int64_t> extractTokenUsage(const std::map<std::string, double>& usage_metrics) {
+        static const char* input_keys[] = {"prompt_tokens", "input_tokens", "promptTokenCount", "prompt_eval_count"};
+        static const char* output_keys[] = {"completion_tokens", "output_tokens", "candidatesTokenCount", "eval_count"};
+        auto first_of = [&usage_metrics](const auto& keys) -> int64_t {
+            for (const char* key : keys) {
+                auto it = usage_metrics.find(key);
+                if (it != usage_metrics.end()) {
+                    return static_cast<int64_t>(it->second);
+                }
+            }
+            return 0;
+        };
+        return {first_of(input_keys), first_of(output_keys)};
+    }
+
+    /**
+     * @brief Rough token estimate for text when a provider reports no usage (streaming)
+     * @param text The text
+     * @return Estimated token count (~4 characters per token)
+     */
+    static int64_t estimateTokens(const std::string& text) {
+        return static_cast<int64_t>((text.size() + 3) / 4);
+    }
+
+private:
+    mutable std::mutex mutex_;
+    Budget budget_;
+    BudgetUsage usage_;
+    bool started_ = false;
+    std::chrono::steady_clock::time_point start_time_;
+
+    const ModelPricing& pricingFor(const std::string& model) const {
+        auto it = budget_.pricing.find(model);
+        return it != budget_.pricing.end() ? it->second : budget_.default_pricing;
+    }
+
+    int64_t elapsedMsLocked() const {
+        if (!started_) {
+            return 0;
+        }
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start_time_).count();
+    }
+
+    double utilizationLocked() const {
+        double utilization = 0.0;
+        auto consider = [&utilization](double used, double limit) {
+            if (limit > 0.0) {
+                utilization = std::max(utilization, used / limit);
+            }
+        };
+        consider(static_cast<double>(usage_.input_tokens), static_cast<double>(budget_.max_input_tokens));
+        consider(static_cast<double>(usage_.output_tokens), static_cast<double>(budget_.max_output_tokens));
+        consider(usage_.cost, budget_.max_cost);
+        consider(static_cast<double>(elapsedMsLocked()), static_cast<double>(budget_.max_wall_time_ms));
+        return utilization;
+    }
+};
+
+/**
+ * @brief LLMInterface decorator that enforces a BudgetGovernor before every call
+ *
+ * Install it on an agent's Context in place of the provider LLM. Before each
+ * call the governor is checked:
+ * - below the soft threshold the primary LLM is used as-is;
+ * - at the soft threshold the call degrades instead of aborting: it is routed to
+ *   the cheaper fallback LLM (if set) and the conversation is trimmed to the
+ *   most recent messages (if a limit is set);
+ * - at the hard limit a BudgetExceededError is thrown, which ends the agent loop.
+ */
+class BudgetedLLM : public LLMInterface {
+public:
+    /**
+     * @brief Constructor
+     * @param llm The primary LLM
+     * @param governor The governor shared by the run
+     * @param fallback_llm Optional cheaper LLM used past the soft threshold
+     * @param soft_limit_max_messages Non-system messages kept past the soft threshold (0 keeps all)
+     */
+    BudgetedLLM(
+        std::shared_ptr<LLMInterface> llm,
+        std::shared_ptr<BudgetGovernor> governor,
+        std::shared_ptr<LLMInterface> fallback_llm = nullptr,
+        size_t soft_limit_max_messages = 0
+    ) : llm_(std::move(llm)), fallback_llm_(std::move(fallback_llm)),
+        governor_(std::move(governor)), soft_limit_max_messages_(soft_limit_max_messages) {
+        if (!llm_ || !governor_) {
+            throw std::invalid_argument("BudgetedLLM requires an LLM and a governor");
+        }
+    }
+
+    /**
+     * @brief Get the budget governor
+     * @return The governor
+     */
+    std::shared_ptr<BudgetGovernor> getGovernor() const { return governor_; }
+
+    /**
+     * @brief Get available models from the primary LLM
+     * @return The available models
+     */
+    std::vector<std::string> getAvailableModels() override { return llm_->getAvailableModels(); }
+
+    /**
+     * @brief Set the model of the primary LLM
+     * @param model The model to use
+     */
+    void setModel(const std::string& model) override { llm_->setModel(model); }
+
+    /**
+     * @brief Get the model of the primary LLM
+     * @return The current model
+     */
+    std::string getModel() const override { return llm_->getModel(); }
+
+    /**
+     * @brief Set API key of the primary LLM
+     * @param api_key The API key to use
+     */
+    void setApiKey(const std::string& api_key) override { llm_->setApiKey(api_key); }
+
+    /**
+     * @brief Set API base URL of the primary LLM
+     * @param api_base The API base URL to use
+     */
+    void setApiBase(const std::string& api_base) override { llm_->setApiBase(api_base); }
+
+    /**
+     * @brief Set options of the primary LLM
+     * @param options The options to use
+     */
+    void setOptions(const LLMOptions& options) override { llm_->setOptions(options); }
+
+    /**
+     * @brief Get options of the primary LLM
+     * @return The current options
+     */
+    LLMOptions getOptions() const override { return llm_->getOptions(); }
+
+    /**
+     * @brief Generate completion from a prompt within budget
+     * @param prompt The prompt
+     * @return The completion
+     */
+    LLMResponse chat(const std::string& prompt) override {
+        return chat(std::vector<Message>{Message{Message::Role::USER, prompt}});
+    }
+
+    /**
+     * @brief Generate completion from a list of messages within budget
+     * @param messages The messages to generate completion from
+     * @return The LLM response
+     */
+    LLMResponse chat(const std::vector<Message>& messages) override {
+        std::vector<Message> effective = messages;
+        auto llm = admit(effective);
+        LLMResponse response = llm->chat(effective);
+        governor_->record(response, llm->getModel());
+        return response;
+    }
+
+    /**
+     * @brief Generate completion with available tools within budget
+     * @param messages The messages to generate completion from
+     * @param tools The tools to use
+     * @return The LLM response
+     */
+    LLMResponse chatWithTools(
+        const std::vector<Message>& messages,
+        const std::vector<std::shared_ptr<Tool>>& tools
+    ) override {
+        std::vector<Message> effective = messages;
+        auto llm = admit(effective);
+        LLMResponse response = llm->chatWithTools(effective, tools);
+        governor_->record(response, llm->getModel());
+        return response;
+    }
+
+    /**
+     * @brief Stream results with callback within budget
+     * @note Streaming responses carry no usage metrics, so tokens are estimated from text length.
+     * @param messages The messages to generate completion from
+     * @param callback The callback to use
+     */
+    void streamChat(
+        const std::vector<Message>& messages,
+        std::function<void(const std::string&, bool)> callback
+    ) override {
+        std::vector<Message> effective = messages;
+        auto llm = admit(effective);
+        int64_t input_tokens = 0;
+        for (const auto& message : effective) {
+            input_tokens += BudgetGovernor::estimateTokens(message.content);
+        }
+        int64_t output_tokens = 0;
+        llm->streamChat(effective, [&output_tokens, &callback](const std::string& chunk, bool done) {
+            output_tokens += BudgetGovernor::estimateTokens(chunk);
+            callback(chunk, done);
+        });
+        governor_->record(input_tokens, output_tokens, llm->getModel());
+    }
+
+    /**
+     * @brief Async chat from a list of messages within budget
+     * @param messages The messages to generate completion from
+     * @return The LLM response
+     */
+    Task<LLMResponse> chatAsync(const std::vector<Message>& messages) override {
+        std::vector<Message> effective = messages;
+        auto llm = admit(effective);
+        LLMResponse response = co_await llm->chatAsync(effective);
+        governor_->record(response, llm->getModel());
+        co_return response;
+    }
+
+    /**
+     * @brief Async chat with tools within budget
+     * @param messages The messages to generate completion from
+     * @param tools The tools to use
+     * @return The LLM response
+     */
+    Task<LLMResponse> chatWithToolsAsync(
+        const std::vector<Message>& messages,
+        const std::vector<std::shared_ptr<Tool>>& tools
+    ) override {
+        std::vector<Message> effective = messages;
+        auto llm = admit(effective);
+        LLMResponse response = co_await llm->chatWithToolsAsync(effective, tools);
+        governor_->record(response, llm->getModel());
+        co_return response;
+    }
+
+    /**
+     * @brief Stream results as an AsyncGenerator within budget
+     * @note Tokens are estimated from text length, as in streamChat().
+     * @param messages The messages to generate completion from
+     * @param tools The tools to use
+     * @return The AsyncGenerator of response chunks
+     * @throws BudgetExceededError if the budget is exhausted
+     */
+    AsyncGenerator<std::string> streamChatAsync(
+        const std::vector<Message>& messages,
+        const std::vector<std::shared_ptr<Tool>>& tools
+    ) override {
+        // Admit eagerly so an exhausted budget throws here, not on the first next()
+        std::vector<Message> effective = messages;
+        auto llm = admit(effective);
+        return meteredStream(std::move(llm), std::move(effective), tools);
+    }
+
+    /**
+     * @brief Upload a media file through the primary LLM
+     * @param local_path Local filesystem path
+     * @param mime The MIME type of the media file
+     * @param binary Optional binary content of the media file
+     * @return Optional envelope; std::nullopt if unsupported
+     */
+    std::optional<JsonObject> uploadMediaFile(const std::string& local_path, const std::string& mime, const std::string& binary = "") override {
+        return llm_->uploadMediaFile(local_path, mime, binary);
+    }
+
+private:
+    std::shared_ptr<LLMInterface> llm_;
+    std::shared_ptr<LLMInterface> fallback_llm_;
+    std::shared_ptr<BudgetGovernor> governor_;
+    size_t soft_limit_max_messages_;
+
+    /**
+     * @brief Check the budget and select the LLM for the next call
+     * @param messages The messages, trimmed in place past the soft threshold
+     * @return The LLM to call
+     */
+    std::shared_ptr<LLMInterface> admit(std::vector<Message>& messages) {
+        switch (governor_->check()) {
+            case BudgetGovernor::Status::HARD_LIMIT:
+                throw BudgetExceededError("Budget exhausted: " + governor_->toJson().dump());
+            case BudgetGovernor::Status::SOFT_LIMIT:
+                if (soft_limit_max_messages_ > 0) {
+                    trimMessages(messages, soft_limit_max_messages_);
+                }
+                return fallback_llm_ ? fallback_llm_ : llm_;
+            case BudgetGovernor::Status::OK:
+                break;
+        }
+        return llm_;
+    }
+
+    /**
+     * @brief Forward a stream and record its estimated usage once it ends
+     * @param llm The LLM selected by admit()
+     * @param messages The admitted messages
+     * @param tools The tools to use
+     * @return The AsyncGenerator of response chunks
+     */
+    AsyncGenerator<std::string> meteredStream(
+        std::shared_ptr<LLMInterface> llm,
+        std::vector<Message> messages,
+        std::vector<std::shared_ptr<Tool>> tools
+    ) {
+        int64_t input_tokens = 0;
+        for (const auto& message : messages) {
+            input_tokens += BudgetGovernor::estimateTokens(message.content);
+        }
+        int64_t output_tokens = 0;
+        auto stream = llm->streamChatAsync(messages, tools);
+        while (auto chunk = co_await stream.next()) {
+            output_tokens += BudgetGovernor::estimateTokens(*chunk);
+            co_yield std::move(*chunk);
+        }
+        governor_->record(input_tokens, output_tokens, llm->getModel());
+    }
+
+    /**
+     * @brief Keep system messages and the most recent `max_messages` other messages
+     *
+     * Tool results at the front of the kept window are dropped as well, since
+     * they would no longer follow the assistant message that requested them.
+     *
+     * @param messages The messages to trim
+     * @param max_messages The number of non-system messages to keep
+     */
+    static void trimMessages(std::vector<Message>& messages, size_t max_messages) {
+        size_t non_system = static_cast<size_t>(std::count_if(messages.begin(), messages.end(),
+            [](const Message& m) { return m.role != Message::Role::SYSTEM; }));
+        if (non_system <= max_messages) {
+            return;
+        }
+        size_t to_drop = non_system - max_messages;
+        std::vector<Message> trimmed;
+        trimmed.reserve(messages.size() - to_drop);
+        bool at_window_start = true;
+        for (auto& message : messages) {
+            if (message.role == Message::Role::SYSTEM) {
+                trimmed.push_back(std::move(message));
+                continue;
+            }
+            if (to_drop > 0) {
+                to_drop--;
+                continue;
+            }
+            if (at_window_start && message.role == Message::Role::TOOL) {
+                continue;
+            }
+            at_window_start = false;
+            trimmed.push_back(std::move(message));
+        }
+        messages = std::move(trimmed);
+    }
+};
+
+} // namespace agents
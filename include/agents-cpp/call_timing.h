@@ -0,0 +1,204 @@
+/**
+ * @file call_timing.h
+ * @brief Typed per-call timing and usage breakdown of LLM calls
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025 Edge AI, LLC. All rights reserved.
+ *
+ */
+#pragma once
+
+#include <agents-cpp/budget_governor.h>
+#include <agents-cpp/types.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace agents {
+
+/**
+ * @brief Summary of the gaps between consecutive streamed chunks
+ *
+ * Providers deliver one or a few tokens per chunk, so this approximates
+ * inter-token latency.
+ */
+struct InterTokenLatency {
+    /**
+     * @brief Number of gaps measured
+     */
+    size_t count = 0;
+    /**
+     * @brief Mean gap in milliseconds
+     */
+    double mean_ms = 0.0;
+    /**
+     * @brief Smallest gap in milliseconds
+     */
+    double min_ms = 0.0;
+    /**
+     * @brief Median gap in milliseconds
+     */
+    double p50_ms = 0.0;
+    /**
+     * @brief 95th percentile gap in milliseconds
+     */
+    double p95_ms = 0.0;
+    /**
+     * @brief Largest gap in milliseconds
+     */
+    double max_ms = 0.0;
+
+    /**
+     * @brief Summarize a list of gaps
+     * @param gaps_ms The gaps in milliseconds
+     * @return The summary
+     */
+    static InterTokenLatency fromGaps(std::vector<double> gaps_ms) {
+        InterTokenLatency stats;
+        if (gaps_ms.empty()) return stats;
+        std::sort(gaps_ms.begin(), gaps_ms.end());
+        auto at = [&gaps_ms](double quantile) {
+            return gaps_ms[static_cast<size_t>(quantile * static_cast<double>(gaps_ms.size() - 1) + 0.5)];
+        };
+        stats.count = gaps_ms.size();
+        stats.mean_ms = std::accumulate(gaps_ms.begin(), gaps_ms.end(), 0.0) / static_cast<double>(gaps_ms.size());
+        stats.min_ms = gaps_ms.front();
+        stats.p50_ms = at(0.5);
+        stats.p95_ms = at(0.95);
+        stats.max_ms = gaps_ms.back();
+        return stats;
+    }
+};
+
+/**
+ * @brief Timing and usage breakdown of one LLM call
+ *
+ * All durations are measured from the start of the call. Time to first
+ * token is only measured for streamed calls and is -1 otherwise. TimedLLM
+ * fills this struct and stores it in LLMResponse::usage_metrics under
+ * `call.*` keys, so it travels with the response; read it back with
+ * CallTiming::from().
+ *
+ * HTTP phases (request build, connect/TLS, time to first byte) and retries
+ * are not part of the breakdown: the providers in the prebuilt library
+ * send their requests with their own compiled client, which reports none
+ * of them, so every field here is filled for all four providers.
+ */
+struct CallTiming {
+    /**
+     * @brief Time until the first non-empty content chunk arrived
+     */
+    double time_to_first_token_ms = -1.0;
+    /**
+     * @brief Total time of the call
+     */
+    double total_ms = 0.0;
+    /**
+     * @brief Gaps between streamed chunks
+     */
+    InterTokenLatency inter_token;
+    /**
+     * @brief Prompt tokens
+     */
+    int64_t input_tokens = 0;
+    /**
+     * @brief Completion tokens
+     */
+    int64_t output_tokens = 0;
+    /**
+     * @brief Prompt tokens served from the provider's prompt cache
+     */
+    int64_t cached_tokens = 0;
+    /**
+     * @brief True when the token counts are estimates (streamed calls report no usage)
+     */
+    bool tokens_estimated = false;
+
+    /**
+     * @brief Store the breakdown as `call.*` entries of a usage map
+     * @param usage_metrics The map to write into
+     */
+    void writeTo(std::map<std::string, double>& usage_metrics) const {
+        usage_metrics["call.ttft_ms"] = time_to_first_token_ms;
+        usage_metrics["call.total_ms"] = total_ms;
+        usage_metrics["call.inter_token_count"] = static_cast<double>(inter_token.count);
+        usage_metrics["call.inter_token_mean_ms"] = inter_token.mean_ms;
+        usage_metrics["call.inter_token_min_ms"] = inter_token.min_ms;
+        usage_metrics["call.inter_token_p50_ms"] = inter_token.p50_ms;
+        usage_metrics["call.inter_token_p95_ms"] = inter_token.p95_ms;
+        usage_metrics["call.inter_token_max_ms"] = inter_token.max_ms;
+        usage_metrics["call.input_tokens"] = static_cast<double>(input_tokens);
+        usage_metrics["call.output_tokens"] = static_cast<double>(output_tokens);
+        usage_metrics["call.cached_tokens"] = static_cast<double>(cached_tokens);
+        usage_metrics["call.tokens_estimated"] = tokens_estimated ? 1.0 : 0.0;
+    }
+
+    /**
+     * @brief Read the breakdown from a usage map
+     *
+     * Without `call.*` entries (a response that did not pass through
+     * TimedLLM) only the token counts are filled, from whichever provider
+     * specific keys are present.
+     *
+     * @param usage_metrics The usage map
+     * @return The breakdown
+     */
+    static CallTiming fromUsage(const std::map<std::string, double>& usage_metrics) {
+        CallTiming timing;
+        auto read = [&usage_metrics](const char* key, double fallback) {
+            auto it = usage_metrics.find(key);
+            return it == usage_metrics.end() ? fallback : it->second;
+        };
+        if (usage_metrics.count("call.total_ms") == 0) {
+            auto [input_tokens, output_tokens] = BudgetGovernor::extractTokenUsage(usage_metrics);
+            timing.input_tokens = input_tokens;
+            timing.output_tokens = output_tokens;
+            timing.cached_tokens = cachedTokens(usage_metrics);
+            return timing;
+        }
+        timing.time_to_first_token_ms = read("call.ttft_ms", -1.0);
+        timing.total_ms = read("call.total_ms", 0.0);
+        timing.inter_token.count = static_cast<size_t>(read("call.inter_token_count", 0.0));
+        timing.inter_token.mean_ms = read("call.inter_token_mean_ms", 0.0);
+        timing.inter_token.min_ms = read("call.inter_token_min_ms", 0.0);
+        timing.inter_token.p50_ms = read("call.inter_token_p50_ms", 0.0);
+        timing.inter_token.p95_ms = read("call.inter_token_p95_ms", 0.0);
+        timing.inter_token.max_ms = read("call.inter_token_max_ms", 0.0);
+        timing.input_tokens = static_cast<int64_t>(read("call.input_tokens", 0.0));
+        timing.output_tokens = static_cast<int64_t>(read("call.output_tokens", 0.0));
+        timing.cached_tokens = static_cast<int64_t>(read("call.cached_tokens", 0.0));
+        timing.tokens_estimated = read("call.tokens_estimated", 0.0) != 0.0;
+        return timing;
+    }
+
+    /**
+     * @brief Read the breakdown carried by a response
+     * @param response The response
+     * @return The breakdown
+     */
+    static CallTiming from(const LLMResponse& response) { return fromUsage(response.usage_metrics); }
+
+    /**
+     * @brief Cached prompt tokens under the key each provider uses
+     * @param usage_metrics The usage map
+     * @return The cached token count, or 0 if not reported
+     */
+    static int64_t cachedTokens(const std::map<std::string, double>& usage_metrics) {
+        static const char* keys[] = {"cached_tokens", "prompt_tokens_details.cached_tokens",
+                                     "cache_read_input_tokens", "cachedContentTokenCount"};
+        for (const char* key : keys) {
+            auto it = usage_metrics.find(key);
+            if (it != usage_metrics.end()) {
+                return static_cast<int64_t>(it->second);
+            }
+        }
+        return 0;
+    }
+};
+
+} // namespace agents
@@ -0,0 +1,675 @@
+/**
+ * @file cascading_llm.h
+ * @brief LLM decorator that escalates through a chain of models on low confidence
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025 Edge AI, LLC. All rights reserved.
+ *
+ */
+#pragma once
+
+#include <agents-cpp/llm_interface.h>
+#include <agents-cpp/utils.h>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <regex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace agents {
+
+/**
+ * @brief Decides whether a response is good enough to return without escalating
+ * @param messages The request messages
+ * @param response The candidate response
+ * @return True to accept the response
+ */
+using ConfidenceCheck = std::function<bool(const std::vector<Message>& messages, const LLMResponse& response)>;
+
+/**
+ * @brief Coroutine form of ConfidenceCheck, for checks that call a model
+ * @param messages The request messages
+ * @param response The candidate response
+ * @return Task yielding true to accept the response
+ */
+using AsyncConfidenceCheck = std::function<Task<bool>(const std::vector<Message>& messages, const LLMResponse& response)>;
+
+/**
+ * @brief LLM decorator that tries a chain of models, cheapest first
+ *
+ * Each request goes to the first model in the chain. After each response a
+ * confidence check runs; on failure the request escalates to the next model.
+ * The last model's response is always returned. Because the cascade is itself
+ * an LLMInterface, it can be set on a Context and used by any agent or
+ * workflow unchanged.
+ *
+ * @code
+ * auto llm = std::make_shared<CascadingLLM>(
+ *     std::vector<std::shared_ptr<LLMInterface>>{small_llm, large_llm},
+ *     CascadingLLM::selfReportedConfidence(0.7));
+ * context->setLLM(llm);
+ * @endcode
+ *
+ * The built-in checks accept responses that carry tool calls, since those
+ * are validated when the tool runs. A tier may also carry an
+ * AsyncConfidenceCheck, which chatAsync(), chatWithToolsAsync() and
+ * streamChatAsync() await instead of the blocking check.
+ */
+class CascadingLLM : public LLMInterface {
+public:
+    /**
+     * @brief A model in the chain with its own confidence check
+     */
+    struct Tier {
+        /**
+         * @brief The model
+         */
+        std::shared_ptr<LLMInterface> llm;
+        /**
+         * @brief Check for this tier's responses (unused for the last tier)
+         */
+        ConfidenceCheck check;
+        /**
+         * @brief Check awaited on the async paths instead of `check`, if set
+         */
+        AsyncConfidenceCheck async_check;
+    };
+
+    /**
+     * @brief Escalation statistics
+     */
+    struct Stats {
+        /**
+         * @brief Requests served
+         */
+        size_t requests = 0;
+        /**
+         * @brief Requests that escalated past the first tier
+         */
+        size_t escalations = 0;
+        /**
+         * @brief Requests answered by each tier
+         */
+        std::vector<size_t> accepted_by_tier;
+        /**
+         * @brief Calls made to each tier
+         */
+        std::vector<size_t> calls_by_tier;
+        /**
+         * @brief Total latency of the calls to each tier in milliseconds
+         */
+        std::vector<double> latency_ms_by_tier;
+        /**
+         * @brief Total end-to-end latency in milliseconds
+         */
+        double total_latency_ms = 0.0;
+        /**
+         * @brief Estimated latency saved versus sending every request to the last tier
+         */
+        double latency_saved_ms = 0.0;
+    };
+
+    /**
+     * @brief Constructor with one check for every tier
+     * @param chain Models in escalation order, cheapest first
+     * @param check The confidence check applied to every tier but the last
+     */
+    CascadingLLM(const std::vector<std::shared_ptr<LLMInterface>>& chain, ConfidenceCheck check) {
+        for (const auto& llm : chain) {
+            addTier(llm, check);
+        }
+    }
+
+    /**
+     * @brief Constructor with one check for every tier, in both forms
+     * @param chain Models in escalation order, cheapest first
+     * @param check The confidence check for the blocking paths
+     * @param async_check The confidence check for the async paths
+     */
+    CascadingLLM(const std::vector<std::shared_ptr<LLMInterface>>& chain, ConfidenceCheck check,
+                 AsyncConfidenceCheck async_check) {
+        for (const auto& llm : chain) {
+            addTier(llm, check, async_check);
+        }
+    }
+
+    /**
+     * @brief Constructor with per-tier checks
+     * @param tiers Tiers in escalation order, cheapest first
+     */
+    explicit CascadingLLM(const std::vector<Tier>& tiers) {
+        for (const auto& tier : tiers) {
+            addTier(tier.llm, tier.check, tier.async_check);
+        }
+    }
+
+    /**
+     * @brief Append a tier to the chain
+     * @param llm The model
+     * @param check Its confidence check
+     * @param async_check Its check for the async paths (defaults to `check`)
+     */
+    void addTier(std::shared_ptr<LLMInterface> llm, ConfidenceCheck check, AsyncConfidenceCheck async_check = {}) {
+        if (!llm) {
+            throw std::invalid_argument("CascadingLLM tier requires an LLM");
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        tiers_.push_back(Tier{std::move(llm), std::move(check), std::move(async_check)});
+        stats_.accepted_by_tier.push_back(0);
+        stats_.calls_by_tier.push_back(0);
+        stats_.latency_ms_by_tier.push_back(0.0);
+    }
+
+    /**
+     * @brief Snapshot of the escalation statistics
+     * @return The statistics
+     */
+    Stats getStats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stats_;
+    }
+
+    /**
+     * @brief Statistics as JSON, including the escalation rate
+     * @return The statistics
+     */
+    JsonObject statsToJson() const {
+        Stats stats;
+        std::vector<Tier> snapshot;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stats = stats_;
+            snapshot = tiers_;
+        }
+        JsonObject tiers = JsonObject::array();
+        for (size_t i = 0; i < stats.calls_by_tier.size(); ++i) {
+            tiers.push_back(JsonObject{
+                {"model", snapshot[i].llm->getModel()},
+                {"calls", stats.calls_by_tier[i]},
+                {"accepted", stats.accepted_by_tier[i]},
+                {"avg_latency_ms", stats.calls_by_tier[i] ? stats.latency_ms_by_tier[i] / static_cast<double>(stats.calls_by_tier[i]) : 0.0}
+            });
+        }
+        return JsonObject{
+            {"requests", stats.requests},
+            {"escalations", stats.escalations},
+            {"escalation_rate", stats.requests ? static_cast<double>(stats.escalations) / static_cast<double>(stats.requests) : 0.0},
+            {"total_latency_ms", stats.total_latency_ms},
+            {"latency_saved_ms", stats.latency_saved_ms},
+            {"tiers", tiers}
+        };
+    }
+
+    /**
+     * @brief Accept responses that parse as JSON matching a schema
+     *
+     * Checks the top-level `type`, the `required` keys and the `type` of
+     * each listed property; other schema keywords are ignored.
+     *
+     * @param schema JSON schema for the response
+     * @return The check
+     */
+    static ConfidenceCheck schemaCheck(JsonObject schema) {
+        return [schema = std::move(schema)](const std::vector<Message>&, const LLMResponse& response) {
+            if (!response.tool_calls.empty()) return true;
+            JsonObject value = Utils::parseJsonResponse(response.content);
+            if (value.is_null()) {
+                value = JsonObject::parse(response.content, nullptr, false);
+            }
+            return !value.is_discarded() && matchesSchema(value, schema);
+        };
+    }
+
+    /**
+     * @brief Accept responses whose self-reported confidence reaches a minimum
+     *
+     * Reads a numeric `field` from a JSON response, or a "field: 0.8" line in
+     * plain text. A missing score or one outside [0, 1] is rejected, not
+     * guessed onto a scale, so ask for a score in [0, 1] in the system prompt.
+     *
+     * @param min_confidence Minimum confidence in [0, 1]
+     * @param field The confidence field name
+     * @return The check
+     */
+    static ConfidenceCheck selfReportedConfidence(double min_confidence, const std::string& field = "confidence") {
+        // Compiled once here; regex_search on a shared const regex is safe from concurrent checks
+        auto pattern = std::make_shared<const std::regex>(field + R"(\s*[:=]\s*([0-9]*\.?[0-9]+))", std::regex::icase);
+        return [min_confidence, field, pattern](const std::vector<Message>&, const LLMResponse& response) {
+            if (!response.tool_calls.empty()) return true;
+            double score = -1.0;
+            JsonObject value = Utils::parseJsonResponse(response.content);
+            if (value.is_object() && value.contains(field) && value[field].is_number()) {
+                score = value[field].get<double>();
+            } else {
+                std::smatch match;
+                if (std::regex_search(response.content, match, *pattern)) {
+                    score = std::stod(match[1].str());
+                }
+            }
+            return score >= 0.0 && score <= 1.0 && score >= min_confidence;
+        };
+    }
+
+    /**
+     * @brief Accept responses that a grader model scores highly enough
+     *
+     * The grader is asked, in the style of EvaluatorWorkflow, for strict JSON
+     * `{"score": <0..1>, "feedback": "..."}` on the given criteria. The check
+     * blocks on grader->chat(); the async paths should use graderTier() or
+     * pass graderCheckAsync() as the async check.
+     *
+     * @param grader The grading model (typically small and fast)
+     * @param criteria What a good response must satisfy
+     * @param min_score Minimum score in [0, 1]
+     * @return The check
+     */
+    static ConfidenceCheck graderCheck(std::shared_ptr<LLMInterface> grader, const std::string& criteria, double min_score) {
+        return [grader = std::move(grader), criteria, min_score](const std::vector<Message>& messages, const LLMResponse& response) {
+            if (!response.tool_calls.empty()) return true;
+            return passesGrade(grader->chat(gradingMessages(criteria, messages, response)), min_score);
+        };
+    }
+
+    /**
+     * @brief graderCheck() that awaits grader->chatAsync()
+     * @param grader The grading model (typically small and fast)
+     * @param criteria What a good response must satisfy
+     * @param min_score Minimum score in [0, 1]
+     * @return The check
+     */
+    static AsyncConfidenceCheck graderCheckAsync(std::shared_ptr<LLMInterface> grader, const std::string& criteria, double min_score) {
+        return [grader = std::move(grader), criteria, min_score](const std::vector<Message>& messages,
+                                                                 const LLMResponse& response) -> Task<bool> {
+            if (!response.tool_calls.empty()) co_return true;
+            LLMResponse verdict = co_await grader->chatAsync(gradingMessages(criteria, messages, response));
+            co_return passesGrade(verdict, min_score);
+        };
+    }
+
+    /**
+     * @brief A tier graded by a model, with graderCheck() and graderCheckAsync()
+     * @param llm The model
+     * @param grader The grading model (typically small and fast)
+     * @param criteria What a good response must satisfy
+     * @param min_score Minimum score in [0, 1]
+     * @return The tier
+     */
+    static Tier graderTier(std::shared_ptr<LLMInterface> llm, std::shared_ptr<LLMInterface> grader,
+                           const std::string& criteria, double min_score) {
+        return Tier{std::move(llm), graderCheck(grader, criteria, min_score), graderCheckAsync(grader, criteria, min_score)};
+    }
+
+    /**
+     * @brief Get available models from the first tier
+     * @return The available models
+     */
+    std::vector<std::string> getAvailableModels() override { return primary()->getAvailableModels(); }
+
+    /**
+     * @brief Set the model of the first tier
+     * @param model The model to use
+     */
+    void setModel(const std::string& model) override { primary()->setModel(model); }
+
+    /**
+     * @brief Get the model of the first tier
+     * @return The current model
+     */
+    std::string getModel() const override { return primary()->getModel(); }
+
+    /**
+     * @brief Set API key of the first tier
+     * @param api_key The API key to use
+     */
+    void setApiKey(const std::string& api_key) override { primary()->setApiKey(api_key); }
+
+    /**
+     * @brief Set API base URL of the first tier
+     * @param api_base The API base URL to use
+     */
+    void setApiBase(const std::string& api_base) override { primary()->setApiBase(api_base); }
+
+    /**
+     * @brief Set options on every tier
+     * @param options The options to use
+     */
+    void setOptions(const LLMOptions& options) override {
+        for (auto& tier : snapshotTiers()) tier.llm->setOptions(options);
+    }
+
+    /**
+     * @brief Get options of the first tier
+     * @return The current options
+     */
+    LLMOptions getOptions() const override { return primary()->getOptions(); }
+
+    /**
+     * @brief Generate completion from a prompt, escalating as needed
+     * @param prompt The prompt
+     * @return The completion
+     */
+    LLMResponse chat(const std::string& prompt) override {
+        return chat(std::vector<Message>{Message{Message::Role::USER, prompt}});
+    }
+
+    /**
+     * @brief Generate completion from a list of messages, escalating as needed
+     * @param messages The messages to generate completion from
+     * @return The LLM response
+     */
+    LLMResponse chat(const std::vector<Message>& messages) override {
+        return cascade(snapshotTiers(), messages, [&messages](LLMInterface& llm) { return llm.chat(messages); });
+    }
+
+    /**
+     * @brief Generate completion with available tools, escalating as needed
+     * @param messages The messages to generate completion from
+     * @param tools The tools to use
+     * @return The LLM response
+     */
+    LLMResponse chatWithTools(
+        const std::vector<Message>& messages,
+        const std::vector<std::shared_ptr<Tool>>& tools
+    ) override {
+        return cascade(snapshotTiers(), messages, [&messages, &tools](LLMInterface& llm) {
+            return llm.chatWithTools(messages, tools);
+        });
+    }
+
+    /**
+     * @brief Stream results with callback, escalating as needed
+     * @note Every tier but the last is buffered so it can be checked before
+     * anything is emitted; an accepted buffered response arrives as one chunk.
+     * @param messages The messages to generate completion from
+     * @param callback The callback to use
+     */
+    void streamChat(
+        const std::vector<Message>& messages,
+        std::function<void(const std::string&, bool)> callback
+    ) override {
+        bool streamed = false;
+        std::vector<Tier> tiers = snapshotTiers();
+        LLMResponse response = cascade(tiers, messages, [&](LLMInterface& llm) {
+            LLMResponse buffered;
+            if (&llm == tiers.back().llm.get()) {
+                streamed = true;
+                llm.streamChat(messages, [&buffered, &callback](const std::string& chunk, bool done) {
+                    buffered.content += chunk;
+                    callback(chunk, done);
+                });
+            } else {
+                llm.streamChat(messages, [&buffered](const std::string& chunk, bool) { buffered.content += chunk; });
+            }
+            return buffered;
+        });
+        if (!streamed) {
+            callback(response.content, true);
+        }
+    }
+
+    /**
+     * @brief Async chat from a list of messages, escalating as needed
+     * @param messages The messages to generate completion from
+     * @return The LLM response
+     */
+    Task<LLMResponse> chatAsync(const std::vector<Message>& messages) override {
+        co_return co_await cascadeAsync(messages, [&messages](LLMInterface& llm) { return llm.chatAsync(messages); });
+    }
+
+    /**
+     * @brief Async chat with tools, escalating as needed
+     * @param messages The messages to generate completion from
+     * @param tools The tools to use
+     * @return The LLM response
+     */
+    Task<LLMResponse> chatWithToolsAsync(
+        const std::vector<Message>& messages,
+        const std::vector<std::shared_ptr<Tool>>& tools
+    ) override {
+        co_return co_await cascadeAsync(messages, [&messages, &tools](LLMInterface& llm) {
+            return llm.chatWithToolsAsync(messages, tools);
+        });
+    }
+
+    /**
+     * @brief Stream results as an AsyncGenerator, escalating as needed
+     * @note As with streamChat(), every tier but the last is buffered and
+     * an accepted buffered response arrives as one chunk.
+     * @param messages The messages to generate completion from
+     * @param tools The tools to use
+     * @return The AsyncGenerator of response chunks
+     */
+    AsyncGenerator<std::string> streamChatAsync(
+        const std::vector<Message>& messages,
+        const std::vector<std::shared_ptr<Tool>>& tools
+    ) override {
+        return cascadeStream(snapshotTiers(), messages, tools);
+    }
+
+    /**
+     * @brief Upload a media file through the first tier
+     * @param local_path Local filesystem path
+     * @param mime The MIME type of the media file
+     * @param binary Optional binary content of the media file
+     * @return Optional envelope; std::nullopt if unsupported
+     */
+    std::optional<JsonObject> uploadMediaFile(const std::string& local_path, const std::string& mime, const std::string& binary = "") override {
+        return primary()->uploadMediaFile(local_path, mime, binary);
+    }
+
+private:
+    std::vector<Tier> tiers_;
+    Stats stats_;
+    mutable std::mutex mutex_;
+
+    // Calls run on a copy of the chain so tiers can be added concurrently
+    std::vector<Tier> snapshotTiers() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (tiers_.empty()) {
+            throw std::logic_error("CascadingLLM has no tiers");
+        }
+        return tiers_;
+    }
+
+    std::shared_ptr<LLMInterface> primary() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (tiers_.empty()) {
+            throw std::logic_error("CascadingLLM has no tiers");
+        }
+        return tiers_.front().llm;
+    }
+
+    static std::vector<Message> gradingMessages(const std::string& criteria, const std::vector<Message>& messages,
+                                                const LLMResponse& response) {
+        std::string request;
+        for (const auto& message : messages) {
+            if (message.role == Message::Role::USER) request = message.content;
+        }
+        return std::vector<Message>{
+            Message{Message::Role::SYSTEM,
+                "You grade responses against these criteria: " + criteria +
+                "\nPlease return strict JSON: {\"score\": <0..1>, \"feedback\": \"...\"}."},
+            Message{Message::Role::USER, "Query: " + request + "\n\nResponse: " + response.content}
+        };
+    }
+
+    static bool passesGrade(const LLMResponse& verdict, double min_score) {
+        JsonObject grade = Utils::parseJsonResponse(verdict.content);
+        return grade.is_object() && grade.contains("score") && grade["score"].is_number() &&
+            grade["score"].get<double>() >= min_score;
+    }
+
+    /**
+     * @brief Minimal JSON schema match: `type`, `required` and property types
+     * @param value The value to check
+     * @param schema The schema
+     * @return True if the value matches
+     */
+    static bool matchesSchema(const JsonObject& value, const JsonObject& schema) {
+        if (!schema.is_object()) {
+            return true;
+        }
+        if (schema.contains("type") && schema["type"].is_string()) {
+            const std::string& type = schema["type"].get_ref<const std::string&>();
+            bool ok = (type == "object" && value.is_object()) ||
+                (type == "array" && value.is_array()) ||
+                (type == "string" && value.is_string()) ||
+                (type == "number" && value.is_number()) ||
+                (type == "integer" && value.is_number_integer()) ||
+                (type == "boolean" && value.is_boolean()) ||
+                (type == "null" && value.is_null());
+            if (!ok) return false;
+        }
+        if (value.is_object()) {
+            if (schema.contains("required") && schema["required"].is_array()) {
+                for (const auto& key : schema["required"]) {
+                    if (!key.is_string() || !value.contains(key.get<std::string>())) return false;
+                }
+            }
+            if (schema.contains("properties") && schema["properties"].is_object()) {
+                for (const auto& [key, property] : schema["properties"].items()) {
+                    if (value.contains(key) && !matchesSchema(value[key], property)) return false;
+                }
+            }
+        }
+        if (value.is_array() && schema.contains("items")) {
+            for (const auto& item : value) {
+                if (!matchesSchema(item, schema["items"])) return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Try each tier until one passes its check
+     * @param tiers The chain to use
+     * @param messages The request messages (for the checks)
+     * @param call Makes the request on one tier
+     * @return The accepted response
+     */
+    LLMResponse cascade(const std::vector<Tier>& tiers, const std::vector<Message>& messages,
+                        const std::function<LLMResponse(LLMInterface&)>& call) {
+        const auto start = Clock::now();
+        std::vector<double> latencies;
+        LLMResponse response;
+        size_t tier = 0;
+        for (; tier < tiers.size(); ++tier) {
+            const auto call_start = Clock::now();
+            response = call(*tiers[tier].llm);
+            latencies.push_back(elapsedMs(call_start));
+            if (accepts(tiers, tier, messages, response)) {
+                break;
+            }
+        }
+        recordStats(tier, latencies, elapsedMs(start));
+        return response;
+    }
+
+    /**
+     * @brief Coroutine counterpart of cascade()
+     * @param messages The request messages (for the checks)
+     * @param call Starts the request on one tier
+     * @return The accepted response
+     */
+    template <typename Call>
+    Task<LLMResponse> cascadeAsync(const std::vector<Message>& messages, Call call) {
+        std::vector<Tier> tiers = snapshotTiers();
+        const auto start = Clock::now();
+        std::vector<double> latencies;
+        LLMResponse response;
+        size_t tier = 0;
+        for (; tier < tiers.size(); ++tier) {
+            const auto call_start = Clock::now();
+            response = co_await call(*tiers[tier].llm);
+            latencies.push_back(elapsedMs(call_start));
+            if (co_await acceptsAsync(tiers, tier, messages, response)) {
+                break;
+            }
+        }
+        recordStats(tier, latencies, elapsedMs(start));
+        co_return response;
+    }
+
+    /**
+     * @brief Streaming counterpart of cascade(); buffers every tier but the last
+     * @param tiers The chain to use
+     * @param messages The request messages
+     * @param tools The tools to use
+     * @return The AsyncGenerator of response chunks
+     */
+    AsyncGenerator<std::string> cascadeStream(
+        std::vector<Tier> tiers,
+        std::vector<Message> messages,
+        std::vector<std::shared_ptr<Tool>> tools
+    ) {
+        const auto start = Clock::now();
+        std::vector<double> latencies;
+        for (size_t tier = 0; tier < tiers.size(); ++tier) {
+            const auto call_start = Clock::now();
+            auto stream = tiers[tier].llm->streamChatAsync(messages, tools);
+            if (tier + 1 == tiers.size()) {
+                while (auto chunk = co_await stream.next()) {
+                    co_yield std::move(*chunk);
+                }
+                latencies.push_back(elapsedMs(call_start));
+                recordStats(tier, latencies, elapsedMs(start));
+                co_return;
+            }
+            LLMResponse buffered;
+            while (auto chunk = co_await stream.next()) {
+                buffered.content += *chunk;
+            }
+            latencies.push_back(elapsedMs(call_start));
+            if (co_await acceptsAsync(tiers, tier, messages, buffered)) {
+                // Record before yielding: the consumer may stop after this chunk
+                recordStats(tier, latencies, elapsedMs(start));
+                co_yield std::move(buffered.content);
+                co_return;
+            }
+        }
+    }
+
+    using Clock = std::chrono::steady_clock;
+
+    static double elapsedMs(Clock::time_point since) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - since).count();
+    }
+
+    static bool accepts(const std::vector<Tier>& tiers, size_t tier, const std::vector<Message>& messages,
+                        const LLMResponse& response) {
+        return tier + 1 == tiers.size() || !tiers[tier].check || tiers[tier].check(messages, response);
+    }
+
+    // Awaits the tier's async check when it has one, so a grader call does not block the executor
+    static Task<bool> acceptsAsync(const std::vector<Tier>& tiers, size_t tier, const std::vector<Message>& messages,
+                                   const LLMResponse& response) {
+        if (tier + 1 < tiers.size() && tiers[tier].async_check) {
+            co_return co_await tiers[tier].async_check(messages, response);
+        }
+        co_return accepts(tiers, tier, messages, response);
+    }
+
+    void recordStats(size_t tier, const std::vector<double>& latencies, double total_ms) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.requests++;
+        if (tier > 0) stats_.escalations++;
+        stats_.accepted_by_tier[tier]++;
+        for (size_t i = 0; i < latencies.size(); ++i) {
+            stats_.calls_by_tier[i]++;
+            stats_.latency_ms_by_tier[i] += latencies[i];
+        }
+        stats_.total_latency_ms += total_ms;
+        const size_t top = stats_.calls_by_tier.size() - 1;
+        if (tier < top && stats_.calls_by_tier[top] > 0) {
+            stats_.latency_saved_ms += stats_.latency_ms_by_tier[top] / static_cast<double>(stats_.calls_by_tier[top]) - total_ms;
+        }
+    }
+};
+
+} // namespace agents
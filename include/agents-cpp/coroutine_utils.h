@@ -9,10 +9,14 @@
  */
 #pragma once
 
+#include <agents-cpp/trace_context.h>
 #include <agents-cpp/types.h>
 
+#include <algorithm>
+#include <atomic>
 #include <condition_variable>
 #include <coroutine>
+#include <deque>
 #include <exception>
 #include <functional>
 #include <future>
@@ -21,11 +25,131 @@
 #include <optional>
 #include <stdexcept>
 #include <thread>
+#include <type_traits>
 #include <utility>
+#include <variant>
 #include <vector>
 
 namespace agents {
 
+template <typename T>
+class Task;
+
+/*! @cond PRIVATE */
+namespace detail {
+template <typename A>
+struct IsTask : std::false_type {};
+
+template <typename T>
+struct IsTask<Task<T>> : std::true_type {};
+
+/**
+ * @brief A task being run inline by ContextAwaitable on this thread
+ */
+struct InlineRun {
+    std::coroutine_handle<> task;
+    bool finished = false;
+};
+
+inline InlineRun*& inlineRun() {
+    thread_local InlineRun* current = nullptr;
+    return current;
+}
+
+/**
+ * @brief Awaitable wrapper that gives the awaiting coroutine back its trace context
+ *
+ * The context is captured when the co_await expression is evaluated and
+ * reinstalled on resumption, whichever thread resumes the coroutine, so
+ * spans opened in a coroutine stay current across its suspensions.
+ *
+ * Awaiting a Task runs it on the current thread without handing it a
+ * continuation up front. A task that finishes within that run lets the
+ * awaiting coroutine carry on directly; resuming it from the task's final
+ * awaiter instead nests a frame per await unless the compiler turns the
+ * transfer into a tail call (GCC does not below -O2), so a loop awaiting
+ * such tasks would overflow the stack. A task that finishes anywhere else
+ * is given the continuation when it completes.
+ */
+template <typename A>
+class ContextAwaitable {
+public:
+    explicit ContextAwaitable(A&& awaitable)
+        : awaitable_(std::forward<A>(awaitable)), context_(TraceContext::current()) {}
+
+    bool await_ready() { return awaitable_.await_ready(); }
+
+    template <typename Handle>
+    auto await_suspend(Handle awaiting) {
+        if constexpr (IsTask<std::remove_cvref_t<A>>::value) {
+            return startTask(awaiting);
+        } else {
+            return awaitable_.await_suspend(awaiting);
+        }
+    }
+
+    decltype(auto) await_resume() {
+        TraceContext::current() = context_;
+        return awaitable_.await_resume();
+    }
+
+private:
+    bool startTask(std::coroutine_handle<> awaiting) {
+        auto task = awaitable_._coro;
+        task.promise().continuation = nullptr;
+        task.promise().on_completed = [task, awaiting]() {
+            InlineRun* running = inlineRun();
+            if (running && running->task == task) {
+                running->finished = true;
+            } else {
+                task.promise().continuation = awaiting;
+            }
+        };
+        // Once the task has suspended another thread may resume the awaiting
+        // coroutine and destroy this awaitable, so only locals are used below
+        TraceContext context = context_;
+        InlineRun run{task};
+        InlineRun* outer = std::exchange(inlineRun(), &run);
+        task.resume();
+        inlineRun() = outer;
+        TraceContext::current() = context;
+        return !run.finished;
+    }
+
+    A awaitable_;
+    TraceContext context_;
+};
+
+/**
+ * @brief Coroutine that wakes a thread blocked in Task::get_sync()
+ *
+ * Installed as the task's continuation, so it runs after the task's final
+ * awaiter is done with the task frame, and it destroys itself when it
+ * finishes; the woken thread can destroy the task right away.
+ */
+struct SyncSignal {
+    struct promise_type {
+        SyncSignal get_return_object() { return {std::coroutine_handle<promise_type>::from_promise(*this)}; }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+inline SyncSignal signalDone(std::mutex& mutex, std::condition_variable& cv, bool& done) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        done = true;
+        cv.notify_one();
+    }
+    co_return;
+}
+} // namespace detail
+/*! @endcond */
+
 /**
  * @brief Standard C++20 coroutine-based Task implementation
  * @tparam T The result type of the task
@@ -55,7 +179,7 @@ public:
         /**
          * @brief On completed callbackfor Task
          */
-        std::function<void()> on_completed; // used by blockingWait
+        std::function<void()> on_completed; // used when awaited from another Task
 
         /**
          * @brief Get the return object for Task
@@ -69,6 +193,16 @@ public:
          * @return The initial suspend for Task
          */
         std::suspend_always initial_suspend() noexcept { return {}; }
+        /**
+         * @brief Wrap every awaited expression so the trace context survives suspension
+         * @tparam A The awaitable type
+         * @param awaitable The awaitable
+         * @return The wrapped awaitable
+         */
+        template <typename A>
+        detail::ContextAwaitable<A> await_transform(A&& awaitable) {
+            return detail::ContextAwaitable<A>(std::forward<A>(awaitable));
+        }
         /**
          * @brief Final awaiter for Task
          */
@@ -84,8 +218,9 @@ public:
              * @return The suspended handle
              */
             std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> h) noexcept {
-                // Notify blocking waiters (if any) BEFORE transferring control,
-                // so the promise memory is still valid during callback.
+                // Notify the awaiter (if any) BEFORE transferring control,
+                // so the promise memory is still valid during callback; it
+                // may set the continuation.
                 if (h.promise().on_completed) {
                     h.promise().on_completed();
                 }
@@ -109,9 +244,12 @@ public:
         /**
          * @brief Return value for Task
          * @param value The value to return
+         *
+         * Emplaced rather than assigned: with an optional `T`, assigning
+         * `std::nullopt` would leave the result itself disengaged.
          */
         template <typename U>
-        void return_value(U&& value) { result = std::forward<U>(value); }
+        void return_value(U&& value) { result.emplace(std::forward<U>(value)); }
     };
 
     /**
@@ -167,7 +305,11 @@ public:
      */
     void await_suspend(std::coroutine_handle<> awaiting) {
         _coro.promise().continuation = awaiting;
+        // The task runs on this thread until it first suspends; keep the
+        // caller's trace context once it does
+        TraceContext context = TraceContext::current();
         _coro.resume();
+        TraceContext::current() = context;
     }
     /**
      * @brief Await resume for Task
@@ -191,13 +333,12 @@ public:
         std::mutex m;
         std::condition_variable cv;
         bool done = false;
-        _coro.promise().on_completed = [&](){
-            std::unique_lock<std::mutex> lk(m);
-            done = true;
-            lk.unlock();
-            cv.notify_one();
-        };
+        // Woken through the continuation rather than on_completed: once it
+        // runs, the final awaiter no longer touches the task frame
+        _coro.promise().continuation = detail::signalDone(m, cv, done).handle;
+        TraceContext context = TraceContext::current();
         _coro.resume();
+        TraceContext::current() = context;
         std::unique_lock<std::mutex> lk(m);
         cv.wait(lk, [&]{ return done; });
         if (_coro.promise().exception) {
@@ -207,6 +348,9 @@ public:
     }
 
 private:
+    template <typename>
+    friend class detail::ContextAwaitable;
+
     handle_type _coro;
 };
 
@@ -247,6 +391,16 @@ public:
          * @return The initial suspend for Task
          */
         std::suspend_always initial_suspend() noexcept { return {}; }
+        /**
+         * @brief Wrap every awaited expression so the trace context survives suspension
+         * @tparam A The awaitable type
+         * @param awaitable The awaitable
+         * @return The wrapped awaitable
+         */
+        template <typename A>
+        detail::ContextAwaitable<A> await_transform(A&& awaitable) {
+            return detail::ContextAwaitable<A>(std::forward<A>(awaitable));
+        }
         /**
          * @brief Final awaiter for Task
          */
@@ -330,7 +484,11 @@ public:
      */
     void await_suspend(std::coroutine_handle<> awaiting) {
         _coro.promise().continuation = awaiting;
+        // The task runs on this thread until it first suspends; keep the
+        // caller's trace context once it does
+        TraceContext context = TraceContext::current();
         _coro.resume();
+        TraceContext::current() = context;
     }
     /**
      * @brief Await resume for Task
@@ -350,13 +508,12 @@ public:
         std::mutex m;
         std::condition_variable cv;
         bool done = false;
-        _coro.promise().on_completed = [&](){
-            std::unique_lock<std::mutex> lk(m);
-            done = true;
-            lk.unlock();
-            cv.notify_one();
-        };
+        // Woken through the continuation rather than on_completed: once it
+        // runs, the final awaiter no longer touches the task frame
+        _coro.promise().continuation = detail::signalDone(m, cv, done).handle;
+        TraceContext context = TraceContext::current();
         _coro.resume();
+        TraceContext::current() = context;
         std::unique_lock<std::mutex> lk(m);
         cv.wait(lk, [&]{ return done; });
         if (_coro.promise().exception) {
@@ -365,6 +522,9 @@ public:
     }
 
 private:
+    template <typename>
+    friend class detail::ContextAwaitable;
+
     handle_type _coro;
 };
 
@@ -472,7 +632,9 @@ public:
             }
             co_return std::nullopt;
         }
+        TraceContext context = TraceContext::current();
         _coro.resume();
+        TraceContext::current() = context;
         if (_coro.promise().exception) {
             auto ex_ptr = _coro.promise().exception;
             _coro.destroy();
@@ -547,12 +709,38 @@ class Executor {
 public:
     /**
      * @brief Add a function to the executor
+     *
+     * The function runs in the caller's trace context.
+     *
      * @tparam F The type of the function to run
      * @param f The function to run
      */
     template <typename F>
     void add(F&& f) {
-        std::thread(std::forward<F>(f)).detach();
+        jobs().fetch_add(1, std::memory_order_relaxed);
+        std::thread([f = std::forward<F>(f), context = TraceContext::current()]() mutable {
+            TraceContextScope scope(context);
+            f();
+            jobs().fetch_sub(1, std::memory_order_relaxed);
+        }).detach();
+    }
+
+    /**
+     * @brief Jobs added to any executor and not yet finished
+     *
+     * MetricsRegistry::global() reports it as the
+     * `agents_executor_queue_depth{executor="io"}` gauge.
+     *
+     * @return The number of jobs in flight
+     */
+    static int64_t inFlight() noexcept {
+        return jobs().load(std::memory_order_relaxed);
+    }
+
+private:
+    static std::atomic<int64_t>& jobs() noexcept {
+        static std::atomic<int64_t> count{0};
+        return count;
     }
 };
 
@@ -565,4 +753,311 @@ inline Executor* getExecutor() {
     return &executor;
 }
 
+/**
+ * @brief Awaitable that runs a blocking function on the executor
+ *
+ * The awaiting coroutine suspends, the function runs on an executor thread,
+ * and the coroutine resumes on that thread with the function's result (or
+ * its exception). Use it to wrap blocking calls such as LLMInterface::chat
+ * so that the coroutine itself never blocks a thread while waiting.
+ *
+ * @tparam F The type of the function to run
+ */
+template <typename F>
+class OffloadAwaitable {
+public:
+    /**
+     * @brief Result type of the function
+     */
+    using Result = std::invoke_result_t<F&>;
+
+    /**
+     * @brief Constructor
+     * @param f The function to run
+     */
+    explicit OffloadAwaitable(F f) : f_(std::move(f)) {}
+
+    /**
+     * @brief Always suspend
+     * @return false
+     */
+    bool await_ready() const noexcept { return false; }
+
+    /**
+     * @brief Run the function on the executor, then resume the awaiting coroutine
+     * @param awaiting The awaiting coroutine handle
+     */
+    void await_suspend(std::coroutine_handle<> awaiting) {
+        getExecutor()->add([this, awaiting]() {
+            try {
+                if constexpr (std::is_void_v<Result>) {
+                    f_();
+                } else {
+                    result_.emplace(f_());
+                }
+            } catch (...) {
+                exception_ = std::current_exception();
+            }
+            awaiting.resume();
+        });
+    }
+
+    /**
+     * @brief Get the function's result
+     * @return The result, or rethrows the function's exception
+     */
+    Result await_resume() {
+        if (exception_) {
+            std::rethrow_exception(exception_);
+        }
+        if constexpr (!std::is_void_v<Result>) {
+            return std::move(*result_);
+        }
+    }
+
+private:
+    F f_;
+    std::conditional_t<std::is_void_v<Result>, std::monostate, std::optional<Result>> result_;
+    std::exception_ptr exception_;
+};
+
+/**
+ * @brief Run a blocking function on the executor from a coroutine
+ *
+ * @note Capture by reference in a lambda written inside the co_await
+ * expression (the coroutine frame outlives the call), or pass a named
+ * callable: GCC 12 can destroy a lambda temporary with non-trivial captures
+ * twice when it appears in a co_await expression.
+ *
+ * @tparam F The type of the function to run
+ * @param f The function to run
+ * @return Awaitable yielding the function's result
+ */
+template <typename F>
+OffloadAwaitable<std::decay_t<F>> offload(F&& f) {
+    return OffloadAwaitable<std::decay_t<F>>(std::forward<F>(f));
+}
+
+/*! @cond PRIVATE */
+namespace detail {
+/**
+ * @brief Eagerly started coroutine that owns its own frame
+ */
+struct DetachedTask {
+    struct promise_type {
+        DetachedTask get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+} // namespace detail
+/*! @endcond */
+
+/**
+ * @brief Run tasks concurrently and wait for all of them
+ *
+ * Every task is started at once; each runs until its first suspension (for
+ * example an offload()), so blocking work inside the tasks overlaps. The
+ * awaiting coroutine resumes on the thread that finishes last. If any task
+ * throws, the first exception is rethrown after all tasks have finished.
+ *
+ * @tparam T The result type of the tasks
+ * @param tasks The tasks to run
+ * @return The results, in the order of the tasks
+ */
+template <typename T>
+Task<std::vector<T>> whenAll(std::vector<Task<T>> tasks) {
+    struct State {
+        std::atomic<size_t> remaining{0};
+        std::coroutine_handle<> continuation;
+        std::vector<std::optional<T>> results;
+        std::mutex mutex;
+        std::exception_ptr exception;
+    };
+    struct Awaiter {
+        // References only: GCC 12 can destroy an aggregate temporary in a
+        // co_await expression twice
+        std::vector<Task<T>>& tasks;
+        std::shared_ptr<State>& state;
+
+        static detail::DetachedTask drive(Task<T> task, std::shared_ptr<State> state, size_t index) {
+            try {
+                state->results[index].emplace(co_await task);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                if (!state->exception) state->exception = std::current_exception();
+            }
+            if (state->remaining.fetch_sub(1) == 1) {
+                state->continuation.resume();
+            }
+        }
+
+        bool await_ready() const noexcept { return tasks.empty(); }
+
+        bool await_suspend(std::coroutine_handle<> awaiting) {
+            state->continuation = awaiting;
+            state->results.resize(tasks.size());
+            // One extra count held by this function, so a task finishing
+            // synchronously cannot resume the caller before we return
+            state->remaining = tasks.size() + 1;
+            for (size_t i = 0; i < tasks.size(); ++i) {
+                drive(std::move(tasks[i]), state, i);
+            }
+            return state->remaining.fetch_sub(1) != 1;
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    auto state = std::make_shared<State>();
+    co_await Awaiter{tasks, state};
+    if (state->exception) {
+        std::rethrow_exception(state->exception);
+    }
+    std::vector<T> results;
+    results.reserve(state->results.size());
+    for (auto& result : state->results) {
+        results.push_back(std::move(*result));
+    }
+    co_return results;
+}
+
+/**
+ * @brief Fixed-size worker pool for CPU-bound work
+ *
+ * Unlike Executor, which spawns a thread per job for blocking I/O, the pool
+ * reuses a bounded set of threads so that parsing, validation and other
+ * CPU-bound work does not oversubscribe the machine.
+ */
+class ThreadPool {
+public:
+    /**
+     * @brief Constructor
+     * @param threads Number of worker threads (0 uses the hardware concurrency)
+     */
+    explicit ThreadPool(size_t threads = 0) {
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        workers_.reserve(threads);
+        for (size_t i = 0; i < threads; ++i) {
+            workers_.emplace_back([this]() { work(); });
+        }
+    }
+
+    /**
+     * @brief Destructor; finishes queued jobs, then joins the workers
+     */
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Queue a job without waiting for its result
+     *
+     * The job runs in the caller's trace context.
+     *
+     * @note The job must not throw; use submit() to capture exceptions.
+     * @tparam F The type of the function to run
+     * @param f The function to run
+     */
+    template <typename F>
+    void add(F&& f) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            jobs_.emplace_back([f = std::forward<F>(f), context = TraceContext::current()]() mutable {
+                TraceContextScope scope(context);
+                f();
+            });
+            queuedJobs().fetch_add(1, std::memory_order_relaxed);
+        }
+        cv_.notify_one();
+    }
+
+    /**
+     * @brief Queue a job and get a future for its result
+     * @tparam F The type of the function to run
+     * @param f The function to run
+     * @return Future holding the result or the exception thrown by the job
+     */
+    template <typename F>
+    auto submit(F&& f) -> std::future<std::invoke_result_t<std::decay_t<F>>> {
+        using R = std::invoke_result_t<std::decay_t<F>>;
+        auto job = std::make_shared<std::packaged_task<R()>>(std::forward<F>(f));
+        auto future = job->get_future();
+        add([job]() { (*job)(); });
+        return future;
+    }
+
+    /**
+     * @brief Number of worker threads
+     * @return The number of threads
+     */
+    size_t size() const {
+        return workers_.size();
+    }
+
+    /**
+     * @brief Jobs waiting in the queues of all pools
+     *
+     * MetricsRegistry::global() reports it as the
+     * `agents_executor_queue_depth{executor="cpu"}` gauge.
+     *
+     * @return The number of queued jobs
+     */
+    static int64_t queued() noexcept {
+        return queuedJobs().load(std::memory_order_relaxed);
+    }
+
+private:
+    std::vector<std::thread> workers_;
+    std::deque<std::function<void()>> jobs_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopping_ = false;
+
+    static std::atomic<int64_t>& queuedJobs() noexcept {
+        static std::atomic<int64_t> count{0};
+        return count;
+    }
+
+    void work() {
+        while (true) {
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this]() { return stopping_ || !jobs_.empty(); });
+                if (jobs_.empty()) {
+                    return;
+                }
+                job = std::move(jobs_.front());
+                jobs_.pop_front();
+                queuedJobs().fetch_sub(1, std::memory_order_relaxed);
+            }
+            job();
+        }
+    }
+};
+
+/**
+ * @brief Get the shared pool for CPU-bound work
+ * @return Pointer to the global pool, sized to the hardware concurrency
+ */
+inline ThreadPool* getCpuPool() {
+    static ThreadPool pool;
+    return &pool;
+}
+
 } // namespace agents
@@ -0,0 +1,124 @@
+/**
+ * @file embedding.h
+ * @brief Text embedding helpers for local similarity search
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025 Edge AI, LLC. All rights reserved.
+ *
+ */
+#pragma once
+
+#include <agents-cpp/utils.h>
+
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace agents {
+
+/**
+ * @brief Dense embedding vector
+ */
+using Embedding = std::vector<float>;
+
+/**
+ * @brief Function that maps text to an embedding
+ * @note Plug in a provider embedding endpoint or an on-device model; all
+ * vectors produced by one embedder must have the same dimension.
+ */
+using Embedder = std::function<Embedding(const std::string&)>;
+
+/**
+ * @brief Cosine similarity of two embeddings
+ * @param a The first embedding
+ * @param b The second embedding
+ * @return Similarity in [-1, 1], or 0 if the dimensions differ or a vector is zero
+ */
+inline float cosineSimilarity(const Embedding& a, const Embedding& b) {
+    if (a.size() != b.size() || a.empty()) {
+        return 0.0f;
+    }
+    double dot = 0.0, norm_a = 0.0, norm_b = 0.0;
+    for (size_t i = 0; i < a.size(); ++i) {
+        dot += static_cast<double>(a[i]) * b[i];
+        norm_a += static_cast<double>(a[i]) * a[i];
+        norm_b += static_cast<double>(b[i]) * b[i];
+    }
+    if (norm_a == 0.0 || norm_b == 0.0) {
+        return 0.0f;
+    }
+    return static_cast<float>(dot / (std::sqrt(norm_a) * std::sqrt(norm_b)));
+}
+
+/**
+ * @brief Dependency-free embedder based on feature hashing
+ *
+ * Lowercased word unigrams and bigrams are hashed into a fixed number of
+ * signed buckets and the result is L2-normalized. It captures lexical overlap
+ * only, which is enough to match recurring task phrasings without a network
+ * round trip; swap in a semantic embedder where paraphrase matters.
+ */
+class HashingEmbedder {
+public:
+    /**
+     * @brief Constructor
+     * @param dimensions The embedding dimension
+     */
+    explicit HashingEmbedder(size_t dimensions = 2048) : dimensions_(dimensions == 0 ? 1 : dimensions) {}
+
+    /**
+     * @brief Embed a text
+     * @param text The text to embed
+     * @return The normalized embedding
+     */
+    Embedding operator()(const std::string& text) const {
+        Embedding vec(dimensions_, 0.0f);
+        std::string previous;
+        std::string word;
+        auto flush = [&]() {
+            if (word.empty()) {
+                return;
+            }
+            add(vec, word);
+            if (!previous.empty()) {
+                add(vec, previous + ' ' + word);
+            }
+            previous = std::move(word);
+            word.clear();
+        };
+        for (unsigned char c : text) {
+            if (std::isalnum(c)) {
+                word.push_back(static_cast<char>(std::tolower(c)));
+            } else {
+                flush();
+            }
+        }
+        flush();
+
+        double norm = 0.0;
+        for (float v : vec) {
+            norm += static_cast<double>(v) * v;
+        }
+        if (norm > 0.0) {
+            float inv = static_cast<float>(1.0 / std::sqrt(norm));
+            for (float& v : vec) {
+                v *= inv;
+            }
+        }
+        return vec;
+    }
+
+private:
+    size_t dimensions_;
+
+    void add(Embedding& vec, const std::string& feature) const {
+        uint64_t hash = Utils::hash64(feature);
+        vec[hash % dimensions_] += (hash >> 63) ? 1.0f : -1.0f;
+    }
+};
+
+} // namespace agents
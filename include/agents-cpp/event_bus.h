@@ -0,0 +1,536 @@
+/**
+ * @file event_bus.h
+ * @brief Asynchronous event bus for step and status callbacks
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025 Edge AI, LLC. All rights reserved.
+ *
+ */
+#pragma once
+
+#include <agents-cpp/agents/autonomous_agent.h>
+#include <agents-cpp/types.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace agents {
+
+/**
+ * @brief Event published on an EventBus
+ */
+struct Event {
+    /**
+     * @brief What produced the event
+     */
+    enum class Kind {
+        /**
+         * @brief Workflow step (Workflow::setStepCallback)
+         */
+        STEP,
+        /**
+         * @brief Agent status message (Agent::setStatusCallback)
+         */
+        STATUS,
+        /**
+         * @brief Autonomous agent step (AutonomousAgent::setStepCallback)
+         */
+        AGENT_STEP,
+        /**
+         * @brief Application-defined event
+         */
+        CUSTOM
+    };
+
+    /**
+     * @brief The kind of event
+     */
+    Kind kind = Kind::CUSTOM;
+    /**
+     * @brief Name of the publishing workflow or agent
+     */
+    std::string source;
+    /**
+     * @brief Step description, status text or event name
+     */
+    std::string name;
+    /**
+     * @brief Event payload
+     */
+    JsonObject data;
+    /**
+     * @brief Publication order, assigned by the bus starting at 1
+     */
+    uint64_t sequence = 0;
+    /**
+     * @brief Publication time
+     */
+    std::chrono::system_clock::time_point time;
+};
+
+/**
+ * @brief Decouples agents and workflows from the observers of their progress
+ *
+ * Producers push events into a lock-free multi-producer queue and return
+ * immediately; they never take a lock or wait on an observer. A dispatcher
+ * thread fans events out to subscribers, each of which is called on its own
+ * thread with batches of events in publication order. A subscriber that
+ * falls behind fills its own bounded queue, where its overflow policy
+ * decides whether events are dropped or held in its own backlog; either
+ * way neither the producers nor the other subscribers wait for it.
+ *
+ * The adapters stepCallback(), statusCallback() and agentStepCallback()
+ * plug the bus into the existing callback setters:
+ * @code
+ * EventBus bus;
+ * bus.subscribe([](const std::vector<Event>& events) { ... });
+ * workflow.setStepCallback(bus.stepCallback("research"));
+ * agent.setStatusCallback(bus.statusCallback("assistant"));
+ * @endcode
+ */
+class EventBus {
+public:
+    /**
+     * @brief What a subscriber does when its queue is full
+     */
+    enum class OverflowPolicy {
+        /**
+         * @brief Discard the incoming event
+         */
+        DROP_NEWEST,
+        /**
+         * @brief Discard the oldest queued event
+         */
+        DROP_OLDEST,
+        /**
+         * @brief Keep the overflow in the subscriber's own backlog (lossless)
+         *
+         * The dispatcher never waits: events that do not fit are appended to
+         * an unbounded per-subscriber backlog and move into the queue as the
+         * handler drains it, so only this subscriber falls behind, and only
+         * its memory grows while it does.
+         */
+        BLOCK
+    };
+
+    /**
+     * @brief Subscriber callback, called with up to `max_batch` events at a time
+     */
+    using Handler = std::function<void(const std::vector<Event>&)>;
+
+    /**
+     * @brief Subscription settings
+     */
+    struct SubscribeOptions {
+        /**
+         * @brief Maximum queued events for the subscriber
+         */
+        size_t capacity = 4096;
+        /**
+         * @brief Behaviour when the queue is full
+         */
+        OverflowPolicy policy = OverflowPolicy::DROP_OLDEST;
+        /**
+         * @brief Maximum events per handler call
+         */
+        size_t max_batch = 64;
+        /**
+         * @brief Kinds to deliver (all kinds when empty)
+         */
+        std::set<Event::Kind> kinds;
+    };
+
+    /**
+     * @brief Delivery counts for a subscriber
+     */
+    struct SubscriberStats {
+        /**
+         * @brief Events passed to the handler
+         */
+        uint64_t delivered = 0;
+        /**
+         * @brief Events discarded by the overflow policy
+         */
+        uint64_t dropped = 0;
+        /**
+         * @brief Handler calls that threw
+         */
+        uint64_t errors = 0;
+    };
+
+    /**
+     * @brief Constructor; starts the dispatcher thread
+     */
+    EventBus() : tail_(new Node()), head_(tail_) {
+        dispatcher_ = std::thread([this]() { dispatch(); });
+    }
+
+    /**
+     * @brief Destructor; delivers every published event, then stops all threads
+     */
+    ~EventBus() {
+        stopping_.store(true);
+        wake();
+        dispatcher_.join();
+        std::map<uint64_t, std::shared_ptr<Subscriber>> subscribers;
+        {
+            std::lock_guard<std::mutex> lock(subscribers_mutex_);
+            subscribers.swap(subscribers_);
+        }
+        for (auto& [id, subscriber] : subscribers) {
+            stopSubscriber(*subscriber);
+        }
+        while (Node* node = tail_) {
+            tail_ = node->next.load();
+            delete node;
+        }
+    }
+
+    EventBus(const EventBus&) = delete;
+    EventBus& operator=(const EventBus&) = delete;
+
+    /**
+     * @brief Publish an event without blocking
+     * @param event The event; its time is set here and its sequence on dispatch
+     */
+    void publish(Event event) {
+        Node* node = new Node();
+        event.time = std::chrono::system_clock::now();
+        node->event = std::move(event);
+        Node* previous = head_.exchange(node, std::memory_order_acq_rel);
+        previous->next.store(node, std::memory_order_release);
+        published_.fetch_add(1);
+        if (dispatcher_idle_.load()) {
+            wake();
+        }
+    }
+
+    /**
+     * @brief Publish a workflow step
+     * @param source Name of the workflow
+     * @param description The step description
+     * @param result The step result
+     */
+    void publishStep(const std::string& source, const std::string& description, const JsonObject& result) {
+        publish(Event{Event::Kind::STEP, source, description, result, 0, {}});
+    }
+
+    /**
+     * @brief Publish an agent status message
+     * @param source Name of the agent
+     * @param status The status text
+     */
+    void publishStatus(const std::string& source, const std::string& status) {
+        publish(Event{Event::Kind::STATUS, source, status, JsonObject(), 0, {}});
+    }
+
+    /**
+     * @brief Callback for Workflow::setStepCallback() that publishes to this bus
+     * @param source Name of the workflow, copied into every event
+     * @return The callback; the bus must outlive the workflow's use of it
+     */
+    std::function<void(const std::string&, const JsonObject&)> stepCallback(std::string source) {
+        return [this, source = std::move(source)](const std::string& description, const JsonObject& result) {
+            publishStep(source, description, result);
+        };
+    }
+
+    /**
+     * @brief Callback for Agent::setStatusCallback() that publishes to this bus
+     * @param source Name of the agent, copied into every event
+     * @return The callback; the bus must outlive the agent's use of it
+     */
+    std::function<void(const std::string&)> statusCallback(std::string source) {
+        return [this, source = std::move(source)](const std::string& status) {
+            publishStatus(source, status);
+        };
+    }
+
+    /**
+     * @brief Callback for AutonomousAgent::setStepCallback() that publishes to this bus
+     * @param source Name of the agent, copied into every event
+     * @return The callback; the bus must outlive the agent's use of it
+     */
+    std::function<void(const AutonomousAgent::Step&)> agentStepCallback(std::string source) {
+        return [this, source = std::move(source)](const AutonomousAgent::Step& step) {
+            publish(Event{Event::Kind::AGENT_STEP, source, step.description, JsonObject{
+                {"status", step.status},
+                {"result", step.result},
+                {"success", step.success}
+            }, 0, {}});
+        };
+    }
+
+    /**
+     * @brief Subscribe with default options
+     * @param handler Called on the subscriber's own thread with batches of events
+     * @return The subscription id
+     */
+    uint64_t subscribe(Handler handler) {
+        return subscribe(std::move(handler), SubscribeOptions());
+    }
+
+    /**
+     * @brief Subscribe to events published from now on
+     * @param handler Called on the subscriber's own thread with batches of events
+     * @param options Capacity, overflow policy, batch size and kind filter
+     * @return The subscription id
+     * @throws std::invalid_argument if the handler is empty or the capacity is zero
+     */
+    uint64_t subscribe(Handler handler, SubscribeOptions options) {
+        if (!handler || options.capacity == 0) {
+            throw std::invalid_argument("EventBus::subscribe requires a handler and a non-zero capacity");
+        }
+        auto subscriber = std::make_shared<Subscriber>();
+        subscriber->handler = std::move(handler);
+        subscriber->options = std::move(options);
+        subscriber->options.max_batch = std::max<size_t>(subscriber->options.max_batch, 1);
+        Subscriber* raw = subscriber.get();
+        subscriber->thread = std::thread([this, raw]() { deliver(*raw); });
+        std::lock_guard<std::mutex> lock(subscribers_mutex_);
+        uint64_t id = ++next_subscription_;
+        subscribers_.emplace(id, std::move(subscriber));
+        return id;
+    }
+
+    /**
+     * @brief Remove a subscription after delivering its queued events
+     * @param id The subscription id
+     * @return false if there was no such subscription
+     */
+    bool unsubscribe(uint64_t id) {
+        std::shared_ptr<Subscriber> subscriber;
+        {
+            std::lock_guard<std::mutex> lock(subscribers_mutex_);
+            auto it = subscribers_.find(id);
+            if (it == subscribers_.end()) return false;
+            subscriber = std::move(it->second);
+            subscribers_.erase(it);
+        }
+        stopSubscriber(*subscriber);
+        return true;
+    }
+
+    /**
+     * @brief Wait until every event published before the call has been handled
+     *
+     * Handled means delivered to, filtered out by or dropped by each
+     * subscriber. Must not be called from a handler.
+     */
+    void flush() {
+        uint64_t target = published_.load();
+        std::vector<std::shared_ptr<Subscriber>> subscribers;
+        {
+            std::unique_lock<std::mutex> lock(flush_mutex_);
+            flushed_cv_.wait(lock, [&]() { return dispatched_ >= target; });
+        }
+        {
+            std::lock_guard<std::mutex> lock(subscribers_mutex_);
+            for (auto& [id, subscriber] : subscribers_) subscribers.push_back(subscriber);
+        }
+        for (auto& subscriber : subscribers) {
+            std::unique_lock<std::mutex> lock(subscriber->mutex);
+            subscriber->idle_cv.wait(lock, [&]() { return subscriber->queue.empty() && !subscriber->busy; });
+        }
+    }
+
+    /**
+     * @brief Delivery counts for a subscription
+     * @param id The subscription id
+     * @return The counts (all zero for an unknown id)
+     */
+    SubscriberStats stats(uint64_t id) const {
+        std::lock_guard<std::mutex> lock(subscribers_mutex_);
+        auto it = subscribers_.find(id);
+        if (it == subscribers_.end()) return SubscriberStats();
+        std::lock_guard<std::mutex> subscriber_lock(it->second->mutex);
+        return it->second->stats;
+    }
+
+    /**
+     * @brief Number of events published so far
+     * @return The count
+     */
+    uint64_t publishedCount() const {
+        return published_.load();
+    }
+
+/*! @cond PRIVATE */
+private:
+    // Node of the intrusive MPSC queue (Vyukov); the consumer owns tail_
+    struct Node {
+        std::atomic<Node*> next{nullptr};
+        Event event;
+    };
+
+    struct Subscriber {
+        Handler handler;
+        SubscribeOptions options;
+        std::thread thread;
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::condition_variable idle_cv;
+        std::deque<Event> queue;
+        std::deque<Event> backlog; // BLOCK overflow; non-empty only while the queue is full
+        SubscriberStats stats;
+        bool busy = false;
+        bool stopping = false;
+    };
+
+    Node* tail_;
+    std::atomic<Node*> head_;
+    std::atomic<uint64_t> published_{0};
+    std::atomic<uint64_t> wakeups_{0};
+    std::atomic<bool> dispatcher_idle_{false};
+    std::atomic<bool> stopping_{false};
+    std::thread dispatcher_;
+
+    mutable std::mutex subscribers_mutex_;
+    std::map<uint64_t, std::shared_ptr<Subscriber>> subscribers_;
+    uint64_t next_subscription_ = 0;
+
+    std::mutex flush_mutex_;
+    std::condition_variable flushed_cv_;
+    uint64_t dispatched_ = 0;
+
+    void wake() {
+        wakeups_.fetch_add(1);
+        wakeups_.notify_one();
+    }
+
+    // Pop one event; only the dispatcher calls this
+    bool pop(Event& event) {
+        Node* next = tail_->next.load(std::memory_order_acquire);
+        if (!next) return false;
+        event = std::move(next->event);
+        delete tail_;
+        tail_ = next;
+        return true;
+    }
+
+    void dispatch() {
+        std::vector<Event> batch;
+        uint64_t sequence = 0;
+        while (true) {
+            uint64_t seen = wakeups_.load();
+            Event event;
+            while (batch.size() < 1024 && pop(event)) {
+                event.sequence = ++sequence;
+                batch.push_back(std::move(event));
+            }
+            if (!batch.empty()) {
+                fanOut(batch);
+                {
+                    std::lock_guard<std::mutex> lock(flush_mutex_);
+                    dispatched_ += batch.size();
+                }
+                flushed_cv_.notify_all();
+                batch.clear();
+                continue;
+            }
+            if (stopping_.load()) {
+                // publish() may have linked its node but not yet stored next
+                if (head_.load() == tail_) return;
+                std::this_thread::yield();
+                continue;
+            }
+            // Either publish() sees the idle flag and wakes us, or we see its count
+            dispatcher_idle_.store(true);
+            if (published_.load() == sequence && !stopping_.load()) {
+                wakeups_.wait(seen);
+            } else if (published_.load() != sequence) {
+                std::this_thread::yield(); // a node is linked but not yet visible
+            }
+            dispatcher_idle_.store(false);
+        }
+    }
+
+    void fanOut(std::vector<Event>& batch) {
+        std::vector<std::shared_ptr<Subscriber>> subscribers;
+        {
+            std::lock_guard<std::mutex> lock(subscribers_mutex_);
+            subscribers.reserve(subscribers_.size());
+            for (auto& [id, subscriber] : subscribers_) subscribers.push_back(subscriber);
+        }
+        for (auto& subscriber : subscribers) {
+            const SubscribeOptions& options = subscriber->options;
+            std::unique_lock<std::mutex> lock(subscriber->mutex);
+            for (const Event& event : batch) {
+                if (!options.kinds.empty() && !options.kinds.count(event.kind)) continue;
+                if (subscriber->queue.size() >= options.capacity) {
+                    if (options.policy == OverflowPolicy::DROP_NEWEST) {
+                        subscriber->stats.dropped++;
+                        continue;
+                    }
+                    if (options.policy == OverflowPolicy::BLOCK) {
+                        // Waiting here would stall every other subscriber behind this one
+                        subscriber->backlog.push_back(event);
+                        continue;
+                    }
+                    subscriber->queue.pop_front();
+                    subscriber->stats.dropped++;
+                }
+                subscriber->queue.push_back(event);
+            }
+            lock.unlock();
+            subscriber->cv.notify_one();
+        }
+    }
+
+    void deliver(Subscriber& subscriber) {
+        std::vector<Event> batch;
+        std::unique_lock<std::mutex> lock(subscriber.mutex);
+        while (true) {
+            subscriber.cv.wait(lock, [&]() { return subscriber.stopping || !subscriber.queue.empty(); });
+            if (subscriber.queue.empty()) return;
+            size_t count = std::min(subscriber.queue.size(), subscriber.options.max_batch);
+            batch.assign(std::make_move_iterator(subscriber.queue.begin()),
+                         std::make_move_iterator(subscriber.queue.begin() + static_cast<std::ptrdiff_t>(count)));
+            subscriber.queue.erase(subscriber.queue.begin(), subscriber.queue.begin() + static_cast<std::ptrdiff_t>(count));
+            while (!subscriber.backlog.empty() && subscriber.queue.size() < subscriber.options.capacity) {
+                subscriber.queue.push_back(std::move(subscriber.backlog.front()));
+                subscriber.backlog.pop_front();
+            }
+            subscriber.busy = true;
+            lock.unlock();
+            bool failed = false;
+            try {
+                subscriber.handler(batch);
+            } catch (...) {
+                failed = true;
+            }
+            lock.lock();
+            subscriber.busy = false;
+            subscriber.stats.delivered += count;
+            if (failed) subscriber.stats.errors++;
+            if (subscriber.queue.empty()) subscriber.idle_cv.notify_all();
+        }
+    }
+
+    static void stopSubscriber(Subscriber& subscriber) {
+        {
+            std::lock_guard<std::mutex> lock(subscriber.mutex);
+            subscriber.stopping = true;
+        }
+        subscriber.cv.notify_one();
+        subscriber.thread.join();
+    }
+/*! @endcond */
+};
+
+} // namespace agents
@@ -0,0 +1,445 @@
+/**
+ * @file execution_journal.h
+ * @brief Write-ahead journal of completed workflow steps for crash recovery
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025 Edge AI, LLC. All rights reserved.
+ *
+ */
+#pragma once
+
+#include <agents-cpp/coroutine_utils.h>
+#include <agents-cpp/llm_interface.h>
+#include <agents-cpp/memo_store.h>
+#include <agents-cpp/types.h>
+#include <agents-cpp/utils.h>
+#include <spdlog/details/os.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace agents {
+
+/**
+ * @brief Durable journal of completed step results, keyed by step
+ *
+ * Each workflow id gets one append-only file of JSON lines in the journal
+ * directory. record() returns once the entry is on disk; entries from
+ * concurrent steps are written and fsynced together by a background writer,
+ * so many workers finishing at once cost one fsync rather than one each.
+ *
+ * Opening a journal replays the existing file. A torn or corrupt tail, as
+ * left by a crash mid-write, is detected by its checksum and cut off, so a
+ * restarted run sees exactly the steps that completed and reruns the rest.
+ */
+class ExecutionJournal {
+public:
+    /**
+     * @brief Group commit settings
+     */
+    struct Options {
+        /**
+         * @brief How long the writer waits for more entries before an fsync
+         */
+        std::chrono::milliseconds group_window{2};
+
+        /**
+         * @brief Entries after which the writer syncs without waiting further
+         */
+        size_t max_group = 256;
+    };
+
+    /**
+     * @brief Open (or create) the journal for a workflow id with default settings
+     * @param directory Directory holding the journals (created if missing)
+     * @param workflow_id Identifies the run; reuse it to resume after a crash
+     * @throws std::runtime_error if the journal cannot be opened
+     */
+    ExecutionJournal(const std::filesystem::path& directory, std::string workflow_id)
+        : ExecutionJournal(directory, std::move(workflow_id), Options()) {}
+
+    /**
+     * @brief Open (or create) the journal for a workflow id
+     * @param directory Directory holding the journals (created if missing)
+     * @param workflow_id Identifies the run; reuse it to resume after a crash
+     * @param options Group commit settings
+     * @throws std::runtime_error if the journal cannot be opened
+     */
+    ExecutionJournal(const std::filesystem::path& directory, std::string workflow_id, Options options)
+        : workflow_id_(std::move(workflow_id)), options_(options) {
+        if (workflow_id_.empty()) {
+            throw std::invalid_argument("ExecutionJournal requires a workflow id");
+        }
+        std::filesystem::create_directories(directory);
+        path_ = directory / (Utils::hashHex(workflow_id_) + ".journal");
+        replay();
+        file_ = std::fopen(path_.string().c_str(), "ab");
+        if (!file_) {
+            throw std::runtime_error("Failed to open execution journal: " + path_.string());
+        }
+        writer_ = std::thread([this]() { writeLoop(); });
+    }
+
+    ExecutionJournal(const ExecutionJournal&) = delete;
+    ExecutionJournal& operator=(const ExecutionJournal&) = delete;
+
+    /**
+     * @brief Destructor; waits for pending entries to reach the disk
+     */
+    ~ExecutionJournal() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        writer_.join();
+        if (file_) std::fclose(file_);
+    }
+
+    /**
+     * @brief The workflow id
+     * @return The id the journal was opened with
+     */
+    const std::string& workflowId() const { return workflow_id_; }
+
+    /**
+     * @brief Path of the journal file
+     * @return The path
+     */
+    const std::filesystem::path& path() const { return path_; }
+
+    /**
+     * @brief Number of entries recovered when the journal was opened
+     * @return The replayed entry count
+     */
+    size_t replayedCount() const { return replayed_; }
+
+    /**
+     * @brief Look up a completed step
+     * @param key The step key
+     * @return The recorded result, or std::nullopt if the step has not completed
+     */
+    std::optional<JsonObject> lookup(const std::string& key) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(key);
+        if (it == entries_.end()) return std::nullopt;
+        return it->second;
+    }
+
+    /**
+     * @brief Record a completed step and wait until it is durable
+     * @param key The step key
+     * @param result The step result
+     * @throws std::runtime_error if the entry could not be written
+     */
+    void record(const std::string& key, const JsonObject& result) {
+        std::string value = result.dump();
+        std::string line = JsonObject{{"key", key}, {"result", result}, {"crc", Utils::hashHex(key + '\n' + value)}}.dump() + "\n";
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!error_.empty()) {
+            throw std::runtime_error(error_);
+        }
+        entries_[key] = result;
+        buffer_ += line;
+        uint64_t ticket = ++appended_;
+        cv_.notify_all();
+        durable_cv_.wait(lock, [&]() { return durable_ >= ticket || !error_.empty(); });
+        if (durable_ < ticket) {
+            throw std::runtime_error(error_);
+        }
+    }
+
+    /**
+     * @brief Delete the journal file once the run has finished
+     *
+     * Call after the workflow's result has been consumed; a later run with
+     * the same id then starts from scratch. The journal is closed and
+     * nothing is written to its file again: lookup() finds no steps and
+     * record() throws.
+     */
+    void discard() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        entries_.clear();
+        discard_ = true;
+        cv_.notify_all();
+        durable_cv_.wait(lock, [this]() { return !discard_; });
+    }
+
+    /**
+     * @brief Run a step unless the journal already holds its result
+     *
+     * The step task is lazy, so a replayed step never starts. Results with
+     * an `error` are not recorded, so failed steps are retried on resume.
+     *
+     * @param journal The journal (the step just runs when null)
+     * @param key The step key
+     * @param step The step
+     * @return Task yielding the recorded or freshly computed result
+     */
+    static Task<JsonObject> journaled(std::shared_ptr<ExecutionJournal> journal, std::string key, Task<JsonObject> step) {
+        if (journal) {
+            if (auto recorded = journal->lookup(key)) {
+                co_return std::move(*recorded);
+            }
+        }
+        JsonObject result = co_await step;
+        if (journal && !(result.is_object() && result.contains("error"))) {
+            co_await offload([&]() { journal->record(key, result); });
+        }
+        co_return result;
+    }
+
+/*! @cond PRIVATE */
+private:
+    std::string workflow_id_;
+    Options options_;
+    std::filesystem::path path_;
+    std::FILE* file_ = nullptr;
+    size_t replayed_ = 0;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::condition_variable durable_cv_;
+    std::unordered_map<std::string, JsonObject> entries_;
+    std::string buffer_;
+    uint64_t appended_ = 0;
+    uint64_t durable_ = 0;
+    std::string error_;
+    bool stopping_ = false;
+    bool discard_ = false;
+    std::thread writer_;
+
+    void replay() {
+        std::ifstream in(path_, std::ios::binary);
+        if (!in) return;
+        std::string line;
+        std::streamoff valid = 0;
+        while (std::getline(in, line)) {
+            if (in.eof()) break; // no trailing newline: torn write
+            JsonObject entry = JsonObject::parse(line, nullptr, false);
+            if (entry.is_discarded() || !entry.is_object() || !entry.contains("key") || !entry.contains("result")) break;
+            std::string key = entry["key"].is_string() ? entry["key"].get<std::string>() : std::string();
+            if (entry.value("crc", "") != Utils::hashHex(key + '\n' + entry["result"].dump())) break;
+            entries_[key] = std::move(entry["result"]);
+            valid += static_cast<std::streamoff>(line.size()) + 1;
+            replayed_++;
+        }
+        in.close();
+        if (static_cast<std::uintmax_t>(valid) < std::filesystem::file_size(path_)) {
+            std::filesystem::resize_file(path_, static_cast<std::uintmax_t>(valid));
+        }
+    }
+
+    void writeLoop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            cv_.wait(lock, [this]() { return stopping_ || discard_ || !buffer_.empty(); });
+            if (discard_) {
+                discard_ = false;
+                if (file_) std::fclose(file_);
+                file_ = nullptr;
+                std::error_code ignored;
+                std::filesystem::remove(path_, ignored);
+                error_ = "Execution journal was discarded: " + path_.string();
+                durable_ = appended_;
+                buffer_.clear();
+                durable_cv_.notify_all();
+            }
+            if (buffer_.empty()) {
+                if (stopping_) return;
+                continue;
+            }
+            // Let concurrent steps join this group, then write and sync them together
+            if (!stopping_ && appended_ - durable_ < options_.max_group) {
+                cv_.wait_for(lock, options_.group_window, [this]() {
+                    return stopping_ || appended_ - durable_ >= options_.max_group;
+                });
+            }
+            std::string pending;
+            pending.swap(buffer_);
+            uint64_t ticket = appended_;
+            lock.unlock();
+            bool ok = file_ && std::fwrite(pending.data(), 1, pending.size(), file_) == pending.size() &&
+                std::fflush(file_) == 0 && spdlog::details::os::fsync(file_);
+            lock.lock();
+            if (ok) {
+                durable_ = ticket;
+            } else if (error_.empty()) {
+                error_ = "Failed to write execution journal: " + path_.string();
+            }
+            durable_cv_.notify_all();
+        }
+    }
+/*! @endcond */
+};
+
+/**
+ * @brief LLM decorator that journals each completed call
+ *
+ * A call is keyed by its messages, model, options and tools, plus how many
+ * identical calls this decorator has already made, so repeated prompts
+ * (such as voters) keep separate answers. Wrapping a workflow's LLM lets the
+ * library's run() resume from a journal: calls recorded by an earlier run
+ * are answered from it and only the rest are sent. Calls that throw are not
+ * recorded. Streaming calls are passed through unjournaled.
+ */
+class JournalingLLM : public LLMInterface {
+public:
+    /**
+     * @brief Constructor
+     * @param llm The wrapped LLM
+     * @param journal The journal
+     */
+    JournalingLLM(std::shared_ptr<LLMInterface> llm, std::shared_ptr<ExecutionJournal> journal)
+        : llm_(std::move(llm)), journal_(std::move(journal)) {
+        if (!llm_ || !journal_) {
+            throw std::invalid_argument("JournalingLLM requires an LLM and a journal");
+        }
+    }
+
+    /**
+     * @brief Calls answered from the journal so far
+     * @return The replayed call count
+     */
+    size_t replayed() const { return replayed_; }
+
+    /**
+     * @brief Get available models
+     * @return The available models
+     */
+    std::vector<std::string> getAvailableModels() override { return llm_->getAvailableModels(); }
+
+    /**
+     * @brief Set the model
+     * @param model The model to use
+     */
+    void setModel(const std::string& model) override { llm_->setModel(model); }
+
+    /**
+     * @brief Get the model
+     * @return The current model
+     */
+    std::string getModel() const override { return llm_->getModel(); }
+
+    /**
+     * @brief Set API key
+     * @param api_key The API key to use
+     */
+    void setApiKey(const std::string& api_key) override { llm_->setApiKey(api_key); }
+
+    /**
+     * @brief Set API base URL
+     * @param api_base The API base URL to use
+     */
+    void setApiBase(const std::string& api_base) override { llm_->setApiBase(api_base); }
+
+    /**
+     * @brief Set options
+     * @param options The options to use
+     */
+    void setOptions(const LLMOptions& options) override { llm_->setOptions(options); }
+
+    /**
+     * @brief Get options
+     * @return The current options
+     */
+    LLMOptions getOptions() const override { return llm_->getOptions(); }
+
+    /**
+     * @brief Generate completion from a prompt
+     * @param prompt The prompt
+     * @return The completion
+     */
+    LLMResponse chat(const std::string& prompt) override {
+        return chat(std::vector<Message>{Message{Message::Role::USER, prompt}});
+    }
+
+    /**
+     * @brief Generate completion from a list of messages, or replay it from the journal
+     * @param messages The messages to generate completion from
+     * @return The LLM response
+     */
+    LLMResponse chat(const std::vector<Message>& messages) override {
+        return journaled(messages, {}, [&]() { return llm_->chat(messages); });
+    }
+
+    /**
+     * @brief Generate completion with available tools, or replay it from the journal
+     * @param messages The messages to generate completion from
+     * @param tools The tools to use
+     * @return The LLM response
+     */
+    LLMResponse chatWithTools(
+        const std::vector<Message>& messages,
+        const std::vector<std::shared_ptr<Tool>>& tools
+    ) override {
+        std::vector<std::string> names;
+        for (const auto& tool : tools) names.push_back(tool->getName());
+        return journaled(messages, names, [&]() { return llm_->chatWithTools(messages, tools); });
+    }
+
+    /**
+     * @brief Stream results with callback (not journaled)
+     * @param messages The messages to generate completion from
+     * @param callback The callback to use
+     */
+    void streamChat(
+        const std::vector<Message>& messages,
+        std::function<void(const std::string&, bool)> callback
+    ) override {
+        llm_->streamChat(messages, std::move(callback));
+    }
+
+    /**
+     * @brief Upload a media file
+     * @param local_path Local filesystem path
+     * @param mime The MIME type of the media file
+     * @param binary Optional binary content of the media file
+     * @return Optional envelope; std::nullopt if unsupported
+     */
+    std::optional<JsonObject> uploadMediaFile(const std::string& local_path, const std::string& mime, const std::string& binary = "") override {
+        return llm_->uploadMediaFile(local_path, mime, binary);
+    }
+
+/*! @cond PRIVATE */
+private:
+    std::shared_ptr<LLMInterface> llm_;
+    std::shared_ptr<ExecutionJournal> journal_;
+    std::mutex mutex_;
+    std::unordered_map<std::string, size_t> occurrences_;
+    std::atomic<size_t> replayed_{0};
+
+    template <typename Call>
+    LLMResponse journaled(const std::vector<Message>& messages, const std::vector<std::string>& tools, Call&& call) {
+        std::string base = MemoStore::makeKey(journal_->workflowId(), "llm", messages, llm_->getModel(), llm_->getOptions(), tools);
+        size_t occurrence;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            occurrence = occurrences_[base]++;
+        }
+        std::string key = "llm:" + base + ":" + std::to_string(occurrence);
+        if (auto recorded = journal_->lookup(key)) {
+            replayed_++;
+            return MemoStore::fromJson(*recorded);
+        }
+        LLMResponse response = call();
+        journal_->record(key, MemoStore::toJson(response));
+        return response;
+    }
+/*! @endcond */
+};
+
+} // namespace agents
@@ -0,0 +1,994 @@
+/**
+ * @file http_cassette.h
+ * @brief Record and replay of HTTP traffic for deterministic tests and benchmarks
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025 Edge AI, LLC. All rights reserved.
+ *
+ */
+#pragma once
+
+#include <agents-cpp/http_client.h>
+#include <agents-cpp/types.h>
+#include <agents-cpp/utils.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace agents {
+
+/**
+ * @brief Records HTTP requests to a file and replays them, as a loopback proxy or HTTPClient interceptor
+ *
+ * In RECORD mode every request goes to the network and the exchange is kept,
+ * including the arrival time of each streamed chunk; save() writes the
+ * cassette as compact JSON. In REPLAY mode requests are answered from the
+ * cassette without touching the network, either immediately or paced at a
+ * multiple of the recorded speed. REPLAY_OR_RECORD replays what it has and
+ * records the rest.
+ *
+ * The providers in the prebuilt library send their requests with their own
+ * compiled client, so they are recorded through the proxy: start() serves
+ * the cassette on a loopback port in front of the provider's real API base,
+ * and the provider is pointed at it with setApiBase(apiBase()), as with
+ * MockLLMServer. Agents and workflows built on such a provider then run
+ * against the cassette. Recordings name the upstream URL, not the proxy, so
+ * a cassette recorded through the proxy also replays through HTTPClient and
+ * the other way round. Proxied responses are relayed as they arrive, so a
+ * streaming provider sees recorded chunk timing on replay; an https
+ * upstream needs CPPHTTPLIB_OPENSSL_SUPPORT.
+ *
+ * A request matches a recorded one when the parts selected by MatchPolicy
+ * are equal; identical requests replay their recordings in order. Multipart
+ * boundaries, which differ on every request, are left out of the comparison.
+ * API keys in the headers and query strings listed in Options are redacted
+ * before anything is stored or compared, so cassettes can be checked in.
+ *
+ * Installed with HTTPClient::setInterceptor(), the cassette sees only the
+ * requests made through the header HTTPClient. A provider left pointing at
+ * its real API would silently reach the network instead, so save() refuses
+ * to write a recording that no request reached, and verify() fails when no
+ * request reached the cassette, a request found no recording or a
+ * recording was never replayed.
+ *
+ * @code
+ * auto cassette = std::make_shared<HTTPCassette>("agent_run.cassette", HTTPCassette::Mode::REPLAY);
+ * cassette->start("https://api.openai.com/v1");
+ * auto llm = createLLM("openai", api_key, "gpt-4o-mini");
+ * llm->setApiBase(cassette->apiBase());
+ * // ... run the agent or workflow under test ...
+ * cassette->stop();
+ * cassette->verify();
+ * @endcode
+ */
+class HTTPCassette : public HTTPClient::Interceptor {
+public:
+    /**
+     * @brief What the cassette does with requests
+     */
+    enum class Mode {
+        /**
+         * @brief Send every request and record it
+         */
+        RECORD,
+        /**
+         * @brief Answer from the cassette only; unmatched requests fail
+         */
+        REPLAY,
+        /**
+         * @brief Answer from the cassette, sending and recording unmatched requests
+         */
+        REPLAY_OR_RECORD
+    };
+
+    /**
+     * @brief Parts of a request compared when looking for its recording
+     */
+    struct MatchPolicy {
+        /**
+         * @brief Compare the method
+         */
+        bool method = true;
+        /**
+         * @brief Compare the scheme, host and path
+         */
+        bool url = true;
+        /**
+         * @brief Compare the query string
+         */
+        bool query = true;
+        /**
+         * @brief Query parameters left out of the comparison
+         */
+        std::set<std::string> ignore_query_params;
+        /**
+         * @brief Headers compared, by case-insensitive name; others are ignored
+         */
+        std::set<std::string> headers;
+        /**
+         * @brief Compare the body
+         */
+        bool body = true;
+        /**
+         * @brief JSON pointers (e.g. `/metadata/user_id`) removed from JSON bodies before comparing
+         */
+        std::vector<std::string> ignore_body_fields;
+    };
+
+    /**
+     * @brief Cassette behavior
+     */
+    struct Options {
+        /**
+         * @brief Matching of requests to recordings
+         */
+        MatchPolicy match;
+        /**
+         * @brief Replay pacing: 0 answers immediately, 1 at recorded speed, 2 twice as fast
+         */
+        double replay_speed = 0.0;
+        /**
+         * @brief Once all recordings of a request were replayed, replay the last one again
+         */
+        bool repeat_last = true;
+        /**
+         * @brief Headers whose values are redacted, by case-insensitive name
+         */
+        std::set<std::string> redact_headers{"authorization", "x-api-key", "x-goog-api-key", "api-key",
+                                             "cookie", "set-cookie"};
+        /**
+         * @brief Query parameters whose values are redacted
+         */
+        std::set<std::string> redact_query_params{"key", "api_key"};
+        /**
+         * @brief Connection and read timeout of requests the proxy sends upstream, in milliseconds
+         */
+        int upstream_timeout_ms = 120000;
+    };
+
+    /**
+     * @brief A streamed body chunk
+     */
+    struct Chunk {
+        /**
+         * @brief Arrival time, in microseconds from the start of the request
+         */
+        int64_t offset_us = 0;
+        /**
+         * @brief Chunk data
+         */
+        std::string data;
+    };
+
+    /**
+     * @brief A recorded request and its response
+     */
+    struct Interaction {
+        /**
+         * @brief The request, redacted
+         */
+        HTTPClient::Request request;
+        /**
+         * @brief The response; its body is in `chunks` when streamed
+         */
+        HTTPClient::Response response;
+        /**
+         * @brief Whether the body was streamed
+         */
+        bool streamed = false;
+        /**
+         * @brief Streamed body chunks
+         */
+        std::vector<Chunk> chunks;
+        /**
+         * @brief Arrival of the response headers, in microseconds from the start of the request
+         */
+        int64_t first_byte_us = 0;
+        /**
+         * @brief Duration of the request in microseconds
+         */
+        int64_t total_us = 0;
+    };
+
+    /**
+     * @brief Constructor with default options
+     * @param path The cassette file
+     * @param mode What to do with requests
+     */
+    HTTPCassette(std::string path, Mode mode) : HTTPCassette(std::move(path), mode, Options()) {}
+
+    /**
+     * @brief Constructor
+     *
+     * Loads the cassette unless recording from scratch.
+     *
+     * @param path The cassette file
+     * @param mode What to do with requests
+     * @param options Cassette behavior
+     * @throws std::runtime_error if replaying and the file cannot be read or parsed
+     * @throws std::invalid_argument if an ignored body field is not a valid JSON pointer
+     */
+    HTTPCassette(std::string path, Mode mode, Options options)
+        : path_(std::move(path)), mode_(mode), options_(std::move(options)) {
+        for (const auto& field : options_.match.ignore_body_fields) {
+            try {
+                ignored_fields_.emplace_back(field);
+            } catch (const JsonObject::exception& e) {
+                throw std::invalid_argument("HTTPCassette: invalid JSON pointer '" + field + "': " + e.what());
+            }
+        }
+        if (mode_ == Mode::REPLAY || (mode_ == Mode::REPLAY_OR_RECORD && std::filesystem::exists(path_))) {
+            load();
+        }
+    }
+
+    /**
+     * @brief Destructor; stops the proxy and saves new recordings, ignoring errors
+     */
+    ~HTTPCassette() override {
+        stop();
+        try {
+            if (dirty_) save();
+        } catch (...) {
+        }
+    }
+
+    HTTPCassette(const HTTPCassette&) = delete;
+    HTTPCassette& operator=(const HTTPCassette&) = delete;
+
+    /**
+     * @brief Answer a request from the cassette or the network
+     * @param request The request
+     * @param write_cb The caller's streaming callback, or empty
+     * @param send Performs the request over the network
+     * @return The response
+     */
+    HTTPClient::Response handle(const HTTPClient::Request& request, const HTTPClient::WriteCallback& write_cb,
+                                const HTTPClient::Transport& send) override {
+        return exchange(request, write_cb, send, nullptr);
+    }
+
+    /**
+     * @brief Serve the cassette as a loopback proxy in front of an API
+     *
+     * Requests to the proxy are answered as handle() answers them, for the
+     * same URL under `upstream`; recorded requests are forwarded there.
+     *
+     * @param upstream The API base the provider would use, e.g. "https://api.openai.com/v1"
+     * @param host The address to bind
+     * @param port The port to bind, or 0 to pick a free one
+     * @return The bound port
+     * @throws std::runtime_error if already running or the address cannot be bound
+     * @throws std::invalid_argument if `upstream` is not an http or https URL
+     */
+    int start(const std::string& upstream, const std::string& host = "127.0.0.1", int port = 0) {
+        if (thread_.joinable()) {
+            throw std::runtime_error("HTTPCassette proxy is already running");
+        }
+        size_t scheme = upstream.find("://");
+        if (scheme == std::string::npos || (upstream.compare(0, scheme, "http") != 0 &&
+                                            upstream.compare(0, scheme, "https") != 0)) {
+            throw std::invalid_argument("HTTPCassette: upstream is not an http(s) URL: " + upstream);
+        }
+        size_t path = upstream.find('/', scheme + 3);
+        upstream_root_ = upstream.substr(0, path);
+        upstream_path_ = path == std::string::npos ? "" : upstream.substr(path);
+        while (!upstream_path_.empty() && upstream_path_.back() == '/') upstream_path_.pop_back();
+
+        server_ = std::make_unique<httplib::Server>();
+        auto proxy = [this](const httplib::Request& req, httplib::Response& res) { serve(req, res); };
+        server_->Get(".*", proxy);
+        server_->Post(".*", proxy);
+        server_->Put(".*", proxy);
+        server_->Delete(".*", proxy);
+        server_->Patch(".*", proxy);
+        int bound = port == 0 ? server_->bind_to_any_port(host) : (server_->bind_to_port(host, port) ? port : -1);
+        if (bound <= 0) {
+            server_.reset();
+            throw std::runtime_error("HTTPCassette proxy failed to bind " + host + ":" + std::to_string(port));
+        }
+        host_ = host;
+        port_ = bound;
+        thread_ = std::thread([this]() { server_->listen_after_bind(); });
+        server_->wait_until_ready();
+        return port_;
+    }
+
+    /**
+     * @brief Stop the proxy and join its threads
+     */
+    void stop() {
+        if (!thread_.joinable()) return;
+        server_->stop();
+        thread_.join();
+        server_.reset();
+        port_ = 0;
+    }
+
+    /**
+     * @brief Get the proxy's port
+     * @return The port, or 0 when the proxy is not running
+     */
+    int port() const { return port_; }
+
+    /**
+     * @brief API base URL to pass to a provider's setApiBase()
+     * @return The proxy's URL followed by the path of the upstream API base
+     */
+    std::string apiBase() const {
+        return "http://" + host_ + ":" + std::to_string(port_) + upstream_path_;
+    }
+
+    /**
+     * @brief Write the cassette file
+     * @throws std::runtime_error if recording and no request reached the cassette,
+     *         or if the file cannot be written
+     */
+    void save() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (mode_ == Mode::RECORD && interactions_.empty()) {
+            throw std::runtime_error("HTTPCassette: nothing to save to " + path_ + "; " + kBypassed);
+        }
+        JsonObject interactions = JsonObject::array();
+        for (const auto& interaction : interactions_) {
+            interactions.push_back(toJson(interaction));
+        }
+        JsonObject document = {{"version", 1}, {"interactions", std::move(interactions)}};
+        // Write aside and rename, so a failed save leaves the old cassette intact
+        std::string temp = path_ + ".tmp";
+        {
+            std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+            out << document.dump();
+            if (!out) {
+                throw std::runtime_error("HTTPCassette: cannot write " + temp);
+            }
+        }
+        std::filesystem::rename(temp, path_);
+        dirty_ = false;
+    }
+
+    /**
+     * @brief Check that the requests of a run went through the cassette
+     *
+     * Call after the run, in any mode.
+     *
+     * @throws std::runtime_error if no request reached the cassette, a request
+     *         found no recording, or a recording loaded from the file was never replayed
+     */
+    void verify() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (requests_ == 0) {
+            throw std::runtime_error("HTTPCassette: no request reached " + path_ + "; " + kBypassed);
+        }
+        if (misses_ > 0) {
+            throw std::runtime_error("HTTPCassette: " + std::to_string(misses_) + " request(s) found no recording in " +
+                                     path_);
+        }
+        std::string unused;
+        size_t count = 0;
+        for (size_t id = 0; id < replayed_.size(); ++id) {
+            if (replayed_[id]) continue;
+            if (count++ == 0) unused = interactions_[id].request.method + " " + interactions_[id].request.url;
+        }
+        if (count > 0) {
+            throw std::runtime_error("HTTPCassette: " + std::to_string(count) + " recording(s) in " + path_ +
+                                     " were never replayed, starting with " + unused + "; " + kBypassed);
+        }
+    }
+
+    /**
+     * @brief Get the number of requests the cassette handled
+     * @return The number of requests
+     */
+    size_t requests() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return requests_;
+    }
+
+    /**
+     * @brief Get the recorded interactions
+     * @return A copy of the interactions, in recording order
+     */
+    std::vector<Interaction> interactions() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return std::vector<Interaction>(interactions_.begin(), interactions_.end());
+    }
+
+    /**
+     * @brief Get the number of recorded interactions
+     * @return The number of interactions
+     */
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return interactions_.size();
+    }
+
+    /**
+     * @brief Get the number of requests that found no recording in REPLAY mode
+     * @return The number of misses
+     */
+    size_t misses() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return misses_;
+    }
+
+    /**
+     * @brief Get the mode
+     * @return The mode
+     */
+    Mode mode() const { return mode_; }
+
+    /**
+     * @brief Get the cassette file
+     * @return The path
+     */
+    const std::string& path() const { return path_; }
+
+    /**
+     * @brief Get the options
+     * @return The options
+     */
+    const Options& options() const { return options_; }
+
+/*! @cond PRIVATE */
+private:
+    using Clock = std::chrono::steady_clock;
+
+    // Receives the status and headers of a response before its body
+    using HeadersCallback = std::function<void(const HTTPClient::Response&)>;
+
+    // Recordings sharing a match key, and the next one to replay
+    struct Track {
+        std::vector<size_t> ids;
+        size_t next = 0;
+    };
+
+    // Hands a response from the thread answering a proxied request to the
+    // server thread writing it to the client
+    struct Relay {
+        std::mutex mutex;
+        std::condition_variable cv;
+        bool headers_ready = false;
+        HTTPClient::Response head;
+        std::deque<std::string> chunks;
+        bool finished = false;
+        HTTPClient::Response result;
+        // The client went away; stop producing the body
+        bool cancelled = false;
+    };
+
+    std::string path_;
+    Mode mode_;
+    Options options_;
+    std::vector<JsonObject::json_pointer> ignored_fields_;
+    mutable std::mutex mutex_;
+    // A deque keeps replayed interactions in place while others are recorded
+    std::deque<Interaction> interactions_;
+    std::unordered_map<std::string, Track> tracks_;
+    // Whether each interaction loaded from the file was replayed
+    std::vector<bool> replayed_;
+    size_t requests_ = 0;
+    size_t misses_ = 0;
+    bool dirty_ = false;
+    std::unique_ptr<httplib::Server> server_;
+    std::thread thread_;
+    std::string host_ = "127.0.0.1";
+    int port_ = 0;
+    std::string upstream_root_;
+    std::string upstream_path_;
+
+    static constexpr const char* kRedacted = "REDACTED";
+    static constexpr const char* kBoundary = "BOUNDARY";
+    static constexpr const char* kBypassed =
+        "point the prebuilt providers at the proxy (start(), apiBase()); as an interceptor, only requests sent "
+        "through the header HTTPClient reach a cassette";
+
+    const Interaction* lookup(const std::string& key) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = tracks_.find(key);
+        if (it == tracks_.end()) return nullptr;
+        Track& track = it->second;
+        if (track.next < track.ids.size()) {
+            size_t id = track.ids[track.next++];
+            if (id < replayed_.size()) replayed_[id] = true;
+            return &interactions_[id];
+        }
+        return options_.repeat_last ? &interactions_[track.ids.back()] : nullptr;
+    }
+
+    void add(Interaction interaction, std::string key) {
+        tracks_[std::move(key)].ids.push_back(interactions_.size());
+        interactions_.push_back(std::move(interaction));
+    }
+
+    HTTPClient::Response record(HTTPClient::Request request, std::string key,
+                                const HTTPClient::WriteCallback& write_cb, const HTTPClient::Transport& send) {
+        Interaction interaction;
+        interaction.request = std::move(request);
+        interaction.streamed = static_cast<bool>(write_cb);
+        auto start = Clock::now();
+        HTTPClient::WriteCallback sink;
+        if (write_cb) {
+            sink = [&interaction, &write_cb, start](const std::string_view& data) {
+                interaction.chunks.push_back({elapsedMicros(start), std::string(data)});
+                return write_cb(data);
+            };
+        }
+        HTTPClient::Response response = send(sink);
+        interaction.total_us = elapsedMicros(start);
+        // The transport stamps the header arrival on this thread's timing
+        auto first_byte = HTTPClient::lastTiming().first_byte;
+        interaction.first_byte_us = first_byte > start
+            ? std::chrono::duration_cast<std::chrono::microseconds>(first_byte - start).count()
+            : interaction.total_us;
+        if (!interaction.chunks.empty()) {
+            interaction.first_byte_us = std::min(interaction.first_byte_us, interaction.chunks.front().offset_us);
+        }
+        interaction.response = response;
+        for (auto& [name, value] : interaction.response.headers) {
+            if (options_.redact_headers.count(Utils::toLower(name))) value = kRedacted;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        add(std::move(interaction), std::move(key));
+        dirty_ = true;
+        return response;
+    }
+
+    HTTPClient::Response exchange(const HTTPClient::Request& request, const HTTPClient::WriteCallback& write_cb,
+                                  const HTTPClient::Transport& send, const HeadersCallback& on_headers) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++requests_;
+        }
+        HTTPClient::Request redacted = redact(request);
+        std::string key = matchKey(redacted);
+        if (mode_ != Mode::RECORD) {
+            if (const Interaction* interaction = lookup(key)) {
+                return play(*interaction, write_cb, on_headers);
+            }
+            if (mode_ == Mode::REPLAY) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                ++misses_;
+                return HTTPClient::Response{-1, {}, true,
+                                            "HTTPCassette: no recording of " + redacted.method + " " + redacted.url,
+                                            {}};
+            }
+        }
+        return record(std::move(redacted), std::move(key), write_cb, send);
+    }
+
+    HTTPClient::Response play(const Interaction& interaction, const HTTPClient::WriteCallback& write_cb,
+                              const HeadersCallback& on_headers) const {
+        auto start = Clock::now();
+        auto wait_until = [this, start](int64_t offset_us) {
+            if (options_.replay_speed <= 0.0) return;
+            auto scaled = static_cast<int64_t>(static_cast<double>(offset_us) / options_.replay_speed);
+            std::this_thread::sleep_until(start + std::chrono::microseconds(scaled));
+        };
+        HTTPClient::Response response = interaction.response;
+        wait_until(interaction.first_byte_us);
+        if (on_headers && !response.error) on_headers(response);
+        if (interaction.streamed && write_cb) {
+            for (const auto& chunk : interaction.chunks) {
+                wait_until(chunk.offset_us);
+                if (!write_cb(chunk.data)) break;
+            }
+        } else if (interaction.streamed) {
+            for (const auto& chunk : interaction.chunks) {
+                response.text += chunk.data;
+            }
+        } else if (write_cb) {
+            if (!response.text.empty()) write_cb(response.text);
+            response.text.clear();
+        }
+        wait_until(interaction.total_us);
+        return response;
+    }
+
+    // Answers a request to the proxy. exchange() runs on a thread of its own
+    // so the body can be relayed while it arrives; the server thread waits for
+    // the status and headers, then streams the chunks to the client.
+    void serve(const httplib::Request& req, httplib::Response& res) {
+        HTTPClient::Request request;
+        request.method = req.method;
+        request.url = upstream_root_ + req.target;
+        for (const auto& [name, value] : req.headers) {
+            if (!isHopHeader(name, true)) request.headers[name] = value;
+        }
+        request.body = req.body;
+
+        auto relay = std::make_shared<Relay>();
+        HTTPClient::WriteCallback sink = [relay](const std::string_view& data) {
+            std::lock_guard<std::mutex> lock(relay->mutex);
+            if (relay->cancelled) return false;
+            relay->chunks.emplace_back(data);
+            relay->cv.notify_all();
+            return true;
+        };
+        HeadersCallback on_headers = [relay](const HTTPClient::Response& head) {
+            std::lock_guard<std::mutex> lock(relay->mutex);
+            relay->head = head;
+            relay->headers_ready = true;
+            relay->cv.notify_all();
+        };
+        auto worker = std::make_shared<std::thread>([this, relay, request, sink, on_headers]() {
+            HTTPClient::Response result;
+            try {
+                result = exchange(request, sink, forward(request, on_headers), on_headers);
+            } catch (const std::exception& e) {
+                result = HTTPClient::Response{-1, {}, true, e.what(), {}};
+            }
+            std::lock_guard<std::mutex> lock(relay->mutex);
+            relay->result = std::move(result);
+            relay->finished = true;
+            relay->cv.notify_all();
+        });
+
+        std::unique_lock<std::mutex> lock(relay->mutex);
+        relay->cv.wait(lock, [&relay]() { return relay->headers_ready || relay->finished; });
+        if (!relay->headers_ready) {
+            // No response to relay: a failed upstream request or a missing recording
+            lock.unlock();
+            worker->join();
+            res.status = 502;
+            res.set_content(relay->result.error_message, "text/plain");
+            return;
+        }
+        res.status = relay->head.status_code;
+        std::string content_type = "application/octet-stream";
+        for (const auto& [name, value] : relay->head.headers) {
+            if (Utils::toLower(name) == "content-type") {
+                content_type = value;
+            } else if (!isHopHeader(name, false)) {
+                res.set_header(name, value);
+            }
+        }
+        lock.unlock();
+        res.set_chunked_content_provider(content_type,
+            [relay](size_t, httplib::DataSink& out) {
+                std::unique_lock<std::mutex> lock(relay->mutex);
+                for (;;) {
+                    relay->cv.wait(lock, [&relay]() { return !relay->chunks.empty() || relay->finished; });
+                    while (!relay->chunks.empty()) {
+                        std::string chunk = std::move(relay->chunks.front());
+                        relay->chunks.pop_front();
+                        lock.unlock();
+                        bool written = out.write(chunk.data(), chunk.size());
+                        lock.lock();
+                        if (!written) {
+                            relay->cancelled = true;
+                            return false;
+                        }
+                    }
+                    if (relay->finished) {
+                        out.done();
+                        return true;
+                    }
+                }
+            },
+            [relay, worker](bool) {
+                {
+                    std::lock_guard<std::mutex> lock(relay->mutex);
+                    relay->cancelled = true;
+                }
+                worker->join();
+            });
+    }
+
+    // Sends a proxied request to the upstream API, reporting the response
+    // headers as soon as they arrive
+    HTTPClient::Transport forward(const HTTPClient::Request& request, const HeadersCallback& on_headers) const {
+        const std::string root = upstream_root_;
+        const int timeout_s = std::max(1, options_.upstream_timeout_ms / 1000);
+        return [request, on_headers, root, timeout_s](const HTTPClient::WriteCallback& sink) {
+            HTTPClient::Response result{-1, {}, true, "", {}};
+            try {
+                httplib::Client client(root);
+                client.set_connection_timeout(timeout_s);
+                client.set_read_timeout(timeout_s);
+                client.set_write_timeout(timeout_s);
+                httplib::Request req;
+                req.method = request.method;
+                req.path = request.url.substr(root.size());
+                for (const auto& [name, value] : request.headers) {
+                    req.set_header(name, value);
+                }
+                req.body = request.body;
+                req.response_handler = [&on_headers](const httplib::Response& response) {
+                    on_headers(HTTPClient::Response{response.status, {}, false, response.reason, response.headers});
+                    return true;
+                };
+                std::string body;
+                req.content_receiver = [&sink, &body](const char* data, size_t length, uint64_t, uint64_t) {
+                    if (sink) return sink(std::string_view(data, length));
+                    body.append(data, length);
+                    return true;
+                };
+                auto res = client.send(req);
+                if (res) {
+                    result = HTTPClient::Response{res->status, std::move(body), false, res->reason, res->headers};
+                } else {
+                    result.error_message = "Upstream request failed: " + httplib::to_string(res.error());
+                }
+            } catch (const std::exception& e) {
+                result.error_message = e.what();
+            }
+            return result;
+        };
+    }
+
+    // Headers that describe one connection or transfer and are not passed on;
+    // httplib also adds the peer addresses to incoming requests
+    static bool isHopHeader(const std::string& name, bool request) {
+        static const std::set<std::string> both{"connection", "keep-alive", "transfer-encoding", "content-length",
+                                                "te", "trailer", "upgrade", "proxy-connection"};
+        static const std::set<std::string> requests{"host", "accept-encoding", "remote_addr", "remote_port",
+                                                    "local_addr", "local_port"};
+        static const std::set<std::string> responses{"content-encoding"};
+        const std::string lower = Utils::toLower(name);
+        return both.count(lower) || (request ? requests.count(lower) : responses.count(lower));
+    }
+
+    static int64_t elapsedMicros(Clock::time_point start) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+    }
+
+    HTTPClient::Request redact(const HTTPClient::Request& request) const {
+        HTTPClient::Request redacted = request;
+        for (auto& [name, value] : redacted.headers) {
+            if (options_.redact_headers.count(Utils::toLower(name))) value = kRedacted;
+        }
+        size_t query = redacted.url.find('?');
+        if (query == std::string::npos || options_.redact_query_params.empty()) return redacted;
+        std::string url = redacted.url.substr(0, query + 1);
+        for (const auto& [name, value] : splitQuery(redacted.url.substr(query + 1))) {
+            if (url.back() != '?') url += '&';
+            url += name + "=" + (options_.redact_query_params.count(name) ? std::string(kRedacted) : value);
+        }
+        redacted.url = std::move(url);
+        return redacted;
+    }
+
+    static std::vector<std::pair<std::string, std::string>> splitQuery(const std::string& query) {
+        std::vector<std::pair<std::string, std::string>> params;
+        size_t begin = 0;
+        while (begin <= query.size()) {
+            size_t end = std::min(query.find('&', begin), query.size());
+            std::string param = query.substr(begin, end - begin);
+            if (!param.empty()) {
+                size_t equals = param.find('=');
+                params.emplace_back(param.substr(0, equals),
+                                    equals == std::string::npos ? "" : param.substr(equals + 1));
+            }
+            begin = end + 1;
+        }
+        return params;
+    }
+
+    std::string matchKey(const HTTPClient::Request& request) const {
+        const MatchPolicy& match = options_.match;
+        size_t query = request.url.find('?');
+        std::string key;
+        if (match.method) key += request.method;
+        key += '\n';
+        if (match.url) key += request.url.substr(0, query);
+        key += '\n';
+        if (match.query && query != std::string::npos) {
+            auto params = splitQuery(request.url.substr(query + 1));
+            std::sort(params.begin(), params.end());
+            for (const auto& [name, value] : params) {
+                if (!match.ignore_query_params.count(name)) key += name + "=" + value + "&";
+            }
+        }
+        key += '\n';
+        const std::string boundary = multipartBoundary(request);
+        for (const auto& wanted : match.headers) {
+            for (const auto& [name, value] : request.headers) {
+                if (Utils::toLower(name) == Utils::toLower(wanted)) {
+                    key += Utils::toLower(name) + ": " + replaceAll(value, boundary, kBoundary) + "\n";
+                }
+            }
+        }
+        key += '\n';
+        if (match.body) key += canonicalBody(replaceAll(request.body, boundary, kBoundary));
+        return key;
+    }
+
+    // The boundary HTTPClient gives in the Content-Type of a multipart request
+    static std::string multipartBoundary(const HTTPClient::Request& request) {
+        for (const auto& [name, value] : request.headers) {
+            if (Utils::toLower(name) != "content-type") continue;
+            size_t at = value.find("boundary=");
+            if (at != std::string::npos) return value.substr(at + std::string("boundary=").size());
+        }
+        return "";
+    }
+
+    static std::string replaceAll(std::string text, const std::string& from, const std::string& to) {
+        if (from.empty()) return text;
+        for (size_t at = text.find(from); at != std::string::npos; at = text.find(from, at + to.size())) {
+            text.replace(at, from.size(), to);
+        }
+        return text;
+    }
+
+    // JSON bodies compare by value, minus the ignored fields
+    std::string canonicalBody(const std::string& body) const {
+        if (body.empty() || (body.front() != '{' && body.front() != '[')) return body;
+        JsonObject json = JsonObject::parse(body, nullptr, false);
+        if (json.is_discarded()) return body;
+        for (const auto& field : ignored_fields_) {
+            if (field.empty() || !json.contains(field)) continue;
+            JsonObject& parent = json[field.parent_pointer()];
+            if (parent.is_object()) {
+                parent.erase(field.back());
+            } else if (parent.is_array()) {
+                parent.erase(std::stoul(field.back()));
+            }
+        }
+        return json.dump();
+    }
+
+    // Strings that are not valid UTF-8 (audio, images) are stored as base64
+    static JsonObject encodeText(const std::string& text) {
+        try {
+            JsonObject value = text;
+            (void)value.dump();
+            return value;
+        } catch (const JsonObject::type_error&) {
+            return JsonObject{{"base64", base64Encode(text)}};
+        }
+    }
+
+    static std::string decodeText(const JsonObject& value) {
+        if (value.is_object()) return base64Decode(value.at("base64").get<std::string>());
+        return value.get<std::string>();
+    }
+
+    static JsonObject toJson(const Interaction& interaction) {
+        const auto& request = interaction.request;
+        const auto& response = interaction.response;
+        JsonObject request_headers = JsonObject::object();
+        for (const auto& [name, value] : request.headers) {
+            request_headers[name] = encodeText(value);
+        }
+        JsonObject response_headers = JsonObject::array();
+        for (const auto& [name, value] : response.headers) {
+            response_headers.push_back({name, encodeText(value)});
+        }
+        JsonObject json = {
+            {"request", {{"method", request.method}, {"url", encodeText(request.url)},
+                         {"headers", std::move(request_headers)}, {"body", encodeText(request.body)}}},
+            {"response", {{"status", response.status_code}, {"error", response.error},
+                          {"message", encodeText(response.error_message)},
+                          {"headers", std::move(response_headers)}, {"body", encodeText(response.text)}}},
+            {"first_byte_us", interaction.first_byte_us},
+            {"total_us", interaction.total_us}};
+        if (interaction.streamed) {
+            JsonObject chunks = JsonObject::array();
+            for (const auto& chunk : interaction.chunks) {
+                chunks.push_back({chunk.offset_us, encodeText(chunk.data)});
+            }
+            json["chunks"] = std::move(chunks);
+        }
+        return json;
+    }
+
+    static Interaction fromJson(const JsonObject& json) {
+        Interaction interaction;
+        const auto& request = json.at("request");
+        interaction.request.method = request.at("method").get<std::string>();
+        interaction.request.url = decodeText(request.at("url"));
+        for (const auto& [name, value] : request.at("headers").items()) {
+            interaction.request.headers[name] = decodeText(value);
+        }
+        interaction.request.body = decodeText(request.at("body"));
+        const auto& response = json.at("response");
+        interaction.response.status_code = response.at("status").get<int>();
+        interaction.response.error = response.at("error").get<bool>();
+        interaction.response.error_message = decodeText(response.at("message"));
+        for (const auto& header : response.at("headers")) {
+            interaction.response.headers.emplace(header.at(0).get<std::string>(), decodeText(header.at(1)));
+        }
+        interaction.response.text = decodeText(response.at("body"));
+        interaction.first_byte_us = json.at("first_byte_us").get<int64_t>();
+        interaction.total_us = json.at("total_us").get<int64_t>();
+        if (json.contains("chunks")) {
+            interaction.streamed = true;
+            for (const auto& chunk : json.at("chunks")) {
+                interaction.chunks.push_back({chunk.at(0).get<int64_t>(), decodeText(chunk.at(1))});
+            }
+        }
+        return interaction;
+    }
+
+    void load() {
+        std::ifstream in(path_, std::ios::binary);
+        if (!in) {
+            throw std::runtime_error("HTTPCassette: cannot read " + path_);
+        }
+        std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        try {
+            JsonObject document = JsonObject::parse(text);
+            for (const auto& json : document.at("interactions")) {
+                Interaction interaction = fromJson(json);
+                std::string key = matchKey(interaction.request);
+                add(std::move(interaction), std::move(key));
+            }
+            replayed_.assign(interactions_.size(), false);
+        } catch (const JsonObject::exception& e) {
+            throw std::runtime_error("HTTPCassette: cannot parse " + path_ + ": " + e.what());
+        }
+    }
+
+    static std::string base64Encode(const std::string& data) {
+        static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        std::string out;
+        out.reserve((data.size() + 2) / 3 * 4);
+        size_t i = 0;
+        for (; i + 2 < data.size(); i += 3) {
+            uint32_t n = (static_cast<uint8_t>(data[i]) << 16) | (static_cast<uint8_t>(data[i + 1]) << 8) |
+                         static_cast<uint8_t>(data[i + 2]);
+            out += alphabet[(n >> 18) & 63];
+            out += alphabet[(n >> 12) & 63];
+            out += alphabet[(n >> 6) & 63];
+            out += alphabet[n & 63];
+        }
+        if (i < data.size()) {
+            uint32_t n = static_cast<uint8_t>(data[i]) << 16;
+            if (i + 1 < data.size()) n |= static_cast<uint8_t>(data[i + 1]) << 8;
+            out += alphabet[(n >> 18) & 63];
+            out += alphabet[(n >> 12) & 63];
+            out += i + 1 < data.size() ? alphabet[(n >> 6) & 63] : '=';
+            out += '=';
+        }
+        return out;
+    }
+
+    static std::string base64Decode(const std::string& text) {
+        auto value = [](char c) -> int {
+            if (c >= 'A' && c <= 'Z') return c - 'A';
+            if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+            if (c >= '0' && c <= '9') return c - '0' + 52;
+            if (c == '+') return 62;
+            if (c == '/') return 63;
+            return -1;
+        };
+        std::string out;
+        out.reserve(text.size() / 4 * 3);
+        uint32_t buffer = 0;
+        int bits = 0;
+        for (char c : text) {
+            int v = value(c);
+            if (v < 0) continue;
+            buffer = (buffer << 6) | static_cast<uint32_t>(v);
+            bits += 6;
+            if (bits >= 8) {
+                bits -= 8;
+                out += static_cast<char>((buffer >> bits) & 0xff);
+            }
+        }
+        return out;
+    }
+/*! @endcond */
+};
+
+} // namespace agents
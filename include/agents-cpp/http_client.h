@@ -8,12 +8,31 @@
  */
 #pragma once
 
+#include <agents-cpp/metrics.h>
+#include <agents-cpp/tracing.h>
+
+#include <chrono>
+#include <cstdint>
 #include <functional>
 #include <httplib.h>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <random>
 #include <string>
+#include <vector>
+
+/**
+ * @brief Gives a definition hidden visibility on ELF platforms
+ *
+ * The prebuilt library defines the same inline functions; hidden copies in
+ * the application cannot be interposed on the library's calls.
+ */
+#if defined(__ELF__)
+#define AGENTS_HTTP_LOCAL __attribute__((visibility("hidden")))
+#else
+#define AGENTS_HTTP_LOCAL
+#endif
 
 namespace agents {
 
@@ -25,6 +44,25 @@ namespace agents {
  *   `response.error` and `response.status_code` to decide success.
  * - For streaming responses provide a WriteCallback to `post()` to receive
  *   incremental body chunks.
+ *
+ * Every request opens a CLIENT span (see tracing.h) carrying the method, the
+ * URL without its query string, body sizes and the status code. Streaming
+ * posts also record a `response.first_byte` event. httplib does not report
+ * connect or TLS handshake time separately, so those are part of the span.
+ * Requests in flight over the network are reported as the
+ * `agents_http_open_connections` gauge (each request uses its own
+ * connection; requests an interceptor answers itself are not counted). The phase timestamps of the
+ * most recent request on the calling thread are available from lastTiming().
+ *
+ * Only requests made through this header are timed, traced, counted and
+ * intercepted. The providers in the prebuilt shared library carry their own
+ * compiled copy of this class, so their requests are not seen here; post()
+ * and get() are kept out of the dynamic symbol table (AGENTS_HTTP_LOCAL) so
+ * the library never binds to the application's definitions.
+ *
+ * An Interceptor installed with setInterceptor() sees every request made
+ * through this header and may answer it in place of the network (see
+ * http_cassette.h).
  */
 class HTTPClient {
 public:
@@ -54,6 +92,90 @@ public:
         httplib::Headers headers;  /**< Response headers */
     };
 
+    /**
+     * @brief Phase timestamps of one request
+     *
+     * `first_byte` is when the response headers of a POST arrived, or when
+     * the whole response of a GET arrived; it stays at the epoch when no
+     * response was received. httplib does not report connect and TLS time
+     * separately, so they fall between `sent` and `first_byte`.
+     */
+    struct Timing {
+        std::chrono::steady_clock::time_point started;    /**< Entered post() or get() */
+        std::chrono::steady_clock::time_point sent;       /**< Request built and handed to httplib */
+        std::chrono::steady_clock::time_point first_byte; /**< Response headers received */
+        std::chrono::steady_clock::time_point finished;   /**< Response complete or failed */
+        std::string target;                               /**< Method and URL without the query string */
+    };
+
+    /**
+     * @brief Timing of the most recent request made on the calling thread
+     * @return The timing; `target` is empty if the thread has made no request
+     */
+    static const Timing& lastTiming() {
+        return timing();
+    }
+
+    /**
+     * @brief Description of an outgoing request as seen by an Interceptor
+     *
+     * GET query parameters passed as `httplib::Params` are appended to `url`
+     * unencoded. Multipart bodies are rendered with the random boundary the
+     * request is sent with, which is also given in a `Content-Type` header so
+     * interceptors can compare bodies regardless of their boundaries.
+     */
+    struct Request {
+        std::string method;                         /**< "GET" or "POST" */
+        std::string url;                            /**< Full request URL */
+        std::map<std::string, std::string> headers; /**< Headers passed by the caller */
+        std::string body;                           /**< Request body */
+    };
+
+    /**
+     * @brief Sends the request over the network, streaming to the given callback if set
+     */
+    using Transport = std::function<Response(const WriteCallback&)>;
+
+    /**
+     * @brief Hook that sees every request and may answer it in place of the network
+     */
+    class Interceptor {
+    public:
+        virtual ~Interceptor() = default;
+
+        /**
+         * @brief Handle one request
+         *
+         * Call `send` to perform the request over the network, or return a
+         * response without calling it. Streamed requests have a `write_cb`,
+         * which must receive the body instead of `Response::text`.
+         *
+         * @param request The request
+         * @param write_cb The caller's streaming callback, or empty
+         * @param send Performs the request over the network
+         * @return The response returned to the caller
+         */
+        virtual Response handle(const Request& request, const WriteCallback& write_cb, const Transport& send) = 0;
+    };
+
+    /**
+     * @brief Install an interceptor for requests made from any thread
+     * @param interceptor The interceptor, or nullptr to remove it
+     */
+    static void setInterceptor(std::shared_ptr<Interceptor> interceptor) {
+        std::lock_guard<std::mutex> lock(interceptorMutex());
+        interceptorSlot() = std::move(interceptor);
+    }
+
+    /**
+     * @brief Get the installed interceptor
+     * @return The interceptor, or nullptr if none is installed
+     */
+    static std::shared_ptr<Interceptor> interceptor() {
+        std::lock_guard<std::mutex> lock(interceptorMutex());
+        return interceptorSlot();
+    }
+
     /**
      * @brief Perform an HTTP POST to `url`.
      *
@@ -69,6 +191,7 @@ public:
      * @param multipart Optional vector of multipart form data parts
      * @return Response Normalized response object
      */
+    AGENTS_HTTP_LOCAL
     static Response post(const std::string& url,
                         const std::map<std::string, std::string>& headers,
                         const std::string& body,
@@ -76,7 +199,161 @@ public:
                         WriteCallback write_cb = nullptr,
                         const std::vector<httplib::MultipartFormData>& multipart = {}) {
         Response result;
+        Span span("HTTP POST", SpanKind::CLIENT);
+        startSpan(span, "POST", url);
+        Timing& timing = beginTiming("POST", url);
+        const std::string boundary = multipart.empty() ? std::string() : make_boundary();
+
+        auto send = [&](const WriteCallback& sink) {
+            OpenConnection connection;
+            return sendPost(url, headers, body, timeout_ms, sink, multipart, boundary, span, timing);
+        };
+        if (auto hook = interceptor()) {
+            Request request{"POST", url, headers, body};
+            if (!multipart.empty()) {
+                request.headers["Content-Type"] = "multipart/form-data; boundary=" + boundary;
+                request.body = build_multipart_body(multipart, boundary);
+            }
+            result = intercept(*hook, request, write_cb, send, timing);
+        } else {
+            result = send(write_cb);
+        }
+
+        timing.finished = std::chrono::steady_clock::now();
+        endSpan(span, result);
+        return result;
+    }
+
+    /**
+     * @brief Perform a simple HTTP GET and return the full body.
+     *
+     * This variant accepts headers but no query params. For callers that
+     * wish to supply query parameters, use the overload that accepts
+     * `httplib::Params` which delegates to cpp-httplib to perform
+     * percent-encoding.
+     *
+     * @param url Full request URL
+     * @param headers Map of headers to send
+     * @param timeout_ms Request timeout in milliseconds
+     * @return Response Normalized response object
+     */
+    AGENTS_HTTP_LOCAL
+    static Response get(const std::string& url,
+                       const std::map<std::string, std::string>& headers,
+                       int timeout_ms = 30000) {
+        Response result;
+        Span span("HTTP GET", SpanKind::CLIENT);
+        startSpan(span, "GET", url);
+        Timing& timing = beginTiming("GET", url);
+
+        auto send = [&](const WriteCallback&) {
+            OpenConnection connection;
+            return sendGet(url, nullptr, headers, timeout_ms, timing);
+        };
+        if (auto hook = interceptor()) {
+            result = intercept(*hook, Request{"GET", url, headers, {}}, nullptr, send, timing);
+        } else {
+            result = send(nullptr);
+        }
+
+        timing.finished = std::chrono::steady_clock::now();
+        endSpan(span, result);
+        return result;
+    }
+
+    /**
+     * @brief Perform an HTTP GET using `params` as query parameters.
+     *
+     * This overload uses cpp-httplib's `Get(path, params, headers)` so the
+     * library handles percent-encoding and parameter ordering.
+     *
+     * @param url Full request URL
+     * @param params Query parameters as an httplib::Params map
+     * @param headers Map of headers to send
+     * @param timeout_ms Request timeout in milliseconds
+     * @return Response Normalized response object
+     */
+    AGENTS_HTTP_LOCAL
+    static Response get(const std::string& url,
+                       const httplib::Params& params,
+                       const std::map<std::string, std::string>& headers,
+                       int timeout_ms = 30000) {
+        Response result;
+        Span span("HTTP GET", SpanKind::CLIENT);
+        startSpan(span, "GET", url);
+        Timing& timing = beginTiming("GET", url);
+
+        auto send = [&](const WriteCallback&) {
+            OpenConnection connection;
+            return sendGet(url, &params, headers, timeout_ms, timing);
+        };
+        if (auto hook = interceptor()) {
+            result = intercept(*hook, Request{"GET", url + queryString(params), headers, {}}, nullptr, send, timing);
+        } else {
+            result = send(nullptr);
+        }
+
+        timing.finished = std::chrono::steady_clock::now();
+        endSpan(span, result);
+        return result;
+    }
+
+private:
+    static std::mutex& interceptorMutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    static std::shared_ptr<Interceptor>& interceptorSlot() {
+        static std::shared_ptr<Interceptor> slot;
+        return slot;
+    }
+
+    static Response intercept(Interceptor& hook, const Request& request, const WriteCallback& write_cb,
+                              const Transport& send, Timing& timing) {
+        // Answers that skip the network still report when their first byte arrived
+        WriteCallback sink;
+        if (write_cb) {
+            sink = [&write_cb, &timing](const std::string_view& data) {
+                if (timing.first_byte == std::chrono::steady_clock::time_point{}) {
+                    timing.first_byte = std::chrono::steady_clock::now();
+                }
+                return write_cb(data);
+            };
+        }
+        if (timing.sent == std::chrono::steady_clock::time_point{}) {
+            timing.sent = std::chrono::steady_clock::now();
+        }
+        Response result;
+        try {
+            result = hook.handle(request, sink, send);
+        } catch (const std::exception& e) {
+            result = Response{-1, {}, true, e.what(), {}};
+        }
+        if (!result.error && timing.first_byte == std::chrono::steady_clock::time_point{}) {
+            timing.first_byte = std::chrono::steady_clock::now();
+        }
+        return result;
+    }
 
+    static std::string queryString(const httplib::Params& params) {
+        std::string query;
+        for (const auto& [key, value] : params) {
+            query += (query.empty() ? "?" : "&") + key + "=" + value;
+        }
+        return query;
+    }
+
+    static Response sendPost(const std::string& url,
+                             const std::map<std::string, std::string>& headers,
+                             const std::string& body,
+                             int timeout_ms,
+                             const WriteCallback& write_cb,
+                             const std::vector<httplib::MultipartFormData>& multipart,
+                             const std::string& boundary,
+                             Span& span,
+                             Timing& timing) {
+        Response result;
         try {
             auto session = createSession(url);
             setSessionOptions(session, headers, body, timeout_ms, write_cb);
@@ -94,33 +371,42 @@ public:
             req.path = getPath(url);
             req.headers = session->headers;
 
-            std::string multipart_boundary;
             std::string multipart_body;
             // If multipart is provided, encode multipart form; else use body
             if (!multipart.empty()) {
                 // Build multipart/form-data body by hand
-                multipart_boundary = make_boundary();
-                multipart_body     = build_multipart_body(multipart, multipart_boundary);
+                multipart_body = build_multipart_body(multipart, boundary);
 
                 req.set_header("Content-Type",
-                            "multipart/form-data; boundary=" + multipart_boundary);
+                            "multipart/form-data; boundary=" + boundary);
                 req.set_header("Content-Length", std::to_string(multipart_body.size()));
                 req.body = std::move(multipart_body);
             } else {
                 req.body = session->body;
             }
 
-            if (write_cb) {
-                // Attach a response handler (no-op but required by some overloads)
-                req.response_handler = [](const httplib::Response &) { return true; };
+            // Called once the response headers are read
+            req.response_handler = [&timing](const httplib::Response &) {
+                timing.first_byte = std::chrono::steady_clock::now();
+                return true;
+            };
 
+            if (write_cb) {
                 // Request::content_receiver expects ContentReceiverWithProgress
-                req.content_receiver = [write_cb](const char *data, size_t len,
-                                                  uint64_t /*offset*/, uint64_t /*total*/) {
+                req.content_receiver = [write_cb, &span, first = true](const char *data, size_t len,
+                                                  uint64_t /*offset*/, uint64_t /*total*/) mutable {
+                    if (first) {
+                        span.addEvent("response.first_byte");
+                        first = false;
+                    }
                     return write_cb(std::string_view(data, len));
                 };
             }
 
+            span.setAttribute("http.request.body.size", req.body.size());
+            span.addEvent("request.built");
+            timing.sent = std::chrono::steady_clock::now();
+
             // Send the request and get a Result (returned by value)
             auto res = client->send(req);
 
@@ -159,28 +445,15 @@ public:
             result.error_message = e.what();
             result.status_code = -1;
         }
-
         return result;
     }
 
-    /**
-     * @brief Perform a simple HTTP GET and return the full body.
-     *
-     * This variant accepts headers but no query params. For callers that
-     * wish to supply query parameters, use the overload that accepts
-     * `httplib::Params` which delegates to cpp-httplib to perform
-     * percent-encoding.
-     *
-     * @param url Full request URL
-     * @param headers Map of headers to send
-     * @param timeout_ms Request timeout in milliseconds
-     * @return Response Normalized response object
-     */
-    static Response get(const std::string& url,
-                       const std::map<std::string, std::string>& headers,
-                       int timeout_ms = 30000) {
+    static Response sendGet(const std::string& url,
+                            const httplib::Params* params,
+                            const std::map<std::string, std::string>& headers,
+                            int timeout_ms,
+                            Timing& timing) {
         Response result;
-
         try {
             httplib::Client cli(getBaseUrl(url));
             cli.set_connection_timeout(timeout_ms / 1000);
@@ -191,8 +464,11 @@ public:
                 header_map.emplace(key, value);
             }
 
-            // Make request
-            auto res = cli.Get(getPath(url).c_str(), header_map);
+            timing.sent = std::chrono::steady_clock::now();
+            // With params, let cpp-httplib handle the encoding
+            auto res = params ? cli.Get(getPath(url).c_str(), *params, header_map)
+                              : cli.Get(getPath(url).c_str(), header_map);
+            if (res) timing.first_byte = std::chrono::steady_clock::now();
 
             if (res) {
                 result.status_code = res->status;
@@ -209,61 +485,48 @@ public:
             result.error_message = e.what();
             result.status_code = -1;
         }
-
         return result;
     }
 
-    /**
-     * @brief Perform an HTTP GET using `params` as query parameters.
-     *
-     * This overload uses cpp-httplib's `Get(path, params, headers)` so the
-     * library handles percent-encoding and parameter ordering.
-     *
-     * @param url Full request URL
-     * @param params Query parameters as an httplib::Params map
-     * @param headers Map of headers to send
-     * @param timeout_ms Request timeout in milliseconds
-     * @return Response Normalized response object
-     */
-    static Response get(const std::string& url,
-                       const httplib::Params& params,
-                       const std::map<std::string, std::string>& headers,
-                       int timeout_ms = 30000) {
-        Response result;
+    struct OpenConnection {
+        OpenConnection() { gauge().add(1); }
+        ~OpenConnection() { gauge().add(-1); }
+        static Gauge& gauge() {
+            static Gauge& open = MetricsRegistry::global().gauge(
+                "agents_http_open_connections", "HTTP requests in flight over the network");
+            return open;
+        }
+    };
 
-        try {
-            httplib::Client cli(getBaseUrl(url));
-            cli.set_connection_timeout(timeout_ms / 1000);
+    static Timing& timing() {
+        thread_local Timing last;
+        return last;
+    }
 
-            // Set headers
-            httplib::Headers header_map;
-            for (const auto& [key, value] : headers) {
-                header_map.emplace(key, value);
-            }
+    static Timing& beginTiming(const char* method, const std::string& url) {
+        Timing& last = timing();
+        last = Timing{std::chrono::steady_clock::now(), {}, {}, {}, std::string(method) + " " + url.substr(0, url.find('?'))};
+        return last;
+    }
 
-            // Use cpp-httplib's built-in params overload so it handles encoding
-            auto res = cli.Get(getPath(url).c_str(), params, header_map);
+    static void startSpan(Span& span, const char* method, const std::string& url) {
+        if (!span.isRecording()) return;
+        span.setAttribute("http.request.method", method);
+        // Drop the query string: some providers pass API keys there
+        span.setAttribute("url.full", url.substr(0, url.find('?')));
+    }
 
-            if (res) {
-                result.status_code = res->status;
-                result.headers = res->headers;
-                result.text = res->body;
-                result.error = false;
-            } else {
-                result.error = true;
-                result.error_message = "Request failed";
-                result.status_code = -1;
-            }
-        } catch (const std::exception& e) {
-            result.error = true;
-            result.error_message = e.what();
-            result.status_code = -1;
+    static void endSpan(Span& span, const Response& result) {
+        if (!span.isRecording()) return;
+        span.setAttribute("http.response.status_code", result.status_code);
+        span.setAttribute("http.response.body.size", result.text.size());
+        if (result.error) {
+            span.setError(result.error_message);
+        } else if (result.status_code >= 400) {
+            span.setError("HTTP " + std::to_string(result.status_code));
         }
-
-        return result;
     }
 
-private:
     static std::string make_boundary() {
         static const char alphanum[] =
             "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
@@ -424,4 +687,4 @@ private:
     }
 };
 
-} // namespace agents
\ No newline at end of file
+} // namespace agents
@@ -0,0 +1,996 @@
+/**
+ * @file instrumentation.h
+ * @brief Tracing, timing and metrics decorators for LLMs, tools and agents
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025 Edge AI, LLC. All rights reserved.
+ *
+ */
+#pragma once
+
+#include <agents-cpp/agent.h>
+#include <agents-cpp/budget_governor.h>
+#include <agents-cpp/call_timing.h>
+#include <agents-cpp/llm_interface.h>
+#include <agents-cpp/metrics.h>
+#include <agents-cpp/tool.h>
+#include <agents-cpp/tracing.h>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace agents {
+
+/**
+ * @brief LLMInterface decorator that records a span per call
+ *
+ * Wraps any provider. Each call opens a CLIENT span named `llm.chat`,
+ * `llm.chat_with_tools` or `llm.stream_chat` carrying the provider, model,
+ * request options, message count, token usage and tool call count. Streaming
+ * calls also record a `first_token` event and `gen_ai.response.ttft_ms`.
+ * Requests the provider sends through the header HTTPClient become child
+ * `HTTP POST` / `HTTP GET` spans. The providers in the prebuilt library use
+ * their own compiled client, so their calls get the `llm.*` span only.
+ *
+ * @code
+ * context->setLLM(std::make_shared<TracingLLM>(createLLM("openai", key), "openai"));
+ * @endcode
+ */
+class TracingLLM : public LLMInterface {
+public:
+    /**
+     * @brief Constructor
+     * @param llm The LLM to trace
+     * @param provider Provider name recorded as `gen_ai.system`
+     * @throws std::invalid_argument if llm is null
+     */
+    explicit TracingLLM(std::shared_ptr<LLMInterface> llm, std::string provider = "")
+        : llm_(std::move(llm)), provider_(std::move(provider)) {
+        if (!llm_) {
+            throw std::invalid_argument("TracingLLM requires an LLM");
+        }
+    }
+
+    /**
+     * @brief Get the wrapped LLM
+     * @return The LLM
+     */
+    std::shared_ptr<LLMInterface> getLLM() const { return llm_; }
+
+    /**
+     * @brief Get available models from the wrapped LLM
+     * @return The available models
+     */
+    std::vector<std::string> getAvailableModels() override { return llm_->getAvailableModels(); }
+
+    /**
+     * @brief Set the model of the wrapped LLM
+     * @param model The model to use
+     */
+    void setModel(const std::string& model) override { llm_->setModel(model); }
+
+    /**
+     * @brief Get the model of the wrapped LLM
+     * @return The current model
+     */
+    std::string getModel() const override { return llm_->getModel(); }
+
+    /**
+     * @brief Set API key of the wrapped LLM
+     * @param api_key The API key to use
+     */
+    void setApiKey(const std::string& api_key) override { llm_->setApiKey(api_key); }
+
+    /**
+     * @brief Set API base URL of the wrapped LLM
+     * @param api_base The API base URL to use
+     */
+    void setApiBase(const std::string& api_base) override { llm_->setApiBase(api_base); }
+
+    /**
+     * @brief Set options of the wrapped LLM
+     * @param options The options to use
+     */
+    void setOptions(const LLMOptions& options) override { llm_->setOptions(options); }
+
+    /**
+     * @brief Get options of the wrapped LLM
+     * @return The current options
+     */
+    LLMOptions getOptions() const override { return llm_->getOptions(); }
+
+    /**
+     * @brief Generate completion from a prompt
+     * @param prompt The prompt
+     * @return The completion
+     */
+    LLMResponse chat(const std::string& prompt) override {
+        return chat(std::vector<Message>{Message{Message::Role::USER, prompt}});
+    }
+
+    /**
+     * @brief Generate completion from a list of messages
+     * @param messages The messages to generate completion from
+     * @return The LLM response
+     */
+    LLMResponse chat(const std::vector<Message>& messages) override {
+        Span span("llm.chat", SpanKind::CLIENT);
+        startSpan(span, messages);
+        return finish(span, [&]() { return llm_->chat(messages); });
+    }
+
+    /**
+     * @brief Generate completion with available tools
+     * @param messages The messages to generate completion from
+     * @param tools The tools to use
+     * @return The LLM response
+     */
+    LLMResponse chatWithTools(
+        const std::vector<Message>& messages,
+        const std::vector<std::shared_ptr<Tool>>& tools
+    ) override {
+        Span span("llm.chat_with_tools", SpanKind::CLIENT);
+        startSpan(span, messages);
+        span.setAttribute("gen_ai.request.tool_count", tools.size());
+        return finish(span, [&]() { return llm_->chatWithTools(messages, tools); });
+    }
+
+    /**
+     * @brief Stream results with callback
+     * @param messages The messages to generate completion from
+     * @param callback The callback to receive chunks
+     */
+    void streamChat(
+        const std::vector<Message>& messages,
+        std::function<void(const std::string&, bool)> callback
+    ) override {
+        Span span("llm.stream_chat", SpanKind::CLIENT);
+        startSpan(span, messages);
+        if (!span.isRecording()) {
+            llm_->streamChat(messages, std::move(callback));
+            return;
+        }
+        const auto started = std::chrono::steady_clock::now();
+        bool first = true;
+        size_t chunks = 0;
+        try {
+            llm_->streamChat(messages, [&](const std::string& chunk, bool done) {
+                if (first && !chunk.empty()) {
+                    first = false;
+                    span.addEvent("first_token");
+                    span.setAttribute("gen_ai.response.ttft_ms",
+                        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count());
+                }
+                if (!chunk.empty()) chunks++;
+                callback(chunk, done);
+            });
+        } catch (const std::exception& e) {
+            span.setError(e.what());
+            throw;
+        }
+        span.setAttribute("gen_ai.response.chunks", chunks);
+    }
+
+    /**
+     * @brief Async chat from a list of messages
+     * @param messages The messages to generate completion from
+     * @return Task yielding the LLM response
+     */
+    Task<LLMResponse> chatAsync(const std::vector<Message>& messages) override {
+        Span span("llm.chat", SpanKind::CLIENT);
+        startSpan(span, messages);
+        try {
+            LLMResponse response = co_await llm_->chatAsync(messages);
+            endSpan(span, response);
+            co_return response;
+        } catch (const std::exception& e) {
+            span.setError(e.what());
+            throw;
+        }
+    }
+
+    /**
+     * @brief Async chat with tools
+     * @param messages The messages to generate completion from
+     * @param tools The tools to use
+     * @return Task yielding the LLM response
+     */
+    Task<LLMResponse> chatWithToolsAsync(
+        const std::vector<Message>& messages,
+        const std::vector<std::shared_ptr<Tool>>& tools
+    ) override {
+        Span span("llm.chat_with_tools", SpanKind::CLIENT);
+        startSpan(span, messages);
+        span.setAttribute("gen_ai.request.tool_count", tools.size());
+        try {
+            LLMResponse response = co_await llm_->chatWithToolsAsync(messages, tools);
+            endSpan(span, response);
+            co_return response;
+        } catch (const std::exception& e) {
+            span.setError(e.what());
+            throw;
+        }
+    }
+
+    /**
+     * @brief Stream results as an AsyncGenerator
+     *
+     * Traced as streamChat() is, in a span that opens at the first next() and
+     * ends with the stream. The span parents the wrapped stream's work but is
+     * not current in the consumer between chunks.
+     *
+     * @param messages The messages to generate completion from
+     * @param tools The tools to use
+     * @return The AsyncGenerator of response chunks
+     */
+    AsyncGenerator<std::string> streamChatAsync(
+        const std::vector<Message>& messages,
+        const std::vector<std::shared_ptr<Tool>>& tools
+    ) override {
+        return tracedStream(messages, tools);
+    }
+
+    /**
+     * @brief Upload a media file through the wrapped LLM
+     * @param local_path Local filesystem path
+     * @param mime The MIME type of the media file
+     * @param binary Optional binary content of the media file
+     * @return Optional envelope; std::nullopt if unsupported
+     */
+    std::optional<JsonObject> uploadMediaFile(const std::string& local_path, const std::string& mime, const std::string& binary = "") override {
+        return llm_->uploadMediaFile(local_path, mime, binary);
+    }
+
+/*! @cond PRIVATE */
+private:
+    std::shared_ptr<LLMInterface> llm_;
+    std::string provider_;
+
+    void startSpan(Span& span, const std::vector<Message>& messages) const {
+        if (!span.isRecording()) return;
+        LLMOptions options = llm_->getOptions();
+        if (!provider_.empty()) span.setAttribute("gen_ai.system", provider_);
+        span.setAttribute("gen_ai.request.model", llm_->getModel());
+        span.setAttribute("gen_ai.request.temperature", options.temperature);
+        span.setAttribute("gen_ai.request.max_tokens", options.max_tokens);
+        span.setAttribute("gen_ai.request.messages", messages.size());
+    }
+
+    static void endSpan(Span& span, const LLMResponse& response) {
+        if (!span.isRecording()) return;
+        auto [input_tokens, output_tokens] = BudgetGovernor::extractTokenUsage(response.usage_metrics);
+        span.setAttribute("gen_ai.usage.input_tokens", input_tokens);
+        span.setAttribute("gen_ai.usage.output_tokens", output_tokens);
+        span.setAttribute("gen_ai.response.tool_calls", response.tool_calls.size());
+    }
+
+    AsyncGenerator<std::string> tracedStream(
+        std::vector<Message> messages,
+        std::vector<std::shared_ptr<Tool>> tools
+    ) {
+        Span span("llm.stream_chat", SpanKind::CLIENT);
+        startSpan(span, messages);
+        span.setAttribute("gen_ai.request.tool_count", tools.size());
+        // The consumer runs between chunks, so the span is only installed
+        // while the wrapped stream produces the next one
+        const TraceContext context = TraceContext::current();
+        span.detach();
+        const auto started = std::chrono::steady_clock::now();
+        size_t chunks = 0;
+        AsyncGenerator<std::string> stream;
+        bool opened = false;
+        while (true) {
+            std::optional<std::string> chunk;
+            try {
+                TraceContextScope scope(context);
+                if (!opened) {
+                    stream = llm_->streamChatAsync(messages, tools);
+                    opened = true;
+                }
+                chunk = co_await stream.next();
+            } catch (const std::exception& e) {
+                span.setError(e.what());
+                throw;
+            }
+            if (!chunk) break;
+            if (!chunk->empty() && chunks++ == 0) {
+                span.addEvent("first_token");
+                span.setAttribute("gen_ai.response.ttft_ms",
+                    std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count());
+            }
+            co_yield std::move(*chunk);
+        }
+        span.setAttribute("gen_ai.response.chunks", chunks);
+    }
+
+    template <typename Call>
+    static LLMResponse finish(Span& span, Call&& call) {
+        try {
+            LLMResponse response = call();
+            endSpan(span, response);
+            return response;
+        } catch (const std::exception& e) {
+            span.setError(e.what());
+            throw;
+        }
+    }
+/*! @endcond */
+};
+
+/**
+ * @brief Tool decorator that records a span per execution
+ *
+ * Register it in place of the tool; Context::executeTool and the agents
+ * then trace every call as a `tool.execute` span with the tool name and
+ * outcome.
+ *
+ * @code
+ * context->registerTool(std::make_shared<TracedTool>(tools::createWebSearchTool()));
+ * @endcode
+ */
+class TracedTool : public Tool {
+public:
+    /**
+     * @brief Constructor
+     * @param tool The tool to trace
+     * @throws std::invalid_argument if tool is null
+     */
+    explicit TracedTool(std::shared_ptr<Tool> tool)
+        : Tool(tool ? tool->getName() : std::string(), tool ? tool->getDescription() : std::string()),
+          tool_(std::move(tool)) {
+        if (!tool_) {
+            throw std::invalid_argument("TracedTool requires a tool");
+        }
+        for (const auto& [name, parameter] : tool_->getParameters()) {
+            addParameter(parameter);
+        }
+    }
+
+    /**
+     * @brief Execute the wrapped tool inside a span
+     * @param params The parameters to execute the tool with
+     * @return The result of the tool execution
+     */
+    ToolResult execute(const JsonObject& params) const override {
+        Span span("tool.execute");
+        span.setAttribute("tool.name", name_);
+        try {
+            ToolResult result = tool_->execute(params);
+            span.setAttribute("tool.success", result.success);
+            if (!result.success) span.setError(result.content);
+            return result;
+        } catch (const std::exception& e) {
+            span.setError(e.what());
+            throw;
+        }
+    }
+
+/*! @cond PRIVATE */
+private:
+    std::shared_ptr<Tool> tool_;
+/*! @endcond */
+};
+
+/**
+ * @brief LLMInterface decorator that records request metrics
+ *
+ * Per provider and model it maintains:
+ * - `agents_llm_requests_total{outcome="ok|error"}`
+ * - `agents_llm_request_duration_seconds` (histogram)
+ * - `agents_llm_ttft_seconds` (histogram, streaming calls)
+ * - `agents_llm_tokens_total{direction="input|output"}` (streamed output is estimated)
+ *
+ * Combine with TracingLLM freely; each only observes the calls it wraps.
+ */
+class MeteredLLM : public LLMInterface {
+public:
+    /**
+     * @brief Constructor
+     * @param llm The LLM to measure
+     * @param provider Provider name used as the `provider` label
+     * @param registry The registry to record into
+     * @throws std::invalid_argument if llm is null
+     */
+    MeteredLLM(std::shared_ptr<LLMInterface> llm, std::string provider, MetricsRegistry& registry = MetricsRegistry::global())
+        : llm_(std::move(llm)), provider_(std::move(provider)), registry_(registry) {
+        if (!llm_) {
+            throw std::invalid_argument("MeteredLLM requires an LLM");
+        }
+    }
+
+    /**
+     * @brief Get available models from the wrapped LLM
+     * @return The available models
+     */
+    std::vector<std::string> getAvailableModels() override { return llm_->getAvailableModels(); }
+
+    /**
+     * @brief Set the model of the wrapped LLM
+     * @param model The model to use
+     */
+    void setModel(const std::string& model) override { llm_->setModel(model); }
+
+    /**
+     * @brief Get the model of the wrapped LLM
+     * @return The current model
+     */
+    std::string getModel() const override { return llm_->getModel(); }
+
+    /**
+     * @brief Set API key of the wrapped LLM
+     * @param api_key The API key to use
+     */
+    void setApiKey(const std::string& api_key) override { llm_->setApiKey(api_key); }
+
+    /**
+     * @brief Set API base URL of the wrapped LLM
+     * @param api_base The API base URL to use
+     */
+    void setApiBase(const std::string& api_base) override { llm_->setApiBase(api_base); }
+
+    /**
+     * @brief Set options of the wrapped LLM
+     * @param options The options to use
+     */
+    void setOptions(const LLMOptions& options) override { llm_->setOptions(options); }
+
+    /**
+     * @brief Get options of the wrapped LLM
+     * @return The current options
+     */
+    LLMOptions getOptions() const override { return llm_->getOptions(); }
+
+    /**
+     * @brief Generate completion from a prompt
+     * @param prompt The prompt
+     * @return The completion
+     */
+    LLMResponse chat(const std::string& prompt) override {
+        return chat(std::vector<Message>{Message{Message::Role::USER, prompt}});
+    }
+
+    /**
+     * @brief Generate completion from a list of messages
+     * @param messages The messages to generate completion from
+     * @return The LLM response
+     */
+    LLMResponse chat(const std::vector<Message>& messages) override {
+        return measure([&]() { return llm_->chat(messages); });
+    }
+
+    /**
+     * @brief Generate completion with available tools
+     * @param messages The messages to generate completion from
+     * @param tools The tools to use
+     * @return The LLM response
+     */
+    LLMResponse chatWithTools(
+        const std::vector<Message>& messages,
+        const std::vector<std::shared_ptr<Tool>>& tools
+    ) override {
+        return measure([&]() { return llm_->chatWithTools(messages, tools); });
+    }
+
+    /**
+     * @brief Stream results with callback
+     * @param messages The messages to generate completion from
+     * @param callback The callback to receive chunks
+     */
+    void streamChat(
+        const std::vector<Message>& messages,
+        std::function<void(const std::string&, bool)> callback
+    ) override {
+        const std::string model = llm_->getModel();
+        const auto started = std::chrono::steady_clock::now();
+        bool first = true;
+        LLMResponse streamed;
+        try {
+            llm_->streamChat(messages, [&](const std::string& chunk, bool done) {
+                if (first && !chunk.empty()) {
+                    first = false;
+                    registry_.histogram("agents_llm_ttft_seconds", "Time to first streamed token", labels(model))
+                        .observe(std::chrono::steady_clock::now() - started);
+                }
+                streamed.content += chunk;
+                callback(chunk, done);
+            });
+        } catch (...) {
+            record(model, started, nullptr);
+            throw;
+        }
+        streamed.usage_metrics["output_tokens"] = static_cast<double>(BudgetGovernor::estimateTokens(streamed.content));
+        record(model, started, &streamed);
+    }
+
+    /**
+     * @brief Async chat from a list of messages
+     * @param messages The messages to generate completion from
+     * @return Task yielding the LLM response
+     */
+    Task<LLMResponse> chatAsync(const std::vector<Message>& messages) override {
+        const std::string model = llm_->getModel();
+        const auto started = std::chrono::steady_clock::now();
+        try {
+            LLMResponse response = co_await llm_->chatAsync(messages);
+            record(model, started, &response);
+            co_return response;
+        } catch (...) {
+            record(model, started, nullptr);
+            throw;
+        }
+    }
+
+    /**
+     * @brief Async chat with tools
+     * @param messages The messages to generate completion from
+     * @param tools The tools to use
+     * @return Task yielding the LLM response
+     */
+    Task<LLMResponse> chatWithToolsAsync(
+        const std::vector<Message>& messages,
+        const std::vector<std::shared_ptr<Tool>>& tools
+    ) override {
+        const std::string model = llm_->getModel();
+        const auto started = std::chrono::steady_clock::now();
+        try {
+            LLMResponse response = co_await llm_->chatWithToolsAsync(messages, tools);
+            record(model, started, &response);
+            co_return response;
+        } catch (...) {
+            record(model, started, nullptr);
+            throw;
+        }
+    }
+
+    /**
+     * @brief Stream results as an AsyncGenerator (not measured)
+     * @param messages The messages to generate completion from
+     * @param tools The tools to use
+     * @return The AsyncGenerator of response chunks
+     */
+    AsyncGenerator<std::string> streamChatAsync(
+        const std::vector<Message>& messages,
+        const std::vector<std::shared_ptr<Tool>>& tools
+    ) override {
+        return llm_->streamChatAsync(messages, tools);
+    }
+
+    /**
+     * @brief Upload a media file through the wrapped LLM
+     * @param local_path Local filesystem path
+     * @param mime The MIME type of the media file
+     * @param binary Optional binary content of the media file
+     * @return Optional envelope; std::nullopt if unsupported
+     */
+    std::optional<JsonObject> uploadMediaFile(const std::string& local_path, const std::string& mime, const std::string& binary = "") override {
+        return llm_->uploadMediaFile(local_path, mime, binary);
+    }
+
+/*! @cond PRIVATE */
+private:
+    std::shared_ptr<LLMInterface> llm_;
+    std::string provider_;
+    MetricsRegistry& registry_;
+
+    MetricLabels labels(const std::string& model) const {
+        return MetricLabels{{"provider", provider_}, {"model", model}};
+    }
+
+    void record(const std::string& model, std::chrono::steady_clock::time_point started, const LLMResponse* response) {
+        MetricLabels series = labels(model);
+        registry_.histogram("agents_llm_request_duration_seconds", "LLM request latency", series)
+            .observe(std::chrono::steady_clock::now() - started);
+        series["outcome"] = response ? "ok" : "error";
+        registry_.counter("agents_llm_requests_total", "LLM requests by outcome", series).inc();
+        if (!response) return;
+        auto [input_tokens, output_tokens] = BudgetGovernor::extractTokenUsage(response->usage_metrics);
+        series.erase("outcome");
+        series["direction"] = "input";
+        registry_.counter("agents_llm_tokens_total", "LLM tokens by direction", series).inc(static_cast<uint64_t>(std::max<int64_t>(input_tokens, 0)));
+        series["direction"] = "output";
+        registry_.counter("agents_llm_tokens_total", "LLM tokens by direction", series).inc(static_cast<uint64_t>(std::max<int64_t>(output_tokens, 0)));
+    }
+
+    template <typename Call>
+    LLMResponse measure(Call&& call) {
+        const std::string model = llm_->getModel();
+        const auto started = std::chrono::steady_clock::now();
+        try {
+            LLMResponse response = call();
+            record(model, started, &response);
+            return response;
+        } catch (...) {
+            record(model, started, nullptr);
+            throw;
+        }
+    }
+/*! @endcond */
+};
+
+/**
+ * @brief LLMInterface decorator that fills a CallTiming for every call
+ *
+ * The breakdown is written into the response's usage_metrics (see
+ * CallTiming::from()) and passed to an optional observer. Streams have no
+ * response: streamChatResponse() assembles one, and the observer is the
+ * only way to receive the breakdown of streamChat() and streamChatAsync().
+ * The decorator measures the total time, time to first token and streaming
+ * gaps itself and takes the token counts from the provider's usage
+ * (estimated for streams), so the breakdown is the same for every
+ * provider. Failed calls are not reported.
+ *
+ * @code
+ * auto llm = std::make_shared<TimedLLM>(createLLM("openai", key),
+ *     [](const std::string& model, const CallTiming& t) { router.observe(model, t.total_ms); });
+ * @endcode
+ */
+class TimedLLM : public LLMInterface {
+public:
+    /**
+     * @brief Observer receiving the model and breakdown of each successful call
+     */
+    using Observer = std::function<void(const std::string&, const CallTiming&)>;
+
+    /**
+     * @brief Constructor
+     * @param llm The LLM to time
+     * @param observer Optional observer called after each successful call
+     * @throws std::invalid_argument if llm is null
+     */
+    explicit TimedLLM(std::shared_ptr<LLMInterface> llm, Observer observer = nullptr)
+        : llm_(std::move(llm)), observer_(std::move(observer)) {
+        if (!llm_) {
+            throw std::invalid_argument("TimedLLM requires an LLM");
+        }
+    }
+
+    /**
+     * @brief Get available models from the wrapped LLM
+     * @return The available models
+     */
+    std::vector<std::string> getAvailableModels() override { return llm_->getAvailableModels(); }
+
+    /**
+     * @brief Set the model of the wrapped LLM
+     * @param model The model to use
+     */
+    void setModel(const std::string& model) override { llm_->setModel(model); }
+
+    /**
+     * @brief Get the model of the wrapped LLM
+     * @return The current model
+     */
+    std::string getModel() const override { return llm_->getModel(); }
+
+    /**
+     * @brief Set API key of the wrapped LLM
+     * @param api_key The API key to use
+     */
+    void setApiKey(const std::string& api_key) override { llm_->setApiKey(api_key); }
+
+    /**
+     * @brief Set API base URL of the wrapped LLM
+     * @param api_base The API base URL to use
+     */
+    void setApiBase(const std::string& api_base) override { llm_->setApiBase(api_base); }
+
+    /**
+     * @brief Set options of the wrapped LLM
+     * @param options The options to use
+     */
+    void setOptions(const LLMOptions& options) override { llm_->setOptions(options); }
+
+    /**
+     * @brief Get options of the wrapped LLM
+     * @return The current options
+     */
+    LLMOptions getOptions() const override { return llm_->getOptions(); }
+
+    /**
+     * @brief Generate completion from a prompt
+     * @param prompt The prompt
+     * @return The completion
+     */
+    LLMResponse chat(const std::string& prompt) override {
+        return chat(std::vector<Message>{Message{Message::Role::USER, prompt}});
+    }
+
+    /**
+     * @brief Generate completion from a list of messages
+     * @param messages The messages to generate completion from
+     * @return The LLM response, with the breakdown in usage_metrics
+     */
+    LLMResponse chat(const std::vector<Message>& messages) override {
+        return measure([&]() { return llm_->chat(messages); });
+    }
+
+    /**
+     * @brief Generate completion with available tools
+     * @param messages The messages to generate completion from
+     * @param tools The tools to use
+     * @return The LLM response, with the breakdown in usage_metrics
+     */
+    LLMResponse chatWithTools(
+        const std::vector<Message>& messages,
+        const std::vector<std::shared_ptr<Tool>>& tools
+    ) override {
+        return measure([&]() { return llm_->chatWithTools(messages, tools); });
+    }
+
+    /**
+     * @brief Stream results with callback, timing each chunk
+     *
+     * Token counts are estimated from the streamed text and the prompt. Use
+     * streamChatResponse() to receive the breakdown with the content.
+     *
+     * @param messages The messages to generate completion from
+     * @param callback The callback to receive chunks
+     */
+    void streamChat(
+        const std::vector<Message>& messages,
+        std::function<void(const std::string&, bool)> callback
+    ) override {
+        streamChatResponse(messages, std::move(callback));
+    }
+
+    /**
+     * @brief Stream results with callback and return the assembled response
+     *
+     * The streamed counterpart of chat(): chunks reach the callback as they
+     * arrive, and the returned response holds the full content with the
+     * breakdown, including time to first token and the gaps between chunks,
+     * in usage_metrics.
+     *
+     * @param messages The messages to generate completion from
+     * @param callback The callback to receive chunks
+     * @return The streamed content, with the breakdown in usage_metrics
+     */
+    LLMResponse streamChatResponse(
+        const std::vector<Message>& messages,
+        std::function<void(const std::string&, bool)> callback
+    ) {
+        StreamClock clock;
+        llm_->streamChat(messages, [&](const std::string& chunk, bool done) {
+            clock.add(chunk);
+            if (callback) callback(chunk, done);
+        });
+        LLMResponse response;
+        response.content = clock.content;
+        CallTiming timing = clock.finish(messages);
+        timing.writeTo(response.usage_metrics);
+        notify(timing);
+        return response;
+    }
+
+    /**
+     * @brief Async chat from a list of messages
+     *
+     * Fills the total time and token counts, as chat() does.
+     *
+     * @param messages The messages to generate completion from
+     * @return Task yielding the LLM response, with the breakdown in usage_metrics
+     */
+    Task<LLMResponse> chatAsync(const std::vector<Message>& messages) override {
+        const auto started = std::chrono::steady_clock::now();
+        LLMResponse response = co_await llm_->chatAsync(messages);
+        complete(response, CallTiming(), started);
+        co_return response;
+    }
+
+    /**
+     * @brief Async chat with tools
+     *
+     * Fills the total time and token counts, as chat() does.
+     *
+     * @param messages The messages to generate completion from
+     * @param tools The tools to use
+     * @return Task yielding the LLM response, with the breakdown in usage_metrics
+     */
+    Task<LLMResponse> chatWithToolsAsync(
+        const std::vector<Message>& messages,
+        const std::vector<std::shared_ptr<Tool>>& tools
+    ) override {
+        const auto started = std::chrono::steady_clock::now();
+        LLMResponse response = co_await llm_->chatWithToolsAsync(messages, tools);
+        complete(response, CallTiming(), started);
+        co_return response;
+    }
+
+    /**
+     * @brief Stream results as an AsyncGenerator, timing each chunk
+     *
+     * Measured as streamChat() is. The breakdown goes to the observer once
+     * the stream ends; a stream abandoned before its end is not reported.
+     *
+     * @param messages The messages to generate completion from
+     * @param tools The tools to use
+     * @return The AsyncGenerator of response chunks
+     */
+    AsyncGenerator<std::string> streamChatAsync(
+        const std::vector<Message>& messages,
+        const std::vector<std::shared_ptr<Tool>>& tools
+    ) override {
+        return timedStream(messages, tools);
+    }
+
+    /**
+     * @brief Upload a media file through the wrapped LLM
+     * @param local_path Local filesystem path
+     * @param mime The MIME type of the media file
+     * @param binary Optional binary content of the media file
+     * @return Optional envelope; std::nullopt if unsupported
+     */
+    std::optional<JsonObject> uploadMediaFile(const std::string& local_path, const std::string& mime, const std::string& binary = "") override {
+        return llm_->uploadMediaFile(local_path, mime, binary);
+    }
+
+/*! @cond PRIVATE */
+private:
+    std::shared_ptr<LLMInterface> llm_;
+    Observer observer_;
+
+    static double millis(std::chrono::steady_clock::duration duration) {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    }
+
+    // Arrival times of the chunks of one stream
+    struct StreamClock {
+        std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+        std::chrono::steady_clock::time_point first;
+        std::chrono::steady_clock::time_point previous;
+        std::vector<double> gaps;
+        std::string content;
+
+        void add(const std::string& chunk) {
+            if (chunk.empty()) return;
+            const auto now = std::chrono::steady_clock::now();
+            if (content.empty()) {
+                first = now;
+            } else {
+                gaps.push_back(millis(now - previous));
+            }
+            previous = now;
+            content += chunk;
+        }
+
+        CallTiming finish(const std::vector<Message>& messages) {
+            CallTiming timing;
+            timing.total_ms = millis(std::chrono::steady_clock::now() - started);
+            timing.time_to_first_token_ms = content.empty() ? -1.0 : millis(first - started);
+            timing.inter_token = InterTokenLatency::fromGaps(std::move(gaps));
+            for (const auto& message : messages) {
+                timing.input_tokens += BudgetGovernor::estimateTokens(message.content);
+            }
+            timing.output_tokens = BudgetGovernor::estimateTokens(content);
+            timing.tokens_estimated = true;
+            return timing;
+        }
+    };
+
+    AsyncGenerator<std::string> timedStream(
+        std::vector<Message> messages,
+        std::vector<std::shared_ptr<Tool>> tools
+    ) {
+        StreamClock clock;
+        auto stream = llm_->streamChatAsync(messages, tools);
+        while (auto chunk = co_await stream.next()) {
+            clock.add(*chunk);
+            co_yield std::move(*chunk);
+        }
+        notify(clock.finish(messages));
+    }
+
+    void complete(LLMResponse& response, CallTiming timing, std::chrono::steady_clock::time_point started) {
+        timing.total_ms = millis(std::chrono::steady_clock::now() - started);
+        CallTiming usage = CallTiming::fromUsage(response.usage_metrics);
+        timing.input_tokens = usage.input_tokens;
+        timing.output_tokens = usage.output_tokens;
+        timing.cached_tokens = usage.cached_tokens;
+        timing.tokens_estimated = usage.tokens_estimated;
+        timing.writeTo(response.usage_metrics);
+        notify(timing);
+    }
+
+    void notify(const CallTiming& timing) {
+        if (observer_) observer_(llm_->getModel(), timing);
+    }
+
+    template <typename Call>
+    LLMResponse measure(Call&& call) {
+        const auto started = std::chrono::steady_clock::now();
+        LLMResponse response = call();
+        complete(response, CallTiming(), started);
+        return response;
+    }
+/*! @endcond */
+};
+
+/**
+ * @brief Tool decorator that records call counts and latency
+ *
+ * Maintains `agents_tool_calls_total{tool, outcome}` and the
+ * `agents_tool_duration_seconds{tool}` histogram.
+ */
+class MeteredTool : public Tool {
+public:
+    /**
+     * @brief Constructor
+     * @param tool The tool to measure
+     * @param registry The registry to record into
+     * @throws std::invalid_argument if tool is null
+     */
+    explicit MeteredTool(std::shared_ptr<Tool> tool, MetricsRegistry& registry = MetricsRegistry::global())
+        : Tool(tool ? tool->getName() : std::string(), tool ? tool->getDescription() : std::string()),
+          tool_(std::move(tool)),
+          duration_(registry.histogram("agents_tool_duration_seconds", "Tool execution latency", {{"tool", name_}})),
+          succeeded_(registry.counter("agents_tool_calls_total", "Tool calls by outcome", {{"tool", name_}, {"outcome", "ok"}})),
+          failed_(registry.counter("agents_tool_calls_total", "Tool calls by outcome", {{"tool", name_}, {"outcome", "error"}})) {
+        if (!tool_) {
+            throw std::invalid_argument("MeteredTool requires a tool");
+        }
+        for (const auto& [name, parameter] : tool_->getParameters()) {
+            addParameter(parameter);
+        }
+    }
+
+    /**
+     * @brief Execute the wrapped tool and record its latency and outcome
+     * @param params The parameters to execute the tool with
+     * @return The result of the tool execution
+     */
+    ToolResult execute(const JsonObject& params) const override {
+        const auto started = std::chrono::steady_clock::now();
+        try {
+            ToolResult result = tool_->execute(params);
+            duration_.observe(std::chrono::steady_clock::now() - started);
+            (result.success ? succeeded_ : failed_).inc();
+            return result;
+        } catch (...) {
+            duration_.observe(std::chrono::steady_clock::now() - started);
+            failed_.inc();
+            throw;
+        }
+    }
+
+/*! @cond PRIVATE */
+private:
+    std::shared_ptr<Tool> tool_;
+    Histogram& duration_;
+    Counter& succeeded_;
+    Counter& failed_;
+/*! @endcond */
+};
+
+/**
+ * @brief Run an agent inside an `agent.run` span
+ *
+ * LLM calls and tools the agent makes through a TracingLLM and TracedTools
+ * on its context become children of the span when they run on the
+ * coroutine's thread. The agent must outlive the task.
+ *
+ * @param agent The agent
+ * @param task The task for the agent
+ * @return Task yielding the agent's result
+ */
+inline Task<JsonObject> tracedRun(Agent& agent, std::string task) {
+    Span span("agent.run");
+    span.setAttribute("agent.task.length", task.size());
+    try {
+        JsonObject result = co_await agent.run(task);
+        if (result.is_object() && result.contains("error")) {
+            span.setError(result["error"].is_string() ? result["error"].get<std::string>() : result["error"].dump());
+        }
+        co_return result;
+    } catch (const std::exception& e) {
+        span.setError(e.what());
+        throw;
+    }
+}
+
+} // namespace agents
@@ -0,0 +1,166 @@
+/**
+ * @file json_log_formatter.h
+ * @brief JSON-lines formatter for structured logging
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025 Edge AI, LLC. All rights reserved.
+ *
+ */
+#pragma once
+
+#include <agents-cpp/types.h>
+#include <spdlog/details/os.h>
+#include <spdlog/formatter.h>
+
+#include <chrono>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+namespace agents {
+
+/**
+ * @brief spdlog formatter that writes each record as one JSON object per line
+ *
+ * Every line carries `ts` (UTC, millisecond precision), `level`, `logger`,
+ * `thread` and `msg`, followed by the structured fields registered for the
+ * record's logger name, such as `session_id`, `agent_id` and `run_id`.
+ * Fields are looked up by logger name rather than by thread, so they stay
+ * correct when records are formatted on spdlog's async worker threads.
+ * Fields registered under the empty name apply to every logger. A record
+ * can also carry its own fields in its logger name, as written by
+ * taggedName(); those replace the lookup.
+ */
+class JsonLogFormatter : public spdlog::formatter {
+public:
+    /**
+     * @brief Set the structured fields for a logger
+     * @param logger_name The logger name (empty for fields shared by all loggers)
+     * @param fields JSON object of fields; an empty object removes them
+     */
+    static void setFields(const std::string& logger_name, const JsonObject& fields) {
+        std::string fragment = fieldFragment(fields);
+        FieldTable& table = fieldTable();
+        std::unique_lock<std::shared_mutex> lock(table.mutex);
+        if (fragment.empty()) {
+            table.fragments.erase(logger_name);
+        } else {
+            table.fragments[logger_name] = std::move(fragment);
+        }
+    }
+
+    /**
+     * @brief Logger name that carries its own fields, for records that should not register any
+     * @param logger_name The logger name written on the record
+     * @param fields JSON object of fields
+     * @return The name followed by the serialized fields
+     */
+    static std::string taggedName(const std::string& logger_name, const JsonObject& fields) {
+        return logger_name + kFieldSeparator + fieldFragment(fields);
+    }
+
+    /**
+     * @brief Format a record as a JSON line
+     * @param msg The record
+     * @param dest Buffer receiving the line
+     */
+    void format(const spdlog::details::log_msg& msg, spdlog::memory_buf_t& dest) override {
+        auto time = std::chrono::system_clock::to_time_t(msg.time);
+        auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(msg.time.time_since_epoch()).count() % 1000;
+        std::tm tm = spdlog::details::os::gmtime(time);
+        fmt::format_to(std::back_inserter(dest), R"({{"ts":"{:04}-{:02}-{:02}T{:02}:{:02}:{:02}.{:03}Z","level":")",
+            tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec, millis);
+        auto level = spdlog::level::to_string_view(msg.level);
+        dest.append(level.data(), level.data() + level.size());
+        std::string_view logger_name(msg.logger_name.data(), msg.logger_name.size());
+        std::string_view own_fields;
+        size_t separator = logger_name.find(kFieldSeparator);
+        if (separator != std::string_view::npos) {
+            own_fields = logger_name.substr(separator + 1);
+            logger_name = logger_name.substr(0, separator);
+        }
+        dest.append(std::string_view(R"(","logger":")"));
+        appendEscaped(dest, logger_name);
+        fmt::format_to(std::back_inserter(dest), R"(","thread":{},"msg":")", msg.thread_id);
+        appendEscaped(dest, std::string_view(msg.payload.data(), msg.payload.size()));
+        dest.push_back('"');
+        {
+            FieldTable& table = fieldTable();
+            std::shared_lock<std::shared_mutex> lock(table.mutex);
+            if (!table.fragments.empty()) {
+                auto shared = table.fragments.find(std::string());
+                if (shared != table.fragments.end()) dest.append(std::string_view(shared->second));
+                if (separator == std::string_view::npos && !logger_name.empty()) {
+                    auto own = table.fragments.find(std::string(logger_name));
+                    if (own != table.fragments.end()) dest.append(std::string_view(own->second));
+                }
+            }
+        }
+        dest.append(own_fields);
+        dest.append(std::string_view("}\n"));
+    }
+
+    /**
+     * @brief Clone the formatter
+     * @return A new formatter (fields are process-wide, so nothing is copied)
+     */
+    std::unique_ptr<spdlog::formatter> clone() const override {
+        return std::make_unique<JsonLogFormatter>();
+    }
+
+/*! @cond PRIVATE */
+private:
+    // Separates a tagged logger name from its fields; never part of a real name
+    static constexpr char kFieldSeparator = '\x1f';
+
+    struct FieldTable {
+        std::shared_mutex mutex;
+        std::unordered_map<std::string, std::string> fragments;
+    };
+
+    static FieldTable& fieldTable() {
+        static FieldTable table;
+        return table;
+    }
+
+    // `,"key":value` for each field
+    static std::string fieldFragment(const JsonObject& fields) {
+        std::string fragment;
+        if (fields.is_object()) {
+            for (const auto& [key, value] : fields.items()) {
+                fragment += ",";
+                fragment += JsonObject(key).dump();
+                fragment += ":";
+                fragment += value.dump();
+            }
+        }
+        return fragment;
+    }
+
+    static void appendEscaped(spdlog::memory_buf_t& dest, std::string_view text) {
+        static const char* hex = "0123456789abcdef";
+        for (char c : text) {
+            switch (c) {
+                case '"': dest.append(std::string_view("\\\"")); break;
+                case '\\': dest.append(std::string_view("\\\\")); break;
+                case '\n': dest.append(std::string_view("\\n")); break;
+                case '\r': dest.append(std::string_view("\\r")); break;
+                case '\t': dest.append(std::string_view("\\t")); break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        char escaped[] = {'\\', 'u', '0', '0', hex[(c >> 4) & 0xf], hex[c & 0xf]};
+                        dest.append(escaped, escaped + sizeof(escaped));
+                    } else {
+                        dest.push_back(c);
+                    }
+            }
+        }
+    }
+/*! @endcond */
+};
+
+} // namespace agents
@@ -9,14 +9,137 @@
  */
 #pragma once
 
+#include <agents-cpp/json_log_formatter.h>
 #include <spdlog/fmt/fmt.h>
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <string>
+#include <thread>
+#include <vector>
+#include <spdlog/async.h>
 #include <spdlog/spdlog.h>
+#include <spdlog/sinks/rotating_file_sink.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief Lowest level compiled into the AGENTS_LOG_* macros
+ *
+ * Numbering follows Logger::Level (0 = TRACE ... 6 = OFF). Macro calls below
+ * it are removed by the preprocessor, arguments included. Defaults to TRACE,
+ * so nothing is compiled out unless asked for. The Logger methods, and the
+ * library's own logging, are not affected.
+ */
+#ifndef AGENTS_LOG_ACTIVE_LEVEL
+#define AGENTS_LOG_ACTIVE_LEVEL 0
+#endif
 
 namespace agents {
 
+/**
+ * @brief Log argument computed only when the record is actually formatted
+ * @tparam F Callable returning a formattable value
+ */
+template <typename F>
+struct LazyLogArg {
+    /**
+     * @brief The callable
+     */
+    F fn;
+};
+
+/*! @cond PRIVATE */
+namespace detail {
+
+// Last sink of the async logger; counts the records its workers have written
+class WrittenCountSink : public spdlog::sinks::sink {
+public:
+    void log(const spdlog::details::log_msg&) override {
+        written.fetch_add(1, std::memory_order_release);
+    }
+    void flush() override {}
+    void set_pattern(const std::string&) override {}
+    void set_formatter(std::unique_ptr<spdlog::formatter>) override {}
+
+    std::atomic<uint64_t> written{0};
+};
+
+// Default logger installed by Logger::initAsync(). spdlog's async_logger is
+// final, so this front end takes each record on the calling thread, renames
+// it after the thread's Logger::FieldScope (with JSON output, the name also
+// carries the scope's fields), posts it to the async logger's thread pool
+// and counts it, so that flush() can wait for the queue to drain. Nothing is
+// registered per scope, so short-lived scopes leave no state behind.
+class FieldRoutingLogger : public spdlog::logger {
+public:
+    struct Backend {
+        std::shared_ptr<spdlog::async_logger> logger;
+        std::shared_ptr<WrittenCountSink> written;
+        std::weak_ptr<spdlog::details::thread_pool> pool;
+        spdlog::async_overflow_policy policy = spdlog::async_overflow_policy::block;
+        bool json = false;
+        std::atomic<uint64_t> enqueued{0};
+    };
+
+    // The innermost FieldScope on a thread; `tag` is the name with the fields
+    struct Scope {
+        std::string name;
+        std::string tag;
+    };
+
+    FieldRoutingLogger(std::string name, std::shared_ptr<Backend> backend, bool scoped)
+        : spdlog::logger(std::move(name), backend->logger->sinks().begin(), backend->logger->sinks().end()),
+          backend_(std::move(backend)), scoped_(scoped) {}
+
+    static Scope& threadScope() {
+        thread_local Scope scope;
+        return scope;
+    }
+
+    std::shared_ptr<spdlog::logger> clone(std::string new_name) override {
+        auto cloned = std::make_shared<FieldRoutingLogger>(std::move(new_name), backend_, false);
+        cloned->set_level(level());
+        return cloned;
+    }
+
+protected:
+    void sink_it_(const spdlog::details::log_msg& msg) override {
+        spdlog::details::log_msg routed = msg;
+        if (scoped_) {
+            const Scope& scope = threadScope();
+            if (!scope.name.empty()) routed.logger_name = backend_->json ? scope.tag : scope.name;
+        }
+        auto pool = backend_->pool.lock();
+        if (!pool) {
+            err_handler_("async log: thread pool doesn't exist anymore");
+            return;
+        }
+        backend_->enqueued.fetch_add(1, std::memory_order_relaxed);
+        // The queued message copies the payload and the name, so the scope may end before it is written
+        pool->post_log(std::shared_ptr<spdlog::async_logger>(backend_->logger), routed, backend_->policy);
+    }
+
+    // Waits until every record counted so far is written or dropped, then flushes the sinks
+    void flush_() override {
+        const uint64_t target = backend_->enqueued.load(std::memory_order_relaxed);
+        if (auto pool = backend_->pool.lock()) {
+            while (backend_->written->written.load(std::memory_order_acquire) + pool->overrun_counter() + pool->discard_counter() < target) {
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+        }
+        for (auto& sink : backend_->logger->sinks()) sink->flush();
+    }
+
+private:
+    std::shared_ptr<Backend> backend_;
+    bool scoped_;
+};
+
+} // namespace detail
+/*! @endcond */
+
 /**
  * @brief Logger utility class that wraps spdlog functionality
  */
@@ -56,12 +179,204 @@ public:
         OFF
     };
 
+    /**
+     * @brief What async logging does when its queue is full
+     */
+    enum class OverflowPolicy {
+        /**
+         * @brief Wait for room in the queue
+         */
+        BLOCK,
+        /**
+         * @brief Replace the oldest queued record
+         */
+        OVERRUN_OLDEST,
+        /**
+         * @brief Drop the new record
+         */
+        DISCARD_NEW
+    };
+
+    /**
+     * @brief Settings for initAsync()
+     */
+    struct AsyncOptions {
+        /**
+         * @brief The log level
+         */
+        Level level = Level::INFO;
+        /**
+         * @brief Records the queue holds before the overflow policy applies
+         */
+        size_t queue_size = 8192;
+        /**
+         * @brief Worker threads that format and write records
+         */
+        size_t threads = 1;
+        /**
+         * @brief Behaviour when the queue is full
+         */
+        OverflowPolicy overflow = OverflowPolicy::BLOCK;
+        /**
+         * @brief Write to stdout
+         */
+        bool console = true;
+        /**
+         * @brief Write JSON lines (see JsonLogFormatter) instead of plain text
+         */
+        bool json = false;
+        /**
+         * @brief Also write to this rotating file when non-empty
+         */
+        std::string file_path;
+        /**
+         * @brief Size at which the file rotates, in bytes
+         */
+        size_t max_file_size = 10 * 1024 * 1024;
+        /**
+         * @brief Rotated files to keep
+         */
+        size_t max_files = 3;
+        /**
+         * @brief Structured fields for every record, e.g. `session_id`
+         */
+        JsonObject fields = JsonObject::object();
+    };
+
     /**
      * @brief Initialize the logger
      * @param level The log level
      */
     static void init(Level level = Level::INFO);
 
+    /**
+     * @brief Structured fields for every record logged on this thread
+     *
+     * While the scope is alive, records logged on the constructing thread
+     * through the default logger, including the SDK's own Logger::* calls,
+     * are written under the scope's name and carry its fields (JSON output,
+     * async mode only). The fields travel with each record and nothing is
+     * registered, so a scope per run or per request costs nothing once it
+     * ends. Scopes nest; a coroutine resumed on another thread needs its
+     * own scope there.
+     * @code
+     * Logger::FieldScope scope("run-42", JsonObject{{"agent_id", "planner"}, {"run_id", 42}});
+     * agent.run(task);
+     * @endcode
+     */
+    class FieldScope {
+    public:
+        /**
+         * @brief Start tagging this thread's records
+         * @param name The logger name written on the records, e.g. a run id
+         * @param fields Fields such as `agent_id` and `run_id`
+         */
+        FieldScope(std::string name, const JsonObject& fields)
+            : previous_(std::move(detail::FieldRoutingLogger::threadScope())) {
+            detail::FieldRoutingLogger::Scope& scope = detail::FieldRoutingLogger::threadScope();
+            scope.tag = JsonLogFormatter::taggedName(name, fields);
+            scope.name = std::move(name);
+        }
+
+        /**
+         * @brief Restore the enclosing scope
+         */
+        ~FieldScope() {
+            detail::FieldRoutingLogger::threadScope() = std::move(previous_);
+        }
+
+        FieldScope(const FieldScope&) = delete;
+        FieldScope& operator=(const FieldScope&) = delete;
+
+    private:
+        detail::FieldRoutingLogger::Scope previous_;
+    };
+
+    /**
+     * @brief Initialize the logger in asynchronous mode
+     *
+     * Log calls only enqueue the record; formatting and writing happen on
+     * spdlog's thread pool, so the calling agent is not slowed by its sinks.
+     * The async logger replaces the default logger used by the Logger
+     * methods. Errors are flushed as soon as they are written.
+     *
+     * @param options Queue, overflow, sink and structured field settings
+     */
+    static void initAsync(const AsyncOptions& options) {
+        spdlog::async_overflow_policy policy = spdlog::async_overflow_policy::block;
+        if (options.overflow == OverflowPolicy::OVERRUN_OLDEST) policy = spdlog::async_overflow_policy::overrun_oldest;
+        if (options.overflow == OverflowPolicy::DISCARD_NEW) policy = spdlog::async_overflow_policy::discard_new;
+
+        std::vector<spdlog::sink_ptr> sinks;
+        if (options.console) {
+            sinks.push_back(std::make_shared<spdlog::sinks::stdout_color_sink_mt>());
+        }
+        if (!options.file_path.empty()) {
+            sinks.push_back(std::make_shared<spdlog::sinks::rotating_file_sink_mt>(
+                options.file_path, options.max_file_size, options.max_files));
+        }
+        if (options.json) {
+            for (auto& sink : sinks) sink->set_formatter(std::make_unique<JsonLogFormatter>());
+        }
+        JsonLogFormatter::setFields("", options.fields);
+
+        auto pool = std::make_shared<spdlog::details::thread_pool>(
+            std::max<size_t>(options.queue_size, 1), std::max<size_t>(options.threads, 1));
+        auto backend = std::make_shared<detail::FieldRoutingLogger::Backend>();
+        backend->written = std::make_shared<detail::WrittenCountSink>();
+        sinks.push_back(backend->written);
+        backend->pool = pool;
+        backend->policy = policy;
+        backend->json = options.json;
+        // Levels are checked by the front end; the worker side writes whatever reaches it
+        backend->logger = std::make_shared<spdlog::async_logger>("agents", sinks.begin(), sinks.end(), pool, policy);
+        backend->logger->set_level(spdlog::level::trace);
+        backend->logger->flush_on(spdlog::level::err);
+        auto logger = std::make_shared<detail::FieldRoutingLogger>("agents", backend, true);
+        logger->set_level(toSpdlogLevel(options.level));
+        if (auto previous = spdlog::default_logger()) previous->flush();
+        spdlog::set_default_logger(logger);
+        // The registry owns the pool; a previous pool drains its queue as it is released
+        spdlog::details::registry::instance().set_tp(std::move(pool));
+    }
+
+    /**
+     * @brief Logger that tags its records with its own structured fields
+     *
+     * Returns a copy of the default logger under a new name, sharing its
+     * sinks and (in async mode) its queue. With JSON output its records
+     * carry the given fields in addition to the shared ones, so concurrent
+     * agents or runs can be told apart. Only records logged through the
+     * returned logger are tagged; use FieldScope to tag the SDK's own
+     * records as well.
+     *
+     * @param name The logger name, e.g. an agent id
+     * @param fields Fields such as `agent_id` and `run_id`
+     * @return The logger
+     */
+    static std::shared_ptr<spdlog::logger> structuredLogger(const std::string& name, const JsonObject& fields) {
+        JsonLogFormatter::setFields(name, fields);
+        return spdlog::default_logger()->clone(name);
+    }
+
+    /**
+     * @brief Replace the structured fields written on every record
+     * @param fields Fields such as `session_id`
+     */
+    static void setStructuredFields(const JsonObject& fields) {
+        JsonLogFormatter::setFields("", fields);
+    }
+
+    /**
+     * @brief Flush the default logger's sinks
+     *
+     * In async mode this first waits until every record logged before the
+     * call has been written or dropped by the overflow policy.
+     */
+    static void flush() {
+        if (auto logger = spdlog::default_logger()) logger->flush();
+    }
+
     /**
      * @brief Set the log level
      * @param level The log level
@@ -75,6 +390,36 @@ public:
      */
     static spdlog::level::level_enum toSpdlogLevel(Level level);
 
+    /**
+     * @brief Whether a record at the level would be emitted
+     *
+     * One comparison against the default logger's level.
+     *
+     * @param level The log level
+     * @return true if the level is enabled
+     */
+    static bool shouldLog(Level level) {
+        // Level and spdlog::level::level_enum share their numbering
+        return spdlog::default_logger_raw()->should_log(static_cast<spdlog::level::level_enum>(level));
+    }
+
+    /**
+     * @brief Wrap an expensive log argument so it is only computed when logged
+     *
+     * The callable runs while the record is formatted on the calling thread,
+     * so it may capture by reference:
+     * @code
+     * AGENTS_LOG_DEBUG("Result: {}", Logger::lazy([&] { return result.dump(2); }));
+     * @endcode
+     *
+     * @param fn Callable returning a formattable value
+     * @return The lazy argument
+     */
+    template <typename F>
+    static LazyLogArg<std::decay_t<F>> lazy(F&& fn) {
+        return LazyLogArg<std::decay_t<F>>{std::forward<F>(fn)};
+    }
+
     /**
      * @brief Log a message at trace level
      * @param fmt The format string
@@ -139,4 +484,87 @@ private:
     static std::shared_ptr<spdlog::logger> s_logger;
 };
 
-} // namespace agents
\ No newline at end of file
+} // namespace agents
+
+/**
+ * @brief Formats a LazyLogArg by formatting the value its callable returns
+ * @tparam F The callable type
+ * @tparam Char The character type
+ */
+template <typename F, typename Char>
+struct fmt::formatter<agents::LazyLogArg<F>, Char>
+    : fmt::formatter<std::decay_t<std::invoke_result_t<const F&>>, Char> {
+    /**
+     * @brief Format the lazily computed value
+     * @param arg The lazy argument
+     * @param ctx The format context
+     * @return The output iterator
+     */
+    template <typename FormatContext>
+    auto format(const agents::LazyLogArg<F>& arg, FormatContext& ctx) const {
+        return fmt::formatter<std::decay_t<std::invoke_result_t<const F&>>, Char>::format(arg.fn(), ctx);
+    }
+};
+
+/*! @cond PRIVATE */
+#define AGENTS_LOG_AT_(level, method, ...) \
+    do { \
+        if (::agents::Logger::shouldLog(::agents::Logger::Level::level)) { \
+            ::agents::Logger::method(__VA_ARGS__); \
+        } \
+    } while (0)
+/*! @endcond */
+
+/**
+ * @brief Log at trace level; arguments are only evaluated when the level is enabled
+ */
+#if AGENTS_LOG_ACTIVE_LEVEL <= 0
+#define AGENTS_LOG_TRACE(...) AGENTS_LOG_AT_(TRACE, trace, __VA_ARGS__)
+#else
+#define AGENTS_LOG_TRACE(...) do {} while (0)
+#endif
+
+/**
+ * @brief Log at debug level; arguments are only evaluated when the level is enabled
+ */
+#if AGENTS_LOG_ACTIVE_LEVEL <= 1
+#define AGENTS_LOG_DEBUG(...) AGENTS_LOG_AT_(DEBUG, debug, __VA_ARGS__)
+#else
+#define AGENTS_LOG_DEBUG(...) do {} while (0)
+#endif
+
+/**
+ * @brief Log at info level; arguments are only evaluated when the level is enabled
+ */
+#if AGENTS_LOG_ACTIVE_LEVEL <= 2
+#define AGENTS_LOG_INFO(...) AGENTS_LOG_AT_(INFO, info, __VA_ARGS__)
+#else
+#define AGENTS_LOG_INFO(...) do {} while (0)
+#endif
+
+/**
+ * @brief Log at warn level; arguments are only evaluated when the level is enabled
+ */
+#if AGENTS_LOG_ACTIVE_LEVEL <= 3
+#define AGENTS_LOG_WARN(...) AGENTS_LOG_AT_(WARN, warn, __VA_ARGS__)
+#else
+#define AGENTS_LOG_WARN(...) do {} while (0)
+#endif
+
+/**
+ * @brief Log at error level; arguments are only evaluated when the level is enabled
+ */
+#if AGENTS_LOG_ACTIVE_LEVEL <= 4
+#define AGENTS_LOG_ERROR(...) AGENTS_LOG_AT_(ERR, error, __VA_ARGS__)
+#else
+#define AGENTS_LOG_ERROR(...) do {} while (0)
+#endif
+
+/**
+ * @brief Log at critical level; arguments are only evaluated when the level is enabled
+ */
+#if AGENTS_LOG_ACTIVE_LEVEL <= 5
+#define AGENTS_LOG_CRITICAL(...) AGENTS_LOG_AT_(CRITICAL, critical, __VA_ARGS__)
+#else
+#define AGENTS_LOG_CRITICAL(...) do {} while (0)
+#endif
@@ -0,0 +1,625 @@
+/**
+ * @file memo_store.h
+ * @brief Memoization of workflow step outputs
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025 Edge AI, LLC. All rights reserved.
+ *
+ */
+#pragma once
+
+#include <agents-cpp/llm_interface.h>
+#include <agents-cpp/metrics.h>
+#include <agents-cpp/utils.h>
+
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace agents {
+
+/**
+ * @brief Store of LLM responses for memoized workflow steps
+ *
+ * Keys are built with makeKey() from the workflow id, the step name, a hash
+ * of the rendered messages (every field, including names and tool calls),
+ * the model and a hash of the generation options, so a step is served from
+ * the store only when everything that determines its output is unchanged.
+ */
+class MemoStore {
+public:
+    virtual ~MemoStore() = default;
+
+    /**
+     * @brief Look up a stored response
+     * @param key The key
+     * @return The response, or std::nullopt on a miss
+     */
+    virtual std::optional<LLMResponse> get(const std::string& key) = 0;
+
+    /**
+     * @brief Store a response
+     * @param key The key
+     * @param response The response
+     */
+    virtual void put(const std::string& key, const LLMResponse& response) = 0;
+
+    /**
+     * @brief Remove every stored response
+     */
+    virtual void clear() = 0;
+
+    /**
+     * @brief Build the key for a step's LLM call
+     * @param workflow_id Identifies the workflow (stable across runs)
+     * @param step The step name
+     * @param messages The rendered messages
+     * @param model The model name
+     * @param options The generation options
+     * @param tools Names of the tools offered to the model, if any
+     * @return The key
+     */
+    static std::string makeKey(
+        const std::string& workflow_id,
+        const std::string& step,
+        const std::vector<Message>& messages,
+        const std::string& model,
+        const LLMOptions& options,
+        const std::vector<std::string>& tools = {}
+    ) {
+        JsonObject prompt = JsonObject::array();
+        for (const auto& message : messages) {
+            JsonObject entry{{"role", static_cast<int>(message.role)}, {"content", message.content}};
+            // Optional fields are only added when set, so plain messages keep their keys
+            if (message.name) {
+                entry["name"] = *message.name;
+            }
+            if (message.tool_call_id) {
+                entry["tool_call_id"] = *message.tool_call_id;
+            }
+            if (!message.tool_calls.empty()) {
+                JsonObject calls = JsonObject::array();
+                for (const auto& [name, params] : message.tool_calls) {
+                    calls.push_back(JsonObject{{"name", name}, {"parameters", params}});
+                }
+                entry["tool_calls"] = std::move(calls);
+            }
+            prompt.push_back(std::move(entry));
+        }
+        JsonObject generation{
+            {"temperature", options.temperature},
+            {"max_tokens", options.max_tokens},
+            {"top_p", options.top_p},
+            {"presence_penalty", options.presence_penalty},
+            {"frequency_penalty", options.frequency_penalty},
+            {"stop", options.stop_sequences},
+            {"schema", options.response_schema.value_or(JsonObject())},
+            {"mime", options.response_mime_type.value_or("")},
+            {"tools", tools}
+        };
+        return Utils::hashHex(workflow_id + '\0' + step + '\0' + Utils::hashHex(prompt.dump()) + '\0' +
+            model + '\0' + Utils::hashHex(generation.dump()));
+    }
+
+    /**
+     * @brief Serialize a response
+     * @param response The response
+     * @return JSON with `content`, `tool_calls` and `usage_metrics`
+     */
+    static JsonObject toJson(const LLMResponse& response) {
+        JsonObject tool_calls = JsonObject::array();
+        for (const auto& [name, params] : response.tool_calls) {
+            tool_calls.push_back(JsonObject{{"name", name}, {"parameters", params}});
+        }
+        return JsonObject{
+            {"content", response.content},
+            {"tool_calls", tool_calls},
+            {"usage_metrics", response.usage_metrics}
+        };
+    }
+
+    /**
+     * @brief Deserialize a response written by toJson()
+     * @param json The JSON
+     * @return The response
+     */
+    static LLMResponse fromJson(const JsonObject& json) {
+        LLMResponse response;
+        response.content = json.value("content", "");
+        if (json.contains("tool_calls") && json["tool_calls"].is_array()) {
+            for (const auto& call : json["tool_calls"]) {
+                response.tool_calls.emplace_back(call.value("name", ""), call.value("parameters", JsonObject::object()));
+            }
+        }
+        if (json.contains("usage_metrics") && json["usage_metrics"].is_object()) {
+            response.usage_metrics = json["usage_metrics"].get<std::map<std::string, double>>();
+        }
+        return response;
+    }
+};
+
+/**
+ * @brief Memo store held in process memory
+ */
+class InMemoryMemoStore : public MemoStore {
+public:
+    /**
+     * @brief Look up a stored response
+     * @param key The key
+     * @return The response, or std::nullopt on a miss
+     */
+    std::optional<LLMResponse> get(const std::string& key) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(key);
+        if (it == entries_.end()) return std::nullopt;
+        return it->second;
+    }
+
+    /**
+     * @brief Store a response
+     * @param key The key
+     * @param response The response
+     */
+    void put(const std::string& key, const LLMResponse& response) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        entries_[key] = response;
+    }
+
+    /**
+     * @brief Remove every stored response
+     */
+    void clear() override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        entries_.clear();
+    }
+
+    /**
+     * @brief Number of stored responses
+     * @return The number of entries
+     */
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return entries_.size();
+    }
+
+/*! @cond PRIVATE */
+private:
+    std::unordered_map<std::string, LLMResponse> entries_;
+    mutable std::mutex mutex_;
+/*! @endcond */
+};
+
+/**
+ * @brief Memo store persisted as one JSON file per entry in a directory
+ *
+ * Entries survive restarts, so a workflow re-run in a new process only
+ * recomputes the steps whose inputs changed. Files are written to a
+ * temporary name, flushed to disk and renamed into place, so a crash
+ * never leaves a truncated entry behind.
+ */
+class FileMemoStore : public MemoStore {
+public:
+    /**
+     * @brief Constructor
+     * @param directory Directory for the entries (created if missing)
+     */
+    explicit FileMemoStore(std::filesystem::path directory) : directory_(std::move(directory)) {
+        std::filesystem::create_directories(directory_);
+    }
+
+    /**
+     * @brief Look up a stored response
+     * @param key The key
+     * @return The response, or std::nullopt on a miss or an unreadable entry
+     */
+    std::optional<LLMResponse> get(const std::string& key) override {
+        std::ifstream file(path(key));
+        if (!file) return std::nullopt;
+        JsonObject json = JsonObject::parse(file, nullptr, false);
+        if (json.is_discarded() || !json.is_object()) return std::nullopt;
+        return fromJson(json);
+    }
+
+    /**
+     * @brief Store a response
+     * @param key The key
+     * @param response The response
+     * @throws std::runtime_error if the entry cannot be written
+     */
+    void put(const std::string& key, const LLMResponse& response) override {
+        std::filesystem::path target = path(key);
+        std::filesystem::path temporary = target;
+        temporary += ".tmp" + std::to_string(counter_.fetch_add(1));
+        const std::string data = toJson(response).dump();
+        std::FILE* file = std::fopen(temporary.string().c_str(), "wb");
+        if (!file) {
+            throw std::runtime_error("Failed to write memo entry: " + temporary.string());
+        }
+        bool written = std::fwrite(data.data(), 1, data.size(), file) == data.size() &&
+                       std::fflush(file) == 0 && syncFile(file);
+        written = std::fclose(file) == 0 && written;
+        if (!written) {
+            std::error_code ignored;
+            std::filesystem::remove(temporary, ignored);
+            throw std::runtime_error("Failed to write memo entry: " + temporary.string());
+        }
+        std::filesystem::rename(temporary, target);
+        syncDirectory();
+    }
+
+    /**
+     * @brief Remove every stored response, including temporaries left by interrupted writes
+     */
+    void clear() override {
+        for (const auto& entry : std::filesystem::directory_iterator(directory_)) {
+            const std::string extension = entry.path().extension().string();
+            if (extension == ".json" || extension.rfind(".tmp", 0) == 0) std::filesystem::remove(entry.path());
+        }
+    }
+
+/*! @cond PRIVATE */
+private:
+    std::filesystem::path directory_;
+    std::atomic<uint64_t> counter_{0};
+
+    std::filesystem::path path(const std::string& key) const {
+        // Keys from makeKey() are hex; hash anything else into a safe file name
+        bool safe = !key.empty() && key.find_first_not_of("0123456789abcdefABCDEF") == std::string::npos;
+        return directory_ / ((safe ? key : Utils::hashHex(key)) + ".json");
+    }
+
+    static bool syncFile(std::FILE* file) {
+#ifdef _WIN32
+        return _commit(_fileno(file)) == 0;
+#else
+        return fsync(fileno(file)) == 0;
+#endif
+    }
+
+    // Makes the rename itself durable; best effort, as not every filesystem supports it
+    void syncDirectory() const {
+#ifndef _WIN32
+        int fd = ::open(directory_.c_str(), O_RDONLY);
+        if (fd >= 0) {
+            fsync(fd);
+            ::close(fd);
+        }
+#endif
+    }
+/*! @endcond */
+};
+
+/**
+ * @brief Opt-in memoization settings for a workflow run
+ */
+struct Memoization {
+    /**
+     * @brief The store (memoization is off when null)
+     */
+    std::shared_ptr<MemoStore> store;
+
+    /**
+     * @brief Identifies the workflow across runs; part of every key
+     */
+    std::string workflow_id;
+};
+
+/**
+ * @brief LLM decorator that serves repeated step calls from a MemoStore
+ *
+ * A workflow wraps its LLM once per step, via forStep(); all decorators made
+ * from the same instance share their hit and miss counts.
+ */
+class MemoizingLLM : public LLMInterface {
+public:
+    /**
+     * @brief Hit and miss counts shared by the decorators of one run
+     */
+    struct Stats {
+        /**
+         * @brief Calls served from the store
+         */
+        std::atomic<size_t> hits{0};
+        /**
+         * @brief Calls sent to the model
+         */
+        std::atomic<size_t> misses{0};
+    };
+
+    /**
+     * @brief Constructor
+     * @param llm The wrapped LLM
+     * @param memo The store and workflow id
+     * @param step The step name for keys
+     * @param stats Shared counts (created when null)
+     */
+    MemoizingLLM(std::shared_ptr<LLMInterface> llm, Memoization memo, std::string step = "", std::shared_ptr<Stats> stats = nullptr)
+        : llm_(std::move(llm)), memo_(std::move(memo)), step_(std::move(step)),
+          stats_(stats ? std::move(stats) : std::make_shared<Stats>()) {
+        if (!llm_ || !memo_.store) {
+            throw std::invalid_argument("MemoizingLLM requires an LLM and a store");
+        }
+    }
+
+    /**
+     * @brief Decorator for another step that shares this one's store and counts
+     * @param step The step name
+     * @return The decorator
+     */
+    std::shared_ptr<MemoizingLLM> forStep(const std::string& step) const {
+        return std::make_shared<MemoizingLLM>(llm_, memo_, step, stats_);
+    }
+
+    /**
+     * @brief The counts shared with decorators made by forStep()
+     * @return The shared counts
+     */
+    std::shared_ptr<Stats> sharedStats() const { return stats_; }
+
+    /**
+     * @brief Calls served from the store so far
+     * @return The hit count
+     */
+    size_t hits() const { return stats_->hits; }
+
+    /**
+     * @brief Calls sent to the model so far
+     * @return The miss count
+     */
+    size_t misses() const { return stats_->misses; }
+
+    /**
+     * @brief Hit and miss counts as JSON
+     * @return `hits`, `misses` and `hit_rate`
+     */
+    JsonObject statsToJson() const {
+        size_t hits = this->hits(), misses = this->misses();
+        return JsonObject{
+            {"hits", hits},
+            {"misses", misses},
+            {"hit_rate", hits + misses > 0 ? static_cast<double>(hits) / static_cast<double>(hits + misses) : 0.0}
+        };
+    }
+
+    /**
+     * @brief Get available models
+     * @return The available models
+     */
+    std::vector<std::string> getAvailableModels() override { return llm_->getAvailableModels(); }
+
+    /**
+     * @brief Set the model
+     * @param model The model to use
+     */
+    void setModel(const std::string& model) override { llm_->setModel(model); }
+
+    /**
+     * @brief Get the model
+     * @return The current model
+     */
+    std::string getModel() const override { return llm_->getModel(); }
+
+    /**
+     * @brief Set API key
+     * @param api_key The API key to use
+     */
+    void setApiKey(const std::string& api_key) override { llm_->setApiKey(api_key); }
+
+    /**
+     * @brief Set API base URL
+     * @param api_base The API base URL to use
+     */
+    void setApiBase(const std::string& api_base) override { llm_->setApiBase(api_base); }
+
+    /**
+     * @brief Set options
+     * @param options The options to use
+     */
+    void setOptions(const LLMOptions& options) override { llm_->setOptions(options); }
+
+    /**
+     * @brief Get options
+     * @return The current options
+     */
+    LLMOptions getOptions() const override { return llm_->getOptions(); }
+
+    /**
+     * @brief Generate completion from a prompt
+     * @param prompt The prompt
+     * @return The completion
+     */
+    LLMResponse chat(const std::string& prompt) override {
+        return chat(std::vector<Message>{Message{Message::Role::USER, prompt}});
+    }
+
+    /**
+     * @brief Generate completion from a list of messages, or serve it from the store
+     * @param messages The messages to generate completion from
+     * @return The LLM response
+     */
+    LLMResponse chat(const std::vector<Message>& messages) override {
+        return memoized(messages, {}, [&]() { return llm_->chat(messages); });
+    }
+
+    /**
+     * @brief Async chat from a list of messages, or serve it from the store
+     * @param messages The messages to generate completion from
+     * @return The LLM response
+     */
+    Task<LLMResponse> chatAsync(const std::vector<Message>& messages) override {
+        std::string key = keyFor(messages, {});
+        if (auto stored = lookup(key)) {
+            co_return *stored;
+        }
+        LLMResponse response = co_await llm_->chatAsync(messages);
+        memo_.store->put(key, response);
+        co_return response;
+    }
+
+    /**
+     * @brief Generate completion with available tools, or serve it from the store
+     * @param messages The messages to generate completion from
+     * @param tools The tools to use
+     * @return The LLM response
+     */
+    LLMResponse chatWithTools(
+        const std::vector<Message>& messages,
+        const std::vector<std::shared_ptr<Tool>>& tools
+    ) override {
+        return memoized(messages, toolNames(tools), [&]() { return llm_->chatWithTools(messages, tools); });
+    }
+
+    /**
+     * @brief Async chat with tools, or serve it from the store
+     * @param messages The messages to generate completion from
+     * @param tools The tools to use
+     * @return The LLM response
+     */
+    Task<LLMResponse> chatWithToolsAsync(
+        const std::vector<Message>& messages,
+        const std::vector<std::shared_ptr<Tool>>& tools
+    ) override {
+        std::string key = keyFor(messages, toolNames(tools));
+        if (auto stored = lookup(key)) {
+            co_return *stored;
+        }
+        LLMResponse response = co_await llm_->chatWithToolsAsync(messages, tools);
+        memo_.store->put(key, response);
+        co_return response;
+    }
+
+    /**
+     * @brief Stream results with callback; a stored response arrives as one chunk
+     * @param messages The messages to generate completion from
+     * @param callback The callback to use
+     */
+    void streamChat(
+        const std::vector<Message>& messages,
+        std::function<void(const std::string&, bool)> callback
+    ) override {
+        std::string key = MemoStore::makeKey(memo_.workflow_id, step_, messages, llm_->getModel(), llm_->getOptions());
+        if (auto stored = memo_.store->get(key)) {
+            countLookup(true);
+            callback(stored->content, true);
+            return;
+        }
+        countLookup(false);
+        LLMResponse buffered;
+        llm_->streamChat(messages, [&buffered, &callback](const std::string& chunk, bool done) {
+            buffered.content += chunk;
+            callback(chunk, done);
+        });
+        memo_.store->put(key, buffered);
+    }
+
+    /**
+     * @brief Stream results as an AsyncGenerator; a stored response arrives as one chunk
+     * @note The response is stored only once the stream has been consumed to the end.
+     * @param messages The messages to generate completion from
+     * @param tools The tools to use
+     * @return The AsyncGenerator of response chunks
+     */
+    AsyncGenerator<std::string> streamChatAsync(
+        const std::vector<Message>& messages,
+        const std::vector<std::shared_ptr<Tool>>& tools
+    ) override {
+        return memoizedStream(keyFor(messages, toolNames(tools)), messages, tools);
+    }
+
+    /**
+     * @brief Upload a media file
+     * @param local_path Local filesystem path
+     * @param mime The MIME type of the media file
+     * @param binary Optional binary content of the media file
+     * @return Optional envelope; std::nullopt if unsupported
+     */
+    std::optional<JsonObject> uploadMediaFile(const std::string& local_path, const std::string& mime, const std::string& binary = "") override {
+        return llm_->uploadMediaFile(local_path, mime, binary);
+    }
+
+/*! @cond PRIVATE */
+private:
+    std::shared_ptr<LLMInterface> llm_;
+    Memoization memo_;
+    std::string step_;
+    std::shared_ptr<Stats> stats_;
+
+    // Per-instance stats plus the process-wide agents_cache_requests_total counter
+    void countLookup(bool hit) {
+        static Counter& hits = MetricsRegistry::global().counter(
+            "agents_cache_requests_total", "Cache lookups by cache and result", {{"cache", "memo"}, {"result", "hit"}});
+        static Counter& misses = MetricsRegistry::global().counter(
+            "agents_cache_requests_total", "Cache lookups by cache and result", {{"cache", "memo"}, {"result", "miss"}});
+        if (hit) {
+            stats_->hits++;
+            hits.inc();
+        } else {
+            stats_->misses++;
+            misses.inc();
+        }
+    }
+
+    static std::vector<std::string> toolNames(const std::vector<std::shared_ptr<Tool>>& tools) {
+        std::vector<std::string> names;
+        for (const auto& tool : tools) names.push_back(tool->getName());
+        return names;
+    }
+
+    std::string keyFor(const std::vector<Message>& messages, const std::vector<std::string>& tools) const {
+        return MemoStore::makeKey(memo_.workflow_id, step_, messages, llm_->getModel(), llm_->getOptions(), tools);
+    }
+
+    std::optional<LLMResponse> lookup(const std::string& key) {
+        std::optional<LLMResponse> stored = memo_.store->get(key);
+        countLookup(stored.has_value());
+        return stored;
+    }
+
+    template <typename Call>
+    LLMResponse memoized(const std::vector<Message>& messages, const std::vector<std::string>& tools, Call&& call) {
+        std::string key = keyFor(messages, tools);
+        if (auto stored = lookup(key)) {
+            return *stored;
+        }
+        LLMResponse response = call();
+        memo_.store->put(key, response);
+        return response;
+    }
+
+    AsyncGenerator<std::string> memoizedStream(
+        std::string key,
+        std::vector<Message> messages,
+        std::vector<std::shared_ptr<Tool>> tools
+    ) {
+        if (auto stored = lookup(key)) {
+            co_yield std::move(stored->content);
+            co_return;
+        }
+        LLMResponse buffered;
+        auto stream = llm_->streamChatAsync(messages, tools);
+        while (auto chunk = co_await stream.next()) {
+            buffered.content += *chunk;
+            co_yield std::move(*chunk);
+        }
+        memo_.store->put(key, buffered);
+    }
+/*! @endcond */
+};
+
+} // namespace agents
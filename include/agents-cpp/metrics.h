@@ -0,0 +1,591 @@
+/**
+ * @file metrics.h
+ * @brief Low-overhead counters, gauges and HDR histograms with Prometheus text exposition
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025 Edge AI, LLC. All rights reserved.
+ *
+ */
+#pragma once
+
+#include <agents-cpp/coroutine_utils.h>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace agents {
+
+/**
+ * @brief Label set identifying one series of a metric
+ */
+using MetricLabels = std::map<std::string, std::string>;
+
+/*! @cond PRIVATE */
+namespace detail {
+/**
+ * @brief Number of shards per sharded metric: the CPU count rounded up to a power of two
+ */
+inline size_t metricShardCount() {
+    static const size_t count = std::bit_ceil(std::clamp<size_t>(std::thread::hardware_concurrency(), 1, 256));
+    return count;
+}
+
+/**
+ * @brief Shard for the calling thread: its current CPU where available
+ */
+inline size_t metricShard() noexcept {
+#if defined(__linux__)
+    int cpu = sched_getcpu();
+    if (cpu >= 0) return static_cast<size_t>(cpu);
+#endif
+    static std::atomic<size_t> next{0};
+    thread_local size_t index = next.fetch_add(1, std::memory_order_relaxed);
+    return index;
+}
+} // namespace detail
+/*! @endcond */
+
+/**
+ * @brief Monotonic counter sharded per CPU
+ *
+ * Increments touch only the calling CPU's cache line, so counters hit from
+ * many threads do not contend; value() sums the shards.
+ */
+class Counter {
+public:
+    /**
+     * @brief Constructor
+     */
+    Counter() : mask_(detail::metricShardCount() - 1), cells_(new Cell[mask_ + 1]) {}
+
+    /**
+     * @brief Add to the counter
+     * @param n The amount to add
+     */
+    void inc(uint64_t n = 1) noexcept {
+        cells_[detail::metricShard() & mask_].value.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Current value
+     * @return The sum over all shards
+     */
+    uint64_t value() const noexcept {
+        uint64_t total = 0;
+        for (size_t i = 0; i <= mask_; ++i) total += cells_[i].value.load(std::memory_order_relaxed);
+        return total;
+    }
+
+/*! @cond PRIVATE */
+private:
+    struct alignas(64) Cell {
+        std::atomic<uint64_t> value{0};
+    };
+    size_t mask_;
+    std::unique_ptr<Cell[]> cells_;
+/*! @endcond */
+};
+
+/**
+ * @brief Value that can go up and down, such as a queue depth
+ */
+class Gauge {
+public:
+    /**
+     * @brief Set the value
+     * @param value The value
+     */
+    void set(double value) noexcept { value_.store(value, std::memory_order_relaxed); }
+
+    /**
+     * @brief Add to the value
+     * @param delta The amount to add (negative to subtract)
+     */
+    void add(double delta) noexcept { value_.fetch_add(delta, std::memory_order_relaxed); }
+
+    /**
+     * @brief Current value
+     * @return The value
+     */
+    double value() const noexcept { return value_.load(std::memory_order_relaxed); }
+
+/*! @cond PRIVATE */
+private:
+    std::atomic<double> value_{0.0};
+/*! @endcond */
+};
+
+/**
+ * @brief Histogram settings
+ */
+struct HistogramOptions {
+    /**
+     * @brief Resolution of the histogram in the metric's base unit
+     *
+     * Observations are stored as whole multiples of it; 1e-6 records
+     * seconds with microsecond resolution, 1 records token counts exactly.
+     */
+    double unit = 1e-6;
+    /**
+     * @brief Upper bounds of the cumulative `le` buckets in the Prometheus output
+     */
+    std::vector<double> buckets{0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1, 2.5, 5, 10, 30, 60, 120};
+};
+
+/**
+ * @brief High dynamic range histogram sharded per CPU
+ *
+ * Values are counted in log-linear buckets: exact below 128 units, then 64
+ * buckets per power of two, so any recorded value and any percentile is
+ * within 1.6% of the true value across the whole range (up to 2^40 units).
+ * A shard's bucket array is allocated the first time its CPU records a
+ * value, so memory grows with the concurrency actually seen.
+ */
+class Histogram {
+public:
+    /**
+     * @brief Values are clamped below 2^kMaxBits units
+     */
+    static constexpr size_t kMaxBits = 40;
+
+    /**
+     * @brief Number of buckets per shard
+     */
+    static constexpr size_t kBuckets = 128 + (kMaxBits - 7) * 64;
+
+    /**
+     * @brief Constructor
+     * @param options The histogram settings
+     * @throws std::invalid_argument if the unit is not positive
+     */
+    explicit Histogram(HistogramOptions options = HistogramOptions())
+        : options_(std::move(options)), mask_(detail::metricShardCount() - 1),
+          shards_(new std::atomic<Shard*>[mask_ + 1]) {
+        if (!(options_.unit > 0)) {
+            throw std::invalid_argument("Histogram unit must be positive");
+        }
+        std::sort(options_.buckets.begin(), options_.buckets.end());
+        for (size_t i = 0; i <= mask_; ++i) shards_[i].store(nullptr, std::memory_order_relaxed);
+    }
+
+    ~Histogram() {
+        for (size_t i = 0; i <= mask_; ++i) delete shards_[i].load(std::memory_order_relaxed);
+    }
+
+    Histogram(const Histogram&) = delete;
+    Histogram& operator=(const Histogram&) = delete;
+
+    /**
+     * @brief Record an observation
+     * @param value The value in the base unit (negative values count as 0)
+     */
+    void observe(double value) noexcept {
+        double units = value / options_.unit;
+        uint64_t v = units <= 0 ? 0 : units >= kMaxValue ? kMaxValue : static_cast<uint64_t>(units + 0.5);
+        Shard& shard = localShard();
+        shard.counts[bucketIndex(v)].fetch_add(1, std::memory_order_relaxed);
+        shard.sum.fetch_add(v, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Record a duration, for histograms in seconds
+     * @param duration The duration
+     */
+    template <typename Rep, typename Period>
+    void observe(std::chrono::duration<Rep, Period> duration) noexcept {
+        observe(std::chrono::duration<double>(duration).count());
+    }
+
+    /**
+     * @brief Merged counts and sum at this moment
+     */
+    struct Snapshot {
+        /**
+         * @brief Count per bucket
+         */
+        std::vector<uint64_t> counts;
+        /**
+         * @brief Total number of observations
+         */
+        uint64_t count = 0;
+        /**
+         * @brief Sum of observations in the base unit
+         */
+        double sum = 0.0;
+    };
+
+    /**
+     * @brief Merge the shards
+     * @return The snapshot
+     */
+    Snapshot snapshot() const {
+        Snapshot snapshot;
+        snapshot.counts.assign(kBuckets, 0);
+        uint64_t sum = 0;
+        for (size_t s = 0; s <= mask_; ++s) {
+            const Shard* shard = shards_[s].load(std::memory_order_acquire);
+            if (!shard) continue;
+            for (size_t i = 0; i < kBuckets; ++i) {
+                uint64_t n = shard->counts[i].load(std::memory_order_relaxed);
+                snapshot.counts[i] += n;
+                snapshot.count += n;
+            }
+            sum += shard->sum.load(std::memory_order_relaxed);
+        }
+        snapshot.sum = static_cast<double>(sum) * options_.unit;
+        return snapshot;
+    }
+
+    /**
+     * @brief Value at a percentile
+     * @param percentile Percentile in [0, 100]
+     * @return The value in the base unit, or 0 when empty
+     */
+    double percentile(double percentile) const {
+        Snapshot snapshot = this->snapshot();
+        if (snapshot.count == 0) return 0.0;
+        uint64_t rank = static_cast<uint64_t>(std::ceil(std::clamp(percentile, 0.0, 100.0) / 100.0 * static_cast<double>(snapshot.count)));
+        rank = std::max<uint64_t>(rank, 1);
+        uint64_t seen = 0;
+        for (size_t i = 0; i < kBuckets; ++i) {
+            seen += snapshot.counts[i];
+            if (seen >= rank) return static_cast<double>(bucketMidpoint(i)) * options_.unit;
+        }
+        return static_cast<double>(bucketMidpoint(kBuckets - 1)) * options_.unit;
+    }
+
+    /**
+     * @brief Total number of observations
+     * @return The count
+     */
+    uint64_t count() const { return snapshot().count; }
+
+    /**
+     * @brief The histogram settings
+     * @return The options
+     */
+    const HistogramOptions& options() const { return options_; }
+
+    /**
+     * @brief Lowest value counted in a bucket
+     * @param index The bucket index
+     * @return The value in units
+     */
+    static uint64_t bucketLowest(size_t index) noexcept {
+        if (index < 128) return index;
+        size_t shift = (index - 128) / 64 + 1;
+        return (64 + (index - 128) % 64) << shift;
+    }
+
+/*! @cond PRIVATE */
+private:
+    static constexpr uint64_t kMaxValue = (uint64_t{1} << kMaxBits) - 1;
+
+    struct Shard {
+        std::atomic<uint64_t> counts[kBuckets]{};
+        std::atomic<uint64_t> sum{0};
+    };
+
+    HistogramOptions options_;
+    size_t mask_;
+    std::unique_ptr<std::atomic<Shard*>[]> shards_;
+
+    static size_t bucketIndex(uint64_t v) noexcept {
+        if (v < 128) return static_cast<size_t>(v);
+        size_t shift = static_cast<size_t>(std::bit_width(v)) - 7;
+        return 128 + (shift - 1) * 64 + static_cast<size_t>((v >> shift) - 64);
+    }
+
+    static uint64_t bucketMidpoint(size_t index) noexcept {
+        if (index < 128) return index;
+        size_t shift = (index - 128) / 64 + 1;
+        return bucketLowest(index) + ((uint64_t{1} << shift) >> 1);
+    }
+
+    Shard& localShard() noexcept {
+        std::atomic<Shard*>& slot = shards_[detail::metricShard() & mask_];
+        Shard* shard = slot.load(std::memory_order_acquire);
+        if (shard) return *shard;
+        Shard* fresh = new Shard();
+        if (slot.compare_exchange_strong(shard, fresh, std::memory_order_acq_rel)) return *fresh;
+        delete fresh;
+        return *shard;
+    }
+/*! @endcond */
+};
+
+/**
+ * @brief Named families of counters, gauges and histograms, rendered for Prometheus
+ *
+ * A metric is looked up by name and labels; the first lookup creates it and
+ * later ones return the same object, which stays valid for the registry's
+ * lifetime. Cache the reference on hot paths to skip the lookup.
+ *
+ * @code
+ * auto& latency = MetricsRegistry::global().histogram(
+ *     "agents_llm_request_duration_seconds", "LLM request latency",
+ *     {{"provider", "openai"}, {"model", "gpt-4o"}});
+ * latency.observe(std::chrono::steady_clock::now() - started);
+ * @endcode
+ */
+class MetricsRegistry {
+public:
+    /**
+     * @brief The process-wide registry used by the SDK's own metrics
+     *
+     * Never destroyed, so detached executor threads can update it during exit.
+     * It reports the jobs in flight on Executor and queued on ThreadPool as
+     * the `agents_executor_queue_depth{executor="io|cpu"}` gauge.
+     *
+     * @return The registry
+     */
+    static MetricsRegistry& global() {
+        static MetricsRegistry* registry = []() {
+            auto* created = new MetricsRegistry();
+            created->gaugeCallback("agents_executor_queue_depth", "Jobs queued or running on an executor",
+                {{"executor", "io"}}, []() { return static_cast<double>(Executor::inFlight()); });
+            created->gaugeCallback("agents_executor_queue_depth", "Jobs queued or running on an executor",
+                {{"executor", "cpu"}}, []() { return static_cast<double>(ThreadPool::queued()); });
+            return created;
+        }();
+        return *registry;
+    }
+
+    /**
+     * @brief Get or create a counter
+     * @param name The metric name
+     * @param help The help text (used when the family is created)
+     * @param labels The series labels
+     * @return The counter
+     * @throws std::invalid_argument if the name is registered with another type
+     */
+    Counter& counter(const std::string& name, const std::string& help, const MetricLabels& labels = {}) {
+        return series(name, help, Type::COUNTER, labels, &Family::counters, [](const Family&) { return std::make_unique<Counter>(); });
+    }
+
+    /**
+     * @brief Get or create a gauge
+     * @param name The metric name
+     * @param help The help text (used when the family is created)
+     * @param labels The series labels
+     * @return The gauge
+     * @throws std::invalid_argument if the name is registered with another type
+     */
+    Gauge& gauge(const std::string& name, const std::string& help, const MetricLabels& labels = {}) {
+        return series(name, help, Type::GAUGE, labels, &Family::gauges, [](const Family&) { return std::make_unique<Gauge>(); });
+    }
+
+    /**
+     * @brief Get or create a histogram with default (latency in seconds) settings
+     * @param name The metric name
+     * @param help The help text (used when the family is created)
+     * @param labels The series labels
+     * @return The histogram
+     * @throws std::invalid_argument if the name is registered with another type
+     */
+    Histogram& histogram(const std::string& name, const std::string& help, const MetricLabels& labels = {}) {
+        return histogram(name, help, labels, HistogramOptions());
+    }
+
+    /**
+     * @brief Get or create a histogram
+     * @param name The metric name
+     * @param help The help text (used when the family is created)
+     * @param labels The series labels
+     * @param options Settings used when the family is created; every series of a family shares them
+     * @return The histogram
+     * @throws std::invalid_argument if the name is registered with another type
+     */
+    Histogram& histogram(const std::string& name, const std::string& help, const MetricLabels& labels, const HistogramOptions& options) {
+        return series(name, help, Type::HISTOGRAM, labels, &Family::histograms, [&options](Family& family) {
+            if (!family.histogram_options) {
+                family.histogram_options = std::make_unique<HistogramOptions>(options);
+            }
+            return std::make_unique<Histogram>(*family.histogram_options);
+        });
+    }
+
+    /**
+     * @brief Register a gauge whose value is computed at scrape time
+     * @param name The metric name
+     * @param help The help text
+     * @param labels The series labels
+     * @param read Called on every render; replaces an earlier callback for the same series
+     * @throws std::invalid_argument if the name is registered with another type
+     */
+    void gaugeCallback(const std::string& name, const std::string& help, const MetricLabels& labels, std::function<double()> read) {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        Family& family = familyFor(name, help, Type::GAUGE);
+        family.callbacks[labels] = std::move(read);
+    }
+
+    /**
+     * @brief Render every metric in the Prometheus text exposition format (0.0.4)
+     * @return The exposition text
+     */
+    std::string renderPrometheus() const {
+        std::ostringstream out;
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        for (const auto& [name, family] : families_) {
+            out << "# HELP " << name << ' ' << escape(family.help, false) << '\n';
+            out << "# TYPE " << name << ' ' << typeName(family.type) << '\n';
+            for (const auto& [labels, counter] : family.counters) {
+                out << name << formatLabels(labels) << ' ' << counter->value() << '\n';
+            }
+            for (const auto& [labels, gauge] : family.gauges) {
+                out << name << formatLabels(labels) << ' ' << formatNumber(gauge->value()) << '\n';
+            }
+            for (const auto& [labels, histogram] : family.histograms) {
+                renderHistogram(out, name, labels, *histogram);
+            }
+            for (const auto& [labels, read] : family.callbacks) {
+                out << name << formatLabels(labels) << ' ' << formatNumber(read()) << '\n';
+            }
+        }
+        return out.str();
+    }
+
+/*! @cond PRIVATE */
+private:
+    enum class Type { COUNTER, GAUGE, HISTOGRAM };
+
+    struct Family {
+        Type type = Type::COUNTER;
+        std::string help;
+        std::unique_ptr<HistogramOptions> histogram_options;
+        std::map<MetricLabels, std::unique_ptr<Counter>> counters;
+        std::map<MetricLabels, std::unique_ptr<Gauge>> gauges;
+        std::map<MetricLabels, std::unique_ptr<Histogram>> histograms;
+        std::map<MetricLabels, std::function<double()>> callbacks;
+    };
+
+    mutable std::shared_mutex mutex_;
+    std::map<std::string, Family> families_;
+
+    Family& familyFor(const std::string& name, const std::string& help, Type type) {
+        auto [it, inserted] = families_.try_emplace(name);
+        if (inserted) {
+            it->second.type = type;
+            it->second.help = help;
+        } else if (it->second.type != type) {
+            throw std::invalid_argument("Metric " + name + " is already registered as a " + typeName(it->second.type));
+        }
+        return it->second;
+    }
+
+    template <typename T, typename Make>
+    T& series(const std::string& name, const std::string& help, Type type, const MetricLabels& labels,
+              std::map<MetricLabels, std::unique_ptr<T>> Family::*map, Make&& make) {
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            auto family = families_.find(name);
+            if (family != families_.end() && family->second.type == type) {
+                auto it = (family->second.*map).find(labels);
+                if (it != (family->second.*map).end()) return *it->second;
+            }
+        }
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        Family& family = familyFor(name, help, type);
+        auto& slot = (family.*map)[labels];
+        if (!slot) slot = make(family);
+        return *slot;
+    }
+
+    static const char* typeName(Type type) {
+        switch (type) {
+            case Type::COUNTER: return "counter";
+            case Type::GAUGE: return "gauge";
+            case Type::HISTOGRAM: return "histogram";
+        }
+        return "untyped";
+    }
+
+    static std::string escape(const std::string& text, bool quote) {
+        std::string escaped;
+        escaped.reserve(text.size());
+        for (char c : text) {
+            if (c == '\\') escaped += "\\\\";
+            else if (c == '\n') escaped += "\\n";
+            else if (quote && c == '"') escaped += "\\\"";
+            else escaped += c;
+        }
+        return escaped;
+    }
+
+    static std::string formatLabels(const MetricLabels& labels, const std::string& extra_key = "", const std::string& extra_value = "") {
+        if (labels.empty() && extra_key.empty()) return "";
+        std::string text = "{";
+        bool first = true;
+        auto append = [&](const std::string& key, const std::string& value) {
+            if (!first) text += ',';
+            first = false;
+            text += key + "=\"" + escape(value, true) + '"';
+        };
+        for (const auto& [key, value] : labels) append(key, value);
+        if (!extra_key.empty()) append(extra_key, extra_value);
+        return text + "}";
+    }
+
+    static std::string formatNumber(double value) {
+        if (std::isnan(value)) return "NaN";
+        if (std::isinf(value)) return value > 0 ? "+Inf" : "-Inf";
+        char buffer[32];
+        auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        return std::string(buffer, result.ptr);
+    }
+
+    static void renderHistogram(std::ostringstream& out, const std::string& name, const MetricLabels& labels, const Histogram& histogram) {
+        Histogram::Snapshot snapshot = histogram.snapshot();
+        const HistogramOptions& options = histogram.options();
+        // Each HDR bucket is assigned to the first `le` bound at or above its lowest value
+        uint64_t cumulative = 0;
+        size_t index = 0;
+        for (double bound : options.buckets) {
+            while (index < Histogram::kBuckets &&
+                   static_cast<double>(Histogram::bucketLowest(index)) * options.unit <= bound) {
+                cumulative += snapshot.counts[index++];
+            }
+            out << name << "_bucket" << formatLabels(labels, "le", formatNumber(bound)) << ' ' << cumulative << '\n';
+        }
+        out << name << "_bucket" << formatLabels(labels, "le", "+Inf") << ' ' << snapshot.count << '\n';
+        out << name << "_sum" << formatLabels(labels) << ' ' << formatNumber(snapshot.sum) << '\n';
+        out << name << "_count" << formatLabels(labels) << ' ' << snapshot.count << '\n';
+    }
+/*! @endcond */
+};
+
+/**
+ * @brief The `agents_llm_retries_total{model}` counter
+ *
+ * Incremented by every component that sends an LLM request again after it
+ * failed or timed out, such as GraphWorkflow's LLM node retries.
+ *
+ * @param model The model of the retried request
+ * @param registry The registry holding the counter
+ * @return The counter
+ */
+inline Counter& llmRetryCounter(const std::string& model, MetricsRegistry& registry = MetricsRegistry::global()) {
+    return registry.counter("agents_llm_retries_total", "LLM requests sent again after a failure", {{"model", model}});
+}
+
+} // namespace agents
@@ -0,0 +1,109 @@
+/**
+ * @file metrics_server.h
+ * @brief Embedded HTTP endpoint serving metrics in Prometheus format
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025 Edge AI, LLC. All rights reserved.
+ *
+ */
+#pragma once
+
+#include <agents-cpp/metrics.h>
+
+#include <httplib.h>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace agents {
+
+/**
+ * @brief Serves `GET /metrics` for a MetricsRegistry on a background thread
+ *
+ * Each scrape renders the registry on the server thread, so recording
+ * metrics never waits on a scrape beyond the registry's shared lock.
+ *
+ * @code
+ * MetricsServer server;
+ * server.start("0.0.0.0", 9464);
+ * @endcode
+ */
+class MetricsServer {
+public:
+    /**
+     * @brief Constructor
+     * @param registry The registry to serve
+     */
+    explicit MetricsServer(MetricsRegistry& registry = MetricsRegistry::global())
+        : registry_(registry) {}
+
+    /**
+     * @brief Destructor; stops the server
+     */
+    ~MetricsServer() { stop(); }
+
+    MetricsServer(const MetricsServer&) = delete;
+    MetricsServer& operator=(const MetricsServer&) = delete;
+
+    /**
+     * @brief Bind and start serving
+     * @param host The address to bind
+     * @param port The port to bind, or 0 to pick a free one
+     * @return The bound port
+     * @throws std::runtime_error if already running or the address cannot be bound
+     */
+    int start(const std::string& host = "127.0.0.1", int port = 9464) {
+        if (thread_.joinable()) {
+            throw std::runtime_error("MetricsServer is already running");
+        }
+        server_ = std::make_unique<httplib::Server>();
+        server_->Get("/metrics", [this](const httplib::Request&, httplib::Response& res) {
+            res.set_content(registry_.renderPrometheus(), "text/plain; version=0.0.4; charset=utf-8");
+        });
+        int bound = port == 0 ? server_->bind_to_any_port(host) : (server_->bind_to_port(host, port) ? port : -1);
+        if (bound <= 0) {
+            server_.reset();
+            throw std::runtime_error("MetricsServer failed to bind " + host + ":" + std::to_string(port));
+        }
+        port_ = bound;
+        thread_ = std::thread([this]() { server_->listen_after_bind(); });
+        server_->wait_until_ready();
+        return port_;
+    }
+
+    /**
+     * @brief Stop serving and join the server thread
+     */
+    void stop() {
+        if (!thread_.joinable()) return;
+        server_->stop();
+        thread_.join();
+        server_.reset();
+        port_ = 0;
+    }
+
+    /**
+     * @brief Get the bound port
+     * @return The port, or 0 when not running
+     */
+    int port() const { return port_; }
+
+    /**
+     * @brief Check whether the server is running
+     * @return True between start() and stop()
+     */
+    bool running() const { return thread_.joinable(); }
+
+/*! @cond PRIVATE */
+private:
+    MetricsRegistry& registry_;
+    std::unique_ptr<httplib::Server> server_;
+    std::thread thread_;
+    int port_ = 0;
+/*! @endcond */
+};
+
+} // namespace agents
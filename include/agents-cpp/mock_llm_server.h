@@ -0,0 +1,886 @@
+/**
+ * @file mock_llm_server.h
+ * @brief Local mock server speaking the OpenAI, Anthropic, Gemini and Ollama wire formats
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025 Edge AI, LLC. All rights reserved.
+ *
+ */
+#pragma once
+
+#include <agents-cpp/budget_governor.h>
+#include <agents-cpp/types.h>
+
+#include <httplib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace agents {
+
+/**
+ * @brief Offline stand-in for the hosted LLM APIs, for load tests and benchmarks
+ *
+ * Serves the chat endpoints of each provider in its own wire format,
+ * including SSE (OpenAI, Anthropic, Gemini) and NDJSON (Ollama) streaming
+ * and tool calls. Point a provider at it with setApiBase(apiBase(provider)).
+ * Replies come from scripted responses when one matches, otherwise from
+ * Options::default_content. Latency, token rate and error injection are
+ * configurable; all randomness comes from one seeded generator.
+ *
+ * @code
+ * MockLLMServer server;
+ * server.start();
+ * auto llm = createLLM("openai", "test-key");
+ * llm->setApiBase(server.apiBase("openai"));
+ * @endcode
+ */
+class MockLLMServer {
+public:
+    /**
+     * @brief Wire format of a request
+     */
+    enum class Provider {
+        /**
+         * @brief OpenAI chat completions
+         */
+        OPENAI,
+        /**
+         * @brief Anthropic messages
+         */
+        ANTHROPIC,
+        /**
+         * @brief Google Gemini generateContent
+         */
+        GOOGLE,
+        /**
+         * @brief Ollama chat and generate
+         */
+        OLLAMA
+    };
+
+    /**
+     * @brief Latency distribution in milliseconds
+     */
+    struct Latency {
+        /**
+         * @brief Shape of the distribution
+         */
+        enum class Distribution {
+            /**
+             * @brief Always mean_ms
+             */
+            FIXED,
+            /**
+             * @brief Uniform between min_ms and max_ms
+             */
+            UNIFORM,
+            /**
+             * @brief Normal with mean_ms and stddev_ms
+             */
+            NORMAL,
+            /**
+             * @brief Log-normal with mean_ms and stddev_ms, giving a long tail
+             */
+            LOG_NORMAL
+        };
+
+        /**
+         * @brief The distribution
+         */
+        Distribution distribution = Distribution::FIXED;
+        /**
+         * @brief Mean (or fixed value)
+         */
+        double mean_ms = 0.0;
+        /**
+         * @brief Standard deviation
+         */
+        double stddev_ms = 0.0;
+        /**
+         * @brief Lower bound; samples are clamped to it
+         */
+        double min_ms = 0.0;
+        /**
+         * @brief Upper bound for UNIFORM; samples of other shapes are clamped to it when positive
+         */
+        double max_ms = 0.0;
+
+        /**
+         * @brief Draw one sample
+         * @param rng The generator
+         * @return The latency in milliseconds
+         */
+        double sample(std::mt19937_64& rng) const {
+            double value = mean_ms;
+            switch (distribution) {
+                case Distribution::FIXED:
+                    break;
+                case Distribution::UNIFORM:
+                    return std::uniform_real_distribution<double>(min_ms, std::max(min_ms, max_ms))(rng);
+                case Distribution::NORMAL:
+                    if (stddev_ms > 0) value = std::normal_distribution<double>(mean_ms, stddev_ms)(rng);
+                    break;
+                case Distribution::LOG_NORMAL:
+                    if (mean_ms > 0 && stddev_ms > 0) {
+                        double sigma2 = std::log1p((stddev_ms * stddev_ms) / (mean_ms * mean_ms));
+                        double mu = std::log(mean_ms) - sigma2 / 2;
+                        value = std::lognormal_distribution<double>(mu, std::sqrt(sigma2))(rng);
+                    }
+                    break;
+            }
+            value = std::max(value, min_ms);
+            return max_ms > 0 ? std::min(value, max_ms) : value;
+        }
+    };
+
+    /**
+     * @brief Server behavior
+     */
+    struct Options {
+        /**
+         * @brief Delay before the first token (before the whole body when not streaming)
+         */
+        Latency first_token_latency;
+        /**
+         * @brief Generation speed; 0 sends all tokens at once
+         */
+        double tokens_per_second = 0.0;
+        /**
+         * @brief Tokens per streamed chunk
+         */
+        size_t tokens_per_chunk = 1;
+        /**
+         * @brief Fraction of requests answered with HTTP 500
+         */
+        double error_rate = 0.0;
+        /**
+         * @brief Fraction of requests answered with HTTP 429
+         */
+        double rate_limit_rate = 0.0;
+        /**
+         * @brief Retry-After value of 429 replies, in seconds
+         */
+        int retry_after_seconds = 1;
+        /**
+         * @brief Reply content when no script matches
+         */
+        std::string default_content = "This is a mock response from the local test server.";
+        /**
+         * @brief Models reported by the model listing endpoints
+         */
+        std::vector<std::string> models{"mock-model"};
+        /**
+         * @brief Random seed; 0 seeds from std::random_device
+         */
+        uint64_t seed = 0;
+        /**
+         * @brief Threads serving connections; each in-flight request holds one
+         */
+        size_t worker_threads = 64;
+    };
+
+    /**
+     * @brief A canned reply
+     */
+    struct ScriptedResponse {
+        /**
+         * @brief Substring of the last message to match; empty matches any request
+         *
+         * Tool results carry no plain text in most formats, so a script that
+         * answers a prompt with a tool call does not match the follow-up
+         * request that returns the tool result.
+         */
+        std::string match;
+        /**
+         * @brief Reply text
+         */
+        std::string content;
+        /**
+         * @brief Tool calls as (name, arguments) pairs, as in LLMResponse
+         */
+        std::vector<std::pair<std::string, JsonObject>> tool_calls;
+        /**
+         * @brief HTTP status; anything but 200 sends a provider-format error with content as message
+         */
+        int status = 200;
+        /**
+         * @brief Keep the script after it matched instead of consuming it
+         */
+        bool repeat = false;
+    };
+
+    /**
+     * @brief A request after routing
+     */
+    struct Call {
+        /**
+         * @brief Wire format
+         */
+        Provider provider = Provider::OPENAI;
+        /**
+         * @brief Parsed request body
+         */
+        JsonObject body;
+        /**
+         * @brief Model named by the request
+         */
+        std::string model;
+        /**
+         * @brief Whether to stream the reply
+         */
+        bool stream = false;
+        /**
+         * @brief Gemini streaming: SSE (`alt=sse`) rather than a JSON array
+         */
+        bool sse = true;
+        /**
+         * @brief Ollama `/api/generate` rather than `/api/chat`
+         */
+        bool generate = false;
+    };
+
+    /**
+     * @brief A reply ready to be written
+     */
+    struct Reply {
+        /**
+         * @brief HTTP status
+         */
+        int status = 200;
+        /**
+         * @brief Content type
+         */
+        std::string content_type = "application/json";
+        /**
+         * @brief Extra headers
+         */
+        std::map<std::string, std::string> headers;
+        /**
+         * @brief Whether the body is sent as a chunked stream
+         */
+        bool streamed = false;
+        /**
+         * @brief Body pieces, each with the delay in milliseconds before it is sent
+         */
+        std::vector<std::pair<double, std::string>> chunks;
+
+        /**
+         * @brief The body without pacing
+         * @return The concatenated chunks
+         */
+        std::string body() const {
+            std::string text;
+            for (const auto& [delay, chunk] : chunks) text += chunk;
+            return text;
+        }
+    };
+
+    /**
+     * @brief Constructor with default options
+     */
+    MockLLMServer() : MockLLMServer(Options()) {}
+
+    /**
+     * @brief Constructor
+     * @param options Server behavior
+     */
+    explicit MockLLMServer(Options options) : options_(std::move(options)) {
+        rng_.seed(options_.seed ? options_.seed : std::random_device{}());
+    }
+
+    /**
+     * @brief Destructor; stops the server
+     */
+    ~MockLLMServer() { stop(); }
+
+    MockLLMServer(const MockLLMServer&) = delete;
+    MockLLMServer& operator=(const MockLLMServer&) = delete;
+
+    /**
+     * @brief Bind and start serving
+     * @param host The address to bind
+     * @param port The port to bind, or 0 to pick a free one
+     * @return The bound port
+     * @throws std::runtime_error if already running or the address cannot be bound
+     */
+    int start(const std::string& host = "127.0.0.1", int port = 0) {
+        if (thread_.joinable()) {
+            throw std::runtime_error("MockLLMServer is already running");
+        }
+        server_ = std::make_unique<httplib::Server>();
+        size_t workers = std::max<size_t>(1, options().worker_threads);
+        server_->new_task_queue = [workers]() { return new httplib::ThreadPool(workers); };
+        route();
+        int bound = port == 0 ? server_->bind_to_any_port(host) : (server_->bind_to_port(host, port) ? port : -1);
+        if (bound <= 0) {
+            server_.reset();
+            throw std::runtime_error("MockLLMServer failed to bind " + host + ":" + std::to_string(port));
+        }
+        host_ = host;
+        port_ = bound;
+        thread_ = std::thread([this]() { server_->listen_after_bind(); });
+        server_->wait_until_ready();
+        return port_;
+    }
+
+    /**
+     * @brief Stop serving and join the server thread
+     */
+    void stop() {
+        if (!thread_.joinable()) return;
+        server_->stop();
+        thread_.join();
+        server_.reset();
+        port_ = 0;
+    }
+
+    /**
+     * @brief Get the bound port
+     * @return The port, or 0 when not running
+     */
+    int port() const { return port_; }
+
+    /**
+     * @brief API base URL to pass to a provider's setApiBase()
+     * @param provider "openai", "anthropic", "google" or "ollama"
+     * @return The base URL
+     * @throws std::invalid_argument for an unknown provider
+     */
+    std::string apiBase(const std::string& provider) const {
+        std::string root = "http://" + host_ + ":" + std::to_string(port_);
+        if (provider == "openai" || provider == "google") return root + "/v1";
+        if (provider == "anthropic") return root;
+        if (provider == "ollama") return root + "/api";
+        throw std::invalid_argument("Unknown provider: " + provider);
+    }
+
+    /**
+     * @brief Get the current options
+     * @return The options
+     */
+    Options options() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return options_;
+    }
+
+    /**
+     * @brief Replace the options; applies to requests that arrive afterwards
+     *
+     * The worker thread count only takes effect on the next start().
+     *
+     * @param options The options
+     */
+    void setOptions(Options options) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        options_ = std::move(options);
+        if (options_.seed) rng_.seed(options_.seed);
+    }
+
+    /**
+     * @brief Queue a scripted reply; scripts are tried in the order they were added
+     * @param response The reply
+     */
+    void addScript(ScriptedResponse response) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        scripts_.push_back(std::move(response));
+    }
+
+    /**
+     * @brief Remove all scripted replies
+     */
+    void clearScripts() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        scripts_.clear();
+    }
+
+    /**
+     * @brief Number of chat requests received
+     * @return The count
+     */
+    uint64_t requestCount() const { return requests_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Build the reply to a routed request without touching the network
+     *
+     * The HTTP handlers use this; it is public so the wire formats can be
+     * exercised directly.
+     *
+     * @param call The request
+     * @return The reply, with pacing delays
+     */
+    Reply respond(const Call& call) {
+        const uint64_t sequence = requests_.fetch_add(1, std::memory_order_relaxed) + 1;
+        const std::string prompt = lastMessageText(call);
+
+        Options options;
+        ScriptedResponse script;
+        double first_delay = 0.0;
+        double draw = 1.0;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            options = options_;
+            script.content = options_.default_content;
+            for (auto it = scripts_.begin(); it != scripts_.end(); ++it) {
+                if (it->match.empty() || prompt.find(it->match) != std::string::npos) {
+                    script = *it;
+                    if (!it->repeat) scripts_.erase(it);
+                    break;
+                }
+            }
+            first_delay = options_.first_token_latency.sample(rng_);
+            draw = std::uniform_real_distribution<double>(0.0, 1.0)(rng_);
+        }
+
+        if (script.status == 200 && draw < options.rate_limit_rate) {
+            script.status = 429;
+            script.content = "Rate limit exceeded (injected)";
+        } else if (script.status == 200 && draw < options.rate_limit_rate + options.error_rate) {
+            script.status = 500;
+            script.content = "Internal server error (injected)";
+        }
+        if (script.status != 200) {
+            Reply reply = errorReply(call.provider, script.status, script.content);
+            if (script.status == 429) {
+                reply.headers["Retry-After"] = std::to_string(options.retry_after_seconds);
+            }
+            return reply;
+        }
+
+        Generation generation;
+        generation.model = call.model.empty() ? options.models.front() : call.model;
+        generation.pieces = split(script.content, std::max<size_t>(1, options.tokens_per_chunk));
+        generation.tool_calls = std::move(script.tool_calls);
+        generation.input_tokens = BudgetGovernor::estimateTokens(call.body.dump());
+        generation.output_tokens = static_cast<int64_t>(tokenCount(script.content));
+        for (const auto& [name, arguments] : generation.tool_calls) {
+            generation.output_tokens += BudgetGovernor::estimateTokens(name + arguments.dump());
+        }
+        generation.id = std::to_string(sequence);
+        const double per_token_ms = options.tokens_per_second > 0 ? 1000.0 / options.tokens_per_second : 0.0;
+        generation.chunk_interval_ms = per_token_ms * static_cast<double>(std::max<size_t>(1, options.tokens_per_chunk));
+
+        Reply reply;
+        reply.streamed = call.stream;
+        if (!call.stream) {
+            // The whole body arrives once generation would have finished
+            reply.chunks.emplace_back(first_delay + per_token_ms * static_cast<double>(generation.output_tokens),
+                                      nonStreamedBody(call, generation).dump());
+            return reply;
+        }
+        reply.content_type = call.provider == Provider::OLLAMA ? "application/x-ndjson"
+                           : (call.provider == Provider::GOOGLE && !call.sse) ? "application/json"
+                           : "text/event-stream";
+        generation.first_delay_ms = first_delay;
+        streamedBody(call, generation, reply);
+        return reply;
+    }
+
+/*! @cond PRIVATE */
+private:
+    struct Generation {
+        std::string id;
+        std::string model;
+        std::vector<std::string> pieces;
+        std::vector<std::pair<std::string, JsonObject>> tool_calls;
+        int64_t input_tokens = 0;
+        int64_t output_tokens = 0;
+        double first_delay_ms = 0.0;
+        double chunk_interval_ms = 0.0;
+    };
+
+    mutable std::mutex mutex_;
+    Options options_;
+    std::deque<ScriptedResponse> scripts_;
+    std::mt19937_64 rng_;
+    std::atomic<uint64_t> requests_{0};
+    std::unique_ptr<httplib::Server> server_;
+    std::thread thread_;
+    std::string host_ = "127.0.0.1";
+    int port_ = 0;
+
+    void route() {
+        server_->Post("/v1/chat/completions", [this](const httplib::Request& req, httplib::Response& res) {
+            serve(Provider::OPENAI, req, res, [](Call& call) {
+                call.model = call.body.value("model", "");
+                call.stream = call.body.value("stream", false);
+            });
+        });
+        server_->Post("/v1/messages", [this](const httplib::Request& req, httplib::Response& res) {
+            serve(Provider::ANTHROPIC, req, res, [](Call& call) {
+                call.model = call.body.value("model", "");
+                call.stream = call.body.value("stream", false);
+            });
+        });
+        server_->Post(R"(/(v1|v1beta)/models/([^/:]+):(generateContent|streamGenerateContent))",
+                      [this](const httplib::Request& req, httplib::Response& res) {
+            serve(Provider::GOOGLE, req, res, [&req](Call& call) {
+                call.model = req.matches[2];
+                call.stream = req.matches[3] == "streamGenerateContent";
+                call.sse = req.get_param_value("alt") == "sse";
+            });
+        });
+        server_->Post("/api/chat", [this](const httplib::Request& req, httplib::Response& res) {
+            serve(Provider::OLLAMA, req, res, [](Call& call) {
+                call.model = call.body.value("model", "");
+                call.stream = call.body.value("stream", true);
+            });
+        });
+        server_->Post("/api/generate", [this](const httplib::Request& req, httplib::Response& res) {
+            serve(Provider::OLLAMA, req, res, [](Call& call) {
+                call.model = call.body.value("model", "");
+                call.stream = call.body.value("stream", true);
+                call.generate = true;
+            });
+        });
+        // OpenAI and Gemini share the path; answer with both list shapes
+        server_->Get("/v1/models", [this](const httplib::Request&, httplib::Response& res) {
+            JsonObject list = {{"object", "list"}, {"data", JsonObject::array()}, {"models", JsonObject::array()}};
+            for (const auto& model : options().models) {
+                list["data"].push_back({{"id", model}, {"object", "model"}, {"owned_by", "mock"}});
+                list["models"].push_back({{"name", "models/" + model}, {"displayName", model}});
+            }
+            res.set_content(list.dump(), "application/json");
+        });
+        server_->Get("/api/tags", [this](const httplib::Request&, httplib::Response& res) {
+            JsonObject tags = {{"models", JsonObject::array()}};
+            for (const auto& model : options().models) {
+                tags["models"].push_back({{"name", model}, {"model", model}});
+            }
+            res.set_content(tags.dump(), "application/json");
+        });
+    }
+
+    template <typename Parse>
+    void serve(Provider provider, const httplib::Request& req, httplib::Response& res, Parse&& parse) {
+        Call call;
+        call.provider = provider;
+        Reply reply;
+        try {
+            call.body = JsonObject::parse(req.body);
+            parse(call);
+            reply = respond(call);
+        } catch (const std::exception& e) {
+            reply = errorReply(provider, 400, std::string("Invalid request: ") + e.what());
+        }
+        res.status = reply.status;
+        for (const auto& [name, value] : reply.headers) {
+            res.set_header(name, value);
+        }
+        if (!reply.streamed) {
+            for (const auto& [delay, chunk] : reply.chunks) pause(delay);
+            res.set_content(reply.body(), reply.content_type);
+            return;
+        }
+        auto chunks = std::make_shared<std::vector<std::pair<double, std::string>>>(std::move(reply.chunks));
+        res.set_chunked_content_provider(reply.content_type, [chunks](size_t, httplib::DataSink& sink) {
+            for (const auto& [delay, chunk] : *chunks) {
+                pause(delay);
+                if (!sink.write(chunk.data(), chunk.size())) return false;
+            }
+            sink.done();
+            return true;
+        });
+    }
+
+    static void pause(double milliseconds) {
+        if (milliseconds > 0) {
+            std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(milliseconds));
+        }
+    }
+
+    // Text of a message content in any of the providers' shapes
+    static std::string textOf(const JsonObject& content) {
+        if (content.is_string()) return content.get<std::string>();
+        std::string text;
+        if (content.is_array()) {
+            for (const auto& part : content) {
+                if (part.is_object() && part.contains("text") && part["text"].is_string()) {
+                    text += part["text"].get<std::string>();
+                }
+            }
+        }
+        return text;
+    }
+
+    static std::string lastMessageText(const Call& call) {
+        const JsonObject& body = call.body;
+        if (call.generate) return body.value("prompt", "");
+        const char* key = call.provider == Provider::GOOGLE ? "contents" : "messages";
+        if (!body.contains(key) || !body[key].is_array() || body[key].empty()) return "";
+        const JsonObject& last = body[key].back();
+        if (!last.is_object()) return "";
+        if (call.provider == Provider::GOOGLE) return last.contains("parts") ? textOf(last["parts"]) : "";
+        if (last.value("role", "") == "tool") return "";
+        return last.contains("content") ? textOf(last["content"]) : "";
+    }
+
+    // A token is a word with its trailing whitespace
+    static std::vector<std::string> tokens(const std::string& text) {
+        std::vector<std::string> out;
+        size_t start = 0;
+        while (start < text.size()) {
+            size_t end = text.find_first_of(" \n\t", start);
+            end = end == std::string::npos ? text.size() : text.find_first_not_of(" \n\t", end);
+            if (end == std::string::npos) end = text.size();
+            out.push_back(text.substr(start, end - start));
+            start = end;
+        }
+        return out;
+    }
+
+    static size_t tokenCount(const std::string& text) { return tokens(text).size(); }
+
+    static std::vector<std::string> split(const std::string& text, size_t tokens_per_chunk) {
+        std::vector<std::string> pieces;
+        std::vector<std::string> words = tokens(text);
+        for (size_t i = 0; i < words.size(); i += tokens_per_chunk) {
+            std::string piece;
+            for (size_t j = i; j < std::min(words.size(), i + tokens_per_chunk); ++j) piece += words[j];
+            pieces.push_back(std::move(piece));
+        }
+        return pieces;
+    }
+
+    static std::string joined(const Generation& generation) {
+        std::string text;
+        for (const auto& piece : generation.pieces) text += piece;
+        return text;
+    }
+
+    static int64_t nowSeconds() {
+        return std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    static Reply errorReply(Provider provider, int status, const std::string& message) {
+        Reply reply;
+        reply.status = status;
+        JsonObject body;
+        switch (provider) {
+            case Provider::OPENAI:
+                body = {{"error", {{"message", message},
+                                   {"type", status == 429 ? "rate_limit_exceeded" : status < 500 ? "invalid_request_error" : "server_error"},
+                                   {"code", nullptr}}}};
+                break;
+            case Provider::ANTHROPIC:
+                body = {{"type", "error"},
+                        {"error", {{"type", status == 429 ? "rate_limit_error" : status < 500 ? "invalid_request_error" : "api_error"},
+                                   {"message", message}}}};
+                break;
+            case Provider::GOOGLE:
+                body = {{"error", {{"code", status}, {"message", message},
+                                   {"status", status == 429 ? "RESOURCE_EXHAUSTED" : status < 500 ? "INVALID_ARGUMENT" : "INTERNAL"}}}};
+                break;
+            case Provider::OLLAMA:
+                body = {{"error", message}};
+                break;
+        }
+        reply.chunks.emplace_back(0.0, body.dump());
+        return reply;
+    }
+
+    static JsonObject nonStreamedBody(const Call& call, const Generation& generation) {
+        const std::string content = joined(generation);
+        const bool tools = !generation.tool_calls.empty();
+        switch (call.provider) {
+            case Provider::OPENAI: {
+                JsonObject message = {{"role", "assistant"}, {"content", content.empty() && tools ? JsonObject() : JsonObject(content)}};
+                for (size_t i = 0; i < generation.tool_calls.size(); ++i) {
+                    const auto& [name, arguments] = generation.tool_calls[i];
+                    message["tool_calls"].push_back({{"id", "call_" + generation.id + "_" + std::to_string(i)}, {"type", "function"},
+                                                     {"function", {{"name", name}, {"arguments", arguments.dump()}}}});
+                }
+                return {{"id", "chatcmpl-mock-" + generation.id}, {"object", "chat.completion"}, {"created", nowSeconds()},
+                        {"model", generation.model},
+                        {"choices", {{{"index", 0}, {"message", message}, {"finish_reason", tools ? "tool_calls" : "stop"}}}},
+                        {"usage", {{"prompt_tokens", generation.input_tokens}, {"completion_tokens", generation.output_tokens},
+                                   {"total_tokens", generation.input_tokens + generation.output_tokens}}}};
+            }
+            case Provider::ANTHROPIC: {
+                JsonObject blocks = JsonObject::array();
+                if (!content.empty()) blocks.push_back({{"type", "text"}, {"text", content}});
+                for (size_t i = 0; i < generation.tool_calls.size(); ++i) {
+                    const auto& [name, arguments] = generation.tool_calls[i];
+                    blocks.push_back({{"type", "tool_use"}, {"id", "toolu_" + generation.id + "_" + std::to_string(i)},
+                                      {"name", name}, {"input", arguments}});
+                }
+                return {{"id", "msg_mock_" + generation.id}, {"type", "message"}, {"role", "assistant"}, {"model", generation.model},
+                        {"content", blocks}, {"stop_reason", tools ? "tool_use" : "end_turn"}, {"stop_sequence", nullptr},
+                        {"usage", {{"input_tokens", generation.input_tokens}, {"output_tokens", generation.output_tokens}}}};
+            }
+            case Provider::GOOGLE: {
+                JsonObject parts = JsonObject::array();
+                if (!content.empty()) parts.push_back({{"text", content}});
+                for (const auto& [name, arguments] : generation.tool_calls) {
+                    parts.push_back({{"functionCall", {{"name", name}, {"args", arguments}}}});
+                }
+                return geminiChunk(generation, parts, true);
+            }
+            case Provider::OLLAMA: {
+                JsonObject final_chunk = ollamaChunk(call, generation, content, true);
+                for (const auto& [name, arguments] : generation.tool_calls) {
+                    final_chunk["message"]["tool_calls"].push_back({{"function", {{"name", name}, {"arguments", arguments}}}});
+                }
+                return final_chunk;
+            }
+        }
+        return JsonObject();
+    }
+
+    static JsonObject geminiChunk(const Generation& generation, const JsonObject& parts, bool last) {
+        JsonObject candidate = {{"content", {{"parts", parts}, {"role", "model"}}}, {"index", 0}};
+        JsonObject chunk = {{"candidates", {candidate}}, {"modelVersion", generation.model}};
+        if (last) {
+            chunk["candidates"][0]["finishReason"] = "STOP";
+            chunk["usageMetadata"] = {{"promptTokenCount", generation.input_tokens},
+                                      {"candidatesTokenCount", generation.output_tokens},
+                                      {"totalTokenCount", generation.input_tokens + generation.output_tokens}};
+        }
+        return chunk;
+    }
+
+    static JsonObject ollamaChunk(const Call& call, const Generation& generation, const std::string& text, bool done) {
+        JsonObject chunk = {{"model", generation.model}, {"created_at", "1970-01-01T00:00:00Z"}, {"done", done}};
+        if (call.generate) {
+            chunk["response"] = text;
+        } else {
+            chunk["message"] = {{"role", "assistant"}, {"content", text}};
+        }
+        if (done) {
+            chunk["done_reason"] = "stop";
+            chunk["prompt_eval_count"] = generation.input_tokens;
+            chunk["eval_count"] = generation.output_tokens;
+        }
+        return chunk;
+    }
+
+    static void streamedBody(const Call& call, const Generation& generation, Reply& reply) {
+        auto sse = [&reply](double delay, const JsonObject& data, const std::string& event = "") {
+            reply.chunks.emplace_back(delay, (event.empty() ? "" : "event: " + event + "\n") + "data: " + data.dump() + "\n\n");
+        };
+        // Headers and preamble go out at once; the first content piece waits for
+        // the latency and each later one for a chunk interval
+        double pending = generation.first_delay_ms;
+        auto step = [&pending, &generation]() {
+            double delay = pending;
+            pending = generation.chunk_interval_ms;
+            return delay;
+        };
+        const bool tools = !generation.tool_calls.empty();
+        switch (call.provider) {
+            case Provider::OPENAI: {
+                const std::string id = "chatcmpl-mock-" + generation.id;
+                auto chunk = [&](const JsonObject& delta, const JsonObject& finish) {
+                    return JsonObject{{"id", id}, {"object", "chat.completion.chunk"}, {"created", nowSeconds()},
+                                      {"model", generation.model},
+                                      {"choices", {{{"index", 0}, {"delta", delta}, {"finish_reason", finish}}}}};
+                };
+                sse(0.0, chunk({{"role", "assistant"}, {"content", ""}}, nullptr));
+                for (const auto& piece : generation.pieces) sse(step(), chunk({{"content", piece}}, nullptr));
+                for (size_t i = 0; i < generation.tool_calls.size(); ++i) {
+                    const auto& [name, arguments] = generation.tool_calls[i];
+                    sse(step(), chunk({{"tool_calls", {{{"index", i}, {"id", "call_" + generation.id + "_" + std::to_string(i)},
+                                                      {"type", "function"},
+                                                      {"function", {{"name", name}, {"arguments", arguments.dump()}}}}}}},
+                                    nullptr));
+                }
+                sse(0.0, chunk(JsonObject::object(), tools ? "tool_calls" : "stop"));
+                if (call.body.contains("stream_options") && call.body["stream_options"].value("include_usage", false)) {
+                    JsonObject usage = chunk(JsonObject::object(), nullptr);
+                    usage["choices"] = JsonObject::array();
+                    usage["usage"] = {{"prompt_tokens", generation.input_tokens}, {"completion_tokens", generation.output_tokens},
+                                      {"total_tokens", generation.input_tokens + generation.output_tokens}};
+                    sse(0.0, usage);
+                }
+                reply.chunks.emplace_back(0.0, "data: [DONE]\n\n");
+                break;
+            }
+            case Provider::ANTHROPIC: {
+                sse(0.0, {{"type", "message_start"},
+                          {"message", {{"id", "msg_mock_" + generation.id}, {"type", "message"}, {"role", "assistant"},
+                                       {"model", generation.model}, {"content", JsonObject::array()}, {"stop_reason", nullptr},
+                                       {"stop_sequence", nullptr},
+                                       {"usage", {{"input_tokens", generation.input_tokens}, {"output_tokens", 1}}}}}},
+                    "message_start");
+                size_t index = 0;
+                if (!generation.pieces.empty()) {
+                    sse(0.0, {{"type", "content_block_start"}, {"index", index}, {"content_block", {{"type", "text"}, {"text", ""}}}},
+                        "content_block_start");
+                    for (const auto& piece : generation.pieces) {
+                        sse(step(), {{"type", "content_block_delta"}, {"index", index}, {"delta", {{"type", "text_delta"}, {"text", piece}}}},
+                            "content_block_delta");
+                    }
+                    sse(0.0, {{"type", "content_block_stop"}, {"index", index}}, "content_block_stop");
+                    index++;
+                }
+                for (size_t i = 0; i < generation.tool_calls.size(); ++i, ++index) {
+                    const auto& [name, arguments] = generation.tool_calls[i];
+                    sse(step(), {{"type", "content_block_start"}, {"index", index},
+                               {"content_block", {{"type", "tool_use"}, {"id", "toolu_" + generation.id + "_" + std::to_string(i)},
+                                                  {"name", name}, {"input", JsonObject::object()}}}},
+                        "content_block_start");
+                    sse(0.0, {{"type", "content_block_delta"}, {"index", index},
+                              {"delta", {{"type", "input_json_delta"}, {"partial_json", arguments.dump()}}}},
+                        "content_block_delta");
+                    sse(0.0, {{"type", "content_block_stop"}, {"index", index}}, "content_block_stop");
+                }
+                sse(0.0, {{"type", "message_delta"}, {"delta", {{"stop_reason", tools ? "tool_use" : "end_turn"}, {"stop_sequence", nullptr}}},
+                          {"usage", {{"output_tokens", generation.output_tokens}}}},
+                    "message_delta");
+                sse(0.0, {{"type", "message_stop"}}, "message_stop");
+                break;
+            }
+            case Provider::GOOGLE: {
+                std::vector<std::pair<double, JsonObject>> chunks;
+                for (const auto& piece : generation.pieces) {
+                    chunks.emplace_back(step(), geminiChunk(generation, {{{"text", piece}}}, false));
+                }
+                for (const auto& [name, arguments] : generation.tool_calls) {
+                    chunks.emplace_back(step(), geminiChunk(generation, {{{"functionCall", {{"name", name}, {"args", arguments}}}}}, false));
+                }
+                if (chunks.empty()) chunks.emplace_back(step(), geminiChunk(generation, {{{"text", ""}}}, false));
+                JsonObject& last = chunks.back().second;
+                last = geminiChunk(generation, last["candidates"][0]["content"]["parts"], true);
+                for (size_t i = 0; i < chunks.size(); ++i) {
+                    if (call.sse) {
+                        sse(chunks[i].first, chunks[i].second);
+                    } else {
+                        reply.chunks.emplace_back(chunks[i].first, (i == 0 ? "[" : ",\r\n") + chunks[i].second.dump());
+                    }
+                }
+                if (!call.sse) reply.chunks.emplace_back(0.0, "]");
+                break;
+            }
+            case Provider::OLLAMA: {
+                for (const auto& piece : generation.pieces) {
+                    reply.chunks.emplace_back(step(), ollamaChunk(call, generation, piece, false).dump() + "\n");
+                }
+                if (tools && !call.generate) {
+                    JsonObject chunk = ollamaChunk(call, generation, "", false);
+                    for (const auto& [name, arguments] : generation.tool_calls) {
+                        chunk["message"]["tool_calls"].push_back({{"function", {{"name", name}, {"arguments", arguments}}}});
+                    }
+                    reply.chunks.emplace_back(step(), chunk.dump() + "\n");
+                }
+                reply.chunks.emplace_back(0.0, ollamaChunk(call, generation, "", true).dump() + "\n");
+                break;
+            }
+        }
+    }
+/*! @endcond */
+};
+
+} // namespace agents
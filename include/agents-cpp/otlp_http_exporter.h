@@ -0,0 +1,70 @@
+/**
+ * @file otlp_http_exporter.h
+ * @brief Span exporter that posts OTLP/JSON to a collector
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025 Edge AI, LLC. All rights reserved.
+ *
+ */
+#pragma once
+
+#include <agents-cpp/http_client.h>
+#include <agents-cpp/logger.h>
+#include <agents-cpp/tracing.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace agents {
+
+/**
+ * @brief Exports span batches to an OTLP/HTTP collector using the JSON encoding
+ *
+ * Works with any collector that accepts OTLP over HTTP, such as the
+ * OpenTelemetry Collector or Jaeger, listening on the default port.
+ */
+class OtlpHttpExporter : public SpanExporter {
+public:
+    /**
+     * @brief Constructor
+     * @param endpoint The traces endpoint of the collector
+     * @param service_name Value of the `service.name` resource attribute
+     * @param headers Extra headers, such as authentication for a hosted collector
+     * @param timeout_ms Request timeout in milliseconds
+     */
+    explicit OtlpHttpExporter(std::string endpoint = "http://localhost:4318/v1/traces",
+                              std::string service_name = "agents-cpp",
+                              std::map<std::string, std::string> headers = {},
+                              int timeout_ms = 10000)
+        : endpoint_(std::move(endpoint)), service_name_(std::move(service_name)),
+          headers_(std::move(headers)), timeout_ms_(timeout_ms) {
+        headers_["Content-Type"] = "application/json";
+    }
+
+    /**
+     * @brief Post the batch to the collector
+     *
+     * Failures are logged and the batch is dropped, so an unreachable
+     * collector never blocks or fails the traced application.
+     *
+     * @param spans The spans
+     */
+    void exportSpans(const std::vector<SpanData>& spans) override {
+        auto response = HTTPClient::post(endpoint_, headers_, Tracer::toOtlpJson(spans, service_name_).dump(), timeout_ms_);
+        if (response.error || response.status_code >= 300) {
+            AGENTS_LOG_WARN("OTLP export to {} failed: {} {}", endpoint_, response.status_code, response.error_message);
+        }
+    }
+
+/*! @cond PRIVATE */
+private:
+    std::string endpoint_;
+    std::string service_name_;
+    std::map<std::string, std::string> headers_;
+    int timeout_ms_;
+/*! @endcond */
+};
+
+} // namespace agents
@@ -0,0 +1,301 @@
+/**
+ * @file prompt_template.h
+ * @brief Precompiled prompt templates with JSON-path slots
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025 Edge AI, LLC. All rights reserved.
+ *
+ */
+#pragma once
+
+#include <agents-cpp/types.h>
+
+#include <cctype>
+#include <charconv>
+#include <functional>
+#include <map>
+#include <optional>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+namespace agents {
+
+/**
+ * @brief A prompt template compiled once into literal and slot segments
+ *
+ * A slot is written `{name}` or `{name.path[0].to.field}`: `name` selects a
+ * variable and the optional path walks into its JSON value. Any text in
+ * braces that is not exactly of that form (e.g. a JSON example such as
+ * `{"key": 1}`, `{a b}`, `{e.g.}` or `{items[]}`) stays literal.
+ *
+ * When a value is a string it is inserted verbatim; other JSON values are
+ * serialized, and missing values render as an empty string. Rendering looks
+ * up each slot once, collecting a view of every segment, then builds the
+ * prompt in one allocation of the exact size. Besides the prompt, it
+ * allocates the list of views and, when a slot holds a non-string value,
+ * that value's serialization.
+ *
+ * @code
+ * PromptTemplate tmpl("Summarize {input} using {outline.response}", {"input", "outline"});
+ * std::string prompt = tmpl.render(JsonObject{{"input", text}, {"outline", outline_output}});
+ * @endcode
+ */
+class PromptTemplate {
+public:
+    /**
+     * @brief Step of a slot path: an object key or an array index
+     */
+    using PathElement = std::variant<std::string, size_t>;
+
+    /**
+     * @brief Resolves a variable name to its value (nullptr when unset)
+     */
+    using Lookup = std::function<const JsonObject*(const std::string&)>;
+
+    /**
+     * @brief Default constructor (empty template)
+     */
+    PromptTemplate() = default;
+
+    /**
+     * @brief Compile a template
+     * @param source The template text
+     * @param variables Allowed variable names; when non-empty, any other name throws
+     * @throws std::invalid_argument on an unknown variable
+     */
+    explicit PromptTemplate(std::string source, const std::set<std::string>& variables = {})
+        : source_(std::move(source)) {
+        compile(variables);
+    }
+
+    /**
+     * @brief Render with variables taken from a JSON object's keys
+     * @param variables Object mapping variable names to values
+     * @return The rendered prompt
+     */
+    std::string render(const JsonObject& variables) const {
+        return render([&variables](const std::string& name) -> const JsonObject* {
+            if (!variables.is_object()) return nullptr;
+            auto it = variables.find(name);
+            return it != variables.end() ? &*it : nullptr;
+        });
+    }
+
+    /**
+     * @brief Render with plain string variables
+     * @param variables Map of variable names to text
+     * @return The rendered prompt
+     */
+    std::string render(const std::map<std::string, std::string>& variables) const {
+        std::vector<std::string_view> pieces;
+        pieces.reserve(segments_.size());
+        for (const Segment& segment : segments_) {
+            if (!segment.is_slot) {
+                pieces.push_back(literal(segment));
+                continue;
+            }
+            auto it = variables.find(segment.variable);
+            if (it != variables.end() && segment.path.empty()) pieces.push_back(it->second);
+        }
+        return join(pieces);
+    }
+
+    /**
+     * @brief Render with a variable lookup
+     * @param lookup Resolves variable names to values
+     * @return The rendered prompt
+     */
+    std::string render(const Lookup& lookup) const {
+        std::vector<std::string_view> pieces;
+        pieces.reserve(segments_.size());
+        // Reserved up front on first use: the views point into these strings
+        std::vector<std::string> serialized;
+        for (const Segment& segment : segments_) {
+            if (!segment.is_slot) {
+                pieces.push_back(literal(segment));
+                continue;
+            }
+            const JsonObject* value = resolve(lookup(segment.variable), segment.path);
+            if (!value || value->is_null()) continue;
+            if (value->is_string()) {
+                pieces.push_back(value->get_ref<const std::string&>());
+                continue;
+            }
+            if (serialized.empty()) serialized.reserve(segments_.size());
+            serialized.push_back(value->dump());
+            pieces.push_back(serialized.back());
+        }
+        return join(pieces);
+    }
+
+    /**
+     * @brief Render, keeping the JSON type when the template is a single slot
+     *
+     * A template that consists of exactly one slot (e.g. `{search.data}`)
+     * yields the referenced value itself, so structured data can be passed
+     * on unchanged; any other template renders to a string.
+     *
+     * @param variables Object mapping variable names to values
+     * @return The referenced value (null when missing), or the rendered string
+     */
+    JsonObject renderJson(const JsonObject& variables) const {
+        if (segments_.size() == 1 && segments_[0].is_slot) {
+            const JsonObject* root = nullptr;
+            if (variables.is_object()) {
+                auto it = variables.find(segments_[0].variable);
+                if (it != variables.end()) root = &*it;
+            }
+            const JsonObject* value = resolve(root, segments_[0].path);
+            return value ? *value : JsonObject();
+        }
+        return render(variables);
+    }
+
+    /**
+     * @brief Names of the variables referenced by the template
+     * @return The variable names
+     */
+    std::set<std::string> variables() const {
+        std::set<std::string> names;
+        for (const auto& segment : segments_) {
+            if (segment.is_slot) names.insert(segment.variable);
+        }
+        return names;
+    }
+
+    /**
+     * @brief The template text
+     * @return The source
+     */
+    const std::string& source() const {
+        return source_;
+    }
+
+/*! @cond PRIVATE */
+private:
+    struct Segment {
+        bool is_slot = false;
+        size_t offset = 0;              // literal: position in source_
+        size_t length = 0;              // literal: length in source_
+        std::string variable;           // slot: variable name
+        std::vector<PathElement> path;  // slot: path into the variable
+    };
+
+    std::string source_;
+    std::vector<Segment> segments_;
+
+    std::string_view literal(const Segment& segment) const {
+        return std::string_view(source_).substr(segment.offset, segment.length);
+    }
+
+    static std::string join(const std::vector<std::string_view>& pieces) {
+        size_t size = 0;
+        for (std::string_view piece : pieces) size += piece.size();
+        std::string out;
+        out.reserve(size);
+        for (std::string_view piece : pieces) out.append(piece);
+        return out;
+    }
+
+    static bool isNameStart(char c) {
+        return std::isalpha(static_cast<unsigned char>(c)) || c == '_';
+    }
+
+    static bool isNameChar(char c) {
+        return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '-';
+    }
+
+    void addLiteral(size_t offset, size_t length) {
+        if (length == 0) return;
+        if (!segments_.empty() && !segments_.back().is_slot && segments_.back().offset + segments_.back().length == offset) {
+            segments_.back().length += length;
+            return;
+        }
+        Segment segment;
+        segment.offset = offset;
+        segment.length = length;
+        segments_.push_back(std::move(segment));
+    }
+
+    void compile(const std::set<std::string>& allowed) {
+        size_t pos = 0;
+        while (pos < source_.size()) {
+            size_t open = source_.find('{', pos);
+            if (open == std::string::npos) break;
+            addLiteral(pos, open - pos);
+            size_t close = source_.find('}', open + 1);
+            if (close == std::string::npos || open + 1 >= source_.size() || !isNameStart(source_[open + 1])) {
+                addLiteral(open, 1);
+                pos = open + 1;
+                continue;
+            }
+            std::optional<Segment> slot = parseSlot(std::string_view(source_).substr(open + 1, close - open - 1));
+            if (!slot) {
+                addLiteral(open, 1);
+                pos = open + 1;
+                continue;
+            }
+            if (!allowed.empty() && !allowed.count(slot->variable)) {
+                throw std::invalid_argument("Unknown template variable '" + slot->variable + "' in prompt template");
+            }
+            segments_.push_back(std::move(*slot));
+            pos = close + 1;
+        }
+        addLiteral(pos, source_.size() - pos);
+    }
+
+    // Parses `name(.key|[index])*`; returns nullopt for anything else, which
+    // the caller keeps as literal text
+    static std::optional<Segment> parseSlot(std::string_view text) {
+        Segment slot;
+        slot.is_slot = true;
+        size_t i = 0;
+        while (i < text.size() && isNameChar(text[i])) i++;
+        slot.variable = std::string(text.substr(0, i));
+        while (i < text.size()) {
+            if (text[i] == '.') {
+                size_t start = ++i;
+                while (i < text.size() && isNameChar(text[i])) i++;
+                if (i == start) return std::nullopt; // e.g. `{e.g.}`
+                slot.path.emplace_back(std::string(text.substr(start, i - start)));
+            } else if (text[i] == '[') {
+                size_t start = ++i;
+                while (i < text.size() && std::isdigit(static_cast<unsigned char>(text[i]))) i++;
+                size_t index = 0;
+                auto parsed = std::from_chars(text.data() + start, text.data() + i, index);
+                if (i == start || parsed.ec != std::errc() || i >= text.size() || text[i] != ']') {
+                    return std::nullopt; // e.g. `{items[]}`
+                }
+                slot.path.emplace_back(index);
+                i++;
+            } else {
+                return std::nullopt; // e.g. `{a b}` or `{name: value}`
+            }
+        }
+        return slot;
+    }
+
+    static const JsonObject* resolve(const JsonObject* value, const std::vector<PathElement>& path) {
+        for (const auto& element : path) {
+            if (!value) return nullptr;
+            if (const std::string* key = std::get_if<std::string>(&element)) {
+                if (!value->is_object()) return nullptr;
+                auto it = value->find(*key);
+                value = it != value->end() ? &*it : nullptr;
+            } else {
+                size_t index = std::get<size_t>(element);
+                if (!value->is_array() || index >= value->size()) return nullptr;
+                value = &(*value)[index];
+            }
+        }
+        return value;
+    }
+/*! @endcond */
+};
+
+} // namespace agents
@@ -0,0 +1,529 @@
+/**
+ * @file reflection_memory.h
+ * @brief Long-term index of Reflexion lessons reused across tasks
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025 Edge AI, LLC. All rights reserved.
+ *
+ */
+#pragma once
+
+#include <agents-cpp/agents/autonomous_agent.h>
+#include <agents-cpp/coroutine_utils.h>
+#include <agents-cpp/embedding.h>
+#include <agents-cpp/llm_interface.h>
+#include <agents-cpp/logger.h>
+#include <agents-cpp/types.h>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace agents {
+
+/**
+ * @brief Persistent memory of self-critiques, indexed by task embedding
+ *
+ * Lessons are normally lost when a run ends. This index keeps them, keyed
+ * by an embedding of the task they were learned on, and appends each new
+ * lesson to a JSON-lines file so it survives restarts. At the start of a
+ * run the most similar lessons are retrieved and rendered into a prompt
+ * section that fits a token budget.
+ *
+ * Lessons come from failed steps, from the plan of a successful run and,
+ * given a critic LLM, from a self-critique of each run (reflect()). The
+ * prebuilt AutonomousAgent's REFLEXION strategy plans as REACT does and
+ * writes no critique of its own, so reflect() is what produces one.
+ *
+ * Typical use with an AutonomousAgent; stepCallback() chains to the
+ * callback it is given, so it can sit behind a StepHistory:
+ * @code
+ * ReflectionMemory lessons("reflections.jsonl");
+ * StepHistory history(agent, 128, "", lessons.stepCallback());
+ * JsonObject result = blockingWait(lessons.run(agent, task, base_prompt, critic_llm));
+ * @endcode
+ */
+class ReflectionMemory {
+public:
+    /**
+     * @brief A lesson learned on a task
+     */
+    struct Reflection {
+        /**
+         * @brief The task the lesson was learned on
+         */
+        std::string task;
+        /**
+         * @brief The lesson (self-critique)
+         */
+        std::string lesson;
+        /**
+         * @brief Optional metadata (e.g. outcome, iterations used)
+         */
+        JsonObject metadata;
+        /**
+         * @brief Creation time in seconds since the epoch
+         */
+        int64_t created_at = 0;
+        /**
+         * @brief Embedding of the task
+         */
+        Embedding embedding;
+    };
+
+    /**
+     * @brief Constructor
+     * @param path JSON-lines file to load from and append to; empty keeps the index in memory only
+     * @param embedder The embedder for task text (defaults to HashingEmbedder)
+     */
+    explicit ReflectionMemory(const std::string& path = "", Embedder embedder = HashingEmbedder())
+        : path_(path), embedder_(std::move(embedder)) {
+        if (!embedder_) {
+            throw std::invalid_argument("ReflectionMemory requires an embedder");
+        }
+        load();
+    }
+
+    /**
+     * @brief Store a lesson for a task
+     *
+     * Exact duplicates of an existing (task, lesson) pair are ignored.
+     *
+     * @param task The task the lesson was learned on
+     * @param lesson The lesson
+     * @param metadata Optional metadata
+     */
+    void addReflection(const std::string& task, const std::string& lesson, const JsonObject& metadata = JsonObject::object()) {
+        if (lesson.empty()) {
+            return;
+        }
+        Reflection reflection;
+        reflection.task = task;
+        reflection.lesson = lesson;
+        reflection.metadata = metadata;
+        reflection.created_at = std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        reflection.embedding = embedder_(task);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& existing : reflections_) {
+            if (existing.task == task && existing.lesson == lesson) {
+                return;
+            }
+        }
+        append(reflection);
+        reflections_.push_back(std::move(reflection));
+    }
+
+    /**
+     * @brief Store a lesson from a failed step
+     *
+     * Steps recorded by AutonomousAgent carry `{"output": ...}` on success
+     * and `{"error": ...}` (with a "Failed: ..." status) on failure. Only
+     * failures become lessons; successful plans are kept by harvestRun().
+     * Suitable for calling from a step callback.
+     *
+     * @param task The task being run
+     * @param step The completed step
+     * @return Whether a lesson was stored
+     */
+    bool harvest(const std::string& task, const AutonomousAgent::Step& step) {
+        if (step.success) {
+            return false;
+        }
+        std::string error;
+        if (step.result.is_object() && step.result.contains("error") && step.result["error"].is_string()) {
+            error = step.result["error"].get<std::string>();
+        } else if (step.status.rfind("Failed: ", 0) == 0) {
+            error = step.status.substr(8);
+        }
+        if (error.empty()) {
+            return false;
+        }
+        std::string description = stripNumbering(step.description);
+        size_t before = size();
+        addReflection(task, "Step \"" + description + "\" failed: " + error,
+                      JsonObject{{"step", description}, {"success", false}});
+        return size() > before;
+    }
+
+    /**
+     * @brief Store the lessons of a finished run
+     *
+     * Reads the result of AutonomousAgent::run(): `{"answer", "steps":
+     * [{"description", "result", "success"}]}` on success, `{"error"}`
+     * otherwise. A run whose steps all succeeded stores its plan as a
+     * lesson; failed steps and run errors are stored as failures.
+     *
+     * @param task The task that was run
+     * @param result The run result
+     * @return The number of lessons stored
+     */
+    size_t harvestRun(const std::string& task, const JsonObject& result) {
+        if (!result.is_object()) {
+            return 0;
+        }
+        size_t before = size();
+        if (result.contains("error") && result["error"].is_string()) {
+            addReflection(task, "A previous attempt failed: " + result["error"].get<std::string>(),
+                          JsonObject{{"success", false}});
+        }
+        if (!result.contains("steps") || !result["steps"].is_array() || result["steps"].empty()) {
+            return size() - before;
+        }
+        std::string plan;
+        bool succeeded = true;
+        for (const auto& entry : result["steps"]) {
+            AutonomousAgent::Step step;
+            step.description = entry.value("description", "");
+            step.result = entry.value("result", JsonObject::object());
+            step.success = entry.value("success", false);
+            if (!step.success) {
+                succeeded = false;
+                harvest(task, step);
+            }
+            plan += (plan.empty() ? "" : "; ") + stripNumbering(step.description);
+        }
+        if (succeeded && result.contains("answer")) {
+            addReflection(task, "A plan that worked: " + plan,
+                          JsonObject{{"steps", result["steps"].size()}, {"success", true}});
+        }
+        return size() - before;
+    }
+
+    /**
+     * @brief Ask a critic LLM for a self-critique of a finished run and store it
+     *
+     * This is the reflection step of Reflexion: the critic sees the task and
+     * the run() result and answers with advice for the next attempt at a
+     * similar task.
+     *
+     * @param task The task that was run
+     * @param result The run result
+     * @param critic The LLM that writes the critique
+     * @return Task yielding whether a lesson was stored
+     */
+    Task<bool> reflect(std::string task, JsonObject result, std::shared_ptr<LLMInterface> critic) {
+        if (!critic) {
+            throw std::invalid_argument("ReflectionMemory::reflect requires a critic LLM");
+        }
+        std::string outcome = result.dump();
+        if (outcome.size() > kMaxOutcomeChars) {
+            outcome = outcome.substr(0, kMaxOutcomeChars) + "...";
+        }
+        std::vector<Message> messages{
+            Message{Message::Role::SYSTEM,
+                    "You review an agent's attempt at a task. Reply with one or two sentences of advice "
+                    "for a future attempt at a similar task: what to repeat and what to avoid. "
+                    "Reply with the advice only."},
+            Message{Message::Role::USER, "Task: " + task + "\n\nOutcome: " + outcome}
+        };
+        LLMResponse response = co_await critic->chatAsync(messages);
+        std::string critique = trim(response.content);
+        if (critique.empty()) {
+            co_return false;
+        }
+        size_t before = size();
+        addReflection(task, critique, JsonObject{{"source", "reflexion"}, {"success", !result.contains("error")}});
+        co_return size() > before;
+    }
+
+    /**
+     * @brief Start a run: make `task` the task stepCallback() harvests for
+     * @param task The task about to run
+     * @return The prompt section of lessons for the task (see buildPromptSection())
+     */
+    std::string beginRun(const std::string& task) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            active_task_ = task;
+        }
+        return buildPromptSection(task);
+    }
+
+    /**
+     * @brief Finish a run: store its lessons and stop harvesting steps for it
+     *
+     * Stores what harvestRun() finds and, given a critic, a critique from
+     * reflect(). A failing critic is logged and does not fail the run.
+     *
+     * @param task The task that was run
+     * @param result The run result
+     * @param critic Optional LLM that writes a critique of the run
+     * @return Task yielding the number of lessons stored
+     */
+    Task<size_t> endRun(std::string task, JsonObject result, std::shared_ptr<LLMInterface> critic = nullptr) {
+        finishRun(task);
+        size_t stored = harvestRun(task, result);
+        if (critic) {
+            try {
+                if (co_await reflect(task, result, critic)) stored++;
+            } catch (const std::exception& e) {
+                AGENTS_LOG_WARN("Reflection on task failed: {}", e.what());
+            }
+        }
+        co_return stored;
+    }
+
+    /**
+     * @brief Run an agent with the lessons for its task in the prompt, then store what the run taught
+     *
+     * The agent prompt is set to `agent_prompt` followed by beginRun()'s
+     * section; endRun() runs once the agent finishes.
+     *
+     * @param agent The agent
+     * @param task The task
+     * @param agent_prompt The agent prompt without lessons
+     * @param critic Optional LLM that writes a critique of the run
+     * @return Task yielding the agent's result
+     */
+    Task<JsonObject> run(AutonomousAgent& agent, std::string task, std::string agent_prompt,
+                         std::shared_ptr<LLMInterface> critic = nullptr) {
+        agent.setAgentPrompt(agent_prompt + beginRun(task));
+        JsonObject result;
+        try {
+            result = co_await agent.run(task);
+        } catch (...) {
+            finishRun(task);
+            throw;
+        }
+        co_await endRun(task, result, critic);
+        co_return result;
+    }
+
+    /**
+     * @brief Step callback that harvests failed steps of the run in progress
+     *
+     * Steps are stored against the task passed to beginRun() (or run()) and
+     * ignored outside a run. The callback then calls `next`, so an existing
+     * callback keeps working; pass it as StepHistory's `next` to use both.
+     *
+     * @param next Optional callback called with each step afterwards
+     * @return The callback to install
+     */
+    std::function<void(const AutonomousAgent::Step&)> stepCallback(
+        std::function<void(const AutonomousAgent::Step&)> next = nullptr) {
+        return [this, next = std::move(next)](const AutonomousAgent::Step& step) {
+            std::string task;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                task = active_task_;
+            }
+            if (!task.empty()) {
+                harvest(task, step);
+            }
+            if (next) {
+                next(step);
+            }
+        };
+    }
+
+    /**
+     * @brief Retrieve the lessons learned on the most similar tasks
+     * @param task The new task
+     * @param top_k Maximum number of lessons
+     * @param min_similarity Minimum cosine similarity of the task embeddings
+     * @return Lessons with their similarity, most similar first
+     */
+    std::vector<std::pair<Reflection, float>> retrieve(const std::string& task, size_t top_k = 5, float min_similarity = 0.2f) const {
+        Embedding query = embedder_(task);
+        std::vector<std::pair<const Reflection*, float>> scored;
+        std::lock_guard<std::mutex> lock(mutex_);
+        scored.reserve(reflections_.size());
+        for (const auto& reflection : reflections_) {
+            float similarity = cosineSimilarity(query, reflection.embedding);
+            if (similarity >= min_similarity) {
+                scored.emplace_back(&reflection, similarity);
+            }
+        }
+        size_t k = std::min(top_k, scored.size());
+        std::partial_sort(scored.begin(), scored.begin() + static_cast<std::ptrdiff_t>(k), scored.end(),
+            [](const auto& a, const auto& b) { return a.second > b.second; });
+
+        std::vector<std::pair<Reflection, float>> results;
+        results.reserve(k);
+        for (size_t i = 0; i < k; ++i) {
+            results.emplace_back(*scored[i].first, scored[i].second);
+        }
+        return results;
+    }
+
+    /**
+     * @brief Render the most relevant lessons as a prompt section within a token budget
+     * @param task The new task
+     * @param top_k Maximum number of lessons
+     * @param max_tokens Token budget for the section (estimated at ~4 characters per token)
+     * @return The prompt section, or an empty string when nothing relevant is stored
+     */
+    std::string buildPromptSection(const std::string& task, size_t top_k = 5, size_t max_tokens = 400) const {
+        static const std::string header = "\n\nLessons learned on similar past tasks:\n";
+        const size_t max_chars = max_tokens * 4;
+        std::string section;
+        for (const auto& [reflection, similarity] : retrieve(task, top_k)) {
+            std::string line = "- " + reflection.lesson + "\n";
+            size_t needed = (section.empty() ? header.size() : 0) + line.size();
+            if (section.size() + needed > max_chars) {
+                break;
+            }
+            if (section.empty()) {
+                section = header;
+            }
+            section += line;
+        }
+        return section;
+    }
+
+    /**
+     * @brief Number of stored lessons
+     * @return The number of lessons
+     */
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return reflections_.size();
+    }
+
+/*! @cond PRIVATE */
+private:
+    /**
+     * @brief Backing file path
+     */
+    std::string path_;
+
+    /**
+     * @brief Task embedder
+     */
+    Embedder embedder_;
+
+    /**
+     * @brief All stored lessons
+     */
+    std::vector<Reflection> reflections_;
+
+    /**
+     * @brief Task of the run in progress, harvested by stepCallback()
+     */
+    std::string active_task_;
+
+    /**
+     * @brief Guards reflections_, active_task_ and the backing file
+     */
+    mutable std::mutex mutex_;
+
+    // Longest run result shown to the critic
+    static constexpr size_t kMaxOutcomeChars = 4000;
+
+    void finishRun(const std::string& task) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (active_task_ == task) active_task_.clear();
+    }
+
+    static std::string trim(const std::string& text) {
+        size_t begin = text.find_first_not_of(" \t\r\n");
+        if (begin == std::string::npos) return "";
+        return text.substr(begin, text.find_last_not_of(" \t\r\n") - begin + 1);
+    }
+
+    // Embeddings are stored as their non-zero entries when that is smaller,
+    // as it is for HashingEmbedder: {"size": n, "index": [...], "value": [...]}
+    static JsonObject encodeEmbedding(const Embedding& embedding) {
+        JsonObject index = JsonObject::array();
+        JsonObject value = JsonObject::array();
+        for (size_t i = 0; i < embedding.size(); ++i) {
+            if (embedding[i] != 0.0f) {
+                index.push_back(i);
+                value.push_back(embedding[i]);
+            }
+        }
+        if (index.size() * 2 >= embedding.size()) {
+            return embedding;
+        }
+        return JsonObject{{"size", embedding.size()}, {"index", std::move(index)}, {"value", std::move(value)}};
+    }
+
+    static Embedding decodeEmbedding(const JsonObject& encoded) {
+        if (encoded.is_array()) {
+            return encoded.get<Embedding>();
+        }
+        if (!encoded.is_object()) {
+            return {};
+        }
+        Embedding embedding(encoded.value("size", size_t{0}), 0.0f);
+        const JsonObject index = encoded.value("index", JsonObject::array());
+        const JsonObject value = encoded.value("value", JsonObject::array());
+        for (size_t i = 0; i < index.size() && i < value.size(); ++i) {
+            size_t at = index[i].get<size_t>();
+            if (at < embedding.size()) embedding[at] = value[i].get<float>();
+        }
+        return embedding;
+    }
+
+    // Plan steps arrive as "1. Do something"
+    static std::string stripNumbering(const std::string& description) {
+        size_t i = 0;
+        while (i < description.size() && std::isdigit(static_cast<unsigned char>(description[i]))) ++i;
+        if (i > 0 && i < description.size() && (description[i] == '.' || description[i] == ')')) {
+            ++i;
+            while (i < description.size() && description[i] == ' ') ++i;
+            return description.substr(i);
+        }
+        return description;
+    }
+
+    void load() {
+        if (path_.empty()) {
+            return;
+        }
+        std::ifstream in(path_);
+        const size_t dimensions = embedder_("").size();
+        std::string line;
+        while (std::getline(in, line)) {
+            if (line.empty()) {
+                continue;
+            }
+            JsonObject record = JsonObject::parse(line, nullptr, false);
+            if (record.is_discarded() || !record.is_object()) {
+                continue; // tolerate a torn final line
+            }
+            Reflection reflection;
+            reflection.task = record.value("task", "");
+            reflection.lesson = record.value("lesson", "");
+            reflection.metadata = record.value("metadata", JsonObject::object());
+            reflection.created_at = record.value("created_at", int64_t{0});
+            reflection.embedding = decodeEmbedding(record.value("embedding", JsonObject()));
+            // Re-embed when the stored vector came from a different embedder
+            if (reflection.embedding.size() != dimensions) {
+                reflection.embedding = embedder_(reflection.task);
+            }
+            reflections_.push_back(std::move(reflection));
+        }
+    }
+
+    void append(const Reflection& reflection) {
+        if (path_.empty()) {
+            return;
+        }
+        std::ofstream out(path_, std::ios::app);
+        if (!out) {
+            throw std::runtime_error("Failed to open reflection memory file: " + path_);
+        }
+        out << JsonObject{
+            {"task", reflection.task},
+            {"lesson", reflection.lesson},
+            {"metadata", reflection.metadata},
+            {"created_at", reflection.created_at},
+            {"embedding", encodeEmbedding(reflection.embedding)}
+        }.dump() << '\n';
+    }
+/*! @endcond */
+};
+
+} // namespace agents
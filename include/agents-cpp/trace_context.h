@@ -0,0 +1,84 @@
+/**
+ * @file trace_context.h
+ * @brief Thread-local trace context shared by tracing and the coroutine utilities
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025 Edge AI, LLC. All rights reserved.
+ *
+ */
+#pragma once
+
+#include <cstdint>
+
+namespace agents {
+
+/**
+ * @brief Identifies the active span of a trace on the current thread
+ *
+ * Kept separate from tracing.h so that Task and offload() can carry the
+ * context across suspension and executor threads without depending on the
+ * tracer itself.
+ */
+struct TraceContext {
+    /**
+     * @brief High 64 bits of the trace id
+     */
+    uint64_t trace_id_high = 0;
+    /**
+     * @brief Low 64 bits of the trace id
+     */
+    uint64_t trace_id_low = 0;
+    /**
+     * @brief Id of the active span
+     */
+    uint64_t span_id = 0;
+    /**
+     * @brief Whether the trace is being recorded
+     */
+    bool sampled = false;
+    /**
+     * @brief Whether a sampling decision has been made (false outside any trace)
+     */
+    bool decided = false;
+
+    /**
+     * @brief The calling thread's current context
+     * @return Reference to the thread-local context
+     */
+    static TraceContext& current() noexcept {
+        thread_local TraceContext context;
+        return context;
+    }
+};
+
+/**
+ * @brief Installs a trace context on the current thread for the scope's lifetime
+ */
+class TraceContextScope {
+public:
+    /**
+     * @brief Constructor
+     * @param context The context to install
+     */
+    explicit TraceContextScope(const TraceContext& context) noexcept : previous_(TraceContext::current()) {
+        TraceContext::current() = context;
+    }
+
+    /**
+     * @brief Destructor; restores the previous context
+     */
+    ~TraceContextScope() {
+        TraceContext::current() = previous_;
+    }
+
+    TraceContextScope(const TraceContextScope&) = delete;
+    TraceContextScope& operator=(const TraceContextScope&) = delete;
+
+/*! @cond PRIVATE */
+private:
+    TraceContext previous_;
+/*! @endcond */
+};
+
+} // namespace agents
@@ -0,0 +1,685 @@
+/**
+ * @file tracing.h
+ * @brief Spans, sampling and OTLP/JSON export for LLM calls, tools, agents and workflows
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025 Edge AI, LLC. All rights reserved.
+ *
+ */
+#pragma once
+
+#include <agents-cpp/logger.h>
+#include <agents-cpp/metrics.h>
+#include <agents-cpp/trace_context.h>
+#include <agents-cpp/types.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace agents {
+
+/**
+ * @brief Role of a span, numbered as in OTLP
+ */
+enum class SpanKind {
+    INTERNAL = 1,
+    SERVER = 2,
+    CLIENT = 3,
+    PRODUCER = 4,
+    CONSUMER = 5
+};
+
+/**
+ * @brief Timestamped event recorded on a span
+ */
+struct SpanEvent {
+    /**
+     * @brief Event name
+     */
+    std::string name;
+    /**
+     * @brief Event time in nanoseconds since the Unix epoch
+     */
+    uint64_t time_unix_nano = 0;
+    /**
+     * @brief Event attributes
+     */
+    JsonObject attributes = JsonObject::object();
+};
+
+/**
+ * @brief A finished span as handed to exporters
+ */
+struct SpanData {
+    /**
+     * @brief Span name
+     */
+    std::string name;
+    /**
+     * @brief Span kind
+     */
+    SpanKind kind = SpanKind::INTERNAL;
+    /**
+     * @brief Trace and span ids of this span
+     */
+    TraceContext context;
+    /**
+     * @brief Id of the parent span (0 for a root span)
+     */
+    uint64_t parent_span_id = 0;
+    /**
+     * @brief Start time in nanoseconds since the Unix epoch
+     */
+    uint64_t start_time_unix_nano = 0;
+    /**
+     * @brief End time in nanoseconds since the Unix epoch
+     */
+    uint64_t end_time_unix_nano = 0;
+    /**
+     * @brief Span attributes
+     */
+    JsonObject attributes = JsonObject::object();
+    /**
+     * @brief Events recorded during the span
+     */
+    std::vector<SpanEvent> events;
+    /**
+     * @brief Whether the span ended in error
+     */
+    bool error = false;
+    /**
+     * @brief Error description when error is set
+     */
+    std::string status_message;
+};
+
+/**
+ * @brief Destination for finished spans
+ *
+ * exportSpans() is called from the tracer's background thread, one batch at
+ * a time, with tracing suppressed so an exporter's own HTTP calls are not
+ * traced.
+ */
+class SpanExporter {
+public:
+    virtual ~SpanExporter() = default;
+
+    /**
+     * @brief Export a batch of finished spans
+     * @param spans The spans
+     */
+    virtual void exportSpans(const std::vector<SpanData>& spans) = 0;
+};
+
+/**
+ * @brief Process-wide tracer: sampling, batching and export
+ *
+ * Tracing is off until an exporter is set. While off, or inside a trace the
+ * sampler dropped, opening a Span costs one atomic load and no allocation.
+ * Finished spans are queued and exported by a background thread every
+ * second, or as soon as a batch fills. The queue is sharded per CPU, so
+ * spans ending on different threads rarely contend. It is bounded: while
+ * it holds the maximum, newly finished spans are dropped and counted in
+ * `agents_spans_dropped_total` rather than blocking the traced code.
+ *
+ * @code
+ * Tracer::setExporter(std::make_shared<OtlpFileExporter>("traces.jsonl"));
+ * Tracer::setSampleRatio(0.1);
+ * ...
+ * Tracer::shutdown();
+ * @endcode
+ */
+class Tracer {
+public:
+    /**
+     * @brief Spans per export batch
+     */
+    static constexpr size_t kMaxBatch = 512;
+
+    /**
+     * @brief Default limit on spans waiting for export
+     */
+    static constexpr size_t kDefaultMaxQueue = 16 * kMaxBatch;
+
+    /**
+     * @brief Set the exporter and enable tracing
+     * @param exporter The exporter (nullptr disables tracing after flushing)
+     */
+    static void setExporter(std::shared_ptr<SpanExporter> exporter) {
+        if (!exporter) {
+            shutdown();
+            return;
+        }
+        State& s = state();
+        std::lock_guard<std::mutex> lock(s.mutex);
+        s.exporter = std::move(exporter);
+        if (!s.worker.joinable()) {
+            s.stopping = false;
+            s.worker = std::thread([&s]() { exportLoop(s); });
+            s.running.store(true, std::memory_order_release);
+        }
+        enabled_.store(true, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Set the limit on spans waiting for export
+     * @param spans The limit; spans finished while the queue is full are dropped
+     */
+    static void setMaxQueueSize(size_t spans) {
+        state().capacity.store(spans, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Number of spans dropped because the export queue was full
+     * @return The count since the process started
+     */
+    static uint64_t droppedSpans() noexcept {
+        return droppedCounter().value();
+    }
+
+    /**
+     * @brief Set the fraction of new traces that are recorded
+     *
+     * The decision is made once per trace, at its root span, from the trace
+     * id, and inherited by every span below it.
+     *
+     * @param ratio Fraction in [0, 1]
+     */
+    static void setSampleRatio(double ratio) {
+        uint64_t bound;
+        if (ratio >= 1.0) {
+            bound = std::numeric_limits<uint64_t>::max();
+        } else if (ratio <= 0.0) {
+            bound = 0;
+        } else {
+            bound = static_cast<uint64_t>(ratio * 18446744073709551616.0);
+        }
+        sample_bound_.store(bound, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Whether tracing is enabled
+     * @return true if an exporter is set
+     */
+    static bool enabled() noexcept {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Export every span finished so far and wait for it
+     */
+    static void flush() {
+        State& s = state();
+        std::unique_lock<std::mutex> lock(s.mutex);
+        if (!s.worker.joinable()) return;
+        uint64_t ticket = ++s.flush_requested;
+        s.cv.notify_all();
+        s.flushed_cv.wait(lock, [&]() { return s.flushed >= ticket; });
+    }
+
+    /**
+     * @brief Flush, stop the export thread and disable tracing
+     */
+    static void shutdown() {
+        enabled_.store(false, std::memory_order_relaxed);
+        State& s = state();
+        std::thread worker;
+        {
+            std::lock_guard<std::mutex> lock(s.mutex);
+            s.stopping = true;
+            s.running.store(false, std::memory_order_release);
+            worker.swap(s.worker);
+        }
+        s.cv.notify_all();
+        if (worker.joinable()) worker.join();
+        std::lock_guard<std::mutex> lock(s.mutex);
+        s.exporter.reset();
+    }
+
+    /**
+     * @brief Context that suppresses tracing for everything below it
+     * @return A decided, unsampled context
+     */
+    static TraceContext suppressed() noexcept {
+        TraceContext context;
+        context.decided = true;
+        return context;
+    }
+
+    /**
+     * @brief Build an OTLP ExportTraceServiceRequest in its JSON encoding
+     * @param spans The spans
+     * @param service_name Value of the `service.name` resource attribute
+     * @return The request body
+     */
+    static JsonObject toOtlpJson(const std::vector<SpanData>& spans, const std::string& service_name) {
+        JsonObject otlp_spans = JsonObject::array();
+        for (const auto& span : spans) {
+            JsonObject item = {
+                {"traceId", hex(span.context.trace_id_high) + hex(span.context.trace_id_low)},
+                {"spanId", hex(span.context.span_id)},
+                {"name", span.name},
+                {"kind", static_cast<int>(span.kind)},
+                {"startTimeUnixNano", std::to_string(span.start_time_unix_nano)},
+                {"endTimeUnixNano", std::to_string(span.end_time_unix_nano)},
+                {"attributes", otlpAttributes(span.attributes)},
+                {"status", span.error ? JsonObject{{"code", 2}, {"message", span.status_message}} : JsonObject{{"code", 1}}}
+            };
+            if (span.parent_span_id != 0) {
+                item["parentSpanId"] = hex(span.parent_span_id);
+            }
+            if (!span.events.empty()) {
+                JsonObject events = JsonObject::array();
+                for (const auto& event : span.events) {
+                    events.push_back({
+                        {"name", event.name},
+                        {"timeUnixNano", std::to_string(event.time_unix_nano)},
+                        {"attributes", otlpAttributes(event.attributes)}
+                    });
+                }
+                item["events"] = std::move(events);
+            }
+            otlp_spans.push_back(std::move(item));
+        }
+        return {
+            {"resourceSpans", JsonObject::array({{
+                {"resource", {{"attributes", otlpAttributes({{"service.name", service_name}})}}},
+                {"scopeSpans", JsonObject::array({{
+                    {"scope", {{"name", "agents-cpp"}, {"version", "0.1"}}},
+                    {"spans", std::move(otlp_spans)}
+                }})}
+            }})}
+        };
+    }
+
+    /**
+     * @brief Current time in nanoseconds since the Unix epoch
+     * @return The time
+     */
+    static uint64_t nowUnixNano() noexcept {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+    }
+
+/*! @cond PRIVATE */
+private:
+    friend class Span;
+
+    struct alignas(64) Shard {
+        std::mutex mutex;
+        std::vector<SpanData> spans;
+    };
+
+    struct State {
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::condition_variable flushed_cv;
+        // Finished spans, sharded by CPU; `queued` counts them across shards
+        std::unique_ptr<Shard[]> shards{new Shard[detail::metricShardCount()]};
+        size_t shard_mask = detail::metricShardCount() - 1;
+        std::atomic<size_t> queued{0};
+        std::atomic<size_t> capacity{kDefaultMaxQueue};
+        std::atomic<bool> running{false};
+        std::shared_ptr<SpanExporter> exporter;
+        std::thread worker;
+        bool stopping = false;
+        uint64_t flush_requested = 0;
+        uint64_t flushed = 0;
+
+        ~State() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            cv.notify_all();
+            if (worker.joinable()) worker.join();
+        }
+    };
+
+    static inline std::atomic<bool> enabled_{false};
+    static inline std::atomic<uint64_t> sample_bound_{std::numeric_limits<uint64_t>::max()};
+
+    static State& state() {
+        static State s;
+        return s;
+    }
+
+    static uint64_t randomId() noexcept {
+        thread_local uint64_t seed = std::random_device{}() ^
+            (static_cast<uint64_t>(std::random_device{}()) << 32) ^ nowUnixNano();
+        uint64_t id;
+        do {
+            // splitmix64
+            uint64_t z = (seed += 0x9e3779b97f4a7c15ULL);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            id = z ^ (z >> 31);
+        } while (id == 0);
+        return id;
+    }
+
+    static bool sampled(uint64_t trace_id_low) noexcept {
+        uint64_t bound = sample_bound_.load(std::memory_order_relaxed);
+        return bound == std::numeric_limits<uint64_t>::max() || trace_id_low < bound;
+    }
+
+    static Counter& droppedCounter() {
+        static Counter& dropped = MetricsRegistry::global().counter(
+            "agents_spans_dropped_total", "Finished spans dropped because the export queue was full");
+        return dropped;
+    }
+
+    static void submit(SpanData&& span) {
+        State& s = state();
+        if (!s.running.load(std::memory_order_acquire)) return;
+        size_t queued = s.queued.fetch_add(1, std::memory_order_relaxed) + 1;
+        if (queued > s.capacity.load(std::memory_order_relaxed)) {
+            s.queued.fetch_sub(1, std::memory_order_relaxed);
+            droppedCounter().inc();
+            return;
+        }
+        {
+            Shard& shard = s.shards[detail::metricShard() & s.shard_mask];
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shard.spans.push_back(std::move(span));
+        }
+        if (queued == kMaxBatch) {
+            // Taking the lock orders the wake-up after the worker's predicate check
+            { std::lock_guard<std::mutex> lock(s.mutex); }
+            s.cv.notify_all();
+        }
+    }
+
+    // Moves every queued span into one batch
+    static std::vector<SpanData> drain(State& s) {
+        std::vector<SpanData> batch;
+        batch.reserve(s.queued.load(std::memory_order_relaxed));
+        for (size_t i = 0; i <= s.shard_mask; ++i) {
+            std::lock_guard<std::mutex> lock(s.shards[i].mutex);
+            std::move(s.shards[i].spans.begin(), s.shards[i].spans.end(), std::back_inserter(batch));
+            s.shards[i].spans.clear();
+        }
+        s.queued.fetch_sub(batch.size(), std::memory_order_relaxed);
+        return batch;
+    }
+
+    static void exportLoop(State& s) {
+        // Spans opened by the exporter itself must not feed back into the queue
+        TraceContext::current() = suppressed();
+        std::unique_lock<std::mutex> lock(s.mutex);
+        while (true) {
+            s.cv.wait_for(lock, std::chrono::seconds(1), [&]() {
+                return s.stopping || s.queued.load(std::memory_order_relaxed) >= kMaxBatch || s.flush_requested > s.flushed;
+            });
+            uint64_t ticket = s.flush_requested;
+            bool stopping = s.stopping;
+            auto exporter = s.exporter;
+            lock.unlock();
+            std::vector<SpanData> batch = drain(s);
+            if (!batch.empty() && exporter) {
+                try {
+                    exporter->exportSpans(batch);
+                } catch (const std::exception& e) {
+                    AGENTS_LOG_WARN("Span export failed: {}", e.what());
+                }
+            }
+            lock.lock();
+            s.flushed = ticket;
+            s.flushed_cv.notify_all();
+            if (stopping) {
+                s.flushed = s.flush_requested;
+                s.flushed_cv.notify_all();
+                return;
+            }
+        }
+    }
+
+    static std::string hex(uint64_t value) {
+        char buffer[17];
+        std::snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(value));
+        return buffer;
+    }
+
+    static JsonObject otlpValue(const JsonObject& value) {
+        if (value.is_string()) return {{"stringValue", value.get<std::string>()}};
+        if (value.is_boolean()) return {{"boolValue", value.get<bool>()}};
+        if (value.is_number_integer()) return {{"intValue", value.dump()}};
+        if (value.is_number_float()) return {{"doubleValue", value.get<double>()}};
+        if (value.is_array()) {
+            JsonObject values = JsonObject::array();
+            for (const auto& item : value) values.push_back(otlpValue(item));
+            return {{"arrayValue", {{"values", std::move(values)}}}};
+        }
+        if (value.is_object()) {
+            return {{"kvlistValue", {{"values", otlpAttributes(value)}}}};
+        }
+        return {{"stringValue", ""}};
+    }
+
+    static JsonObject otlpAttributes(const JsonObject& attributes) {
+        JsonObject list = JsonObject::array();
+        if (attributes.is_object()) {
+            for (const auto& [key, value] : attributes.items()) {
+                list.push_back({{"key", key}, {"value", otlpValue(value)}});
+            }
+        }
+        return list;
+    }
+/*! @endcond */
+};
+
+/**
+ * @brief A timed operation in a trace, current on its thread while open
+ *
+ * Spans nest through the thread-local TraceContext, which Task and offload()
+ * carry across suspension, so a span opened inside a coroutine parents the
+ * spans of everything it awaits. The span ends when it goes out of scope or
+ * when end() is called.
+ *
+ * @code
+ * Span span("summarize");
+ * span.setAttribute("input.length", input.size());
+ * auto result = co_await llm->chatAsync(input);
+ * @endcode
+ */
+class Span {
+public:
+    /**
+     * @brief Open a span as a child of the current one
+     * @param name The span name
+     * @param kind The span kind
+     */
+    explicit Span(std::string_view name, SpanKind kind = SpanKind::INTERNAL) {
+        if (!Tracer::enabled()) return;
+        TraceContext& current = TraceContext::current();
+        if (current.decided && !current.sampled) return;
+        start(name, kind, current);
+    }
+
+    /**
+     * @brief Destructor; ends the span
+     */
+    ~Span() {
+        if (restore_ || data_) end();
+    }
+
+    Span(const Span&) = delete;
+    Span& operator=(const Span&) = delete;
+
+    /**
+     * @brief Whether the span is being recorded
+     * @return true if attributes and events will be exported
+     */
+    bool isRecording() const noexcept { return data_ != nullptr; }
+
+    /**
+     * @brief Set an attribute
+     * @tparam V Any type convertible to JsonObject
+     * @param key The attribute key
+     * @param value The attribute value
+     * @return This span
+     */
+    template <typename V>
+    Span& setAttribute(std::string_view key, V&& value) {
+        if (data_) data_->attributes[std::string(key)] = std::forward<V>(value);
+        return *this;
+    }
+
+    /**
+     * @brief Record an event at the current time
+     * @param name The event name
+     * @param attributes The event attributes
+     * @return This span
+     */
+    Span& addEvent(std::string_view name, JsonObject attributes = JsonObject::object()) {
+        if (data_) data_->events.push_back({std::string(name), Tracer::nowUnixNano(), std::move(attributes)});
+        return *this;
+    }
+
+    /**
+     * @brief Mark the span as failed
+     * @param message Description of the failure
+     * @return This span
+     */
+    Span& setError(std::string_view message) {
+        if (data_) {
+            data_->error = true;
+            data_->status_message = std::string(message);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief The context of this span, for propagating it to another thread
+     * @return The span's context, or the current one if not recording
+     */
+    TraceContext context() const noexcept {
+        return data_ ? data_->context : TraceContext::current();
+    }
+
+    /**
+     * @brief Stop being the current span without ending it
+     *
+     * For a span that stays open across suspensions nothing carries the
+     * trace context over, such as the yields of an AsyncGenerator: the
+     * thread gets its previous context back now, and the span still ends
+     * when it goes out of scope. Install context() around the work it
+     * should parent.
+     */
+    void detach() noexcept {
+        if (restore_) {
+            TraceContext::current() = previous_;
+            restore_ = false;
+        }
+    }
+
+    /**
+     * @brief End the span and hand it to the exporter; later calls do nothing
+     */
+    void end() {
+        if (data_) {
+            data_->end_time_unix_nano = Tracer::nowUnixNano();
+            Tracer::submit(std::move(*data_));
+            data_.reset();
+        }
+        if (restore_) {
+            TraceContext::current() = previous_;
+            restore_ = false;
+        }
+    }
+
+/*! @cond PRIVATE */
+private:
+    std::unique_ptr<SpanData> data_;
+    TraceContext previous_;
+    bool restore_ = false;
+
+    void start(std::string_view name, SpanKind kind, TraceContext& current) {
+        previous_ = current;
+        restore_ = true;
+        TraceContext context;
+        if (current.decided) {
+            context.trace_id_high = current.trace_id_high;
+            context.trace_id_low = current.trace_id_low;
+        } else {
+            context.trace_id_high = Tracer::randomId();
+            context.trace_id_low = Tracer::randomId();
+            context.decided = true;
+            if (!Tracer::sampled(context.trace_id_low)) {
+                // Unsampled root: children see the decision and stay no-ops
+                current = Tracer::suppressed();
+                return;
+            }
+        }
+        context.span_id = Tracer::randomId();
+        context.sampled = true;
+        context.decided = true;
+        data_ = std::make_unique<SpanData>();
+        data_->name = std::string(name);
+        data_->kind = kind;
+        data_->context = context;
+        data_->parent_span_id = current.span_id;
+        data_->start_time_unix_nano = Tracer::nowUnixNano();
+        current = context;
+    }
+/*! @endcond */
+};
+
+/**
+ * @brief Exporter that appends one OTLP/JSON ExportTraceServiceRequest per line to a file
+ *
+ * The file can be replayed into a collector with its `otlpjsonfile` receiver.
+ */
+class OtlpFileExporter : public SpanExporter {
+public:
+    /**
+     * @brief Constructor
+     * @param path The output file (appended to; parent directories are created)
+     * @param service_name Value of the `service.name` resource attribute
+     * @throws std::runtime_error if the file cannot be opened
+     */
+    explicit OtlpFileExporter(const std::filesystem::path& path, std::string service_name = "agents-cpp")
+        : service_name_(std::move(service_name)) {
+        if (path.has_parent_path()) {
+            std::filesystem::create_directories(path.parent_path());
+        }
+        out_.open(path, std::ios::app);
+        if (!out_) {
+            throw std::runtime_error("Failed to open trace file: " + path.string());
+        }
+    }
+
+    /**
+     * @brief Append the batch as one line
+     * @param spans The spans
+     */
+    void exportSpans(const std::vector<SpanData>& spans) override {
+        out_ << Tracer::toOtlpJson(spans, service_name_).dump() << '\n';
+        out_.flush();
+    }
+
+/*! @cond PRIVATE */
+private:
+    std::string service_name_;
+    std::ofstream out_;
+/*! @endcond */
+};
+
+} // namespace agents
@@ -11,6 +11,9 @@
 
 #include <agents-cpp/types.h>
 
+#include <cstdint>
+#include <string_view>
+
 namespace agents {
 
 /**
@@ -48,6 +51,62 @@ public:
         std::transform(result.begin(), result.end(), result.begin(), [](unsigned char c){ return static_cast<char>(std::tolower(c)); });
         return result;
     }
+
+    /**
+     * @brief Hash a string with 64-bit FNV-1a
+     *
+     * Stable across runs and platforms, so it can key caches on disk. Not
+     * cryptographic.
+     *
+     * @param data The data to hash
+     * @return The hash
+     */
+    static uint64_t hash64(std::string_view data) {
+        uint64_t hash = 14695981039346656037ull;
+        for (unsigned char c : data) {
+            hash ^= c;
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    /**
+     * @brief Hash a string to 16 hex digits (hash64() as hex)
+     * @param data The data to hash
+     * @return The hash as lowercase hex
+     */
+    static std::string hashHex(const std::string& data) {
+        uint64_t hash = hash64(data);
+        static const char digits[] = "0123456789abcdef";
+        std::string hex(16, '0');
+        for (size_t i = 16; i-- > 0; hash >>= 4) {
+            hex[i] = digits[hash & 0xf];
+        }
+        return hex;
+    }
+
+    /**
+     * @brief Parse a JSON object out of an LLM response
+     *
+     * Accepts bare JSON as well as JSON wrapped in prose or a markdown code
+     * fence, by parsing the span from the first `{` to the last `}`.
+     *
+     * @param text The response text
+     * @return The parsed object, or a null JSON value if none could be parsed
+     */
+    static JsonObject parseJsonResponse(const std::string& text) {
+        JsonObject parsed = JsonObject::parse(text, nullptr, false);
+        if (!parsed.is_discarded() && parsed.is_object()) {
+            return parsed;
+        }
+        size_t begin = text.find('{');
+        size_t end = text.rfind('}');
+        if (begin == std::string::npos || end == std::string::npos || end < begin) {
+            return JsonObject();
+        }
+        parsed = JsonObject::parse(text.substr(begin, end - begin + 1), nullptr, false);
+        return parsed.is_discarded() ? JsonObject() : parsed;
+    }
 };
 
 } // namespace agents
\ No newline at end of file
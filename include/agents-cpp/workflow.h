@@ -10,6 +10,8 @@
 #pragma once
 
 #include <agents-cpp/context.h>
+#include <agents-cpp/coroutine_utils.h>
+#include <agents-cpp/tracing.h>
 #include <agents-cpp/types.h>
 #include <functional>
 #include <memory>
@@ -57,6 +59,30 @@ public:
         std::function<void(const JsonObject&)> callback
     );
 
+    /**
+     * @brief Run the workflow as a coroutine by offloading run()
+     *
+     * This is not a non-blocking run: run() is compiled into the library
+     * and blocks on its LLM and tool calls, so the whole of run() executes
+     * on one executor thread, which stays blocked until run() returns, and a
+     * workflow nested inside run() (such as a route's workflow) blocks
+     * another. Only the awaiting coroutine is freed. runTask() is not
+     * virtual, since adding a virtual here would change the layout of the
+     * workflows the library builds; called through a Workflow reference or a
+     * derived type, it yields what run() returns.
+     *
+     * The input is taken by value because the task starts lazily; the
+     * workflow must outlive the task.
+     *
+     * @param input The user input
+     * @return Task yielding the result
+     */
+    Task<JsonObject> runTask(std::string input) {
+        Span span("workflow.run");
+        span.setAttribute("workflow.type", "custom");
+        co_return co_await offload([&]() { return run(input); });
+    }
+
     /**
      * @brief Get the workflow's context
      * @return The context
@@ -104,6 +130,32 @@ protected:
      * @param result The result
      */
     void logStep(const std::string& description, const JsonObject& result);
+
+    /**
+     * @brief Run run() with another LLM in place of the context's
+     *
+     * run() sees a copy of the context that shares its memory and tools but
+     * answers getLLM() with `llm`. Only this workflow's context pointer is
+     * swapped, so other users of the context are unaffected; it is restored
+     * when run() returns or throws.
+     *
+     * @param input The user input
+     * @param llm The LLM for the run, e.g. a decorator around the context's
+     * @return What run() returns
+     */
+    JsonObject runWithLLM(const std::string& input, std::shared_ptr<LLMInterface> llm) {
+        auto context = std::make_shared<Context>(*context_);
+        context->setLLM(std::move(llm));
+        context_.swap(context);
+        try {
+            JsonObject result = run(input);
+            context_.swap(context);
+            return result;
+        } catch (...) {
+            context_.swap(context);
+            throw;
+        }
+    }
 /*! @endcond */
 };
 
@@ -0,0 +1,769 @@
+/**
+ * @file bounded_parallelization_workflow.h
+ * @brief Bounded-concurrency Parallelization Workflow with streaming aggregation
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025 Edge AI, LLC. All rights reserved.
+ *
+ */
+#pragma once
+
+#include <agents-cpp/workflows/parallelization_workflow.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace agents {
+namespace workflows {
+
+/**
+ * @brief Aggregator that consumes task results as they complete
+ *
+ * `add()` is called once per task, in completion order, on the thread that
+ * called `run()`, so implementations need no locking.
+ */
+class IncrementalAggregator {
+public:
+    /**
+     * @brief Destructor
+     */
+    virtual ~IncrementalAggregator() = default;
+
+    /**
+     * @brief Prepare for a new run
+     * @param total_tasks The number of tasks in the run
+     */
+    virtual void reset(size_t total_tasks) { (void)total_tasks; }
+
+    /**
+     * @brief Consume one task result
+     * @param task_name The name of the task
+     * @param result The task result (contains `error` when the task failed or timed out)
+     */
+    virtual void add(const std::string& task_name, const JsonObject& result) = 0;
+
+    /**
+     * @brief Snapshot of the aggregate so far (reported through the step callback)
+     * @return The partial aggregate
+     */
+    virtual JsonObject partial() const { return JsonObject::object(); }
+
+    /**
+     * @brief Whether further results can no longer change the outcome
+     * @note When this returns true the workflow cancels the remaining tasks.
+     * @return True once the outcome is settled
+     */
+    virtual bool decided() const { return false; }
+
+    /**
+     * @brief Widen the current run (used by adaptive voting)
+     * @param total_tasks The new number of tasks in the run
+     */
+    virtual void expand(size_t total_tasks) { (void)total_tasks; }
+
+    /**
+     * @brief Produce the final aggregate
+     * @return The aggregated result
+     */
+    virtual JsonObject finish() = 0;
+};
+
+/**
+ * @brief Incremental aggregator for the sectioning strategy
+ *
+ * Keeps each section's result under its task name and joins the `response`
+ * fields into `answer` in task registration order.
+ */
+class SectioningAggregator : public IncrementalAggregator {
+public:
+    /**
+     * @brief Constructor
+     * @param task_order The task names in registration order
+     */
+    explicit SectioningAggregator(std::vector<std::string> task_order = {}) : task_order_(std::move(task_order)) {}
+
+    /**
+     * @brief Prepare for a new run
+     * @param total_tasks The number of tasks in the run
+     */
+    void reset(size_t total_tasks) override {
+        (void)total_tasks;
+        sections_ = JsonObject::object();
+    }
+
+    /**
+     * @brief Consume one section result
+     * @param task_name The name of the task
+     * @param result The task result
+     */
+    void add(const std::string& task_name, const JsonObject& result) override {
+        sections_[task_name] = result;
+    }
+
+    /**
+     * @brief Sections completed so far
+     * @return The partial aggregate
+     */
+    JsonObject partial() const override {
+        return JsonObject{{"completed", sections_.size()}};
+    }
+
+    /**
+     * @brief Join the sections
+     * @return The aggregated result with `answer` and `sections`
+     */
+    JsonObject finish() override {
+        std::string answer;
+        auto append = [&answer](const JsonObject& result) {
+            if (result.contains("response") && result["response"].is_string()) {
+                if (!answer.empty()) answer += "\n\n";
+                answer += result["response"].get<std::string>();
+            }
+        };
+        if (!task_order_.empty()) {
+            for (const auto& name : task_order_) {
+                if (sections_.contains(name)) append(sections_[name]);
+            }
+        } else {
+            for (const auto& [name, result] : sections_.items()) append(result);
+        }
+        return JsonObject{{"answer", answer}, {"sections", sections_}};
+    }
+
+private:
+    std::vector<std::string> task_order_;
+    JsonObject sections_ = JsonObject::object();
+};
+
+/**
+ * @brief Incremental aggregator for the voting strategy
+ *
+ * Counts normalized (trimmed, case-insensitive) `response` values and
+ * returns the most common one as `answer`.
+ */
+class VotingAggregator : public IncrementalAggregator {
+public:
+    /**
+     * @brief Constructor
+     * @param threshold Fraction of all voters the winner needs for consensus
+     */
+    explicit VotingAggregator(double threshold = 0.5) : threshold_(threshold) {}
+
+    /**
+     * @brief Prepare for a new run
+     * @param total_tasks The number of voters
+     */
+    void reset(size_t total_tasks) override {
+        total_ = total_tasks;
+        received_ = 0;
+        counts_.clear();
+        first_response_.clear();
+    }
+
+    /**
+     * @brief Count one vote
+     * @param task_name The name of the voter
+     * @param result The voter result
+     */
+    void add(const std::string& task_name, const JsonObject& result) override {
+        (void)task_name;
+        received_++;
+        if (result.contains("error")) {
+            return;
+        }
+        std::string response = result.contains("response") && result["response"].is_string()
+            ? result["response"].get<std::string>() : result.dump();
+        std::string key = normalize(response);
+        if (counts_[key]++ == 0) {
+            first_response_[key] = response;
+        }
+    }
+
+    /**
+     * @brief Current leader and vote counts
+     * @return The partial aggregate
+     */
+    JsonObject partial() const override {
+        auto [key, votes] = leader();
+        return JsonObject{{"leader", key.empty() ? "" : first_response_.at(key)}, {"votes", votes}, {"received", received_}, {"total", total_}};
+    }
+
+    /**
+     * @brief Whether the vote is settled
+     *
+     * True once the leader holds the threshold share of all voters, or leads
+     * the runner-up by more than the number of outstanding votes.
+     *
+     * @return True once the remaining votes cannot change the winner
+     */
+    bool decided() const override {
+        if (counts_.empty()) {
+            return false;
+        }
+        size_t best = 0, second = 0;
+        for (const auto& [key, count] : counts_) {
+            if (count > best) {
+                second = best;
+                best = count;
+            } else if (count > second) {
+                second = count;
+            }
+        }
+        const size_t outstanding = total_ > received_ ? total_ - received_ : 0;
+        if (best > second + outstanding) {
+            return true;
+        }
+        return static_cast<double>(best) >= threshold_ * static_cast<double>(total_) && best > second;
+    }
+
+    /**
+     * @brief Add voters to the run
+     * @param total_tasks The new number of voters
+     */
+    void expand(size_t total_tasks) override {
+        total_ = std::max(total_, total_tasks);
+    }
+
+    /**
+     * @brief Pick the winner
+     * @return The aggregated result with `answer`, `votes`, `agreement` and `consensus`
+     */
+    JsonObject finish() override {
+        auto [key, votes] = leader();
+        double agreement = total_ > 0 ? static_cast<double>(votes) / static_cast<double>(total_) : 0.0;
+        return JsonObject{
+            {"answer", key.empty() ? "" : first_response_.at(key)},
+            {"votes", votes},
+            {"received", received_},
+            {"total", total_},
+            {"agreement", agreement},
+            {"consensus", agreement >= threshold_}
+        };
+    }
+
+/*! @cond PRIVATE */
+protected:
+    /**
+     * @brief Consensus threshold as a fraction of all voters
+     */
+    double threshold_;
+    /**
+     * @brief Number of voters in the run
+     */
+    size_t total_ = 0;
+    /**
+     * @brief Number of results received
+     */
+    size_t received_ = 0;
+    /**
+     * @brief Vote count per normalized response
+     */
+    std::map<std::string, size_t> counts_;
+    /**
+     * @brief First original response seen per normalized response
+     */
+    std::map<std::string, std::string> first_response_;
+
+    /**
+     * @brief Normalize a response for comparison
+     * @param s The response
+     * @return Trimmed, lowercased response
+     */
+    static std::string normalize(const std::string& s) {
+        size_t begin = s.find_first_not_of(" \t\r\n.");
+        if (begin == std::string::npos) return "";
+        size_t end = s.find_last_not_of(" \t\r\n.");
+        std::string out = s.substr(begin, end - begin + 1);
+        std::transform(out.begin(), out.end(), out.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return out;
+    }
+
+    /**
+     * @brief The response with the most votes
+     * @return Normalized response and its vote count
+     */
+    std::pair<std::string, size_t> leader() const {
+        std::pair<std::string, size_t> best{"", 0};
+        for (const auto& [key, count] : counts_) {
+            if (count > best.second) best = {key, count};
+        }
+        return best;
+    }
+/*! @endcond */
+};
+
+/**
+ * @brief Parallelization workflow with a concurrency cap, per-task timeouts
+ * and results aggregated as they complete
+ *
+ * @details Accepts the same tasks and strategies as ParallelizationWorkflow,
+ * but at most `max_concurrency` tasks are in flight at once, which keeps
+ * workflows with hundreds of sections within provider rate limits. Each
+ * completed task is handed to an IncrementalAggregator immediately and
+ * reported through the step callback together with the partial aggregate.
+ *
+ * A task that exceeds its timeout is recorded as failed and stops counting
+ * against the concurrency limit; its request is abandoned and a late result
+ * is ignored.
+ *
+ * With the VOTING strategy the run returns as soon as the vote is settled
+ * (see VotingAggregator::decided()); voters not yet sent are skipped and
+ * in-flight ones are abandoned. Adaptive voting goes further and starts
+ * with only a few voters, enlisting more only while they disagree.
+ */
+class BoundedParallelizationWorkflow : public Workflow {
+public:
+    /**
+     * @brief Parallelization strategy (same as ParallelizationWorkflow)
+     */
+    using Strategy = ParallelizationWorkflow::Strategy;
+
+    /**
+     * @brief Task definition (same as ParallelizationWorkflow)
+     */
+    using Task = ParallelizationWorkflow::Task;
+
+    /**
+     * @brief Constructor with context
+     * @param context The context of the workflow
+     * @param strategy The strategy of the workflow
+     */
+    BoundedParallelizationWorkflow(
+        std::shared_ptr<Context> context,
+        Strategy strategy = Strategy::SECTIONING
+    ) : Workflow(std::move(context)), strategy_(strategy) {}
+
+    /**
+     * @brief Destructor
+     */
+    virtual ~BoundedParallelizationWorkflow() = default;
+
+    /**
+     * @brief Add a task to the workflow
+     * @param task The task to add
+     */
+    void addTask(const Task& task) { tasks_.push_back(task); }
+
+    /**
+     * @brief Add a task to the workflow with basic params
+     * @param name The name of the task
+     * @param prompt_template The prompt template (system prompt) of the task
+     * @param context The context of the task
+     */
+    void addTask(
+        const std::string& name,
+        const std::string& prompt_template,
+        const JsonObject& context = JsonObject()
+    ) {
+        tasks_.emplace_back(name, prompt_template, context);
+    }
+
+    /**
+     * @brief Add a task to the workflow with generators and parser
+     * @param name The name of the task
+     * @param prompt_template The prompt template (system prompt) of the task
+     * @param prompt_fn The prompt function of the task
+     * @param result_parser The result parser of the task
+     * @param context The context of the task
+     */
+    void addTask(
+        const std::string& name,
+        const std::string& prompt_template,
+        std::function<std::string(const std::string&)> prompt_fn,
+        std::function<JsonObject(const std::string&)> result_parser,
+        const JsonObject& context = JsonObject()
+    ) {
+        tasks_.emplace_back(name, prompt_template, context, prompt_fn, result_parser);
+    }
+
+    /**
+     * @brief Set the strategy
+     * @param strategy The strategy
+     */
+    void setStrategy(Strategy strategy) { strategy_ = strategy; }
+
+    /**
+     * @brief Set the voting threshold (for VOTING mode)
+     * @param threshold Fraction of voters that must agree
+     */
+    void setVotingThreshold(double threshold) { voting_threshold_ = threshold; }
+
+    /**
+     * @brief Set the maximum number of tasks in flight
+     * @note Requests abandoned after a timeout or an early stop keep their
+     * slot until they return, so the workflow never has more than this many
+     * requests running, across runs.
+     * @param max_concurrency The cap (0 runs every task at once)
+     */
+    void setMaxConcurrency(size_t max_concurrency) { max_concurrency_ = max_concurrency; }
+
+    /**
+     * @brief Set the per-task timeout
+     * @param timeout_ms Timeout in milliseconds (0 disables it)
+     */
+    void setTaskTimeout(int timeout_ms) { task_timeout_ms_ = timeout_ms; }
+
+    /**
+     * @brief Stop as soon as the aggregator reports the outcome settled
+     * @note On by default; voting returns once a quorum is reached or the
+     * leader can no longer be beaten, and the remaining voters are cancelled.
+     * @param early_stop Whether to stop early
+     */
+    void setEarlyStop(bool early_stop) { early_stop_ = early_stop; }
+
+    /**
+     * @brief Enable adaptive voting (for VOTING mode)
+     *
+     * Runs only the first `initial_voters` tasks, and enlists `increment`
+     * more at a time while the vote stays undecided.
+     *
+     * @param initial_voters Voters in the first round (0 disables adaptive voting)
+     * @param increment Voters added per extra round
+     */
+    void setAdaptiveVoting(size_t initial_voters = 3, size_t increment = 2) {
+        adaptive_initial_voters_ = initial_voters;
+        adaptive_voter_increment_ = increment;
+    }
+
+    /**
+     * @brief Set a batch aggregator over all results (in task order)
+     * @note Ignored when an incremental aggregator is set.
+     * @param aggregator The aggregation function
+     */
+    void setAggregator(std::function<JsonObject(const std::vector<JsonObject>&)> aggregator) {
+        aggregator_ = std::move(aggregator);
+    }
+
+    /**
+     * @brief Set an aggregator that consumes results as they complete
+     * @param aggregator The incremental aggregator
+     */
+    void setIncrementalAggregator(std::shared_ptr<IncrementalAggregator> aggregator) {
+        incremental_aggregator_ = std::move(aggregator);
+    }
+
+    /**
+     * @brief Execute the workflow with input
+     * @param input The input to the workflow
+     * @return The output of the workflow
+     */
+    JsonObject run(const std::string& input) override {
+        Span span("workflow.run");
+        span.setAttribute("workflow.type", "bounded_parallelization");
+        auto llm = context_->getLLM();
+        if (!llm) {
+            throw std::runtime_error("No LLM configured on the context");
+        }
+        if (tasks_.empty()) {
+            return JsonObject{{"answer", ""}, {"error", "No tasks configured"}};
+        }
+
+        auto aggregator = selectAggregator();
+        std::vector<JsonObject> ordered(tasks_.size());
+
+        // Adaptive voting enlists a few voters first and widens only on disagreement
+        const bool adaptive = strategy_ == Strategy::VOTING && adaptive_initial_voters_ > 0;
+        size_t enlisted = adaptive ? std::min(adaptive_initial_voters_, tasks_.size()) : tasks_.size();
+        aggregator->reset(enlisted);
+
+        size_t completed = 0, cancelled = 0, begin = 0;
+        auto on_result = [&](size_t index, JsonObject result, bool was_cancelled) {
+            if (was_cancelled) {
+                cancelled++;
+                ordered[index] = std::move(result);
+                return;
+            }
+            completed++;
+            aggregator->add(tasks_[index].name, result);
+            logStep("Task completed: " + tasks_[index].name, JsonObject{
+                {"task", tasks_[index].name},
+                {"result", result},
+                {"completed", completed},
+                {"total", enlisted},
+                {"partial", aggregator->partial()}
+            });
+            ordered[index] = std::move(result);
+        };
+        auto settled = [&]() { return early_stop_ && aggregator->decided(); };
+
+        while (true) {
+            runBounded(llm, input, on_result, settled, begin, enlisted);
+            if (!adaptive || aggregator->decided() || enlisted == tasks_.size()) {
+                break;
+            }
+            begin = enlisted;
+            enlisted = std::min(enlisted + std::max<size_t>(adaptive_voter_increment_, 1), tasks_.size());
+            aggregator->expand(enlisted);
+            logStep("Voters disagree, widening vote", JsonObject{{"voters", enlisted}, {"partial", aggregator->partial()}});
+        }
+
+        if (!incremental_aggregator_ && aggregator_) {
+            return aggregator_(ordered);
+        }
+        JsonObject output = aggregator->finish();
+        if (strategy_ == Strategy::VOTING && output.is_object()) {
+            output["voters"] = enlisted;
+            output["cancelled"] = cancelled;
+        }
+        return output;
+    }
+
+/*! @cond PRIVATE */
+protected:
+    /**
+     * @brief Tasks to execute
+     */
+    std::vector<Task> tasks_;
+
+    /**
+     * @brief Strategy to use
+     */
+    Strategy strategy_;
+
+    /**
+     * @brief Voting threshold
+     */
+    double voting_threshold_ = 0.5;
+
+    /**
+     * @brief Maximum tasks in flight (0 = unbounded)
+     */
+    size_t max_concurrency_ = 8;
+
+    /**
+     * @brief Per-task timeout in milliseconds (0 = none)
+     */
+    int task_timeout_ms_ = 0;
+
+    /**
+     * @brief Whether to stop once the outcome is settled
+     */
+    bool early_stop_ = true;
+
+    /**
+     * @brief Voters in the first adaptive round (0 = adaptive voting off)
+     */
+    size_t adaptive_initial_voters_ = 0;
+
+    /**
+     * @brief Voters added per adaptive round
+     */
+    size_t adaptive_voter_increment_ = 2;
+
+    /**
+     * @brief Requests running on the executor, shared by every run of this workflow
+     */
+    struct Workers {
+        /**
+         * @brief Guards every field here and the per-run state
+         */
+        std::mutex mutex;
+        /**
+         * @brief Signalled when a request finishes
+         */
+        std::condition_variable cv;
+        /**
+         * @brief Requests started and not yet returned, abandoned ones included
+         */
+        size_t active = 0;
+    };
+
+    /**
+     * @brief Worker accounting; outlives the workflow while requests are abandoned
+     */
+    std::shared_ptr<Workers> workers_ = std::make_shared<Workers>();
+
+    /**
+     * @brief Batch aggregator
+     */
+    std::function<JsonObject(const std::vector<JsonObject>&)> aggregator_;
+
+    /**
+     * @brief Incremental aggregator
+     */
+    std::shared_ptr<IncrementalAggregator> incremental_aggregator_;
+
+    /**
+     * @brief Pick the aggregator for a run
+     * @return The incremental aggregator to feed
+     */
+    std::shared_ptr<IncrementalAggregator> selectAggregator() const {
+        if (incremental_aggregator_) {
+            return incremental_aggregator_;
+        }
+        if (strategy_ == Strategy::VOTING) {
+            return std::make_shared<VotingAggregator>(voting_threshold_);
+        }
+        std::vector<std::string> order;
+        order.reserve(tasks_.size());
+        for (const auto& task : tasks_) order.push_back(task.name);
+        return std::make_shared<SectioningAggregator>(std::move(order));
+    }
+
+    /**
+     * @brief Execute a single task against the LLM
+     * @param llm The LLM
+     * @param task The task
+     * @param input The workflow input
+     * @return The task result
+     */
+    static JsonObject executeTask(const std::shared_ptr<LLMInterface>& llm, const Task& task, const std::string& input) {
+        std::string prompt = task.prompt_fn ? task.prompt_fn(input) : input;
+        if (!task.context.is_null() && !task.context.empty()) {
+            prompt += "\n\nContext: " + task.context.dump();
+        }
+        std::vector<Message> messages;
+        if (!task.prompt_template.empty()) {
+            messages.push_back(Message{Message::Role::SYSTEM, task.prompt_template});
+        }
+        messages.push_back(Message{Message::Role::USER, prompt});
+        LLMResponse response = llm->chat(messages);
+        if (task.result_parser) {
+            return task.result_parser(response.content);
+        }
+        return JsonObject{{"response", response.content}};
+    }
+
+    /**
+     * @brief Run tasks with at most `max_concurrency_` in flight
+     *
+     * `on_result` is called on the calling thread, in completion order, once
+     * per task. `stop` is checked before each wait; once it returns true the
+     * unfinished tasks are delivered with the cancelled flag set (and an
+     * `error` of "cancelled" in their result). Requests run on the
+     * executor and check a per-run cancellation flag before they are sent,
+     * so tasks not yet sent when the run ends never are; late results from
+     * requests already sent are dropped. Abandoned requests keep counting
+     * against the cap until they return.
+     *
+     * @param llm The LLM
+     * @param input The workflow input
+     * @param on_result Called with each task's index, its result and whether it was cancelled
+     * @param stop Optional predicate checked after each result; true stops the run
+     * @param first Index of the first task to run
+     * @param last One past the last task to run (defaults to all)
+     */
+    void runBounded(
+        const std::shared_ptr<LLMInterface>& llm,
+        const std::string& input,
+        const std::function<void(size_t, JsonObject, bool)>& on_result,
+        const std::function<bool()>& stop = nullptr,
+        size_t first = 0,
+        std::optional<size_t> last = std::nullopt
+    ) {
+        using Clock = std::chrono::steady_clock;
+        // Guarded by workers->mutex
+        struct Run {
+            std::deque<std::pair<size_t, JsonObject>> done;
+            bool cancelled = false;
+        };
+        auto run = std::make_shared<Run>();
+        auto workers = workers_;
+
+        const size_t end = std::min(last.value_or(tasks_.size()), tasks_.size());
+        if (first >= end) {
+            return;
+        }
+        const size_t limit = max_concurrency_ == 0 ? std::numeric_limits<size_t>::max() : max_concurrency_;
+        std::map<size_t, Clock::time_point> in_flight; // index -> deadline
+        std::vector<bool> finished(end, false);
+        size_t next = first, remaining = end - first;
+
+        auto deliver = [&](size_t index, JsonObject result, bool cancelled = false) {
+            if (finished[index]) return;
+            finished[index] = true;
+            in_flight.erase(index);
+            remaining--;
+            on_result(index, std::move(result), cancelled);
+        };
+
+        while (remaining > 0) {
+            if (stop && stop()) {
+                for (size_t i = first; i < end; ++i) {
+                    if (!finished[i]) deliver(i, JsonObject{{"error", "cancelled"}}, true);
+                }
+                break;
+            }
+
+            std::vector<size_t> launch;
+            std::deque<std::pair<size_t, JsonObject>> batch;
+            {
+                std::unique_lock<std::mutex> lock(workers->mutex);
+                while (next < end && workers->active < limit) {
+                    workers->active++;
+                    launch.push_back(next++);
+                }
+                if (launch.empty()) {
+                    Clock::time_point deadline = Clock::time_point::max();
+                    for (const auto& [index, task_deadline] : in_flight) {
+                        deadline = std::min(deadline, task_deadline);
+                    }
+                    // Also wake when an abandoned request frees a slot
+                    auto ready = [&] { return !run->done.empty() || (next < end && workers->active < limit); };
+                    if (deadline == Clock::time_point::max()) {
+                        workers->cv.wait(lock, ready);
+                    } else {
+                        workers->cv.wait_until(lock, deadline, ready);
+                    }
+                    batch.swap(run->done);
+                }
+            }
+
+            for (size_t index : launch) {
+                in_flight[index] = task_timeout_ms_ > 0
+                    ? Clock::now() + std::chrono::milliseconds(task_timeout_ms_)
+                    : Clock::time_point::max();
+                getExecutor()->add([workers, run, llm, task = tasks_[index], input, index]() {
+                    bool cancelled;
+                    {
+                        std::lock_guard<std::mutex> lock(workers->mutex);
+                        cancelled = run->cancelled;
+                    }
+                    JsonObject result;
+                    if (!cancelled) {
+                        try {
+                            result = executeTask(llm, task, input);
+                        } catch (const std::exception& e) {
+                            result = JsonObject{{"error", e.what()}};
+                        }
+                    }
+                    std::lock_guard<std::mutex> lock(workers->mutex);
+                    workers->active--;
+                    if (!cancelled) {
+                        run->done.emplace_back(index, std::move(result));
+                    }
+                    workers->cv.notify_all();
+                });
+            }
+            for (auto& [index, result] : batch) {
+                deliver(index, std::move(result));
+            }
+
+            auto now = Clock::now();
+            std::vector<size_t> expired;
+            for (const auto& [index, task_deadline] : in_flight) {
+                if (task_deadline <= now) expired.push_back(index);
+            }
+            for (size_t index : expired) {
+                deliver(index, JsonObject{{"error", "timeout"}});
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(workers->mutex);
+        run->cancelled = true;
+    }
+/*! @endcond */
+};
+
+} // namespace workflows
+} // namespace agents
@@ -9,8 +9,12 @@
  */
 #pragma once
 
+#include <agents-cpp/memo_store.h>
+#include <agents-cpp/utils.h>
 #include <agents-cpp/workflow.h>
+#include <algorithm>
 #include <functional>
+#include <stdexcept>
 #include <vector>
 
 namespace agents {
@@ -50,6 +54,181 @@ public:
      */
     JsonObject run(const std::string& input) override;
 
+    /**
+     * @brief Execute the workflow with best-of-N candidates per iteration
+     *
+     * Each iteration generates `candidates` responses concurrently and scores
+     * them concurrently, optionally with one evaluator call per criterion
+     * (scores are averaged). The best candidate so far is kept and refined in
+     * the next iteration, and the loop stops as soon as it reaches the
+     * improvement threshold, so each iteration costs two serial round trips
+     * regardless of N.
+     *
+     * Candidates after the first are asked for a distinct draft so the N
+     * requests do not collapse onto one answer. LLMOptions belong to the LLM
+     * instance and are shared by concurrent calls, so to also vary sampling,
+     * pass LLMs configured with different temperatures as `candidate_llms`;
+     * candidate i uses `candidate_llms[i % size]`.
+     *
+     * Custom optimizer and evaluator functions are honoured as in run() and
+     * may be called from several threads at once; an empty result falls
+     * back to the LLM. The optimizer's feedback object also carries
+     * `candidate` (0-based index) and `candidates` (N), since it receives the
+     * same input and feedback for every candidate of an iteration and must
+     * use them to produce distinct drafts. A custom evaluator is called once
+     * per candidate and scores the whole response; `per_criterion` only
+     * splits the LLM scoring of candidates it returns no score for.
+     *
+     * @param input The input to execute the workflow with
+     * @param candidates Candidates generated per iteration
+     * @param per_criterion Whether to score each criterion in its own call
+     * @param candidate_llms Optional optimizer LLMs to rotate through (defaults to the context LLM)
+     * @return The result with `final_response`, `final_score`, `iterations` and `evaluations`
+     */
+    JsonObject runBestOfN(const std::string& input, size_t candidates = 3, bool per_criterion = false,
+                          std::vector<std::shared_ptr<LLMInterface>> candidate_llms = {}) {
+        return blockingWait(runBestOfNTask(input, candidates, per_criterion, std::move(candidate_llms)));
+    }
+
+    /**
+     * @brief Execute the best-of-N loop as a coroutine
+     *
+     * Same as runBestOfN(), with every optimizer and evaluator call offloaded
+     * to the executor so the workflow holds no thread while it waits.
+     *
+     * @param input The input to execute the workflow with
+     * @param candidates Candidates generated per iteration
+     * @param per_criterion Whether to score each criterion in its own call
+     * @param candidate_llms Optional optimizer LLMs to rotate through (defaults to the context LLM)
+     * @return Task yielding `final_response`, `final_score`, `iterations` and `evaluations`
+     */
+    Task<JsonObject> runBestOfNTask(std::string input, size_t candidates = 3, bool per_criterion = false,
+                                    std::vector<std::shared_ptr<LLMInterface>> candidate_llms = {}) {
+        auto llm = context_->getLLM();
+        if (!llm) {
+            throw std::runtime_error("No LLM configured on the context");
+        }
+        auto evaluator_llm = evaluator_llm_ ? evaluator_llm_ : llm;
+        candidates = std::max<size_t>(candidates, 1);
+        const bool split = per_criterion && !evaluation_criteria_.empty();
+        candidate_llms.erase(std::remove(candidate_llms.begin(), candidate_llms.end(), nullptr), candidate_llms.end());
+        if (candidate_llms.empty()) {
+            candidate_llms.push_back(llm);
+        }
+
+        std::string best_response;
+        double best_score = -1.0;
+        JsonObject best_feedback = JsonObject::object();
+        JsonObject evaluations = JsonObject::array();
+        int iteration = 0;
+
+        while (iteration < std::max(max_iterations_, 1)) {
+            iteration++;
+            // Generate
+            std::vector<Task<std::string>> drafts;
+            for (size_t i = 0; i < candidates; ++i) {
+                drafts.push_back(generateCandidateTask(candidate_llms[i % candidate_llms.size()], input,
+                                                       best_response, best_feedback, i, candidates));
+            }
+            std::vector<std::string> responses = co_await whenAll(std::move(drafts));
+
+            // Score every candidate, and every criterion when split, at once
+            std::vector<Task<JsonObject>> scoring;
+            for (const auto& response : responses) {
+                scoring.push_back(scoreCandidateTask(evaluator_llm, input, response, split));
+            }
+            std::vector<JsonObject> scored = co_await whenAll(std::move(scoring));
+
+            JsonObject candidate_scores = JsonObject::array();
+            size_t round_best = 0;
+            double round_best_score = -1.0;
+            for (size_t c = 0; c < responses.size(); ++c) {
+                double score = scored[c]["score"].get<double>();
+                candidate_scores.push_back(score);
+                if (score > round_best_score) {
+                    round_best = c;
+                    round_best_score = score;
+                }
+            }
+
+            JsonObject evaluation{
+                {"iteration", iteration},
+                {"score", round_best_score},
+                {"feedback", joinFeedback(scored[round_best]["feedback"], scored[round_best].value("per_criterion", false))},
+                {"candidate_scores", candidate_scores}
+            };
+            logStep("Best-of-N iteration", evaluation);
+            evaluations.push_back(evaluation);
+
+            if (round_best_score > best_score) {
+                best_score = round_best_score;
+                best_response = responses[round_best];
+                best_feedback = JsonObject{{"score", best_score}, {"feedback", evaluation["feedback"]}};
+            }
+            if (best_score >= improvement_threshold_) {
+                break;
+            }
+        }
+
+        co_return JsonObject{
+            {"final_response", best_response},
+            {"final_score", best_score},
+            {"iterations", iteration},
+            {"candidates_per_iteration", candidates},
+            {"evaluations", evaluations}
+        };
+    }
+
+    /**
+     * @brief Execute the workflow as a coroutine
+     *
+     * Runs run() on the executor (see Workflow::runTask()), so the result is
+     * what run() returns.
+     */
+    using Workflow::runTask;
+
+    /**
+     * @brief Execute the workflow as a coroutine, memoizing LLM calls
+     *
+     * Runs run() with the context LLM wrapped in a MemoizingLLM as step
+     * `optimizer` and the evaluator LLM (when one is set) as step
+     * `evaluator`, so the loop sends the same prompts and returns the same
+     * result as without memoization; only calls already in the store are not
+     * sent. Without a separate evaluator LLM, both roles share the `optimizer`
+     * step and are still told apart by their messages. The step callback
+     * receives a `Memo` entry with the hit rate at the end.
+     *
+     * @param input The input to execute the workflow with
+     * @param memo The store and workflow id (no memoization when the store is null)
+     * @return Task yielding what run() returns
+     */
+    Task<JsonObject> runTask(std::string input, Memoization memo) {
+        if (!memo.store) {
+            co_return co_await Workflow::runTask(std::move(input));
+        }
+        Span span("workflow.run");
+        span.setAttribute("workflow.type", "evaluator");
+        auto llm = context_->getLLM();
+        if (!llm) {
+            throw std::runtime_error("No LLM configured on the context");
+        }
+        auto memoizing = std::make_shared<MemoizingLLM>(llm, memo, "optimizer");
+        auto evaluator_llm = evaluator_llm_;
+        if (evaluator_llm) {
+            evaluator_llm_ = std::make_shared<MemoizingLLM>(evaluator_llm, memo, "evaluator", memoizing->sharedStats());
+        }
+        JsonObject result;
+        try {
+            result = co_await offload([&]() { return runWithLLM(input, memoizing); });
+        } catch (...) {
+            evaluator_llm_ = evaluator_llm;
+            throw;
+        }
+        evaluator_llm_ = evaluator_llm;
+        logStep("Memo", memoizing->statsToJson());
+        co_return result;
+    }
+
     /**
      * @brief Set the evaluation criteria for the evaluator
      * @param criteria The evaluation criteria to set
@@ -100,6 +279,10 @@ public:
 
     /**
      * @brief Set the optimizer function
+     *
+     * The function receives the input and the feedback on the best response
+     * so far; runBestOfN() adds `candidate` and `candidates` to the feedback.
+     *
      * @param optimizer The optimizer function to set
      */
     void setOptimizer(std::function<std::string(const std::string&, const JsonObject&)> optimizer);
@@ -163,6 +346,218 @@ private:
      * @return The evaluator system prompt
      */
     std::string createEvaluatorSystemPrompt() const;
+
+    /**
+     * @brief Produce one candidate response
+     * @param llm The optimizer LLM
+     * @param input The user input
+     * @param previous The best response so far (empty on the first iteration)
+     * @param feedback Feedback on the best response so far
+     * @param index The candidate's index within its iteration
+     * @param count The number of candidates per iteration
+     * @return The candidate response
+     */
+    std::string generateCandidate(
+        const std::shared_ptr<LLMInterface>& llm,
+        const std::string& input,
+        const std::string& previous,
+        const JsonObject& feedback,
+        size_t index = 0,
+        size_t count = 1
+    ) const {
+        if (optimizer_) {
+            // The optimizer cannot see the prompt variation below, so tell it which draft this is
+            JsonObject optimizer_feedback = feedback.is_object() ? feedback : JsonObject::object();
+            optimizer_feedback["candidate"] = index;
+            optimizer_feedback["candidates"] = count;
+            std::string response = optimizer_(input, optimizer_feedback);
+            if (!response.empty()) {
+                return response;
+            }
+        }
+        std::string prompt = input;
+        if (!previous.empty()) {
+            prompt += "\n\nPrevious response:\n" + previous +
+                "\n\nIncorporate this feedback to improve your response:\n" + feedback.value("feedback", "");
+        }
+        if (index > 0) {
+            // Without per-call sampling options, the prompt is what varies between candidates
+            prompt += "\n\n(Draft " + std::to_string(index + 1) + " of " + std::to_string(count) +
+                ": take a different approach from the most obvious answer.)";
+        }
+        std::vector<Message> messages;
+        if (!optimizer_prompt_template_.empty()) {
+            messages.push_back(Message{Message::Role::SYSTEM, optimizer_prompt_template_});
+        }
+        messages.push_back(Message{Message::Role::USER, prompt});
+        return llm->chat(messages).content;
+    }
+
+    /**
+     * @brief Score one candidate with the evaluator function
+     *
+     * init() installs a default evaluator that returns no score, so one is
+     * always set; only a result with a score replaces LLM scoring.
+     *
+     * @param input The user input
+     * @param response The candidate response
+     * @return The evaluation, or null when the function returns no score
+     * @throws std::out_of_range if the function returns a score outside [0, 1]
+     */
+    JsonObject customEvaluation(const std::string& input, const std::string& response) const {
+        if (!evaluator_) {
+            return JsonObject();
+        }
+        JsonObject evaluation = evaluator_(input, response);
+        if (!evaluation.is_object() || !evaluation.contains("score")) {
+            return JsonObject();
+        }
+        if (!isValidScore(evaluation["score"])) {
+            throw std::out_of_range("Custom evaluator score must be a number in [0, 1], got " + evaluation["score"].dump());
+        }
+        return evaluation;
+    }
+
+    /**
+     * @brief Score one candidate with the LLM, on all criteria or on a single one
+     * @param llm The evaluator LLM
+     * @param input The user input
+     * @param response The candidate response
+     * @param criterion The criterion to score, or nullptr for all criteria
+     * @return The evaluation with `score` in [0, 1] and `feedback`; a reply
+     * without a score in [0, 1] scores 0 and carries an `error`
+     */
+    JsonObject scoreCandidate(
+        const std::shared_ptr<LLMInterface>& llm,
+        const std::string& input,
+        const std::string& response,
+        const std::string* criterion
+    ) const {
+        std::string system_prompt = criterion
+            ? evaluator_prompt_template_ + "\n\nEvaluate the response on this criterion only: " + *criterion +
+              "\nPlease return strict JSON: {\"score\": <0..1>, \"feedback\": \"...\"}."
+            : createEvaluatorSystemPrompt();
+        LLMResponse reply = llm->chat(std::vector<Message>{
+            Message{Message::Role::SYSTEM, system_prompt},
+            Message{Message::Role::USER, "Query: " + input + "\n\nResponse: " + response}
+        });
+        JsonObject evaluation = Utils::parseJsonResponse(reply.content);
+        if (!evaluation.is_object() || !evaluation.contains("score")) {
+            return JsonObject{{"score", 0.0}, {"feedback", reply.content}, {"error", "No score in evaluator reply"}};
+        }
+        if (!isValidScore(evaluation["score"])) {
+            // Out-of-contract scores are rejected rather than guessed onto a scale
+            return JsonObject{
+                {"score", 0.0},
+                {"feedback", evaluation.contains("feedback") ? evaluation["feedback"] : JsonObject(reply.content)},
+                {"error", "Score must be a number in [0, 1], got " + evaluation["score"].dump()}
+            };
+        }
+        if (criterion) {
+            evaluation["criterion"] = *criterion;
+        }
+        return evaluation;
+    }
+
+    /**
+     * @brief Run generateCandidate() on the executor
+     * @param llm The optimizer LLM
+     * @param input The user input
+     * @param previous The best response so far
+     * @param feedback Feedback on the best response so far
+     * @param index The candidate's index within its iteration
+     * @param count The number of candidates per iteration
+     * @return Task yielding the candidate response
+     */
+    Task<std::string> generateCandidateTask(std::shared_ptr<LLMInterface> llm, std::string input, std::string previous,
+                                            JsonObject feedback, size_t index, size_t count) const {
+        co_return co_await offload([&]() { return generateCandidate(llm, input, previous, feedback, index, count); });
+    }
+
+    /**
+     * @brief Run scoreCandidate() on the executor
+     * @param llm The evaluator LLM
+     * @param input The user input
+     * @param response The candidate response
+     * @param criterion The criterion to score, or nullptr for all criteria
+     * @return Task yielding the evaluation
+     */
+    Task<JsonObject> llmScoreTask(std::shared_ptr<LLMInterface> llm, std::string input, std::string response,
+                                  const std::string* criterion) const {
+        co_return co_await offload([&]() { return scoreCandidate(llm, input, response, criterion); });
+    }
+
+    /**
+     * @brief Score one candidate on the executor
+     *
+     * The evaluator function is tried first; without a score from it the
+     * LLM scores the candidate, once per criterion (averaged) when split.
+     *
+     * @param llm The evaluator LLM
+     * @param input The user input
+     * @param response The candidate response
+     * @param split Whether to score each criterion in its own LLM call
+     * @return Task yielding `score`, `feedback` (one entry per call) and `per_criterion`
+     * @throws std::out_of_range if the evaluator function returns a score outside [0, 1]
+     */
+    Task<JsonObject> scoreCandidateTask(std::shared_ptr<LLMInterface> llm, std::string input, std::string response,
+                                        bool split) const {
+        JsonObject custom = co_await offload([&]() { return customEvaluation(input, response); });
+        if (!custom.is_null()) {
+            co_return JsonObject{
+                {"score", custom["score"]},
+                {"feedback", JsonObject::array({custom.contains("feedback") ? custom["feedback"] : JsonObject("")})},
+                {"per_criterion", false}
+            };
+        }
+        std::vector<Task<JsonObject>> calls;
+        if (split) {
+            for (const auto& criterion : evaluation_criteria_) {
+                calls.push_back(llmScoreTask(llm, input, response, &criterion));
+            }
+        } else {
+            calls.push_back(llmScoreTask(llm, input, response, nullptr));
+        }
+        std::vector<JsonObject> evaluations = co_await whenAll(std::move(calls));
+        double total = 0.0;
+        JsonObject feedback = JsonObject::array();
+        for (const auto& evaluation : evaluations) {
+            total += evaluation["score"].get<double>();
+            feedback.push_back(evaluation.contains("feedback") ? evaluation["feedback"] : JsonObject(""));
+        }
+        co_return JsonObject{
+            {"score", total / static_cast<double>(evaluations.size())},
+            {"feedback", feedback},
+            {"per_criterion", split}
+        };
+    }
+
+    /**
+     * @brief Whether a score honours the [0, 1] contract
+     * @param score The score value
+     * @return True for a finite number in [0, 1]
+     */
+    static bool isValidScore(const JsonObject& score) {
+        return score.is_number() && score.get<double>() >= 0.0 && score.get<double>() <= 1.0;
+    }
+
+    /**
+     * @brief Flatten per-criterion feedback into one string
+     * @param feedback Feedback strings, one per criterion (or a single one)
+     * @param split Whether the feedback is per criterion
+     * @return The combined feedback
+     */
+    std::string joinFeedback(const JsonObject& feedback, bool split) const {
+        std::string out;
+        for (size_t k = 0; k < feedback.size(); ++k) {
+            std::string text = feedback[k].is_string() ? feedback[k].get<std::string>() : feedback[k].dump();
+            if (text.empty()) continue;
+            if (!out.empty()) out += "\n";
+            if (split && k < evaluation_criteria_.size()) out += "- " + evaluation_criteria_[k] + ": ";
+            out += text;
+        }
+        return out;
+    }
 };
 
 } // namespace workflows
@@ -0,0 +1,895 @@
+/**
+ * @file graph_workflow.h
+ * @brief Declarative DAG workflow with parallel scheduling
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025 Edge AI, LLC. All rights reserved.
+ *
+ */
+#pragma once
+
+#include <agents-cpp/coroutine_utils.h>
+#include <agents-cpp/metrics.h>
+#include <agents-cpp/prompt_template.h>
+#include <agents-cpp/tool.h>
+#include <agents-cpp/utils.h>
+#include <agents-cpp/workflow.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace agents {
+namespace workflows {
+
+/**
+ * @brief A workflow defined as a graph of nodes whose outputs feed each other
+ *
+ * @details Each node is an LLM call, a tool call, a sub-workflow or a C++
+ * function, and produces a JSON output. Templates in a node (prompts, tool
+ * parameters, sub-workflow input) are PromptTemplates over `{input}` and the
+ * names of other nodes, e.g. `{outline.response}`; every node referenced this
+ * way, or listed in `depends_on`, becomes an incoming edge. A template that
+ * is a single slot passes the referenced JSON value through unchanged.
+ *
+ * The scheduler runs every node whose dependencies have finished, up to the
+ * concurrency limit, retries failed or timed-out nodes, and skips the
+ * dependents of nodes that fail for good. A timed-out attempt cannot be
+ * interrupted, so it keeps its concurrency slot until it returns and its
+ * result is discarded. Node outputs are cached, least recently used first
+ * out, by a hash of the node's resolved request, so when the graph is run
+ * again with a changed input only the nodes whose requests changed are
+ * executed. Tools may have side effects, so TOOL nodes run every time
+ * unless they set `cache`.
+ *
+ * Graphs can be built in C++ or loaded from JSON:
+ * @code{.json}
+ * {
+ *   "nodes": [
+ *     {"name": "outline", "type": "llm", "prompt": "Outline an article about {input}"},
+ *     {"name": "search", "type": "tool", "tool": "web_search", "params": {"query": "{input}"}},
+ *     {"name": "draft", "type": "llm", "retries": 2, "timeout_ms": 60000,
+ *      "prompt": "Write the article.\nOutline: {outline.response}\nSources: {search.content}"},
+ *     {"name": "review", "type": "workflow", "workflow": "reviewer", "input": "{draft.response}"}
+ *   ],
+ *   "output": "review"
+ * }
+ * @endcode
+ */
+class GraphWorkflow : public Workflow {
+public:
+    /**
+     * @brief Kind of work a node performs
+     */
+    enum class NodeType {
+        /**
+         * @brief Chat call with a rendered prompt; output `{"response": ...}`
+         */
+        LLM,
+        /**
+         * @brief Tool call with rendered parameters; output `{"success", "content", "data"}`
+         */
+        TOOL,
+        /**
+         * @brief Run of another workflow on a rendered input; output is its result
+         */
+        WORKFLOW,
+        /**
+         * @brief C++ function of `{"input": ..., <dependency>: <output>, ...}`
+         */
+        FUNCTION
+    };
+
+    /**
+     * @brief Function executed by a FUNCTION node
+     */
+    using NodeFunction = std::function<JsonObject(const JsonObject&)>;
+
+    /**
+     * @brief Node definition
+     */
+    struct Node {
+        /**
+         * @brief Unique node name (also the template variable for its output)
+         */
+        std::string name;
+        /**
+         * @brief Kind of node
+         */
+        NodeType type = NodeType::LLM;
+        /**
+         * @brief Dependencies in addition to those referenced by templates
+         */
+        std::vector<std::string> depends_on;
+        /**
+         * @brief LLM: user prompt template
+         */
+        std::string prompt;
+        /**
+         * @brief LLM: system prompt template (optional)
+         */
+        std::string system_prompt;
+        /**
+         * @brief LLM: model to use instead of the context's LLM (optional)
+         */
+        std::shared_ptr<LLMInterface> llm;
+        /**
+         * @brief TOOL: name of a tool registered on the context
+         */
+        std::string tool;
+        /**
+         * @brief TOOL: parameters; string values are templates
+         */
+        JsonObject params = JsonObject::object();
+        /**
+         * @brief WORKFLOW: the workflow to run
+         */
+        std::shared_ptr<Workflow> workflow;
+        /**
+         * @brief WORKFLOW: input template
+         */
+        std::string input = "{input}";
+        /**
+         * @brief FUNCTION: the function to call
+         */
+        NodeFunction function;
+        /**
+         * @brief Extra attempts after a failure or timeout
+         */
+        int max_retries = 0;
+        /**
+         * @brief Time limit per attempt (0 = none)
+         */
+        std::chrono::milliseconds timeout{0};
+        /**
+         * @brief Whether the output may be served from the cache (unset: all but TOOL nodes)
+         */
+        std::optional<bool> cache;
+    };
+
+    /**
+     * @brief Constructor
+     * @param context The context (supplies the default LLM and the tools)
+     */
+    explicit GraphWorkflow(std::shared_ptr<Context> context) : Workflow(std::move(context)) {}
+
+    /**
+     * @brief Add a node
+     * @param node The node
+     * @throws std::invalid_argument if the name is empty, reserved or already used
+     */
+    void addNode(const Node& node) {
+        if (node.name.empty() || node.name == "input") {
+            throw std::invalid_argument("Graph node name must be non-empty and not 'input'");
+        }
+        if (index_.count(node.name)) {
+            throw std::invalid_argument("Duplicate graph node '" + node.name + "'");
+        }
+        Templates templates = compile(node);
+        index_[node.name] = nodes_.size();
+        nodes_.push_back(node);
+        templates_.push_back(std::move(templates));
+    }
+
+    /**
+     * @brief Add an LLM node
+     * @param name The node name
+     * @param prompt The prompt template
+     * @param depends_on Extra dependencies
+     */
+    void addLLMNode(const std::string& name, const std::string& prompt, const std::vector<std::string>& depends_on = {}) {
+        Node node;
+        node.name = name;
+        node.type = NodeType::LLM;
+        node.prompt = prompt;
+        node.depends_on = depends_on;
+        addNode(node);
+    }
+
+    /**
+     * @brief Add a tool node
+     * @param name The node name
+     * @param tool The tool name
+     * @param params The parameters; string values are templates
+     * @param depends_on Extra dependencies
+     */
+    void addToolNode(const std::string& name, const std::string& tool, const JsonObject& params, const std::vector<std::string>& depends_on = {}) {
+        Node node;
+        node.name = name;
+        node.type = NodeType::TOOL;
+        node.tool = tool;
+        node.params = params;
+        node.depends_on = depends_on;
+        addNode(node);
+    }
+
+    /**
+     * @brief Add a sub-workflow node
+     * @param name The node name
+     * @param workflow The workflow to run
+     * @param input The input template
+     * @param depends_on Extra dependencies
+     */
+    void addWorkflowNode(const std::string& name, std::shared_ptr<Workflow> workflow, const std::string& input = "{input}", const std::vector<std::string>& depends_on = {}) {
+        Node node;
+        node.name = name;
+        node.type = NodeType::WORKFLOW;
+        node.workflow = std::move(workflow);
+        node.input = input;
+        node.depends_on = depends_on;
+        addNode(node);
+    }
+
+    /**
+     * @brief Add a function node
+     * @param name The node name
+     * @param function The function, called with the input and its dependencies' outputs
+     * @param depends_on The dependencies
+     */
+    void addFunctionNode(const std::string& name, NodeFunction function, const std::vector<std::string>& depends_on = {}) {
+        Node node;
+        node.name = name;
+        node.type = NodeType::FUNCTION;
+        node.function = std::move(function);
+        node.depends_on = depends_on;
+        addNode(node);
+    }
+
+    /**
+     * @brief Register a function that loaded graphs can reference by name
+     * @param name The name used in the graph spec
+     * @param function The function
+     */
+    void registerFunction(const std::string& name, NodeFunction function) {
+        functions_[name] = std::move(function);
+    }
+
+    /**
+     * @brief Register a workflow that loaded graphs can reference by name
+     * @param name The name used in the graph spec
+     * @param workflow The workflow
+     */
+    void registerWorkflow(const std::string& name, std::shared_ptr<Workflow> workflow) {
+        workflows_[name] = std::move(workflow);
+    }
+
+    /**
+     * @brief Add the nodes of a JSON graph spec
+     *
+     * Node fields: `name`, `type` (`llm`, `tool`, `workflow`, `function`),
+     * `depends_on`, `retries`, `timeout_ms`, `cache`, and per type `prompt`
+     * and `system`; `tool` and `params`; `workflow` and `input`; `function`.
+     * Workflows and functions are looked up among the registered ones. The
+     * optional top-level `output` names the node whose output is the result.
+     *
+     * @param spec The graph spec
+     * @throws std::invalid_argument on a malformed spec or an unknown reference
+     */
+    void loadJson(const JsonObject& spec) {
+        if (!spec.is_object() || !spec.contains("nodes") || !spec["nodes"].is_array()) {
+            throw std::invalid_argument("Graph spec requires a \"nodes\" array");
+        }
+        for (const auto& item : spec["nodes"]) {
+            if (!item.is_object() || !item.contains("name") || !item["name"].is_string()) {
+                throw std::invalid_argument("Graph node requires a \"name\": " + item.dump());
+            }
+            Node node;
+            node.name = item["name"].get<std::string>();
+            std::string type = item.value("type", "llm");
+            if (type == "llm") {
+                node.type = NodeType::LLM;
+                node.prompt = item.value("prompt", "{input}");
+                node.system_prompt = item.value("system", "");
+            } else if (type == "tool") {
+                node.type = NodeType::TOOL;
+                node.tool = item.value("tool", "");
+                node.params = item.value("params", JsonObject::object());
+            } else if (type == "workflow") {
+                node.type = NodeType::WORKFLOW;
+                node.workflow = lookup(workflows_, item.value("workflow", ""), "workflow", node.name);
+                node.input = item.value("input", "{input}");
+            } else if (type == "function") {
+                node.type = NodeType::FUNCTION;
+                node.function = lookup(functions_, item.value("function", ""), "function", node.name);
+            } else {
+                throw std::invalid_argument("Unknown type '" + type + "' for graph node '" + node.name + "'");
+            }
+            if (item.contains("depends_on")) {
+                node.depends_on = item["depends_on"].get<std::vector<std::string>>();
+            }
+            node.max_retries = item.value("retries", 0);
+            node.timeout = std::chrono::milliseconds(item.value("timeout_ms", 0));
+            if (item.contains("cache")) {
+                node.cache = item["cache"].get<bool>();
+            }
+            addNode(node);
+        }
+        if (spec.contains("output")) {
+            output_node_ = spec["output"].get<std::string>();
+        }
+    }
+
+    /**
+     * @brief Add the nodes of a graph spec file
+     * @param path Path to a JSON graph spec
+     * @throws std::invalid_argument if the file cannot be read or parsed
+     */
+    void loadFile(const std::string& path) {
+        std::ifstream file(path);
+        if (!file) {
+            throw std::invalid_argument("Cannot open graph spec: " + path);
+        }
+        JsonObject spec = JsonObject::parse(file, nullptr, false);
+        if (spec.is_discarded()) {
+            throw std::invalid_argument("Graph spec is not valid JSON: " + path);
+        }
+        loadJson(spec);
+    }
+
+    /**
+     * @brief Set the node whose output is the workflow result
+     * @param name The node name (by default the last node nothing depends on)
+     */
+    void setOutputNode(const std::string& name) {
+        output_node_ = name;
+    }
+
+    /**
+     * @brief Set the maximum number of nodes executing at once
+     * @param max_concurrency The limit (0 = no limit)
+     */
+    void setMaxConcurrency(size_t max_concurrency) {
+        max_concurrency_ = max_concurrency;
+    }
+
+    /**
+     * @brief Enable or disable the node output cache
+     * @param enabled Whether to cache node outputs
+     */
+    void setCacheEnabled(bool enabled) {
+        cache_enabled_ = enabled;
+    }
+
+    /**
+     * @brief Set the maximum number of cached node outputs
+     * @param capacity The limit; the least recently used outputs are evicted first
+     */
+    void setCacheCapacity(size_t capacity) {
+        std::lock_guard<std::mutex> lock(cache_mutex_);
+        cache_capacity_ = capacity;
+        evictCache();
+    }
+
+    /**
+     * @brief Drop all cached node outputs
+     */
+    void clearCache() {
+        std::lock_guard<std::mutex> lock(cache_mutex_);
+        cache_.clear();
+        cache_order_.clear();
+    }
+
+    /**
+     * @brief Execute the graph
+     *
+     * Every finished node is reported through the step callback with
+     * `cached`, `attempts` and `latency_ms`.
+     *
+     * @param input The graph input, available to templates as `{input}`
+     * @return `response` (the output node's `response`, or its whole output),
+     * `outputs` per node, `errors` per failed or skipped node, and `stats`
+     * @throws std::invalid_argument on an unknown dependency or a cycle
+     */
+    JsonObject run(const std::string& input) override {
+        Span span("workflow.run");
+        span.setAttribute("workflow.type", "graph");
+        using Clock = std::chrono::steady_clock;
+        const size_t count = nodes_.size();
+        const auto started = Clock::now();
+        std::vector<std::vector<size_t>> prerequisites = resolveEdges();
+        std::vector<std::vector<size_t>> dependents(count);
+        std::vector<size_t> waiting_on(count, 0);
+        for (size_t i = 0; i < count; ++i) {
+            waiting_on[i] = prerequisites[i].size();
+            for (size_t dep : prerequisites[i]) dependents[dep].push_back(i);
+        }
+
+        enum class Status { PENDING, RUNNING, DONE, FAILED };
+        struct State {
+            Status status = Status::PENDING;
+            int attempts = 0;
+            Clock::time_point started;
+            Clock::time_point deadline = Clock::time_point::max();
+            JsonObject request;
+            std::string key;
+        };
+        struct Completion {
+            size_t index;
+            int attempt;
+            bool ok;
+            JsonObject output;
+        };
+        struct Shared {
+            std::mutex mutex;
+            std::condition_variable cv;
+            std::deque<Completion> done;
+        };
+        auto shared = std::make_shared<Shared>();
+        std::vector<State> states(count);
+        JsonObject outputs = JsonObject::object();
+        JsonObject errors = JsonObject::object();
+        JsonObject stats{{"executed", 0}, {"cached", 0}, {"retries", 0}, {"failed", 0}, {"skipped", 0}};
+        const JsonObject input_value = input;
+        std::deque<size_t> ready;
+        for (size_t i = 0; i < count; ++i) {
+            if (waiting_on[i] == 0) ready.push_back(i);
+        }
+        const size_t limit = max_concurrency_ == 0 ? count : max_concurrency_;
+        // Timed-out attempts still executing hold a slot in `abandoned`
+        size_t in_flight = 0, abandoned = 0, finished = 0;
+        std::deque<size_t> retrying;
+
+        auto launch = [&](size_t index) {
+            State& state = states[index];
+            state.status = Status::RUNNING;
+            state.attempts++;
+            state.started = Clock::now();
+            state.deadline = nodes_[index].timeout.count() > 0 ? state.started + nodes_[index].timeout : Clock::time_point::max();
+            in_flight++;
+            getExecutor()->add([shared, node = nodes_[index], context = context_, request = state.request, index, attempt = state.attempts]() {
+                Completion completion{index, attempt, true, JsonObject()};
+                try {
+                    completion.output = executeNode(node, context, request);
+                } catch (const std::exception& e) {
+                    completion.ok = false;
+                    completion.output = e.what();
+                }
+                std::lock_guard<std::mutex> lock(shared->mutex);
+                shared->done.push_back(std::move(completion));
+                shared->cv.notify_one();
+            });
+        };
+        auto finish = [&](size_t index, JsonObject output, bool cached) {
+            State& state = states[index];
+            state.status = Status::DONE;
+            finished++;
+            stats[cached ? "cached" : "executed"] = stats[cached ? "cached" : "executed"].get<int>() + 1;
+            logStep("Node completed: " + nodes_[index].name, JsonObject{
+                {"node", nodes_[index].name},
+                {"cached", cached},
+                {"attempts", state.attempts},
+                {"latency_ms", cached ? 0.0 : std::chrono::duration<double, std::milli>(Clock::now() - state.started).count()},
+                {"output", preview(output)}
+            });
+            outputs[nodes_[index].name] = std::move(output);
+            for (size_t next : dependents[index]) {
+                if (--waiting_on[next] == 0 && states[next].status == Status::PENDING) ready.push_back(next);
+            }
+        };
+        // Fails a node and, transitively, every node that depends on it
+        auto fail = [&](size_t index, const std::string& error) {
+            std::vector<std::pair<size_t, std::string>> pending{{index, error}};
+            while (!pending.empty()) {
+                auto [current, message] = pending.back();
+                pending.pop_back();
+                if (states[current].status == Status::DONE || states[current].status == Status::FAILED) continue;
+                states[current].status = Status::FAILED;
+                finished++;
+                bool skipped = current != index;
+                stats[skipped ? "skipped" : "failed"] = stats[skipped ? "skipped" : "failed"].get<int>() + 1;
+                errors[nodes_[current].name] = message;
+                logStep("Node failed: " + nodes_[current].name, JsonObject{
+                    {"node", nodes_[current].name},
+                    {"attempts", states[current].attempts},
+                    {"error", message}
+                });
+                for (size_t next : dependents[current]) {
+                    pending.emplace_back(next, "Dependency failed: " + nodes_[current].name);
+                }
+            }
+        };
+        // Retries wait for a free slot like any other launch
+        auto retryOrFail = [&](size_t index, const std::string& error) {
+            if (states[index].attempts <= nodes_[index].max_retries) {
+                stats["retries"] = stats["retries"].get<int>() + 1;
+                retryCounter().inc();
+                if (nodes_[index].type == NodeType::LLM) {
+                    auto llm = nodes_[index].llm ? nodes_[index].llm : context_->getLLM();
+                    llmRetryCounter(llm ? llm->getModel() : "").inc();
+                }
+                states[index].status = Status::PENDING;
+                retrying.push_back(index);
+            } else {
+                fail(index, error);
+            }
+        };
+
+        while (finished < count) {
+            while (!retrying.empty() && in_flight + abandoned < limit) {
+                size_t index = retrying.front();
+                retrying.pop_front();
+                if (states[index].status == Status::PENDING) launch(index);
+            }
+            while (!ready.empty() && retrying.empty() && in_flight + abandoned < limit) {
+                size_t index = ready.front();
+                ready.pop_front();
+                if (states[index].status != Status::PENDING) continue;
+                JsonObject variables = inputVariables(input_value, prerequisites[index], outputs);
+                try {
+                    states[index].request = buildRequest(index, variables);
+                } catch (const std::exception& e) {
+                    fail(index, e.what());
+                    continue;
+                }
+                if (cache_enabled_ && cacheable(nodes_[index])) {
+                    states[index].key = cacheKey(nodes_[index], states[index].request);
+                    std::lock_guard<std::mutex> lock(cache_mutex_);
+                    auto hit = cache_.find(states[index].key);
+                    cacheCounter(hit != cache_.end()).inc();
+                    if (hit != cache_.end()) {
+                        cache_order_.splice(cache_order_.begin(), cache_order_, hit->second);
+                        finish(index, hit->second->second, true);
+                        continue;
+                    }
+                }
+                launch(index);
+            }
+            if (in_flight == 0) {
+                if (ready.empty() && retrying.empty()) break; // only unreachable nodes remain
+                if (abandoned == 0) continue;
+                // Every slot is held by a timed-out attempt; wait for one to return
+            }
+
+            std::deque<Completion> batch;
+            {
+                std::unique_lock<std::mutex> lock(shared->mutex);
+                Clock::time_point deadline = Clock::time_point::max();
+                for (const auto& state : states) {
+                    if (state.status == Status::RUNNING) deadline = std::min(deadline, state.deadline);
+                }
+                auto has_done = [&shared]() { return !shared->done.empty(); };
+                if (deadline == Clock::time_point::max()) {
+                    shared->cv.wait(lock, has_done);
+                } else {
+                    shared->cv.wait_until(lock, deadline, has_done);
+                }
+                batch.swap(shared->done);
+            }
+            for (auto& completion : batch) {
+                State& state = states[completion.index];
+                // Results of timed-out attempts arrive late, free their slot and are dropped
+                if (state.status != Status::RUNNING || completion.attempt != state.attempts) {
+                    abandoned--;
+                    continue;
+                }
+                in_flight--;
+                if (completion.ok) {
+                    if (!state.key.empty()) {
+                        storeCache(state.key, completion.output);
+                    }
+                    finish(completion.index, std::move(completion.output), false);
+                } else {
+                    retryOrFail(completion.index, completion.output.get<std::string>());
+                }
+            }
+            auto now = Clock::now();
+            for (size_t i = 0; i < count; ++i) {
+                if (states[i].status == Status::RUNNING && states[i].deadline <= now) {
+                    in_flight--;
+                    abandoned++;
+                    states[i].status = Status::PENDING;
+                    retryOrFail(i, "timeout");
+                }
+            }
+        }
+
+        JsonObject result{{"outputs", outputs}};
+        std::string output_node = outputNode(dependents);
+        if (outputs.contains(output_node)) {
+            const JsonObject& output = outputs[output_node];
+            result["response"] = output.is_object() && output.contains("response") ? output["response"] : output;
+        } else {
+            result["response"] = nullptr;
+            result["error"] = errors.value(output_node, std::string("Output node did not run"));
+        }
+        if (!errors.empty()) {
+            result["errors"] = errors;
+        }
+        stats["wall_ms"] = std::chrono::duration<double, std::milli>(Clock::now() - started).count();
+        result["stats"] = stats;
+        logStep("Graph completed", stats);
+        return result;
+    }
+
+/*! @cond PRIVATE */
+private:
+    std::vector<Node> nodes_;
+    std::map<std::string, size_t> index_;
+    std::map<std::string, NodeFunction> functions_;
+    std::map<std::string, std::shared_ptr<Workflow>> workflows_;
+    std::string output_node_;
+    size_t max_concurrency_ = 8;
+    bool cache_enabled_ = true;
+    size_t cache_capacity_ = 1024;
+    // Most recently used first; cache_ indexes into it by key
+    std::list<std::pair<std::string, JsonObject>> cache_order_;
+    std::unordered_map<std::string, std::list<std::pair<std::string, JsonObject>>::iterator> cache_;
+    std::mutex cache_mutex_;
+
+    // A node's templates, compiled once when it is added
+    struct Templates {
+        PromptTemplate prompt;
+        PromptTemplate system_prompt;
+        PromptTemplate input;
+        std::map<std::string, PromptTemplate> params;
+        std::set<std::string> variables;
+    };
+    std::vector<Templates> templates_;
+
+    // Longest node output written to a step log
+    static constexpr size_t kLogOutputBytes = 512;
+
+    template <typename T>
+    static T lookup(const std::map<std::string, T>& registry, const std::string& name, const std::string& kind, const std::string& node) {
+        auto it = registry.find(name);
+        if (it == registry.end()) {
+            throw std::invalid_argument("Graph node '" + node + "' references unregistered " + kind + " '" + name + "'");
+        }
+        return it->second;
+    }
+
+    // Parses a node's templates and collects the variables they reference
+    static Templates compile(const Node& node) {
+        Templates templates;
+        auto add = [&templates](const PromptTemplate& compiled) {
+            for (const auto& name : compiled.variables()) templates.variables.insert(name);
+        };
+        std::function<void(const JsonObject&)> walk = [&](const JsonObject& value) {
+            if (value.is_string()) {
+                const std::string& source = value.get_ref<const std::string&>();
+                add(templates.params.try_emplace(source, source).first->second);
+            } else if (value.is_structured()) {
+                for (const auto& item : value) walk(item);
+            }
+        };
+        switch (node.type) {
+            case NodeType::LLM:
+                templates.prompt = PromptTemplate(node.prompt);
+                templates.system_prompt = PromptTemplate(node.system_prompt);
+                add(templates.prompt);
+                add(templates.system_prompt);
+                break;
+            case NodeType::TOOL: walk(node.params); break;
+            case NodeType::WORKFLOW:
+                templates.input = PromptTemplate(node.input);
+                add(templates.input);
+                break;
+            case NodeType::FUNCTION: break;
+        }
+        templates.variables.erase("input");
+        return templates;
+    }
+
+    // Incoming edges per node; throws on unknown dependencies and cycles
+    std::vector<std::vector<size_t>> resolveEdges() const {
+        const size_t count = nodes_.size();
+        std::vector<std::vector<size_t>> prerequisites(count);
+        for (size_t i = 0; i < count; ++i) {
+            std::set<std::string> names = templates_[i].variables;
+            names.insert(nodes_[i].depends_on.begin(), nodes_[i].depends_on.end());
+            for (const auto& name : names) {
+                auto it = index_.find(name);
+                if (it == index_.end()) {
+                    throw std::invalid_argument("Graph node '" + nodes_[i].name + "' depends on unknown node '" + name + "'");
+                }
+                if (it->second == i) {
+                    throw std::invalid_argument("Graph node '" + nodes_[i].name + "' depends on itself");
+                }
+                prerequisites[i].push_back(it->second);
+            }
+        }
+        // Kahn's algorithm: anything left unvisited is on a cycle
+        std::vector<size_t> indegree(count);
+        std::vector<std::vector<size_t>> dependents(count);
+        for (size_t i = 0; i < count; ++i) {
+            indegree[i] = prerequisites[i].size();
+            for (size_t dep : prerequisites[i]) dependents[dep].push_back(i);
+        }
+        std::vector<size_t> queue;
+        for (size_t i = 0; i < count; ++i) {
+            if (indegree[i] == 0) queue.push_back(i);
+        }
+        size_t visited = 0;
+        while (!queue.empty()) {
+            size_t current = queue.back();
+            queue.pop_back();
+            visited++;
+            for (size_t next : dependents[current]) {
+                if (--indegree[next] == 0) queue.push_back(next);
+            }
+        }
+        if (visited != count) {
+            for (size_t i = 0; i < count; ++i) {
+                if (indegree[i] > 0) {
+                    throw std::invalid_argument("Graph has a cycle through node '" + nodes_[i].name + "'");
+                }
+            }
+        }
+        return prerequisites;
+    }
+
+    std::string outputNode(const std::vector<std::vector<size_t>>& dependents) const {
+        if (!output_node_.empty()) return output_node_;
+        for (size_t i = nodes_.size(); i-- > 0;) {
+            if (dependents[i].empty()) return nodes_[i].name;
+        }
+        return std::string();
+    }
+
+    JsonObject inputVariables(const JsonObject& input, const std::vector<size_t>& prerequisites, const JsonObject& outputs) const {
+        JsonObject variables{{"input", input}};
+        for (size_t dep : prerequisites) {
+            variables[nodes_[dep].name] = outputs[nodes_[dep].name];
+        }
+        return variables;
+    }
+
+    static JsonObject renderValue(const JsonObject& value, const std::map<std::string, PromptTemplate>& params, const JsonObject& variables) {
+        if (value.is_string()) {
+            return params.at(value.get_ref<const std::string&>()).renderJson(variables);
+        }
+        if (value.is_object()) {
+            JsonObject rendered = JsonObject::object();
+            for (auto it = value.begin(); it != value.end(); ++it) {
+                rendered[it.key()] = renderValue(it.value(), params, variables);
+            }
+            return rendered;
+        }
+        if (value.is_array()) {
+            JsonObject rendered = JsonObject::array();
+            for (const auto& item : value) rendered.push_back(renderValue(item, params, variables));
+            return rendered;
+        }
+        return value;
+    }
+
+    // Everything a node needs to run, resolved against its inputs; also the cache fingerprint
+    JsonObject buildRequest(size_t index, const JsonObject& variables) const {
+        const Node& node = nodes_[index];
+        const Templates& templates = templates_[index];
+        switch (node.type) {
+            case NodeType::LLM:
+                return JsonObject{
+                    {"system", templates.system_prompt.render(variables)},
+                    {"prompt", templates.prompt.render(variables)}
+                };
+            case NodeType::TOOL:
+                return JsonObject{{"tool", node.tool}, {"params", renderValue(node.params, templates.params, variables)}};
+            case NodeType::WORKFLOW:
+                return JsonObject{{"input", templates.input.render(variables)}};
+            case NodeType::FUNCTION:
+                return variables;
+        }
+        return JsonObject();
+    }
+
+    // Caller holds cache_mutex_
+    void evictCache() {
+        while (cache_order_.size() > cache_capacity_) {
+            cache_.erase(cache_order_.back().first);
+            cache_order_.pop_back();
+        }
+    }
+
+    void storeCache(const std::string& key, const JsonObject& output) {
+        std::lock_guard<std::mutex> lock(cache_mutex_);
+        auto existing = cache_.find(key);
+        if (existing != cache_.end()) {
+            existing->second->second = output;
+            cache_order_.splice(cache_order_.begin(), cache_order_, existing->second);
+            return;
+        }
+        cache_order_.emplace_front(key, output);
+        cache_[key] = cache_order_.begin();
+        evictCache();
+    }
+
+    // Node output as logged: its JSON text, cut at kLogOutputBytes on a UTF-8 boundary
+    static std::string preview(const JsonObject& output) {
+        std::string text = output.dump(-1, ' ', false, JsonObject::error_handler_t::replace);
+        if (text.size() <= kLogOutputBytes) return text;
+        size_t cut = kLogOutputBytes;
+        while (cut > 0 && (static_cast<unsigned char>(text[cut]) & 0xC0) == 0x80) cut--;
+        return text.substr(0, cut) + "... (" + std::to_string(text.size()) + " bytes)";
+    }
+
+    static JsonObject executeNode(const Node& node, const std::shared_ptr<Context>& context, const JsonObject& request) {
+        switch (node.type) {
+            case NodeType::LLM: {
+                auto llm = node.llm ? node.llm : context->getLLM();
+                if (!llm) {
+                    throw std::runtime_error("No LLM configured on the context");
+                }
+                std::vector<Message> messages;
+                const std::string& system = request["system"].get_ref<const std::string&>();
+                if (!system.empty()) {
+                    messages.push_back(Message{Message::Role::SYSTEM, system});
+                }
+                messages.push_back(Message{Message::Role::USER, request["prompt"].get<std::string>()});
+                return JsonObject{{"response", llm->chat(messages).content}};
+            }
+            case NodeType::TOOL: {
+                auto tool = context->getTool(node.tool);
+                if (!tool) {
+                    throw std::runtime_error("Tool not found: " + node.tool);
+                }
+                ToolResult result = tool->execute(request["params"]);
+                if (!result.success) {
+                    throw std::runtime_error(result.content.empty() ? "Tool failed: " + node.tool : result.content);
+                }
+                return JsonObject{{"success", true}, {"content", result.content}, {"data", result.data}};
+            }
+            case NodeType::WORKFLOW:
+                if (!node.workflow) {
+                    throw std::runtime_error("No workflow set on graph node '" + node.name + "'");
+                }
+                return node.workflow->run(request["input"].get<std::string>());
+            case NodeType::FUNCTION:
+                if (!node.function) {
+                    throw std::runtime_error("No function set on graph node '" + node.name + "'");
+                }
+                return node.function(request);
+        }
+        return JsonObject();
+    }
+
+    static Counter& cacheCounter(bool hit) {
+        static Counter& hits = MetricsRegistry::global().counter(
+            "agents_cache_requests_total", "Cache lookups by cache and result", {{"cache", "graph"}, {"result", "hit"}});
+        static Counter& misses = MetricsRegistry::global().counter(
+            "agents_cache_requests_total", "Cache lookups by cache and result", {{"cache", "graph"}, {"result", "miss"}});
+        return hit ? hits : misses;
+    }
+
+    static Counter& retryCounter() {
+        static Counter& retries = MetricsRegistry::global().counter(
+            "agents_retries_total", "Retried operations by component", {{"component", "graph_workflow"}});
+        return retries;
+    }
+
+    static bool cacheable(const Node& node) {
+        return node.cache.value_or(node.type != NodeType::TOOL);
+    }
+
+    // Hash of the node identity and its resolved request
+    std::string cacheKey(const Node& node, const JsonObject& request) const {
+        std::string fingerprint = node.name;
+        fingerprint += '\0';
+        fingerprint += std::to_string(static_cast<int>(node.type));
+        fingerprint += '\0';
+        if (node.type == NodeType::LLM) {
+            auto llm = node.llm ? node.llm : context_->getLLM();
+            if (llm) fingerprint += llm->getModel();
+            fingerprint += '\0';
+        }
+        fingerprint += request.dump();
+        return Utils::hashHex(fingerprint);
+    }
+/*! @endcond */
+};
+
+} // namespace workflows
+} // namespace agents
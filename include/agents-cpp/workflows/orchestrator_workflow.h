@@ -9,9 +9,17 @@
  */
 #pragma once
 
+#include <agents-cpp/execution_journal.h>
+#include <agents-cpp/utils.h>
 #include <agents-cpp/workflow.h>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <functional>
 #include <map>
+#include <mutex>
+#include <optional>
 #include <utility>
 #include <vector>
 
@@ -114,6 +122,250 @@ public:
      */
     JsonObject run(const std::string& input) override;
 
+    /**
+     * @brief Execute the workflow with independent workers running concurrently
+     *
+     * The orchestrator is asked for the usual plan, where each item may also
+     * carry an `id` and a `depends_on` list of ids (or plan indices). Items run
+     * as soon as their dependencies have finished, with at most
+     * `max_parallel` workers in flight; a dependent item receives the outputs
+     * of its prerequisites. Each worker uses its own LLM when it has one, so
+     * workers on different providers proceed in parallel.
+     *
+     * Every finished worker is reported through the step callback with its
+     * `latency_ms`, and the results are synthesized in plan order.
+     *
+     * With a journal, the plan and every successful worker result are
+     * recorded durably as they complete. Running again with a journal for
+     * the same workflow id, e.g. after a crash, reuses the recorded plan and
+     * results and only runs the workers that had not completed.
+     *
+     * @param input The input to the workflow
+     * @param max_parallel Maximum workers in flight (0 = no limit)
+     * @param journal The journal (nothing is journaled when null)
+     * @return The output of the workflow
+     */
+    JsonObject runParallel(const std::string& input, size_t max_parallel = 4, std::shared_ptr<ExecutionJournal> journal = nullptr) {
+        using Clock = std::chrono::steady_clock;
+        auto llm = context_->getLLM();
+        if (!llm) {
+            throw std::runtime_error("No LLM configured on the context");
+        }
+        const std::map<std::string, const Worker*> workers = workersByName();
+
+        // Plan
+        const std::string plan_key = planKey(input);
+        std::optional<JsonObject> recorded_plan = journal ? journal->lookup(plan_key) : std::nullopt;
+        JsonObject plan;
+        if (recorded_plan) {
+            plan = std::move(*recorded_plan);
+        } else {
+            LLMResponse plan_response = llm->chat(planMessages(input));
+            plan = Utils::parseJsonResponse(plan_response.content);
+            if (!isValidPlan(plan)) {
+                return JsonObject{{"answer", plan_response.content}, {"error", "Failed to get plan from LLM"}};
+            }
+            if (journal) journal->record(plan_key, plan);
+        }
+        const JsonObject& items = plan["plan"];
+        const size_t count = items.size();
+        logStep("Plan", plan);
+        PlanGraph graph = resolveDependencies(items);
+        auto& [dependents, prerequisites, waiting_on] = graph;
+
+        struct Shared {
+            std::mutex mutex;
+            std::condition_variable cv;
+            std::deque<std::pair<size_t, JsonObject>> done;
+        };
+        auto shared = std::make_shared<Shared>();
+        std::vector<JsonObject> results(count);
+        std::deque<size_t> ready;
+        for (size_t i = 0; i < count; ++i) {
+            if (waiting_on[i] == 0) ready.push_back(i);
+        }
+        const size_t limit = max_parallel == 0 ? count : max_parallel;
+        size_t in_flight = 0, finished = 0;
+        const auto started = Clock::now();
+        double worker_ms_total = 0.0;
+
+        while (finished < count) {
+            while (!ready.empty() && in_flight < limit) {
+                size_t index = ready.front();
+                ready.pop_front();
+                const JsonObject& item = items[index];
+                std::string worker_name = item.value("worker", "");
+                std::string task = item.value("task", input);
+                JsonObject task_context = item.value("context", JsonObject::object());
+                if (!prerequisites[index].empty()) {
+                    JsonObject inputs = JsonObject::array();
+                    for (size_t dep : prerequisites[index]) inputs.push_back(results[dep]);
+                    task_context["prerequisites"] = std::move(inputs);
+                }
+                std::string key = workerKey(index, worker_name, task, task_context);
+                std::optional<JsonObject> recorded = journal ? journal->lookup(key) : std::nullopt;
+                auto it = workers.find(worker_name);
+                if (recorded || it == workers.end()) {
+                    std::lock_guard<std::mutex> lock(shared->mutex);
+                    shared->done.emplace_back(index, recorded ? std::move(*recorded)
+                        : JsonObject{{"worker_name", worker_name}, {"task", task}, {"error", "Worker not found"}});
+                    in_flight++;
+                    continue;
+                }
+                in_flight++;
+                getExecutor()->add([shared, journal, key, worker = *it->second, llm, task, task_context, index]() {
+                    auto start = Clock::now();
+                    JsonObject result;
+                    try {
+                        result = runWorker(worker, worker.llm ? worker.llm : llm, task, task_context);
+                    } catch (const std::exception& e) {
+                        result = JsonObject{{"worker_name", worker.name}, {"task", task}, {"error", e.what()}};
+                    }
+                    result["latency_ms"] = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+                    if (journal && !result.contains("error")) {
+                        try {
+                            journal->record(key, result);
+                        } catch (const std::exception& e) {
+                            result["journal_error"] = e.what();
+                        }
+                    }
+                    std::lock_guard<std::mutex> lock(shared->mutex);
+                    shared->done.emplace_back(index, std::move(result));
+                    shared->cv.notify_one();
+                });
+            }
+
+            if (ready.empty() && in_flight == 0) {
+                // Nothing can start: every unfinished item waits on a cycle
+                finished += failCycles(items, input, waiting_on, results);
+                break;
+            }
+
+            std::deque<std::pair<size_t, JsonObject>> batch;
+            {
+                std::unique_lock<std::mutex> lock(shared->mutex);
+                shared->cv.wait(lock, [&shared]() { return !shared->done.empty(); });
+                batch.swap(shared->done);
+            }
+            for (auto& [index, result] : batch) {
+                in_flight--;
+                finished++;
+                worker_ms_total += result.value("latency_ms", 0.0);
+                logStep("Worker completed: " + result.value("worker_name", std::string()), result);
+                results[index] = std::move(result);
+                for (size_t next : dependents[index]) {
+                    if (--waiting_on[next] == 0) ready.push_back(next);
+                }
+            }
+        }
+
+        logStep("Workers completed", JsonObject{
+            {"workers", count},
+            {"wall_ms", std::chrono::duration<double, std::milli>(Clock::now() - started).count()},
+            {"worker_ms_total", worker_ms_total}
+        });
+        return synthesizer_ ? synthesizer_(results) : defaultSynthesizer(results);
+    }
+
+    /**
+     * @brief Execute the workflow as a coroutine
+     *
+     * Runs run() on the executor (see Workflow::runTask()), so the result is
+     * what run() returns. The journaling overload below plans and dispatches
+     * as runParallel() does, which differs from run().
+     */
+    using Workflow::runTask;
+
+    /**
+     * @brief Execute the workflow as a coroutine, journaling the plan and worker results
+     *
+     * Journaling works as for runParallel(): a rerun with a journal for the
+     * same workflow id skips the recorded plan and workers.
+     *
+     * @param input The input to the workflow
+     * @param journal The journal (nothing is journaled when null)
+     * @param max_parallel Maximum workers in flight (0 = no limit)
+     * @return Task yielding the output of the workflow
+     */
+    Task<JsonObject> runTask(std::string input, std::shared_ptr<ExecutionJournal> journal, size_t max_parallel = 4) {
+        Span span("workflow.run");
+        span.setAttribute("workflow.type", "orchestrator");
+        auto llm = context_->getLLM();
+        if (!llm) {
+            throw std::runtime_error("No LLM configured on the context");
+        }
+        const std::map<std::string, const Worker*> workers = workersByName();
+
+        const std::string plan_key = planKey(input);
+        std::optional<JsonObject> recorded_plan = journal ? journal->lookup(plan_key) : std::nullopt;
+        JsonObject plan;
+        if (recorded_plan) {
+            plan = std::move(*recorded_plan);
+        } else {
+            std::vector<Message> messages = planMessages(input);
+            LLMResponse plan_response = co_await offload([&]() { return llm->chat(messages); });
+            plan = Utils::parseJsonResponse(plan_response.content);
+            if (!isValidPlan(plan)) {
+                co_return JsonObject{{"answer", plan_response.content}, {"error", "Failed to get plan from LLM"}};
+            }
+            if (journal) {
+                co_await offload([&]() { journal->record(plan_key, plan); });
+            }
+        }
+        const JsonObject& items = plan["plan"];
+        const size_t count = items.size();
+        logStep("Plan", plan);
+        PlanGraph graph = resolveDependencies(items);
+        auto& [dependents, prerequisites, waiting_on] = graph;
+
+        std::vector<JsonObject> results(count);
+        std::vector<size_t> wave;
+        for (size_t i = 0; i < count; ++i) {
+            if (waiting_on[i] == 0) wave.push_back(i);
+        }
+        const size_t limit = max_parallel == 0 ? std::max<size_t>(count, 1) : max_parallel;
+        while (!wave.empty()) {
+            // Start the ready items in batches of at most `limit`
+            std::vector<size_t> batch(wave.begin(), wave.begin() + static_cast<std::ptrdiff_t>(std::min(limit, wave.size())));
+            wave.erase(wave.begin(), wave.begin() + static_cast<std::ptrdiff_t>(batch.size()));
+            std::vector<Task<JsonObject>> pending;
+            pending.reserve(batch.size());
+            for (size_t index : batch) {
+                const JsonObject& item = items[index];
+                std::string worker_name = item.value("worker", "");
+                std::string task = item.value("task", input);
+                JsonObject task_context = item.value("context", JsonObject::object());
+                if (!prerequisites[index].empty()) {
+                    JsonObject inputs = JsonObject::array();
+                    for (size_t dep : prerequisites[index]) inputs.push_back(results[dep]);
+                    task_context["prerequisites"] = std::move(inputs);
+                }
+                std::string key = workerKey(index, worker_name, task, task_context);
+                auto it = workers.find(worker_name);
+                if (it == workers.end()) {
+                    pending.push_back(failedWorker(worker_name, task));
+                } else {
+                    const Worker& worker = *it->second;
+                    pending.push_back(ExecutionJournal::journaled(journal, std::move(key),
+                        runWorkerTask(worker, worker.llm ? worker.llm : llm, task, task_context)));
+                }
+            }
+            std::vector<JsonObject> outputs = co_await whenAll(std::move(pending));
+
+            for (size_t k = 0; k < batch.size(); ++k) {
+                size_t index = batch[k];
+                logStep("Worker completed: " + outputs[k].value("worker_name", std::string()), outputs[k]);
+                results[index] = std::move(outputs[k]);
+                for (size_t next : dependents[index]) {
+                    if (--waiting_on[next] == 0) wave.push_back(next);
+                }
+            }
+        }
+        failCycles(items, input, waiting_on, results);
+
+        co_return synthesizer_ ? synthesizer_(results) : defaultSynthesizer(results);
+    }
+
     /**
      * @brief Set the max number of iterations
      * @param max_iterations The max number of iterations
@@ -175,6 +427,209 @@ private:
      */
     std::string createOrchestratorSystemPrompt() const;
 
+    /**
+     * @brief Index the registered workers by name
+     * @note Built per run, so workers added after an earlier run are found.
+     * The first worker registered under a name wins.
+     * @return Pointers into workers_, keyed by worker name
+     */
+    std::map<std::string, const Worker*> workersByName() const {
+        std::map<std::string, const Worker*> workers;
+        for (const auto& worker : workers_) workers.emplace(worker.name, &worker);
+        return workers;
+    }
+
+    /**
+     * @brief Execute a worker on a given LLM without touching shared state
+     * @param worker The worker
+     * @param llm The LLM to use when the worker has no handler
+     * @param task The task for the worker
+     * @param context_data Extra context for the task
+     * @return The worker result with `worker_name`, `task` and `output`
+     */
+    static JsonObject runWorker(
+        const Worker& worker,
+        const std::shared_ptr<LLMInterface>& llm,
+        const std::string& task,
+        const JsonObject& context_data
+    ) {
+        if (worker.handler) {
+            JsonObject result = worker.handler(task, context_data);
+            if (result.is_object() && !result.contains("worker_name")) result["worker_name"] = worker.name;
+            return result;
+        }
+        std::string prompt = task;
+        if (context_data.is_object() && !context_data.empty()) {
+            prompt += "\n\nContext: " + context_data.dump();
+        }
+        LLMResponse response = llm->chat(std::vector<Message>{
+            Message{Message::Role::SYSTEM, worker.prompt_template},
+            Message{Message::Role::USER, prompt}
+        });
+        return JsonObject{{"worker_name", worker.name}, {"task", task}, {"output", response.content}};
+    }
+
+    /**
+     * @brief Run a worker as a coroutine, offloading it to the executor
+     * @param worker The worker
+     * @param llm The LLM to use when the worker has no handler
+     * @param task The task for the worker
+     * @param context_data Extra context for the task
+     * @return Task yielding the worker result with `latency_ms`, or `error` on failure
+     */
+    static Task<JsonObject> runWorkerTask(
+        Worker worker,
+        std::shared_ptr<LLMInterface> llm,
+        std::string task,
+        JsonObject context_data
+    ) {
+        using Clock = std::chrono::steady_clock;
+        auto start = Clock::now();
+        JsonObject result;
+        try {
+            result = co_await offload([&]() { return runWorker(worker, llm, task, context_data); });
+        } catch (const std::exception& e) {
+            result = JsonObject{{"worker_name", worker.name}, {"task", task}, {"error", e.what()}};
+        }
+        result["latency_ms"] = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        co_return result;
+    }
+
+    /**
+     * @brief Result for a plan item naming an unknown worker
+     * @param worker_name The requested worker
+     * @param task The task
+     * @return Task yielding the error result
+     */
+    static Task<JsonObject> failedWorker(std::string worker_name, std::string task) {
+        co_return JsonObject{{"worker_name", worker_name}, {"task", task}, {"error", "Worker not found"}};
+    }
+
+    /**
+     * @brief Dependency edges between plan items
+     */
+    struct PlanGraph {
+        /**
+         * @brief Items waiting on each item
+         */
+        std::vector<std::vector<size_t>> dependents;
+        /**
+         * @brief Items each item waits on
+         */
+        std::vector<std::vector<size_t>> prerequisites;
+        /**
+         * @brief Number of unfinished prerequisites per item
+         */
+        std::vector<size_t> waiting_on;
+    };
+
+    /**
+     * @brief Journal key for the plan
+     * @param input The input to the workflow
+     * @return The key
+     */
+    static std::string planKey(const std::string& input) {
+        return "plan:" + Utils::hashHex(input);
+    }
+
+    /**
+     * @brief Journal key for a plan item's worker call
+     * @param index The plan index
+     * @param worker_name The worker
+     * @param task The task
+     * @param context_data The task context, including prerequisite outputs
+     * @return The key
+     */
+    static std::string workerKey(size_t index, const std::string& worker_name, const std::string& task, const JsonObject& context_data) {
+        return "worker:" + std::to_string(index) + ":" + Utils::hashHex(worker_name + '\n' + task + '\n' + context_data.dump());
+    }
+
+    /**
+     * @brief Messages asking the orchestrator for a plan with optional dependencies
+     * @param input The input to the workflow
+     * @return The messages
+     */
+    std::vector<Message> planMessages(const std::string& input) const {
+        std::string system_prompt = createOrchestratorSystemPrompt() +
+            "\n\nPlan items that need the output of other items may add \"id\" and "
+            "\"depends_on\": [<ids>]. Items without dependencies run in parallel.";
+        return std::vector<Message>{
+            Message{Message::Role::SYSTEM, system_prompt},
+            Message{Message::Role::USER, input}
+        };
+    }
+
+    /**
+     * @brief Check that a parsed plan has a non-empty `plan` array
+     * @param plan The parsed orchestrator response
+     * @return Whether the plan is usable
+     */
+    static bool isValidPlan(const JsonObject& plan) {
+        return plan.is_object() && plan.contains("plan") && plan["plan"].is_array() && !plan["plan"].empty();
+    }
+
+    /**
+     * @brief Resolve `id`/`depends_on` references to plan indices
+     *
+     * A reference matches an item's `id` of the same JSON type first (so
+     * `"1"` and `1` are different ids); an integer that matches no id is
+     * taken as a plan index.
+     *
+     * @param items The plan items
+     * @return The dependency edges; unknown, duplicate and self references are ignored
+     */
+    static PlanGraph resolveDependencies(const JsonObject& items) {
+        const size_t count = items.size();
+        std::map<JsonObject, size_t> ids;
+        for (size_t i = 0; i < count; ++i) {
+            if (items[i].contains("id")) ids.emplace(items[i]["id"], i);
+        }
+        PlanGraph graph{std::vector<std::vector<size_t>>(count), std::vector<std::vector<size_t>>(count), std::vector<size_t>(count, 0)};
+        for (size_t i = 0; i < count; ++i) {
+            if (!items[i].contains("depends_on") || !items[i]["depends_on"].is_array()) continue;
+            for (const auto& dep : items[i]["depends_on"]) {
+                std::optional<size_t> target;
+                if (auto it = ids.find(dep); it != ids.end()) {
+                    target = it->second;
+                } else if (dep.is_number_unsigned() || (dep.is_number_integer() && dep.get<int64_t>() >= 0)) {
+                    target = dep.get<size_t>();
+                }
+                if (!target || *target >= count || *target == i ||
+                    std::find(graph.prerequisites[i].begin(), graph.prerequisites[i].end(), *target) != graph.prerequisites[i].end()) {
+                    continue;
+                }
+                graph.dependents[*target].push_back(i);
+                graph.prerequisites[i].push_back(*target);
+                graph.waiting_on[i]++;
+            }
+        }
+        return graph;
+    }
+
+    /**
+     * @brief Mark items still waiting on a dependency cycle as failed
+     * @param items The plan items
+     * @param input The workflow input (the task of items without one)
+     * @param waiting_on Unfinished dependency counts
+     * @param results The results, filled in for the failed items
+     * @return The number of items marked
+     */
+    static size_t failCycles(const JsonObject& items, const std::string& input, const std::vector<size_t>& waiting_on,
+                             std::vector<JsonObject>& results) {
+        size_t marked = 0;
+        for (size_t i = 0; i < items.size(); ++i) {
+            if (waiting_on[i] > 0 && results[i].is_null()) {
+                results[i] = JsonObject{
+                    {"worker_name", items[i].value("worker", "")},
+                    {"task", items[i].value("task", input)},
+                    {"error", "Dependency cycle"}
+                };
+                marked++;
+            }
+        }
+        return marked;
+    }
+
     /**
      * @brief Execute a worker by name
      */
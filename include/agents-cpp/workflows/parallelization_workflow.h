@@ -9,8 +9,10 @@
  */
 #pragma once
 
+#include <agents-cpp/execution_journal.h>
 #include <agents-cpp/workflow.h>
 #include <functional>
+#include <stdexcept>
 #include <vector>
 
 namespace agents {
@@ -169,6 +171,56 @@ public:
      */
     JsonObject run();
 
+    /**
+     * @brief Execute the workflow as a coroutine
+     *
+     * Runs run() on the executor (see Workflow::runTask()), so the result is
+     * what run() returns.
+     */
+    using Workflow::runTask;
+
+    /**
+     * @brief Execute the workflow as a coroutine, journaling LLM calls
+     *
+     * Runs run() with the LLM wrapped in a JournalingLLM, so the tasks send
+     * the same prompts and the result is what run() returns. Every completed
+     * call is recorded in the journal; running again with a journal for the
+     * same workflow id, e.g. after a crash, answers the recorded calls from
+     * it and only sends the tasks that had not completed. Like runTask(), the
+     * whole run holds an executor thread.
+     *
+     * @param input The input to the workflow
+     * @param journal The journal (nothing is journaled when null)
+     * @return Task yielding what run() returns
+     */
+    agents::Task<JsonObject> runTask(std::string input, std::shared_ptr<ExecutionJournal> journal) {
+        if (!journal) {
+            co_return co_await Workflow::runTask(std::move(input));
+        }
+        Span span("workflow.run");
+        span.setAttribute("workflow.type", "parallelization");
+        auto llm = llm_ ? llm_ : context_->getLLM();
+        if (!llm) {
+            throw std::runtime_error("No LLM configured on the context");
+        }
+        auto journaling = std::make_shared<JournalingLLM>(llm, journal);
+        // run() calls through the cached llm_ when it is set, so swap both
+        JsonObject result = co_await offload([&]() {
+            std::shared_ptr<LLMInterface> cached = llm_ ? journaling : nullptr;
+            llm_.swap(cached);
+            try {
+                JsonObject output = runWithLLM(input, journaling);
+                llm_.swap(cached);
+                return output;
+            } catch (...) {
+                llm_.swap(cached);
+                throw;
+            }
+        });
+        logStep("Journal", JsonObject{{"replayed", journaling->replayed()}});
+        co_return result;
+    }
+
 private:
     /**
      * @brief List of tasks to execute in parallel
@@ -9,8 +9,15 @@
  */
 #pragma once
 
+#include <agents-cpp/coroutine_utils.h>
+#include <agents-cpp/memo_store.h>
 #include <agents-cpp/workflow.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <functional>
+#include <map>
+#include <mutex>
 #include <vector>
 
 namespace agents {
@@ -70,6 +77,31 @@ public:
             validator(validator), transformer(transformer) {}
     };
 
+    /**
+     * @brief Options for batch execution
+     */
+    struct BatchOptions {
+        /**
+         * @brief Maximum LLM calls in flight per step
+         */
+        size_t concurrency = 4;
+
+        /**
+         * @brief Per-step overrides of `concurrency`, keyed by step name
+         */
+        std::map<std::string, size_t> step_concurrency;
+
+        /**
+         * @brief Called with each result in input order, as soon as all earlier inputs are done
+         */
+        std::function<void(size_t, const JsonObject&)> on_result;
+
+        /**
+         * @brief Opt-in memoization of step outputs (off when `memo.store` is null)
+         */
+        Memoization memo;
+    };
+
     /**
      * @brief Constructor with context
      * @param context The context to use
@@ -114,6 +146,160 @@ public:
      */
     JsonObject run();
 
+    /**
+     * @brief Run many inputs through the chain with default batch options
+     * @param inputs The inputs to process
+     * @return The results, in input order
+     */
+    std::vector<JsonObject> runBatch(const std::vector<std::string>& inputs) {
+        return runBatch(inputs, BatchOptions());
+    }
+
+    /**
+     * @brief Run many inputs through the chain with the steps pipelined
+     *
+     * Each input runs the library's run() on its own copy of the context,
+     * so its result, the prompts sent (with `{input}`, `{context}`,
+     * `{step_name}`, `{step_index}` and `{total_steps}` substituted) and the
+     * step callbacks are exactly those of run(input) as the next call on
+     * this workflow. The copies start from the context's system prompt,
+     * tools and conversation at the start of the batch and do not write
+     * back to it, so inputs do not see each other's messages.
+     *
+     * Every step acts as a stage with its own limit on LLM calls in flight,
+     * so step 2 of one input overlaps with step 1 of the next. A run holds
+     * a thread while it waits, so at most the sum of the stage limits runs
+     * at once. The step callback is invoked from those threads, so entries
+     * of different inputs interleave; with memoization enabled it also
+     * receives one `Memo` entry with the batch's hit rate at the end.
+     *
+     * @param inputs The inputs to process
+     * @param options Concurrency, ordered result callback and memoization
+     * @return The results, in input order
+     */
+    std::vector<JsonObject> runBatch(const std::vector<std::string>& inputs, const BatchOptions& options) {
+        auto llm = context_->getLLM();
+        if (!llm) {
+            throw std::runtime_error("No LLM configured on the context");
+        }
+        std::vector<JsonObject> results(inputs.size(), JsonObject::object());
+        if (inputs.empty()) {
+            return results;
+        }
+
+        auto stages = std::make_shared<std::vector<Stage>>(std::max<size_t>(steps_.size(), 1));
+        size_t workers = 0;
+        for (size_t s = 0; s < steps_.size(); ++s) {
+            auto it = options.step_concurrency.find(steps_[s].name);
+            (*stages)[s].limit = std::max<size_t>(it != options.step_concurrency.end() ? it->second : options.concurrency, 1);
+            workers += (*stages)[s].limit;
+        }
+        workers = std::min(std::max<size_t>(workers, 1), inputs.size());
+        for (auto& stage : *stages) {
+            stage.llm = llm;
+        }
+        std::shared_ptr<MemoizingLLM> memoizing;
+        if (options.memo.store) {
+            memoizing = std::make_shared<MemoizingLLM>(llm, options.memo);
+        }
+        for (size_t s = 0; s < steps_.size(); ++s) {
+            (*stages)[s].llm = memoizing ? memoizing->forStep(steps_[s].name) : llm;
+        }
+        std::vector<std::shared_ptr<Tool>> tools = context_->getTools();
+        std::vector<Message> history = context_->getMessages();
+        const std::string system_prompt = context_->getSystemPrompt();
+
+        // Each worker runs whole inputs; results are handed out in input order
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::vector<bool> done(inputs.size(), false);
+        size_t next_input = 0, next_to_emit = 0, running = workers;
+        auto work = [&]() {
+            while (true) {
+                size_t index;
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (next_input == inputs.size()) break;
+                    index = next_input++;
+                }
+                JsonObject result;
+                try {
+                    auto context = std::make_shared<Context>();
+                    context->setLLM(std::make_shared<StagedLLM>(stages));
+                    context->setSystemPrompt(system_prompt);
+                    for (const auto& tool : tools) context->registerTool(tool);
+                    for (const auto& message : history) context->addMessage(message);
+                    PromptChainingWorkflow chain(context);
+                    for (const auto& step : steps_) chain.addStep(step);
+                    chain.setMaxSteps(max_steps_);
+                    chain.setStepCallback(step_callback_);
+                    result = chain.run(inputs[index]);
+                } catch (const std::exception& e) {
+                    result = JsonObject{{"error", e.what()}};
+                }
+                std::lock_guard<std::mutex> lock(mutex);
+                results[index] = std::move(result);
+                done[index] = true;
+                while (next_to_emit < inputs.size() && done[next_to_emit]) {
+                    if (options.on_result) options.on_result(next_to_emit, results[next_to_emit]);
+                    next_to_emit++;
+                }
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--running == 0) cv.notify_all();
+        };
+        for (size_t w = 0; w < workers; ++w) {
+            getExecutor()->add(work);
+        }
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [&running]() { return running == 0; });
+        }
+        if (memoizing) {
+            logStep("Memo", memoizing->statsToJson());
+        }
+        return results;
+    }
+
+    /**
+     * @brief Execute the workflow as a coroutine
+     *
+     * Runs run() on the executor (see Workflow::runTask()), so the result is
+     * what run() returns.
+     */
+    using Workflow::runTask;
+
+    /**
+     * @brief Execute the workflow as a coroutine, memoizing LLM calls
+     *
+     * Runs run() with the context LLM wrapped in a MemoizingLLM, so the
+     * chain sends the same prompts and returns the same result shape as
+     * without memoization; only calls already in the store are not sent.
+     * A call is keyed by the workflow id, its messages, the model and the
+     * options, so after a step's template changes, only that step and the
+     * steps that consume its output are recomputed. After the run the step
+     * callback receives a `Memo` entry with the hit rate.
+     *
+     * @param input The input to process
+     * @param memo The store and workflow id (no memoization when the store is null)
+     * @return Task yielding what run() returns
+     */
+    Task<JsonObject> runTask(std::string input, Memoization memo) {
+        if (!memo.store) {
+            co_return co_await Workflow::runTask(std::move(input));
+        }
+        Span span("workflow.run");
+        span.setAttribute("workflow.type", "prompt_chaining");
+        auto llm = context_->getLLM();
+        if (!llm) {
+            throw std::runtime_error("No LLM configured on the context");
+        }
+        auto memoizing = std::make_shared<MemoizingLLM>(llm, memo);
+        JsonObject result = co_await offload([&]() { return runWithLLM(input, memoizing); });
+        logStep("Memo", memoizing->statsToJson());
+        co_return result;
+    }
+
 private:
     /**
      * @brief List of steps in the workflow
@@ -131,6 +317,181 @@ private:
      * @return The result of the workflow execution
      */
     JsonObject runChain(const JsonObject& input);
+
+    /**
+     * @brief A batch stage: the step's LLM and its limit on calls in flight
+     */
+    struct Stage {
+        /**
+         * @brief The step's LLM (memoizing when enabled)
+         */
+        std::shared_ptr<LLMInterface> llm;
+        /**
+         * @brief Maximum calls in flight
+         */
+        size_t limit = 1;
+        /**
+         * @brief Calls in flight
+         */
+        size_t active = 0;
+        /**
+         * @brief Guards `active`
+         */
+        std::mutex mutex;
+        /**
+         * @brief Signalled when a call finishes
+         */
+        std::condition_variable cv;
+    };
+
+    /**
+     * @brief One input's LLM during a batch
+     *
+     * run() makes one call per step, in step order, so the n-th call of an
+     * input belongs to step n: it goes to that step's LLM once the stage
+     * has a free slot.
+     */
+    class StagedLLM : public LLMInterface {
+    public:
+        /**
+         * @brief Constructor
+         * @param stages The batch's stages, shared by every input
+         */
+        explicit StagedLLM(std::shared_ptr<std::vector<Stage>> stages) : stages_(std::move(stages)) {}
+
+        /**
+         * @brief Get available models
+         * @return The available models
+         */
+        std::vector<std::string> getAvailableModels() override { return stages_->front().llm->getAvailableModels(); }
+
+        /**
+         * @brief Models are fixed during a batch
+         */
+        void setModel(const std::string&) override {}
+
+        /**
+         * @brief Get the model
+         * @return The current model
+         */
+        std::string getModel() const override { return stages_->front().llm->getModel(); }
+
+        /**
+         * @brief API keys are fixed during a batch
+         */
+        void setApiKey(const std::string&) override {}
+
+        /**
+         * @brief API base URLs are fixed during a batch
+         */
+        void setApiBase(const std::string&) override {}
+
+        /**
+         * @brief Options are fixed during a batch
+         */
+        void setOptions(const LLMOptions&) override {}
+
+        /**
+         * @brief Get options
+         * @return The current options
+         */
+        LLMOptions getOptions() const override { return stages_->front().llm->getOptions(); }
+
+        /**
+         * @brief Generate completion from a prompt
+         * @param prompt The prompt
+         * @return The completion
+         */
+        LLMResponse chat(const std::string& prompt) override {
+            return chat(std::vector<Message>{Message{Message::Role::USER, prompt}});
+        }
+
+        /**
+         * @brief Generate completion in the current step's stage
+         * @param messages The messages to generate completion from
+         * @return The LLM response
+         */
+        LLMResponse chat(const std::vector<Message>& messages) override {
+            Slot slot(next());
+            return slot.stage.llm->chat(messages);
+        }
+
+        /**
+         * @brief Generate completion with tools in the current step's stage
+         * @param messages The messages to generate completion from
+         * @param tools The tools to use
+         * @return The LLM response
+         */
+        LLMResponse chatWithTools(
+            const std::vector<Message>& messages,
+            const std::vector<std::shared_ptr<Tool>>& tools
+        ) override {
+            Slot slot(next());
+            return slot.stage.llm->chatWithTools(messages, tools);
+        }
+
+        /**
+         * @brief Async chat in the current step's stage
+         * @param messages The messages to generate completion from
+         * @return The LLM response
+         */
+        Task<LLMResponse> chatAsync(const std::vector<Message>& messages) override {
+            Slot slot(next());
+            co_return co_await slot.stage.llm->chatAsync(messages);
+        }
+
+        /**
+         * @brief Async chat with tools in the current step's stage
+         * @param messages The messages to generate completion from
+         * @param tools The tools to use
+         * @return The LLM response
+         */
+        Task<LLMResponse> chatWithToolsAsync(
+            const std::vector<Message>& messages,
+            const std::vector<std::shared_ptr<Tool>>& tools
+        ) override {
+            Slot slot(next());
+            co_return co_await slot.stage.llm->chatWithToolsAsync(messages, tools);
+        }
+
+        /**
+         * @brief Stream in the current step's stage
+         * @param messages The messages to generate completion from
+         * @param callback The callback to use
+         */
+        void streamChat(
+            const std::vector<Message>& messages,
+            std::function<void(const std::string&, bool)> callback
+        ) override {
+            Slot slot(next());
+            slot.stage.llm->streamChat(messages, std::move(callback));
+        }
+
+    private:
+        std::shared_ptr<std::vector<Stage>> stages_;
+        std::atomic<size_t> calls_{0};
+
+        // Holds a slot in a stage for the duration of a call
+        struct Slot {
+            Stage& stage;
+            explicit Slot(Stage& stage) : stage(stage) {
+                std::unique_lock<std::mutex> lock(stage.mutex);
+                stage.cv.wait(lock, [&stage]() { return stage.active < stage.limit; });
+                stage.active++;
+            }
+            ~Slot() {
+                {
+                    std::lock_guard<std::mutex> lock(stage.mutex);
+                    stage.active--;
+                }
+                stage.cv.notify_one();
+            }
+        };
+
+        Stage& next() {
+            return (*stages_)[std::min(calls_++, stages_->size() - 1)];
+        }
+    };
 };
 
 } // namespace workflows
@@ -0,0 +1,224 @@
+/**
+ * @file route_classifier.h
+ * @brief Local nearest-centroid classifier for fast-path routing
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025 Edge AI, LLC. All rights reserved.
+ *
+ */
+#pragma once
+
+#include <agents-cpp/embedding.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace agents {
+namespace workflows {
+
+/**
+ * @brief Classifies inputs into routes without an LLM call
+ *
+ * Each route is represented by the centroid of the embeddings of its
+ * description and labelled examples. An input is assigned to the route with
+ * the most similar centroid; the prediction counts as confident when that
+ * similarity and its margin over the runner-up clear the configured
+ * thresholds. Unconfident inputs should go to the LLM router, whose decision
+ * can be fed back with addExample() so the fast path keeps improving.
+ *
+ * The default thresholds suit HashingEmbedder, whose bag-of-words cosine
+ * scores are low in absolute terms (a clear match often scores 0.2-0.4)
+ * but separate well by margin once each route has a few examples. Other
+ * embedders score on different scales; use calibrate() with held-out
+ * labelled inputs, or setThresholds(), when plugging one in.
+ *
+ * Classification is a single embedding plus one dot product per route, and
+ * is safe to call from several threads while examples are being added.
+ */
+class RouteClassifier {
+public:
+    /**
+     * @brief Result of classifying an input
+     */
+    struct Prediction {
+        /**
+         * @brief The best route (empty when no routes are registered)
+         */
+        std::string route;
+        /**
+         * @brief Cosine similarity to the best route's centroid
+         */
+        float similarity = 0.0f;
+        /**
+         * @brief Similarity lead over the second-best route
+         */
+        float margin = 0.0f;
+        /**
+         * @brief Whether the prediction clears both thresholds
+         */
+        bool confident = false;
+    };
+
+    /**
+     * @brief Constructor
+     * @param embedder The embedder for route texts and inputs
+     * @param min_similarity Minimum similarity for a confident prediction
+     * @param min_margin Minimum lead over the runner-up for a confident prediction
+     */
+    explicit RouteClassifier(Embedder embedder = HashingEmbedder(), float min_similarity = 0.1f, float min_margin = 0.08f)
+        : embedder_(std::move(embedder)), min_similarity_(min_similarity), min_margin_(min_margin) {
+        if (!embedder_) {
+            throw std::invalid_argument("RouteClassifier requires an embedder");
+        }
+    }
+
+    /**
+     * @brief Register a route by its description
+     * @param route The route name
+     * @param description The route description
+     */
+    void addRoute(const std::string& route, const std::string& description) {
+        addExample(route, description);
+    }
+
+    /**
+     * @brief Add a labelled example to a route (creating the route if needed)
+     * @param route The route name
+     * @param text Example input for the route
+     */
+    void addExample(const std::string& route, const std::string& text) {
+        Embedding embedding = embedder_(text);
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        Centroid& centroid = centroids_[route];
+        if (centroid.sum.empty()) {
+            centroid.sum.assign(embedding.size(), 0.0f);
+        }
+        if (centroid.sum.size() != embedding.size()) {
+            throw std::invalid_argument("Embedding dimension mismatch for route '" + route + "'");
+        }
+        for (size_t i = 0; i < embedding.size(); ++i) {
+            centroid.sum[i] += embedding[i];
+        }
+        centroid.count++;
+    }
+
+    /**
+     * @brief Classify an input
+     * @param input The input text
+     * @return The best route with its similarity, margin and confidence
+     */
+    Prediction classify(const std::string& input) const {
+        Embedding query = embedder_(input);
+        Prediction prediction;
+        float second = -1.0f;
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        for (const auto& [route, centroid] : centroids_) {
+            // Cosine similarity is scale-invariant, so the summed vector serves as the centroid
+            float similarity = cosineSimilarity(query, centroid.sum);
+            if (prediction.route.empty() || similarity > prediction.similarity) {
+                if (!prediction.route.empty()) second = prediction.similarity;
+                prediction.route = route;
+                prediction.similarity = similarity;
+            } else if (similarity > second) {
+                second = similarity;
+            }
+        }
+        prediction.margin = centroids_.size() > 1 ? prediction.similarity - second : prediction.similarity;
+        prediction.confident = !prediction.route.empty() &&
+            prediction.similarity >= min_similarity_ && prediction.margin >= min_margin_;
+        return prediction;
+    }
+
+    /**
+     * @brief Set the confidence thresholds
+     * @param min_similarity Minimum similarity for a confident prediction
+     * @param min_margin Minimum lead over the runner-up for a confident prediction
+     */
+    void setThresholds(float min_similarity, float min_margin) {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        min_similarity_ = min_similarity;
+        min_margin_ = min_margin;
+    }
+
+    /**
+     * @brief Fit the margin threshold to labelled inputs
+     *
+     * Classifies each input and sets the minimum margin to the lowest value
+     * at which the predictions clearing the similarity threshold are right
+     * at least `target_precision` of the time, so the fast path covers as
+     * many inputs as it can at that precision. When no margin reaches the
+     * target, the threshold is set above every observed margin and nothing
+     * is routed locally. The inputs should not also be added as examples.
+     *
+     * @param labelled Pairs of (route, input) held out from the examples
+     * @param target_precision Required fraction of correct confident predictions
+     * @return The chosen minimum margin
+     */
+    float calibrate(const std::vector<std::pair<std::string, std::string>>& labelled, float target_precision = 0.95f) {
+        float min_similarity;
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            min_similarity = min_similarity_;
+        }
+        std::vector<std::pair<float, bool>> scored; // margin, correct
+        for (const auto& [route, input] : labelled) {
+            Prediction prediction = classify(input);
+            if (!prediction.route.empty() && prediction.similarity >= min_similarity) {
+                scored.emplace_back(prediction.margin, prediction.route == route);
+            }
+        }
+        std::sort(scored.begin(), scored.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+
+        float threshold = std::numeric_limits<float>::max();
+        size_t correct = 0;
+        for (size_t i = 0; i < scored.size(); ++i) {
+            correct += scored[i].second;
+            // Only cut between distinct margins
+            bool boundary = i + 1 == scored.size() || scored[i + 1].first < scored[i].first;
+            if (boundary && static_cast<float>(correct) >= target_precision * static_cast<float>(i + 1)) {
+                threshold = scored[i].first;
+            }
+        }
+        if (threshold == std::numeric_limits<float>::max() && !scored.empty()) {
+            threshold = std::nextafter(scored.front().first, std::numeric_limits<float>::max());
+        }
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        min_margin_ = threshold;
+        return threshold;
+    }
+
+    /**
+     * @brief Number of registered routes
+     * @return The number of routes
+     */
+    size_t size() const {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        return centroids_.size();
+    }
+
+/*! @cond PRIVATE */
+private:
+    struct Centroid {
+        Embedding sum;
+        size_t count = 0;
+    };
+
+    Embedder embedder_;
+    float min_similarity_;
+    float min_margin_;
+    std::map<std::string, Centroid> centroids_;
+    mutable std::shared_mutex mutex_;
+/*! @endcond */
+};
+
+} // namespace workflows
+} // namespace agents
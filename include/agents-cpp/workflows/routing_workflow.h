@@ -9,7 +9,9 @@
  */
 #pragma once
 
+#include <agents-cpp/utils.h>
 #include <agents-cpp/workflow.h>
+#include <agents-cpp/workflows/route_classifier.h>
 #include <functional>
 #include <map>
 
@@ -119,6 +121,67 @@ public:
      */
     JsonObject run(const std::string& input) override;
 
+    /**
+     * @brief Register every route's description with a local classifier
+     * @param classifier The classifier to seed
+     */
+    void registerRoutes(RouteClassifier& classifier) const {
+        for (const auto& [name, handler] : route_handlers_) {
+            classifier.addRoute(name, handler.description);
+        }
+    }
+
+    /**
+     * @brief Execute the workflow, routing locally when the classifier is confident
+     *
+     * A confident local prediction dispatches straight to the route handler,
+     * skipping the LLM router round trip. Otherwise the LLM router decides as
+     * in run(), and with `learn` set its decision is added to the classifier
+     * as a labelled example. The `routing_info` passed to handlers carries
+     * `route`, `reason`, `confidence` and `fast_path`.
+     *
+     * @param input The input to the workflow
+     * @param classifier The local classifier (see registerRoutes())
+     * @param learn Whether to learn from LLM router decisions
+     * @return The output of the workflow
+     */
+    JsonObject runFastPath(const std::string& input, RouteClassifier& classifier, bool learn = true) {
+        RouteClassifier::Prediction prediction = classifier.classify(input);
+        if (prediction.confident && route_handlers_.count(prediction.route)) {
+            JsonObject routing_info{
+                {"route", prediction.route},
+                {"reason", "local classifier"},
+                {"confidence", prediction.similarity},
+                {"context", JsonObject::object()},
+                {"fast_path", true}
+            };
+            logStep("Routing decision", routing_info);
+            return dispatchRoute(prediction.route, input, routing_info);
+        }
+
+        auto llm = context_->getLLM();
+        if (!llm) {
+            throw std::runtime_error("No LLM configured on the context");
+        }
+        LLMResponse response = llm->chat(std::vector<Message>{
+            Message{Message::Role::SYSTEM, createRouterSystemPrompt()},
+            Message{Message::Role::USER, input}
+        });
+        JsonObject routing_info = Utils::parseJsonResponse(response.content);
+        if (!routing_info.is_object()) {
+            routing_info = JsonObject{{"route", ""}, {"reason", response.content}};
+        }
+        routing_info["confidence"] = prediction.similarity;
+        routing_info["fast_path"] = false;
+        logStep("Routing decision", routing_info);
+
+        std::string route = routing_info.value("route", "");
+        if (learn && route_handlers_.count(route)) {
+            classifier.addExample(route, input);
+        }
+        return dispatchRoute(route, input, routing_info);
+    }
+
     /**
      * @brief Set the router prompt template
      * @param prompt_template The prompt template to set
@@ -182,6 +245,35 @@ private:
      * @return The router system prompt
      */
     std::string createRouterSystemPrompt() const;
+
+    /**
+     * @brief Run the handler for a route, or the default handler if it is unknown
+     * @param route The route name
+     * @param input The input to the workflow
+     * @param routing_info The routing decision passed to the handler
+     * @return The handler output
+     */
+    JsonObject dispatchRoute(const std::string& route, const std::string& input, const JsonObject& routing_info) {
+        auto it = route_handlers_.find(route);
+        const RouteHandler* handler = it != route_handlers_.end() ? &it->second
+            : (default_handler_ ? &*default_handler_ : nullptr);
+        if (!handler) {
+            throw std::runtime_error("No suitable route found and no default handler configured");
+        }
+        if (handler->handler) {
+            return handler->handler(input, routing_info);
+        }
+        if (handler->workflow) {
+            return handler->workflow->run(input);
+        }
+        auto llm = handler->llm ? handler->llm : context_->getLLM();
+        std::vector<Message> messages;
+        if (!handler->prompt_template.empty()) {
+            messages.push_back(Message{Message::Role::SYSTEM, handler->prompt_template});
+        }
+        messages.push_back(Message{Message::Role::USER, input});
+        return JsonObject{{"answer", llm->chat(messages).content}, {"route", handler->name}};
+    }
 };
 
 } // namespace workflows
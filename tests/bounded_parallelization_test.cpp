@@ -0,0 +1,284 @@
+/**
+ * @file bounded_parallelization_test.cpp
+ * @brief BoundedParallelizationWorkflow::runBounded() concurrency cap, timeouts and cancellation,
+ * and VotingAggregator early decisions
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025 Edge AI, LLC. All rights reserved.
+ *
+ */
+#include <agents-cpp/context.h>
+#include <agents-cpp/workflows/bounded_parallelization_workflow.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace agents;
+using namespace agents::workflows;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << std::endl;
+        failures++;
+    }
+}
+
+// Replies with the system prompt after a delay taken from it ("sleep <ms>"),
+// tracking how many calls run at once
+class SlowLLM : public LLMInterface {
+public:
+    std::vector<std::string> getAvailableModels() override { return {"slow"}; }
+    void setModel(const std::string&) override {}
+    std::string getModel() const override { return "slow"; }
+    void setApiKey(const std::string&) override {}
+    void setApiBase(const std::string&) override {}
+    void setOptions(const LLMOptions& options) override { options_ = options; }
+    LLMOptions getOptions() const override { return options_; }
+
+    LLMResponse chat(const std::string& prompt) override {
+        return chat(std::vector<Message>{Message{Message::Role::USER, prompt}});
+    }
+
+    LLMResponse chat(const std::vector<Message>& messages) override {
+        int running = ++active;
+        int seen = peak.load();
+        while (running > seen && !peak.compare_exchange_weak(seen, running)) {}
+        calls++;
+        const std::string& system = messages.front().content;
+        int delay_ms = system.rfind("sleep ", 0) == 0 ? std::stoi(system.substr(6)) : 0;
+        std::this_thread::sleep_for(std::chrono::milliseconds(delay_ms));
+        --active;
+        LLMResponse response;
+        response.content = system;
+        return response;
+    }
+
+    LLMResponse chatWithTools(const std::vector<Message>& messages,
+                              const std::vector<std::shared_ptr<Tool>>&) override {
+        return chat(messages);
+    }
+
+    void streamChat(const std::vector<Message>& messages,
+                    std::function<void(const std::string&, bool)> callback) override {
+        callback(chat(messages).content, true);
+    }
+
+    std::atomic<int> active{0};
+    std::atomic<int> peak{0};
+    std::atomic<int> calls{0};
+
+private:
+    LLMOptions options_;
+};
+
+// Exposes runBounded() to the test
+class Bounded : public BoundedParallelizationWorkflow {
+public:
+    using BoundedParallelizationWorkflow::BoundedParallelizationWorkflow;
+    using BoundedParallelizationWorkflow::runBounded;
+};
+
+struct Delivery {
+    size_t index;
+    JsonObject result;
+    bool cancelled;
+};
+
+struct Fixture {
+    std::shared_ptr<SlowLLM> llm = std::make_shared<SlowLLM>();
+    std::shared_ptr<Bounded> workflow;
+
+    explicit Fixture(const std::vector<int>& delays_ms) {
+        auto context = std::make_shared<Context>();
+        context->setLLM(llm);
+        workflow = std::make_shared<Bounded>(context);
+        for (size_t i = 0; i < delays_ms.size(); ++i) {
+            workflow->addTask("task" + std::to_string(i), "sleep " + std::to_string(delays_ms[i]));
+        }
+    }
+
+    std::vector<Delivery> run(const std::function<bool()>& stop = nullptr, size_t first = 0,
+                              std::optional<size_t> last = std::nullopt) {
+        std::vector<Delivery> deliveries;
+        workflow->runBounded(llm, "input", [&deliveries](size_t index, JsonObject result, bool cancelled) {
+            deliveries.push_back(Delivery{index, std::move(result), cancelled});
+        }, stop, first, last);
+        return deliveries;
+    }
+};
+
+bool eachOnce(const std::vector<Delivery>& deliveries, size_t first, size_t end) {
+    std::map<size_t, int> seen;
+    for (const auto& delivery : deliveries) seen[delivery.index]++;
+    if (seen.size() != end - first) return false;
+    for (const auto& [index, count] : seen) {
+        if (index < first || index >= end || count != 1) return false;
+    }
+    return true;
+}
+
+void testConcurrencyCap() {
+    Fixture fixture(std::vector<int>(12, 20));
+    fixture.workflow->setMaxConcurrency(3);
+    std::vector<Delivery> deliveries = fixture.run();
+    check(eachOnce(deliveries, 0, 12), "every task is delivered exactly once");
+    check(fixture.llm->peak.load() <= 3, "no more than max_concurrency requests run at once: " +
+          std::to_string(fixture.llm->peak.load()));
+    check(fixture.llm->peak.load() >= 2, "requests do run concurrently");
+    bool ok = std::all_of(deliveries.begin(), deliveries.end(), [](const Delivery& delivery) {
+        return !delivery.cancelled && delivery.result.value("response", "") == "sleep 20";
+    });
+    check(ok, "each result is the task's reply");
+}
+
+void testRange() {
+    Fixture fixture(std::vector<int>(6, 0));
+    std::vector<Delivery> deliveries = fixture.run(nullptr, 2, 5);
+    check(eachOnce(deliveries, 2, 5), "only tasks in [first, last) run");
+    check(fixture.llm->calls.load() == 3, "tasks outside the range are not sent");
+    check(fixture.run(nullptr, 4, 4).empty(), "an empty range delivers nothing");
+}
+
+void testCompletionOrder() {
+    Fixture fixture({150, 0});
+    fixture.workflow->setMaxConcurrency(2);
+    std::vector<Delivery> deliveries = fixture.run();
+    check(deliveries.size() == 2 && deliveries[0].index == 1 && deliveries[1].index == 0,
+          "results are delivered in completion order");
+}
+
+void testTimeout() {
+    Fixture fixture({1000, 0, 0});
+    fixture.workflow->setMaxConcurrency(2);
+    fixture.workflow->setTaskTimeout(100);
+    auto start = std::chrono::steady_clock::now();
+    std::vector<Delivery> deliveries = fixture.run();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    check(eachOnce(deliveries, 0, 3), "a timed-out task is delivered once");
+    for (const auto& delivery : deliveries) {
+        if (delivery.index == 0) {
+            check(delivery.result.value("error", "") == "timeout" && !delivery.cancelled, "the slow task times out");
+        } else {
+            check(!delivery.result.contains("error"), "the other tasks complete");
+        }
+    }
+    check(elapsed < std::chrono::milliseconds(800), "the run does not wait for the abandoned request");
+    // The abandoned request still holds a slot, so only one more runs next to it
+    std::vector<Delivery> again = fixture.run();
+    check(eachOnce(again, 0, 3), "the next run delivers every task again");
+    check(fixture.llm->peak.load() <= 2, "abandoned requests count against the cap across runs");
+}
+
+void testStop() {
+    Fixture fixture(std::vector<int>(8, 30));
+    fixture.workflow->setMaxConcurrency(2);
+    size_t delivered = 0;
+    std::vector<Delivery> deliveries;
+    fixture.workflow->runBounded(fixture.llm, "input", [&](size_t index, JsonObject result, bool cancelled) {
+        if (!cancelled) delivered++;
+        deliveries.push_back(Delivery{index, std::move(result), cancelled});
+    }, [&delivered]() { return delivered >= 2; });
+    check(eachOnce(deliveries, 0, 8), "stopping still delivers every task once");
+    size_t cancelled = static_cast<size_t>(std::count_if(deliveries.begin(), deliveries.end(),
+        [](const Delivery& delivery) { return delivery.cancelled; }));
+    check(delivered == 2 && cancelled == 6, "the unfinished tasks are cancelled once stop() is true");
+    for (const auto& delivery : deliveries) {
+        if (delivery.cancelled) {
+            check(delivery.result.value("error", "") == "cancelled", "a cancelled task carries the cancelled error");
+        }
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    check(fixture.llm->calls.load() <= 4, "tasks not yet sent when the run stops are never sent: " +
+          std::to_string(fixture.llm->calls.load()));
+}
+
+JsonObject vote(const std::string& response) {
+    return JsonObject{{"response", response}};
+}
+
+void testVotingDecided() {
+    VotingAggregator votes(0.5);
+    votes.reset(5);
+    check(!votes.decided(), "no votes decide nothing");
+    votes.add("v1", vote("Yes"));
+    votes.add("v2", vote(" yes."));
+    check(!votes.decided(), "2 of 5 is neither a quorum nor unbeatable");
+    votes.add("v3", vote("YES"));
+    check(votes.decided(), "3 of 5 reaches the 0.5 quorum");
+    check(votes.finish().value("votes", 0) == 3, "normalized responses count as one answer");
+
+    VotingAggregator strict(0.9);
+    strict.reset(5);
+    for (const char* response : {"a", "a", "a", "b"}) strict.add("v", vote(response));
+    check(strict.decided(), "a lead larger than the outstanding votes is decided below the quorum");
+
+    VotingAggregator close(0.9);
+    close.reset(5);
+    for (const char* response : {"a", "a", "b"}) close.add("v", vote(response));
+    check(!close.decided(), "a lead the outstanding votes could overturn is not decided");
+
+    VotingAggregator tie(0.5);
+    tie.reset(4);
+    for (const char* response : {"a", "b", "a", "b"}) tie.add("v", vote(response));
+    check(!tie.decided(), "a tie at the quorum is not decided");
+
+    VotingAggregator failed(0.5);
+    failed.reset(3);
+    failed.add("v1", vote("a"));
+    failed.add("v2", JsonObject{{"error", "timeout"}});
+    check(!failed.decided(), "a failed voter is not a vote, and one vote can still be tied");
+    failed.add("v3", JsonObject{{"error", "timeout"}});
+    check(failed.decided(), "with no votes outstanding, the only answer wins");
+
+    VotingAggregator widened(0.6);
+    widened.reset(2);
+    widened.add("v1", vote("a"));
+    widened.add("v2", vote("b"));
+    check(!widened.decided(), "a split vote is not decided");
+    widened.expand(4);
+    widened.add("v3", vote("a"));
+    check(!widened.decided(), "after expand() the new voters are outstanding");
+    widened.add("v4", vote("a"));
+    check(widened.decided(), "the widened vote is decided once the leader is ahead");
+}
+
+void testVotingStopsEarly() {
+    Fixture fixture(std::vector<int>(5, 20));
+    fixture.workflow->setStrategy(BoundedParallelizationWorkflow::Strategy::VOTING);
+    fixture.workflow->setMaxConcurrency(1);
+    JsonObject output = fixture.workflow->run("question");
+    check(output.value("answer", "") == "sleep 20" && output.value("votes", 0) == 3,
+          "the run returns the quorum's answer: " + output.dump());
+    check(output.value("cancelled", 0) == 2, "the voters left after the quorum are cancelled");
+    check(fixture.llm->calls.load() == 3, "cancelled voters are never sent");
+}
+
+} // namespace
+
+int main() {
+    testConcurrencyCap();
+    testRange();
+    testCompletionOrder();
+    testTimeout();
+    testStop();
+    testVotingDecided();
+    testVotingStopsEarly();
+    if (failures > 0) {
+        return EXIT_FAILURE;
+    }
+    std::cout << "bounded_parallelization_test passed" << std::endl;
+    return EXIT_SUCCESS;
+}
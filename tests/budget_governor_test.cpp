@@ -0,0 +1,164 @@
+/**
+ * @file budget_governor_test.cpp
+ * @brief BudgetGovernor accounting and BudgetedLLM soft and hard limits
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025 Edge AI, LLC. All rights reserved.
+ *
+ */
+#include <agents-cpp/budget_governor.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace agents;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << std::endl;
+        failures++;
+    }
+}
+
+// Answers every chat with fixed usage and remembers what it was sent
+class FakeLLM : public LLMInterface {
+public:
+    FakeLLM(std::string model, double prompt_tokens, double completion_tokens)
+        : model_(std::move(model)), prompt_tokens_(prompt_tokens), completion_tokens_(completion_tokens) {}
+
+    std::vector<std::string> getAvailableModels() override { return {model_}; }
+    void setModel(const std::string& model) override { model_ = model; }
+    std::string getModel() const override { return model_; }
+    void setApiKey(const std::string&) override {}
+    void setApiBase(const std::string&) override {}
+    void setOptions(const LLMOptions& options) override { options_ = options; }
+    LLMOptions getOptions() const override { return options_; }
+
+    LLMResponse chat(const std::string& prompt) override {
+        return chat(std::vector<Message>{Message{Message::Role::USER, prompt}});
+    }
+
+    LLMResponse chat(const std::vector<Message>& messages) override {
+        calls++;
+        last_messages = messages;
+        LLMResponse response;
+        response.content = model_;
+        response.usage_metrics = {{"prompt_tokens", prompt_tokens_}, {"completion_tokens", completion_tokens_}};
+        return response;
+    }
+
+    LLMResponse chatWithTools(const std::vector<Message>& messages,
+                              const std::vector<std::shared_ptr<Tool>>&) override {
+        return chat(messages);
+    }
+
+    void streamChat(const std::vector<Message>& messages,
+                    std::function<void(const std::string&, bool)> callback) override {
+        callback(chat(messages).content, true);
+    }
+
+    int calls = 0;
+    std::vector<Message> last_messages;
+
+private:
+    std::string model_;
+    double prompt_tokens_;
+    double completion_tokens_;
+    LLMOptions options_;
+};
+
+void testAccounting() {
+    Budget budget;
+    budget.max_input_tokens = 1000;
+    budget.default_pricing = {1.0, 2.0};
+    budget.pricing["cheap"] = {0.1, 0.2};
+    BudgetGovernor governor(budget);
+
+    check(governor.check() == BudgetGovernor::Status::OK, "an unused budget is OK");
+    governor.record(500, 100, "premium");
+    governor.record(100, 500, "cheap");
+    BudgetUsage usage = governor.getUsage();
+    check(usage.input_tokens == 600 && usage.output_tokens == 600 && usage.calls == 2, "usage accumulates");
+    check(std::abs(usage.cost - (0.5 + 0.2 + 0.01 + 0.1)) < 1e-9, "cost uses per-model and default pricing");
+    check(std::abs(governor.getUtilization() - 0.6) < 1e-9, "utilization is the highest fraction of any limit");
+
+    governor.record(250, 0, "premium");
+    check(governor.check() == BudgetGovernor::Status::SOFT_LIMIT, "crossing the soft threshold is reported");
+    governor.record(150, 0, "premium");
+    check(governor.check() == BudgetGovernor::Status::HARD_LIMIT, "reaching a limit is a hard limit");
+
+    governor.reset();
+    check(governor.getUsage().calls == 0 && governor.check() == BudgetGovernor::Status::OK, "reset clears usage");
+}
+
+void testTokenNormalization() {
+    auto openai = BudgetGovernor::extractTokenUsage({{"prompt_tokens", 3}, {"completion_tokens", 4}});
+    auto anthropic = BudgetGovernor::extractTokenUsage({{"input_tokens", 5}, {"output_tokens", 6}});
+    auto google = BudgetGovernor::extractTokenUsage({{"promptTokenCount", 7}, {"candidatesTokenCount", 8}});
+    auto ollama = BudgetGovernor::extractTokenUsage({{"prompt_eval_count", 9}, {"eval_count", 10}});
+    check(openai.first == 3 && openai.second == 4, "OpenAI usage keys are understood");
+    check(anthropic.first == 5 && anthropic.second == 6, "Anthropic usage keys are understood");
+    check(google.first == 7 && google.second == 8, "Google usage keys are understood");
+    check(ollama.first == 9 && ollama.second == 10, "Ollama usage keys are understood");
+}
+
+void testBudgetedLLM() {
+    Budget budget;
+    budget.max_output_tokens = 100;
+    budget.soft_threshold = 0.5;
+    auto governor = std::make_shared<BudgetGovernor>(budget);
+    auto primary = std::make_shared<FakeLLM>("primary", 10, 30);
+    auto fallback = std::make_shared<FakeLLM>("fallback", 10, 30);
+    BudgetedLLM llm(primary, governor, fallback, 2);
+
+    std::vector<Message> conversation = {
+        {Message::Role::SYSTEM, "system"},
+        {Message::Role::USER, "one"},
+        {Message::Role::ASSISTANT, "two"},
+        {Message::Role::USER, "three"},
+        {Message::Role::ASSISTANT, "four"},
+        {Message::Role::USER, "five"}
+    };
+
+    check(llm.chat(conversation).content == "primary", "below the soft threshold the primary LLM answers");
+    check(primary->last_messages.size() == conversation.size(), "below the soft threshold nothing is trimmed");
+    llm.chat(conversation);
+
+    check(llm.chat(conversation).content == "fallback", "past the soft threshold the fallback LLM answers");
+    check(fallback->last_messages.size() == 3 && fallback->last_messages[0].role == Message::Role::SYSTEM &&
+          fallback->last_messages[2].content == "five",
+          "past the soft threshold the system prompt and the latest messages are kept");
+    check(governor->getUsage().output_tokens == 90, "usage of both LLMs is recorded");
+
+    llm.chat(conversation);
+    bool threw = false;
+    try {
+        llm.chat(conversation);
+    } catch (const BudgetExceededError&) {
+        threw = true;
+    }
+    check(threw, "a call at the hard limit throws BudgetExceededError");
+    check(primary->calls + fallback->calls == 4, "the call over the limit never reaches an LLM");
+}
+
+} // namespace
+
+int main() {
+    testAccounting();
+    testTokenNormalization();
+    testBudgetedLLM();
+    if (failures > 0) {
+        return EXIT_FAILURE;
+    }
+    std::cout << "budget_governor_test passed" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,194 @@
+/**
+ * @file call_timing_test.cpp
+ * @brief CallTiming usage round-trip, InterTokenLatency summaries and TimedLLM stream timing
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025 Edge AI, LLC. All rights reserved.
+ *
+ */
+#include <agents-cpp/call_timing.h>
+#include <agents-cpp/instrumentation.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace agents;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << std::endl;
+        failures++;
+    }
+}
+
+// Streams its chunks with a fixed delay before each one
+class ChunkedLLM : public LLMInterface {
+public:
+    ChunkedLLM(std::vector<std::string> chunks, int delay_ms) : chunks_(std::move(chunks)), delay_ms_(delay_ms) {}
+
+    std::vector<std::string> getAvailableModels() override { return {"chunked"}; }
+    void setModel(const std::string&) override {}
+    std::string getModel() const override { return "chunked"; }
+    void setApiKey(const std::string&) override {}
+    void setApiBase(const std::string&) override {}
+    void setOptions(const LLMOptions& options) override { options_ = options; }
+    LLMOptions getOptions() const override { return options_; }
+
+    LLMResponse chat(const std::string& prompt) override {
+        return chat(std::vector<Message>{Message{Message::Role::USER, prompt}});
+    }
+
+    LLMResponse chat(const std::vector<Message>&) override {
+        LLMResponse response;
+        for (const auto& chunk : chunks_) response.content += chunk;
+        response.usage_metrics["prompt_tokens"] = 12;
+        response.usage_metrics["completion_tokens"] = 34;
+        return response;
+    }
+
+    LLMResponse chatWithTools(const std::vector<Message>& messages,
+                              const std::vector<std::shared_ptr<Tool>>&) override {
+        return chat(messages);
+    }
+
+    void streamChat(const std::vector<Message>&,
+                    std::function<void(const std::string&, bool)> callback) override {
+        for (size_t i = 0; i < chunks_.size(); ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(delay_ms_));
+            callback(chunks_[i], i + 1 == chunks_.size());
+        }
+    }
+
+    AsyncGenerator<std::string> streamChatAsync(const std::vector<Message>&,
+                                                const std::vector<std::shared_ptr<Tool>>&) override {
+        for (const auto& chunk : chunks_) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(delay_ms_));
+            co_yield chunk;
+        }
+    }
+
+private:
+    std::vector<std::string> chunks_;
+    int delay_ms_;
+    LLMOptions options_;
+};
+
+void testFromGaps() {
+    InterTokenLatency none = InterTokenLatency::fromGaps({});
+    check(none.count == 0 && none.mean_ms == 0.0 && none.max_ms == 0.0, "no gaps summarize to zeros");
+
+    InterTokenLatency one = InterTokenLatency::fromGaps({7.0});
+    check(one.count == 1 && one.min_ms == 7.0 && one.p50_ms == 7.0 && one.p95_ms == 7.0 && one.max_ms == 7.0,
+          "a single gap is every statistic");
+
+    std::vector<double> gaps;
+    for (int i = 20; i >= 1; --i) gaps.push_back(static_cast<double>(i));
+    InterTokenLatency many = InterTokenLatency::fromGaps(gaps);
+    check(many.count == 20, "every gap is counted");
+    check(many.mean_ms == 10.5, "the mean of 1..20 is 10.5");
+    check(many.min_ms == 1.0 && many.max_ms == 20.0, "min and max ignore the input order");
+    check(many.p50_ms == 11.0, "the median rounds to the nearest rank: " + std::to_string(many.p50_ms));
+    check(many.p95_ms == 19.0, "p95 rounds to the nearest rank: " + std::to_string(many.p95_ms));
+}
+
+void testRoundTrip() {
+    CallTiming timing;
+    timing.time_to_first_token_ms = 120.5;
+    timing.total_ms = 900.25;
+    timing.inter_token = InterTokenLatency::fromGaps({3.0, 1.0, 2.0});
+    timing.input_tokens = 1500;
+    timing.output_tokens = 250;
+    timing.cached_tokens = 1024;
+    timing.tokens_estimated = true;
+
+    std::map<std::string, double> usage{{"prompt_tokens", 1.0}};
+    timing.writeTo(usage);
+    CallTiming read = CallTiming::fromUsage(usage);
+    check(read.time_to_first_token_ms == 120.5 && read.total_ms == 900.25, "durations survive the round-trip");
+    check(read.inter_token.count == 3 && read.inter_token.mean_ms == 2.0 && read.inter_token.min_ms == 1.0 &&
+          read.inter_token.p50_ms == 2.0 && read.inter_token.p95_ms == 3.0 && read.inter_token.max_ms == 3.0,
+          "the streaming gaps survive the round-trip");
+    check(read.input_tokens == 1500 && read.output_tokens == 250 && read.cached_tokens == 1024,
+          "the call.* token counts win over provider keys");
+    check(read.tokens_estimated, "the estimate flag survives the round-trip");
+
+    LLMResponse response;
+    response.usage_metrics = usage;
+    check(CallTiming::from(response).total_ms == 900.25, "from() reads the response's usage");
+
+    CallTiming provider = CallTiming::fromUsage({{"input_tokens", 40.0}, {"output_tokens", 9.0},
+                                                 {"cache_read_input_tokens", 32.0}});
+    check(provider.input_tokens == 40 && provider.output_tokens == 9 && provider.cached_tokens == 32,
+          "without call.* entries the provider's token keys are read");
+    check(provider.total_ms == 0.0 && provider.time_to_first_token_ms == -1.0 && !provider.tokens_estimated,
+          "without call.* entries nothing is timed");
+}
+
+void testTimedChat() {
+    std::vector<CallTiming> observed;
+    TimedLLM llm(std::make_shared<ChunkedLLM>(std::vector<std::string>{"a", "b"}, 0),
+                 [&observed](const std::string&, const CallTiming& timing) { observed.push_back(timing); });
+    LLMResponse response = llm.chat("question");
+    CallTiming timing = CallTiming::from(response);
+    check(timing.input_tokens == 12 && timing.output_tokens == 34 && !timing.tokens_estimated,
+          "chat() takes the provider's token counts");
+    check(timing.time_to_first_token_ms == -1.0, "chat() has no time to first token");
+    check(observed.size() == 1 && observed[0].output_tokens == 34, "the observer receives the breakdown");
+}
+
+void checkStreamed(const CallTiming& timing, const std::string& name) {
+    check(timing.time_to_first_token_ms >= 15.0, name + ": time to first token covers the first delay: " +
+          std::to_string(timing.time_to_first_token_ms));
+    check(timing.inter_token.count == 2, name + ": three chunks give two gaps");
+    check(timing.inter_token.min_ms >= 15.0, name + ": each gap covers a delay: " + std::to_string(timing.inter_token.min_ms));
+    check(timing.total_ms >= timing.time_to_first_token_ms + 30.0, name + ": the total covers every chunk");
+    check(timing.tokens_estimated && timing.output_tokens > 0, name + ": token counts are estimated");
+}
+
+void testTimedStreams() {
+    std::vector<CallTiming> observed;
+    TimedLLM llm(std::make_shared<ChunkedLLM>(std::vector<std::string>{"Hello", " streamed", " world"}, 20),
+                 [&observed](const std::string&, const CallTiming& timing) { observed.push_back(timing); });
+    std::vector<Message> messages{Message{Message::Role::USER, "question"}};
+
+    std::string received;
+    LLMResponse response = llm.streamChatResponse(messages, [&received](const std::string& chunk, bool) {
+        received += chunk;
+    });
+    check(received == "Hello streamed world" && response.content == received,
+          "streamChatResponse() forwards the chunks and returns the content");
+    checkStreamed(CallTiming::from(response), "streamChatResponse() response");
+    check(observed.size() == 1, "streamChatResponse() notifies the observer");
+
+    received.clear();
+    auto stream = llm.streamChatAsync(messages, {});
+    while (auto chunk = blockingWait(stream.next())) received += *chunk;
+    check(received == "Hello streamed world", "streamChatAsync() yields every chunk");
+    check(observed.size() == 2, "streamChatAsync() notifies the observer once the stream ends");
+    if (observed.size() == 2) checkStreamed(observed[1], "streamChatAsync()");
+}
+
+} // namespace
+
+int main() {
+    testFromGaps();
+    testRoundTrip();
+    testTimedChat();
+    testTimedStreams();
+    if (failures > 0) {
+        return EXIT_FAILURE;
+    }
+    std::cout << "call_timing_test passed" << std::endl;
+    return EXIT_SUCCESS;
+}
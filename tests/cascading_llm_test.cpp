@@ -0,0 +1,209 @@
+/**
+ * @file cascading_llm_test.cpp
+ * @brief CascadingLLM escalation, confidence checks and statistics
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025 Edge AI, LLC. All rights reserved.
+ *
+ */
+#include <agents-cpp/cascading_llm.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace agents;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << std::endl;
+        failures++;
+    }
+}
+
+// Answers with a fixed reply and counts the calls it receives
+class FakeLLM : public LLMInterface {
+public:
+    explicit FakeLLM(std::string reply) : reply(std::move(reply)) {}
+
+    std::vector<std::string> getAvailableModels() override { return {"fake"}; }
+    void setModel(const std::string&) override {}
+    std::string getModel() const override { return "fake"; }
+    void setApiKey(const std::string&) override {}
+    void setApiBase(const std::string&) override {}
+    void setOptions(const LLMOptions& options) override { options_ = options; }
+    LLMOptions getOptions() const override { return options_; }
+
+    LLMResponse chat(const std::string& prompt) override {
+        return chat(std::vector<Message>{Message{Message::Role::USER, prompt}});
+    }
+
+    LLMResponse chat(const std::vector<Message>&) override {
+        calls++;
+        LLMResponse response;
+        response.content = reply;
+        return response;
+    }
+
+    LLMResponse chatWithTools(const std::vector<Message>& messages,
+                              const std::vector<std::shared_ptr<Tool>>&) override {
+        return chat(messages);
+    }
+
+    // Streams the reply in two chunks
+    void streamChat(const std::vector<Message>&,
+                    std::function<void(const std::string&, bool)> callback) override {
+        calls++;
+        size_t half = reply.size() / 2;
+        callback(reply.substr(0, half), false);
+        callback(reply.substr(half), true);
+    }
+
+    std::string reply;
+    int calls = 0;
+
+private:
+    LLMOptions options_;
+};
+
+void testSelfReportedConfidence() {
+    auto small = std::make_shared<FakeLLM>(R"({"answer": "Paris", "confidence": 0.9})");
+    auto large = std::make_shared<FakeLLM>("Paris, from the large model");
+    CascadingLLM llm({small, large}, CascadingLLM::selfReportedConfidence(0.7));
+
+    check(llm.chat("Capital of France?").content == small->reply, "a confident first tier answers");
+    check(large->calls == 0, "a confident answer does not escalate");
+
+    small->reply = "Paris\nConfidence = 0.8";
+    check(llm.chat("Capital of France?").content == small->reply, "a plain-text score above the minimum is accepted");
+    small->reply = "Paris\nconfidence: 0.4";
+    check(llm.chat("Capital of France?").content == large->reply, "a plain-text score below the minimum escalates");
+    small->reply = "Paris\nconfidence: 80";
+    check(llm.chat("Capital of France?").content == large->reply, "a score above 1 is rejected, not rescaled");
+    small->reply = R"({"answer": "Paris", "confidence": 8})";
+    check(llm.chat("Capital of France?").content == large->reply, "a JSON score above 1 is rejected");
+    small->reply = "Paris";
+    check(llm.chat("Capital of France?").content == large->reply, "a response without a score escalates");
+
+    CascadingLLM::Stats stats = llm.getStats();
+    check(stats.requests == 6 && stats.escalations == 4, "requests and escalations are counted");
+    check(stats.accepted_by_tier == std::vector<size_t>{2, 4}, "answers are attributed to the accepting tier");
+    check(stats.calls_by_tier == std::vector<size_t>{6, 4}, "every tier tried is counted as called");
+}
+
+void testSchemaCheck() {
+    JsonObject schema = {
+        {"type", "object"},
+        {"required", {"answer"}},
+        {"properties", {{"answer", {{"type", "string"}}}}}
+    };
+    auto small = std::make_shared<FakeLLM>("```json\n{\"answer\": \"42\"}\n```");
+    auto large = std::make_shared<FakeLLM>(R"({"answer": "forty-two"})");
+    CascadingLLM llm({small, large}, CascadingLLM::schemaCheck(schema));
+
+    check(llm.chat("question").content == small->reply, "a fenced response matching the schema is accepted");
+    small->reply = R"({"answer": 42})";
+    check(llm.chat("question").content == large->reply, "a property of the wrong type escalates");
+    small->reply = R"({"result": "42"})";
+    check(llm.chat("question").content == large->reply, "a missing required property escalates");
+}
+
+void testPerTierChecksAndLastTier() {
+    auto first = std::make_shared<FakeLLM>("first");
+    auto second = std::make_shared<FakeLLM>("second");
+    auto third = std::make_shared<FakeLLM>("third");
+    auto reject = [](const std::vector<Message>&, const LLMResponse&) { return false; };
+    CascadingLLM llm(std::vector<CascadingLLM::Tier>{{first, reject, nullptr}, {second, reject, nullptr}, {third, reject, nullptr}});
+
+    check(llm.chat("question").content == "third", "the last tier's response is returned without a check");
+    check(first->calls == 1 && second->calls == 1 && third->calls == 1, "each tier is tried once in order");
+}
+
+void testStreaming() {
+    auto small = std::make_shared<FakeLLM>(R"({"answer": "yes", "confidence": 0.95})");
+    auto large = std::make_shared<FakeLLM>("streamed by the large model");
+    CascadingLLM llm({small, large}, CascadingLLM::selfReportedConfidence(0.7));
+
+    std::vector<std::string> chunks;
+    auto collect = [&chunks](const std::string& chunk, bool) { chunks.push_back(chunk); };
+    llm.streamChat({Message{Message::Role::USER, "question"}}, collect);
+    check(chunks == std::vector<std::string>{small->reply}, "an accepted buffered tier arrives as one chunk");
+
+    chunks.clear();
+    small->reply = "not sure";
+    llm.streamChat({Message{Message::Role::USER, "question"}}, collect);
+    check(chunks.size() == 2 && chunks[0] + chunks[1] == large->reply, "the last tier streams its chunks through");
+}
+
+void testAsync() {
+    auto small = std::make_shared<FakeLLM>("confidence: 0.2");
+    auto large = std::make_shared<FakeLLM>("large");
+    CascadingLLM llm({small, large}, CascadingLLM::selfReportedConfidence(0.7));
+    LLMResponse response = blockingWait(llm.chatAsync({Message{Message::Role::USER, "question"}}));
+    check(response.content == "large", "chatAsync escalates like chat");
+    check(llm.getStats().escalations == 1, "async requests are counted");
+}
+
+// Grades with a fixed score and records whether it was called blocking or async
+class GraderLLM : public FakeLLM {
+public:
+    explicit GraderLLM(double score) : FakeLLM("{\"score\": " + std::to_string(score) + ", \"feedback\": \"ok\"}") {}
+
+    LLMResponse chat(const std::vector<Message>& messages) override {
+        blocking_calls++;
+        return FakeLLM::chat(messages);
+    }
+
+    Task<LLMResponse> chatAsync(const std::vector<Message>&) override {
+        async_calls++;
+        LLMResponse response;
+        response.content = reply;
+        co_return response;
+    }
+
+    int blocking_calls = 0;
+    int async_calls = 0;
+};
+
+void testGraderTier() {
+    auto small = std::make_shared<FakeLLM>("small");
+    auto large = std::make_shared<FakeLLM>("large");
+    auto grader = std::make_shared<GraderLLM>(0.9);
+    CascadingLLM llm(std::vector<CascadingLLM::Tier>{
+        CascadingLLM::graderTier(small, grader, "correct", 0.7), {large, nullptr, nullptr}});
+
+    check(llm.chat("question").content == "small", "a well-graded first tier answers");
+    check(grader->blocking_calls == 1 && grader->async_calls == 0, "chat() grades with the blocking check");
+
+    LLMResponse response = blockingWait(llm.chatAsync({Message{Message::Role::USER, "question"}}));
+    check(response.content == "small", "chatAsync accepts a well-graded first tier");
+    check(grader->blocking_calls == 1 && grader->async_calls == 1, "chatAsync awaits the grader's chatAsync");
+
+    grader->reply = R"({"score": 0.2, "feedback": "wrong"})";
+    response = blockingWait(llm.chatAsync({Message{Message::Role::USER, "question"}}));
+    check(response.content == "large", "chatAsync escalates on a low grade");
+    check(grader->blocking_calls == 1, "the async path never blocks on the grader");
+}
+
+} // namespace
+
+int main() {
+    testSelfReportedConfidence();
+    testSchemaCheck();
+    testPerTierChecksAndLastTier();
+    testStreaming();
+    testAsync();
+    testGraderTier();
+    if (failures > 0) {
+        return EXIT_FAILURE;
+    }
+    std::cout << "cascading_llm_test passed" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,213 @@
+/**
+ * @file coroutine_utils_test.cpp
+ * @brief Task and AsyncGenerator regressions: deep await loops, await semantics and optional results
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025 Edge AI, LLC. All rights reserved.
+ *
+ */
+#include <agents-cpp/coroutine_utils.h>
+
+#include <agents-cpp/trace_context.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace agents;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << std::endl;
+        failures++;
+    }
+}
+
+Task<int> one() {
+    co_return 1;
+}
+
+// Every awaited task completes synchronously; without symmetric transfer
+// each iteration would nest a resume frame and overflow the stack
+Task<long> sumOfOnes(long count) {
+    long total = 0;
+    for (long i = 0; i < count; ++i) {
+        total += co_await one();
+    }
+    co_return total;
+}
+
+Task<void> nothing() {
+    co_return;
+}
+
+Task<long> countVoidAwaits(long count) {
+    long awaited = 0;
+    for (long i = 0; i < count; ++i) {
+        co_await nothing();
+        ++awaited;
+    }
+    co_return awaited;
+}
+
+Task<int> offloadedTwo() {
+    co_return co_await offload([]() { return 2; });
+}
+
+// Awaited tasks that suspend and finish on an executor thread
+Task<long> sumOffloaded(long count) {
+    long total = 0;
+    for (long i = 0; i < count; ++i) {
+        total += co_await offloadedTwo();
+    }
+    co_return total;
+}
+
+void testDeepAwaitLoop() {
+    const long count = 1000000;
+    check(blockingWait(sumOfOnes(count)) == count, "a million synchronous Task<int> awaits complete");
+    check(blockingWait(countVoidAwaits(count)) == count, "a million synchronous Task<void> awaits complete");
+    check(blockingWait(sumOffloaded(2000)) == 4000, "tasks that finish on another thread resume their awaiter");
+}
+
+Task<int> failsInline() {
+    throw std::runtime_error("inline");
+    co_return 0;
+}
+
+Task<int> failsOffloaded() {
+    co_await offload([]() {});
+    throw std::runtime_error("offloaded");
+    co_return 0;
+}
+
+Task<std::string> catchFrom(Task<int> task) {
+    try {
+        co_await task;
+    } catch (const std::runtime_error& error) {
+        co_return error.what();
+    }
+    co_return "";
+}
+
+// An awaited task that changes the thread's trace context, as a span left
+// open would, and finishes on the awaiting thread or on an executor thread
+Task<int> switchesContext(bool offloaded) {
+    TraceContext::current().span_id = 99;
+    if (offloaded) {
+        co_await offload([]() {});
+        TraceContext::current().span_id = 98;
+    }
+    co_return 1;
+}
+
+Task<int> keepsContext(bool offloaded) {
+    TraceContext::current().span_id = 7;
+    co_await switchesContext(offloaded);
+    co_return static_cast<int>(TraceContext::current().span_id);
+}
+
+// Awaits an inline task that itself awaits one finishing on an executor thread
+Task<int> middle() {
+    int inline_part = co_await one();
+    int offloaded_part = co_await offloadedTwo();
+    co_return inline_part + offloaded_part;
+}
+
+Task<int> nested() {
+    int total = 0;
+    for (int i = 0; i < 100; ++i) total += co_await middle();
+    co_return total;
+}
+
+void testAwaitSemantics() {
+    check(blockingWait(catchFrom(failsInline())) == "inline", "an exception from an inline task reaches the awaiter");
+    check(blockingWait(catchFrom(failsOffloaded())) == "offloaded",
+          "an exception from a task finishing on another thread reaches the awaiter");
+
+    const auto caller = std::this_thread::get_id();
+    TraceContext::current().span_id = 0;
+    check(blockingWait(keepsContext(false)) == 7, "the awaiter's context survives an inline task changing it");
+    check(blockingWait(keepsContext(true)) == 7, "the awaiter's context survives a task resuming it on another thread");
+    check(std::this_thread::get_id() == caller && TraceContext::current().span_id == 0,
+          "blockingWait() leaves the caller's context untouched");
+
+    check(blockingWait(nested()) == 300, "nested inline and offloaded awaits resume the right awaiter");
+
+    // get_sync() may return while the executor thread is still in the task's
+    // final awaiter; the task is destroyed right away (run under ASan or TSan)
+    long total = 0;
+    for (int i = 0; i < 2000; ++i) total += blockingWait(offloadedTwo());
+    check(total == 4000, "blockingWait() on tasks finishing on another thread returns each result");
+}
+
+Task<std::optional<int>> maybe(bool present) {
+    if (!present) {
+        co_return std::nullopt;
+    }
+    co_return 42;
+}
+
+Task<int> countPresent() {
+    int present = 0;
+    for (bool flag : {true, false, true, false}) {
+        std::optional<int> value = co_await maybe(flag);
+        if (value) {
+            check(*value == 42, "an awaited optional carries its value");
+            present++;
+        }
+    }
+    co_return present;
+}
+
+void testOptionalResult() {
+    check(blockingWait(maybe(true)) == std::optional<int>(42), "Task<optional<int>> returns a value");
+    check(!blockingWait(maybe(false)).has_value(), "Task<optional<int>> returns nullopt");
+    check(blockingWait(countPresent()) == 2, "awaited Task<optional<int>> keeps nullopt results");
+}
+
+AsyncGenerator<std::string> words() {
+    co_yield "alpha";
+    co_yield "beta";
+    co_yield "gamma";
+}
+
+Task<int> nextAfterEnd() {
+    auto generator = words();
+    int items = 0;
+    while (co_await generator.next()) {
+        items++;
+    }
+    // An exhausted generator keeps reporting the end
+    check(!(co_await generator.next()).has_value(), "next() after the end returns nullopt");
+    co_return items;
+}
+
+void testGeneratorDrain() {
+    std::vector<std::string> all = collectAll(words());
+    check(all == std::vector<std::string>{"alpha", "beta", "gamma"}, "collectAll drains the generator");
+    check(blockingWait(nextAfterEnd()) == 3, "next() yields each item once and then ends");
+}
+
+} // namespace
+
+int main() {
+    testDeepAwaitLoop();
+    testAwaitSemantics();
+    testOptionalResult();
+    testGeneratorDrain();
+    if (failures > 0) {
+        return EXIT_FAILURE;
+    }
+    std::cout << "coroutine_utils_test passed" << std::endl;
+    return EXIT_SUCCESS;
+}
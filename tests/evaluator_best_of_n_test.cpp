@@ -0,0 +1,262 @@
+/**
+ * @file evaluator_best_of_n_test.cpp
+ * @brief EvaluatorWorkflow::runBestOfN() candidate selection, ties, refinement, per-criterion scoring and errors
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025 Edge AI, LLC. All rights reserved.
+ *
+ */
+#include <agents-cpp/context.h>
+#include <agents-cpp/workflows/evaluator_workflow.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace agents;
+using namespace agents::workflows;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << std::endl;
+        failures++;
+    }
+}
+
+template <typename E, typename F>
+bool throws(F&& f) {
+    try {
+        f();
+    } catch (const E&) {
+        return true;
+    } catch (...) {
+    }
+    return false;
+}
+
+// Drafts "draft <n>" (or "revised <n>" once it sees a previous response) and
+// scores a response with `score(system prompt, response)`. The workflow's
+// evaluator prompt is recognised by its "Query: " user message.
+class ScriptedLLM : public LLMInterface {
+public:
+    using Score = std::function<std::string(const std::string& system, const std::string& response)>;
+
+    explicit ScriptedLLM(Score score) : score_(std::move(score)) {}
+
+    std::vector<std::string> getAvailableModels() override { return {"scripted"}; }
+    void setModel(const std::string&) override {}
+    std::string getModel() const override { return "scripted"; }
+    void setApiKey(const std::string&) override {}
+    void setApiBase(const std::string&) override {}
+    void setOptions(const LLMOptions& options) override { options_ = options; }
+    LLMOptions getOptions() const override { return options_; }
+
+    LLMResponse chat(const std::string& prompt) override {
+        return chat(std::vector<Message>{Message{Message::Role::USER, prompt}});
+    }
+
+    LLMResponse chat(const std::vector<Message>& messages) override {
+        const std::string& user = messages.back().content;
+        LLMResponse response;
+        if (user.rfind("Query: ", 0) == 0) {
+            evaluations++;
+            const std::string system = messages.size() > 1 ? messages.front().content : "";
+            response.content = score_(system, user.substr(user.find("Response: ") + 10));
+            return response;
+        }
+        drafts++;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            prompts.push_back(user);
+        }
+        size_t marker = user.find("(Draft ");
+        std::string number = marker == std::string::npos ? "1" : user.substr(marker + 7, user.find(' ', marker + 7) - marker - 7);
+        response.content = (user.find("Previous response:") == std::string::npos ? "draft " : "revised ") + number;
+        return response;
+    }
+
+    LLMResponse chatWithTools(const std::vector<Message>& messages,
+                              const std::vector<std::shared_ptr<Tool>>&) override {
+        return chat(messages);
+    }
+
+    void streamChat(const std::vector<Message>& messages,
+                    std::function<void(const std::string&, bool)> callback) override {
+        callback(chat(messages).content, true);
+    }
+
+    std::atomic<int> drafts{0};
+    std::atomic<int> evaluations{0};
+    std::vector<std::string> prompts;
+
+private:
+    Score score_;
+    std::mutex mutex_;
+    LLMOptions options_;
+};
+
+std::string scored(double score, const std::string& feedback = "ok") {
+    return JsonObject{{"score", score}, {"feedback", feedback}}.dump();
+}
+
+// Scores each response from a table; unknown responses score 0
+ScriptedLLM::Score table(std::map<std::string, std::string> replies) {
+    return [replies](const std::string&, const std::string& response) {
+        auto it = replies.find(response);
+        return it == replies.end() ? scored(0.0) : it->second;
+    };
+}
+
+struct Fixture {
+    std::shared_ptr<ScriptedLLM> llm;
+    std::shared_ptr<EvaluatorWorkflow> workflow;
+
+    explicit Fixture(ScriptedLLM::Score score, int max_iterations = 3, double threshold = 0.8) {
+        llm = std::make_shared<ScriptedLLM>(std::move(score));
+        auto context = std::make_shared<Context>();
+        context->setLLM(llm);
+        workflow = std::make_shared<EvaluatorWorkflow>(context);
+        workflow->setMaxIterations(max_iterations);
+        workflow->setImprovementThreshold(threshold);
+    }
+};
+
+void testSelection() {
+    Fixture fixture(table({{"draft 1", scored(0.2)}, {"draft 2", scored(0.9, "good")}, {"draft 3", scored(0.5)}}));
+    JsonObject result = fixture.workflow->runBestOfN("write a haiku", 3);
+    check(result.value("final_response", "") == "draft 2" && result.value("final_score", 0.0) == 0.9,
+          "the highest scoring candidate wins: " + result.dump());
+    check(result.value("iterations", 0) == 1, "a candidate over the threshold ends the loop");
+    check(result["evaluations"][0]["candidate_scores"] == JsonObject::array({0.2, 0.9, 0.5}),
+          "every candidate's score is reported in order");
+    check(fixture.llm->drafts.load() == 3 && fixture.llm->evaluations.load() == 3, "one draft and one score per candidate");
+    bool distinct = fixture.llm->prompts.size() == 3;
+    for (size_t i = 0; i < fixture.llm->prompts.size(); ++i) {
+        for (size_t j = i + 1; j < fixture.llm->prompts.size(); ++j) {
+            if (fixture.llm->prompts[i] == fixture.llm->prompts[j]) distinct = false;
+        }
+    }
+    check(distinct, "the candidates are asked for distinct drafts");
+
+    Fixture single(table({{"draft 1", scored(1.0)}}));
+    check(single.workflow->runBestOfN("x", 0).value("candidates_per_iteration", 0) == 1, "zero candidates means one");
+}
+
+void testTies() {
+    Fixture first(table({{"draft 1", scored(0.5)}, {"draft 2", scored(0.5)}, {"draft 3", scored(0.5)}}), 1);
+    check(first.workflow->runBestOfN("x", 3).value("final_response", "") == "draft 1",
+          "among tied candidates the first one wins");
+
+    // The revision ties with the first iteration's best, which is kept
+    Fixture kept(table({{"draft 1", scored(0.6)}, {"revised 1", scored(0.6)}}), 2);
+    JsonObject result = kept.workflow->runBestOfN("x", 1);
+    check(result.value("iterations", 0) == 2 && result.value("final_response", "") == "draft 1",
+          "a later candidate that only ties does not replace the best: " + result.dump());
+}
+
+void testRefinement() {
+    Fixture fixture(table({{"draft 1", scored(0.4, "too long")}, {"draft 2", scored(0.3)},
+                           {"revised 1", scored(0.85)}, {"revised 2", scored(0.2)}}));
+    JsonObject result = fixture.workflow->runBestOfN("x", 2);
+    check(result.value("final_response", "") == "revised 1" && result.value("iterations", 0) == 2,
+          "the loop refines until a candidate reaches the threshold: " + result.dump());
+    bool refined = false;
+    for (const auto& prompt : fixture.llm->prompts) {
+        if (prompt.find("Previous response:\ndraft 1") != std::string::npos && prompt.find("too long") != std::string::npos) {
+            refined = true;
+        }
+    }
+    check(refined, "the next iteration sees the best response and its feedback");
+
+    Fixture capped(table({{"draft 1", scored(0.1)}}), 2);
+    JsonObject low = capped.workflow->runBestOfN("x", 1);
+    check(low.value("iterations", 0) == 2 && low.value("final_response", "") == "draft 1" &&
+          low["evaluations"].size() == 2, "without a candidate over the threshold the loop stops at max_iterations");
+}
+
+void testPerCriterion() {
+    Fixture fixture([](const std::string& system, const std::string&) {
+        return system.find("criterion only: clarity") != std::string::npos ? scored(1.0, "clear") : scored(0.5, "vague");
+    }, 3, 0.7);
+    fixture.workflow->setEvaluationCriteria({"clarity", "accuracy"});
+    JsonObject result = fixture.workflow->runBestOfN("x", 2, true);
+    check(result.value("final_score", 0.0) == 0.75, "per-criterion scores are averaged: " + result.dump());
+    check(fixture.llm->evaluations.load() == 4, "each candidate is scored once per criterion");
+    std::string feedback = result["evaluations"][0].value("feedback", "");
+    check(feedback.find("- clarity: clear") != std::string::npos && feedback.find("- accuracy: vague") != std::string::npos,
+          "feedback is labelled by criterion");
+}
+
+void testCustomFunctions() {
+    Fixture fixture(table({}));
+    std::mutex mutex;
+    std::vector<int> seen;
+    fixture.workflow->setOptimizer([&](const std::string&, const JsonObject& feedback) {
+        std::lock_guard<std::mutex> lock(mutex);
+        seen.push_back(feedback.value("candidate", -1));
+        return "custom " + std::to_string(feedback.value("candidate", -1)) + "/" + std::to_string(feedback.value("candidates", 0));
+    });
+    fixture.workflow->setEvaluator([](const std::string&, const std::string& response) {
+        return JsonObject{{"score", response == "custom 2/3" ? 1.0 : 0.0}, {"feedback", ""}};
+    });
+    JsonObject result = fixture.workflow->runBestOfN("x", 3, true);
+    std::sort(seen.begin(), seen.end());
+    check(seen == std::vector<int>{0, 1, 2}, "the optimizer is told which candidate it drafts");
+    check(result.value("final_response", "") == "custom 2/3", "the custom evaluator picks the winner");
+    check(fixture.llm->drafts.load() == 0 && fixture.llm->evaluations.load() == 0,
+          "custom functions replace the LLM, per_criterion included");
+}
+
+void testErrors() {
+    Fixture invalid(table({{"draft 1", "not json"}, {"draft 2", scored(7.0)}, {"draft 3", scored(0.3)}}), 1);
+    JsonObject result = invalid.workflow->runBestOfN("x", 3);
+    check(result.value("final_response", "") == "draft 3" && result.value("final_score", 0.0) == 0.3,
+          "unparsable and out-of-range scores count as 0: " + result.dump());
+    check(result["evaluations"][0]["candidate_scores"] == JsonObject::array({0.0, 0.0, 0.3}),
+          "the rejected candidates are reported with 0");
+
+    Fixture strict(table({}));
+    strict.workflow->setEvaluator([](const std::string&, const std::string&) { return JsonObject{{"score", 1.5}}; });
+    check(throws<std::out_of_range>([&]() { strict.workflow->runBestOfN("x", 2); }),
+          "a custom evaluator outside [0, 1] throws");
+
+    Fixture failing([](const std::string&, const std::string& response) -> std::string {
+        if (response == "draft 2") throw std::runtime_error("evaluator down");
+        return scored(1.0);
+    });
+    check(throws<std::runtime_error>([&]() { failing.workflow->runBestOfN("x", 2); }),
+          "an evaluator failure reaches the caller once every call has finished");
+
+    auto context = std::make_shared<Context>();
+    EvaluatorWorkflow empty(context);
+    check(throws<std::runtime_error>([&]() { empty.runBestOfN("x", 2); }), "no LLM on the context throws");
+}
+
+} // namespace
+
+int main() {
+    testSelection();
+    testTies();
+    testRefinement();
+    testPerCriterion();
+    testCustomFunctions();
+    testErrors();
+    if (failures > 0) {
+        return EXIT_FAILURE;
+    }
+    std::cout << "evaluator_best_of_n_test passed" << std::endl;
+    return EXIT_SUCCESS;
+}
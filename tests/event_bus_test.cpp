@@ -0,0 +1,285 @@
+/**
+ * @file event_bus_test.cpp
+ * @brief EventBus ordering, overflow policies, subscriber isolation, flush and shutdown delivery
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025 Edge AI, LLC. All rights reserved.
+ *
+ */
+#include <agents-cpp/event_bus.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace agents;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << std::endl;
+        failures++;
+    }
+}
+
+// Collects delivered events; optionally holds the first batch until released
+class Recorder {
+public:
+    explicit Recorder(bool hold_first = false) : holding_(hold_first) {}
+
+    EventBus::Handler handler() {
+        return [this](const std::vector<Event>& batch) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            events_.insert(events_.end(), batch.begin(), batch.end());
+            batches_++;
+            entered_cv_.notify_all();
+            release_cv_.wait(lock, [this]() { return !holding_; });
+        };
+    }
+
+    void waitUntilHeld() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        entered_cv_.wait(lock, [this]() { return batches_ > 0; });
+    }
+
+    void release() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            holding_ = false;
+        }
+        release_cv_.notify_all();
+    }
+
+    std::vector<std::string> names() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<std::string> names;
+        for (const auto& event : events_) names.push_back(event.name);
+        return names;
+    }
+
+    std::vector<Event> events() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return events_;
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable entered_cv_;
+    std::condition_variable release_cv_;
+    std::vector<Event> events_;
+    size_t batches_ = 0;
+    bool holding_;
+};
+
+std::vector<std::string> numbered(int from, int to) {
+    std::vector<std::string> names;
+    for (int i = from; i <= to; ++i) names.push_back(std::to_string(i));
+    return names;
+}
+
+// The dispatcher runs on its own thread, so wait (boundedly) for it to reach a state
+template <typename Predicate>
+bool eventually(Predicate predicate) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!predicate()) {
+        if (std::chrono::steady_clock::now() > deadline) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+void testOrderAcrossProducers() {
+    EventBus bus;
+    Recorder recorder;
+    uint64_t id = bus.subscribe(recorder.handler());
+    const int producers = 4, per_producer = 500;
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&bus, p]() {
+            for (int i = 0; i < per_producer; ++i) {
+                bus.publish(Event{Event::Kind::CUSTOM, "p" + std::to_string(p), std::to_string(i), JsonObject(), 0, {}});
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    bus.flush();
+
+    std::vector<Event> events = recorder.events();
+    check(events.size() == producers * per_producer, "flush() returns after every event is delivered");
+    bool sequential = true;
+    std::map<std::string, int> next;
+    bool per_source_order = true;
+    for (size_t i = 0; i < events.size(); ++i) {
+        sequential = sequential && events[i].sequence == i + 1;
+        int& expected = next[events[i].source];
+        per_source_order = per_source_order && events[i].name == std::to_string(expected);
+        expected++;
+    }
+    check(sequential, "sequences are assigned 1, 2, 3... in delivery order");
+    check(per_source_order, "each producer's events arrive in the order it published them");
+    check(bus.stats(id).delivered == producers * per_producer && bus.stats(id).dropped == 0, "the stats count every delivery");
+    check(bus.publishedCount() == producers * per_producer, "publishedCount() counts every event");
+}
+
+// One held event in the handler, then 10 more into a queue of 4
+std::vector<std::string> overflow(EventBus::OverflowPolicy policy, EventBus::SubscriberStats& stats) {
+    EventBus bus;
+    Recorder recorder(true);
+    EventBus::SubscribeOptions options;
+    options.capacity = 4;
+    options.max_batch = 1;
+    options.policy = policy;
+    uint64_t id = bus.subscribe(recorder.handler(), options);
+    bus.publish(Event{Event::Kind::CUSTOM, "test", "0", JsonObject(), 0, {}});
+    recorder.waitUntilHeld();
+    for (int i = 1; i <= 10; ++i) {
+        bus.publish(Event{Event::Kind::CUSTOM, "test", std::to_string(i), JsonObject(), 0, {}});
+    }
+    if (policy != EventBus::OverflowPolicy::BLOCK) {
+        check(eventually([&]() { return bus.stats(id).dropped == 6; }), "the overflowing events are dropped");
+    }
+    check(bus.publishedCount() == 11, "publishers never wait on a stalled subscriber");
+    recorder.release();
+    bus.flush();
+    stats = bus.stats(id);
+    return recorder.names();
+}
+
+void testOverflowPolicies() {
+    EventBus::SubscriberStats stats;
+    std::vector<std::string> newest = overflow(EventBus::OverflowPolicy::DROP_NEWEST, stats);
+    check(newest == numbered(0, 4), "DROP_NEWEST keeps the events that were queued first");
+    check(stats.dropped == 6 && stats.delivered == 5, "DROP_NEWEST counts its drops");
+
+    std::vector<std::string> oldest = overflow(EventBus::OverflowPolicy::DROP_OLDEST, stats);
+    std::vector<std::string> expected{"0", "7", "8", "9", "10"};
+    check(oldest == expected, "DROP_OLDEST keeps the latest events");
+    check(stats.dropped == 6 && stats.delivered == 5, "DROP_OLDEST counts its drops");
+
+    std::vector<std::string> blocked = overflow(EventBus::OverflowPolicy::BLOCK, stats);
+    check(blocked == numbered(0, 10), "BLOCK delivers every event in order");
+    check(stats.dropped == 0 && stats.delivered == 11, "BLOCK drops nothing");
+}
+
+void testBlockDoesNotStallOthers() {
+    EventBus bus;
+    Recorder stalled(true);
+    Recorder other;
+    EventBus::SubscribeOptions options;
+    options.capacity = 2;
+    options.max_batch = 1;
+    options.policy = EventBus::OverflowPolicy::BLOCK;
+    uint64_t stalled_id = bus.subscribe(stalled.handler(), options);
+    bus.subscribe(other.handler());
+    bus.publish(Event{Event::Kind::CUSTOM, "test", "0", JsonObject(), 0, {}});
+    stalled.waitUntilHeld();
+    for (int i = 1; i <= 20; ++i) {
+        bus.publish(Event{Event::Kind::CUSTOM, "test", std::to_string(i), JsonObject(), 0, {}});
+    }
+    check(eventually([&]() { return other.names().size() == 21; }),
+          "a stalled BLOCK subscriber does not hold back the others");
+    stalled.release();
+    bus.flush();
+    check(stalled.names() == numbered(0, 20), "the BLOCK subscriber still receives every event in order");
+    check(bus.stats(stalled_id).dropped == 0, "the BLOCK backlog drops nothing");
+}
+
+void testFiltersAndAdapters() {
+    EventBus bus;
+    Recorder all, statuses;
+    bus.subscribe(all.handler());
+    EventBus::SubscribeOptions options;
+    options.kinds = {Event::Kind::STATUS};
+    uint64_t status_id = bus.subscribe(statuses.handler(), options);
+
+    bus.stepCallback("research")("Plan", JsonObject{{"steps", 3}});
+    bus.statusCallback("assistant")("thinking");
+    AutonomousAgent::Step step;
+    step.description = "search";
+    step.status = "done";
+    step.result = JsonObject{{"hits", 2}};
+    step.success = true;
+    bus.agentStepCallback("agent")(step);
+    bus.flush();
+
+    std::vector<Event> events = all.events();
+    check(events.size() == 3, "every adapter publishes one event");
+    if (events.size() == 3) {
+        check(events[0].kind == Event::Kind::STEP && events[0].source == "research" &&
+              events[0].data == JsonObject{{"steps", 3}}, "stepCallback() publishes a STEP with its result");
+        check(events[1].kind == Event::Kind::STATUS && events[1].name == "thinking", "statusCallback() publishes a STATUS");
+        check(events[2].kind == Event::Kind::AGENT_STEP && events[2].data["status"] == "done" &&
+              events[2].data["success"] == true, "agentStepCallback() publishes an AGENT_STEP");
+    }
+    check(statuses.names() == std::vector<std::string>{"thinking"}, "a kind filter delivers only those kinds");
+    check(bus.stats(status_id).delivered == 1, "filtered events are not counted as delivered");
+}
+
+void testHandlerErrorsAndUnsubscribe() {
+    EventBus bus;
+    int calls = 0;
+    EventBus::SubscribeOptions options;
+    options.max_batch = 1;
+    uint64_t id = bus.subscribe([&calls](const std::vector<Event>&) {
+        if (++calls == 1) throw std::runtime_error("observer bug");
+    }, options);
+    bus.publishStatus("a", "one");
+    bus.publishStatus("a", "two");
+    bus.flush();
+    check(calls == 2, "a throwing handler keeps receiving events");
+    check(bus.stats(id).errors == 1 && bus.stats(id).delivered == 2, "handler errors are counted");
+
+    check(bus.unsubscribe(id), "unsubscribe() removes the subscription");
+    check(!bus.unsubscribe(id), "unsubscribing twice reports no such subscription");
+    bus.publishStatus("a", "three");
+    bus.flush();
+    check(calls == 2, "an unsubscribed handler receives nothing more");
+    check(bus.stats(id).delivered == 0, "stats for an unknown id are zero");
+
+    bool threw = false;
+    try {
+        bus.subscribe(EventBus::Handler());
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    check(threw, "subscribe() rejects an empty handler");
+}
+
+void testShutdownDelivers() {
+    Recorder recorder;
+    {
+        EventBus bus;
+        bus.subscribe(recorder.handler());
+        for (int i = 0; i < 200; ++i) {
+            bus.publish(Event{Event::Kind::CUSTOM, "test", std::to_string(i), JsonObject(), 0, {}});
+        }
+    }
+    check(recorder.names() == numbered(0, 199), "destroying the bus delivers every published event first");
+}
+
+} // namespace
+
+int main() {
+    testOrderAcrossProducers();
+    testOverflowPolicies();
+    testBlockDoesNotStallOthers();
+    testFiltersAndAdapters();
+    testHandlerErrorsAndUnsubscribe();
+    testShutdownDelivers();
+    if (failures > 0) {
+        return EXIT_FAILURE;
+    }
+    std::cout << "event_bus_test passed" << std::endl;
+    return EXIT_SUCCESS;
+}
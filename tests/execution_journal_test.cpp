@@ -0,0 +1,261 @@
+/**
+ * @file execution_journal_test.cpp
+ * @brief ExecutionJournal replay, torn-tail recovery, group commit and discard, and JournalingLLM resume
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025 Edge AI, LLC. All rights reserved.
+ *
+ */
+#include <agents-cpp/execution_journal.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace agents;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << std::endl;
+        failures++;
+    }
+}
+
+std::string readFile(const std::filesystem::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+void appendRaw(const std::filesystem::path& path, const std::string& data) {
+    std::ofstream(path, std::ios::binary | std::ios::app) << data;
+}
+
+// Numbers its replies, so a replayed reply is told apart from a resent one
+class CountingLLM : public LLMInterface {
+public:
+    std::vector<std::string> getAvailableModels() override { return {"counting"}; }
+    void setModel(const std::string&) override {}
+    std::string getModel() const override { return "counting"; }
+    void setApiKey(const std::string&) override {}
+    void setApiBase(const std::string&) override {}
+    void setOptions(const LLMOptions& options) override { options_ = options; }
+    LLMOptions getOptions() const override { return options_; }
+
+    LLMResponse chat(const std::string& prompt) override {
+        return chat(std::vector<Message>{Message{Message::Role::USER, prompt}});
+    }
+
+    LLMResponse chat(const std::vector<Message>& messages) override {
+        if (messages.back().content == "fail") {
+            throw std::runtime_error("model error");
+        }
+        LLMResponse response;
+        response.content = messages.back().content + " #" + std::to_string(++calls);
+        return response;
+    }
+
+    LLMResponse chatWithTools(const std::vector<Message>& messages,
+                              const std::vector<std::shared_ptr<Tool>>&) override {
+        return chat(messages);
+    }
+
+    void streamChat(const std::vector<Message>& messages,
+                    std::function<void(const std::string&, bool)> callback) override {
+        callback(chat(messages).content, true);
+    }
+
+    std::atomic<int> calls{0};
+
+private:
+    LLMOptions options_;
+};
+
+void testReplay(const std::filesystem::path& directory) {
+    std::filesystem::path path;
+    {
+        ExecutionJournal journal(directory, "replay");
+        path = journal.path();
+        check(journal.replayedCount() == 0, "a new journal replays nothing");
+        journal.record("plan", JsonObject{{"steps", 2}});
+        journal.record("step:0", JsonObject{{"response", "first"}});
+        check(journal.lookup("plan") == JsonObject{{"steps", 2}}, "a recorded step can be looked up");
+        check(readFile(path).find("\"step:0\"") != std::string::npos, "record() returns once the entry is in the file");
+    }
+    ExecutionJournal reopened(directory, "replay");
+    check(reopened.replayedCount() == 2, "reopening replays both entries");
+    check(reopened.lookup("step:0") == JsonObject{{"response", "first"}}, "replayed results are unchanged");
+    check(!reopened.lookup("step:1").has_value(), "steps that never completed are missing");
+
+    ExecutionJournal other(directory, "other run");
+    check(other.replayedCount() == 0 && other.path() != path, "each workflow id has its own file");
+}
+
+void testTornTail(const std::filesystem::path& directory) {
+    std::filesystem::path path;
+    {
+        ExecutionJournal journal(directory, "torn");
+        path = journal.path();
+        journal.record("a", JsonObject{{"v", 1}});
+    }
+    const auto intact = std::filesystem::file_size(path);
+    // A crash in the middle of writing the next entry
+    appendRaw(path, R"({"key":"b","result":{"v":2},"cr)");
+    {
+        ExecutionJournal journal(directory, "torn");
+        check(journal.replayedCount() == 1, "a torn entry is not replayed");
+        check(std::filesystem::file_size(path) == intact, "the torn tail is cut off");
+        journal.record("b", JsonObject{{"v", 2}});
+    }
+    {
+        ExecutionJournal journal(directory, "torn");
+        check(journal.replayedCount() == 2 && journal.lookup("b") == JsonObject{{"v", 2}},
+              "entries recorded after recovery replay");
+    }
+
+    // A complete line with a bad checksum, followed by a valid one
+    appendRaw(path, R"({"crc":"0000000000000000","key":"c","result":{"v":3}})" "\n");
+    std::string contents = readFile(path);
+    std::string valid_line = contents.substr(0, contents.find('\n') + 1);
+    appendRaw(path, valid_line);
+    ExecutionJournal journal(directory, "torn");
+    check(journal.replayedCount() == 2, "replay stops at an entry whose checksum does not match");
+    check(!journal.lookup("c").has_value(), "the corrupt entry is not replayed");
+    check(readFile(path).find("\"c\"") == std::string::npos, "everything from the corrupt entry on is cut off");
+}
+
+void testGroupCommit(const std::filesystem::path& directory) {
+    const size_t threads = 16, per_thread = 25;
+    ExecutionJournal::Options options;
+    options.group_window = std::chrono::milliseconds(5);
+    options.max_group = 8;
+    std::filesystem::path path;
+    {
+        ExecutionJournal journal(directory, "group", options);
+        path = journal.path();
+        std::vector<std::thread> workers;
+        std::atomic<size_t> returned{0};
+        for (size_t t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t]() {
+                for (size_t i = 0; i < per_thread; ++i) {
+                    std::string key = "worker:" + std::to_string(t) + ":" + std::to_string(i);
+                    journal.record(key, JsonObject{{"t", t}, {"i", i}});
+                    returned++;
+                }
+            });
+        }
+        for (auto& worker : workers) worker.join();
+        check(returned == threads * per_thread, "every concurrent record() returns");
+    }
+    std::string contents = readFile(path);
+    check(static_cast<size_t>(std::count(contents.begin(), contents.end(), '\n')) == threads * per_thread,
+          "every concurrent entry is written exactly once, on its own line");
+    ExecutionJournal reopened(directory, "group");
+    check(reopened.replayedCount() == threads * per_thread, "every concurrent entry replays");
+    check(reopened.lookup("worker:15:24") == JsonObject{{"t", 15}, {"i", 24}}, "concurrent entries keep their results");
+}
+
+void testDiscard(const std::filesystem::path& directory) {
+    std::filesystem::path path;
+    {
+        ExecutionJournal journal(directory, "discard");
+        path = journal.path();
+        journal.record("a", JsonObject{{"v", 1}});
+        journal.discard();
+        check(!std::filesystem::exists(path), "discard() deletes the file");
+        check(!journal.lookup("a").has_value(), "a discarded journal finds no steps");
+        bool threw = false;
+        try {
+            journal.record("b", JsonObject{{"v", 2}});
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        check(threw, "record() throws after discard()");
+    }
+    check(!std::filesystem::exists(path), "the file is not recreated when the journal closes");
+    ExecutionJournal fresh(directory, "discard");
+    check(fresh.replayedCount() == 0, "a later run with the same id starts from scratch");
+}
+
+Task<JsonObject> countedStep(std::shared_ptr<std::atomic<int>> runs, JsonObject result) {
+    ++*runs;
+    co_return result;
+}
+
+void testJournaled(const std::filesystem::path& directory) {
+    auto journal = std::make_shared<ExecutionJournal>(directory, "journaled");
+    auto runs = std::make_shared<std::atomic<int>>(0);
+    JsonObject ok{{"response", "done"}};
+    JsonObject failed{{"error", "rate limited"}};
+
+    check(blockingWait(ExecutionJournal::journaled(journal, "ok", countedStep(runs, ok))) == ok, "a step runs once");
+    check(blockingWait(ExecutionJournal::journaled(journal, "ok", countedStep(runs, ok))) == ok, "a replayed step returns its result");
+    check(*runs == 1, "a recorded step does not run again");
+
+    blockingWait(ExecutionJournal::journaled(journal, "failed", countedStep(runs, failed)));
+    blockingWait(ExecutionJournal::journaled(journal, "failed", countedStep(runs, failed)));
+    check(*runs == 3, "a result with an error is not recorded, so the step is retried");
+
+    blockingWait(ExecutionJournal::journaled(nullptr, "ok", countedStep(runs, ok)));
+    check(*runs == 4, "without a journal the step just runs");
+}
+
+void testJournalingLLM(const std::filesystem::path& directory) {
+    std::vector<std::string> first;
+    {
+        auto journal = std::make_shared<ExecutionJournal>(directory, "llm");
+        auto model = std::make_shared<CountingLLM>();
+        JournalingLLM llm(model, journal);
+        first.push_back(llm.chat("vote").content);
+        first.push_back(llm.chat("vote").content);
+        check(first[0] != first[1], "identical calls are journaled separately");
+        bool threw = false;
+        try {
+            llm.chat("fail");
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        check(threw, "a failed call throws through the decorator");
+    }
+
+    auto journal = std::make_shared<ExecutionJournal>(directory, "llm");
+    auto model = std::make_shared<CountingLLM>();
+    JournalingLLM llm(model, journal);
+    check(llm.chat("vote").content == first[0] && llm.chat("vote").content == first[1],
+          "a resumed run replays the recorded calls in order");
+    check(llm.replayed() == 2 && model->calls.load() == 0, "replayed calls are not sent");
+    check(llm.chat("vote").content == "vote #1", "a call beyond the recorded ones is sent");
+    check(model->calls.load() == 1, "only the new call reaches the model");
+}
+
+} // namespace
+
+int main() {
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "execution_journal_test";
+    std::filesystem::remove_all(directory);
+    testReplay(directory);
+    testTornTail(directory);
+    testGroupCommit(directory);
+    testDiscard(directory);
+    testJournaled(directory);
+    testJournalingLLM(directory);
+    std::filesystem::remove_all(directory);
+    if (failures > 0) {
+        return EXIT_FAILURE;
+    }
+    std::cout << "execution_journal_test passed" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,246 @@
+/**
+ * @file graph_workflow_test.cpp
+ * @brief GraphWorkflow scheduling, output caching, retries and failure propagation
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025 Edge AI, LLC. All rights reserved.
+ *
+ */
+#include <agents-cpp/context.h>
+#include <agents-cpp/tool.h>
+#include <agents-cpp/workflows/graph_workflow.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace agents;
+using namespace agents::workflows;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << std::endl;
+        failures++;
+    }
+}
+
+// Echoes the prompt and counts the calls
+class EchoLLM : public LLMInterface {
+public:
+    std::vector<std::string> getAvailableModels() override { return {"echo"}; }
+    void setModel(const std::string&) override {}
+    std::string getModel() const override { return "echo"; }
+    void setApiKey(const std::string&) override {}
+    void setApiBase(const std::string&) override {}
+    void setOptions(const LLMOptions& options) override { options_ = options; }
+    LLMOptions getOptions() const override { return options_; }
+
+    LLMResponse chat(const std::string& prompt) override {
+        return chat(std::vector<Message>{Message{Message::Role::USER, prompt}});
+    }
+
+    LLMResponse chat(const std::vector<Message>& messages) override {
+        calls++;
+        if (fail_next.fetch_sub(1) > 0) throw std::runtime_error("transient");
+        LLMResponse response;
+        response.content = "echo: " + messages.back().content;
+        return response;
+    }
+
+    LLMResponse chatWithTools(const std::vector<Message>& messages,
+                              const std::vector<std::shared_ptr<Tool>>&) override {
+        return chat(messages);
+    }
+
+    void streamChat(const std::vector<Message>& messages,
+                    std::function<void(const std::string&, bool)> callback) override {
+        callback(chat(messages).content, true);
+    }
+
+    std::atomic<int> calls{0};
+    std::atomic<int> fail_next{0};
+
+private:
+    LLMOptions options_;
+};
+
+struct Fixture {
+    std::shared_ptr<EchoLLM> llm = std::make_shared<EchoLLM>();
+    std::shared_ptr<Context> context = std::make_shared<Context>();
+    std::shared_ptr<std::atomic<int>> tool_calls = std::make_shared<std::atomic<int>>(0);
+
+    Fixture() {
+        context->setLLM(llm);
+        auto counter = tool_calls;
+        context->registerTool(createTool("stamp", "Returns its text with a call number",
+            {Parameter{"text", "Text to stamp", "string", true}},
+            [counter](const JsonObject& params) {
+                int call = ++*counter;
+                return ToolResult{true, params.value("text", "") + " #" + std::to_string(call), JsonObject()};
+            }));
+    }
+};
+
+int stat(const JsonObject& result, const std::string& name) {
+    return result["stats"].value(name, -1);
+}
+
+void testTemplatesAndOrder() {
+    Fixture fixture;
+    GraphWorkflow graph(fixture.context);
+    graph.addLLMNode("outline", "Outline {input}");
+    graph.addFunctionNode("count", [](const JsonObject& args) {
+        return JsonObject{{"length", args["outline"]["response"].get<std::string>().size()}};
+    }, {"outline"});
+    graph.addLLMNode("draft", "Draft from {outline.response} ({count.length} chars)");
+    graph.setOutputNode("draft");
+
+    JsonObject result = graph.run("tea");
+    check(result["outputs"]["outline"]["response"] == "echo: Outline tea", "an LLM node renders {input}");
+    check(result["outputs"]["count"]["length"] == std::string("echo: Outline tea").size(),
+          "a function node receives its dependency's output");
+    check(result["response"] == "echo: Draft from echo: Outline tea (17 chars)",
+          "a node's template reads the outputs of earlier nodes");
+    check(stat(result, "executed") == 3 && stat(result, "failed") == 0, "every node runs once");
+}
+
+void testCacheSkipsToolNodesByDefault() {
+    Fixture fixture;
+    GraphWorkflow graph(fixture.context);
+    graph.addLLMNode("summary", "Summarize {input}");
+    graph.addToolNode("stamp", "stamp", JsonObject{{"text", "{summary.response}"}});
+
+    JsonObject first = graph.run("tides");
+    JsonObject second = graph.run("tides");
+    check(fixture.llm->calls == 1, "an LLM node is served from the cache on the second run");
+    check(*fixture.tool_calls == 2, "a tool node runs on every run by default");
+    check(first["outputs"]["stamp"]["content"] == "echo: Summarize tides #1" &&
+          second["outputs"]["stamp"]["content"] == "echo: Summarize tides #2",
+          "each tool run returns its own result");
+    check(stat(second, "cached") == 1 && stat(second, "executed") == 1, "the stats count cached and executed nodes");
+
+    GraphWorkflow opted_in(fixture.context);
+    GraphWorkflow::Node node;
+    node.name = "stamp";
+    node.type = GraphWorkflow::NodeType::TOOL;
+    node.tool = "stamp";
+    node.params = JsonObject{{"text", "{input}"}};
+    node.cache = true;
+    opted_in.addNode(node);
+    opted_in.run("x");
+    opted_in.run("x");
+    check(*fixture.tool_calls == 3, "a tool node that sets cache is served from the cache");
+
+    GraphWorkflow no_llm_cache(fixture.context);
+    no_llm_cache.loadJson(JsonObject::parse(R"({"nodes": [
+        {"name": "a", "type": "llm", "prompt": "{input}", "cache": false},
+        {"name": "b", "type": "tool", "tool": "stamp", "params": {"text": "{input}"}, "cache": true}
+    ]})"));
+    no_llm_cache.run("y");
+    no_llm_cache.run("y");
+    check(fixture.llm->calls == 3, "\"cache\": false in a spec turns off caching for an LLM node");
+    check(*fixture.tool_calls == 4, "\"cache\": true in a spec turns on caching for a tool node");
+}
+
+void testCacheFollowsChangedInput() {
+    Fixture fixture;
+    GraphWorkflow graph(fixture.context);
+    graph.addLLMNode("fixed", "Always the same");
+    graph.addLLMNode("varying", "About {input}");
+    graph.run("one");
+    JsonObject second = graph.run("two");
+    check(fixture.llm->calls == 3, "only the node whose request changed runs again");
+    check(stat(second, "cached") == 1, "the unchanged node is cached");
+
+    graph.clearCache();
+    graph.run("two");
+    check(fixture.llm->calls == 5, "clearCache() drops every cached output");
+}
+
+void testRetriesAndFailures() {
+    Fixture fixture;
+    GraphWorkflow graph(fixture.context);
+    auto attempts = std::make_shared<std::atomic<int>>(0);
+    GraphWorkflow::Node flaky;
+    flaky.name = "flaky";
+    flaky.type = GraphWorkflow::NodeType::FUNCTION;
+    flaky.max_retries = 2;
+    flaky.function = [attempts](const JsonObject&) -> JsonObject {
+        if (++*attempts < 2) throw std::runtime_error("transient");
+        return JsonObject{{"response", "recovered"}};
+    };
+    graph.addNode(flaky);
+    graph.addFunctionNode("broken", [](const JsonObject&) -> JsonObject {
+        throw std::runtime_error("broken for good");
+    });
+    graph.addFunctionNode("after_broken", [](const JsonObject&) { return JsonObject{{"ok", true}}; }, {"broken"});
+    graph.setOutputNode("flaky");
+
+    JsonObject result = graph.run("go");
+    check(result["response"] == "recovered", "a node succeeds on a retry");
+    check(stat(result, "retries") == 1, "the retry is counted");
+    check(result["errors"]["broken"] == "broken for good", "a node that keeps failing reports its error");
+    check(result["errors"]["after_broken"] == "Dependency failed: broken", "its dependents are skipped");
+    check(stat(result, "failed") == 1 && stat(result, "skipped") == 1, "failed and skipped nodes are counted");
+
+    Counter& llm_retries = llmRetryCounter("echo");
+    const uint64_t before = llm_retries.value();
+    GraphWorkflow::Node draft;
+    draft.name = "draft";
+    draft.prompt = "Draft {input}";
+    draft.max_retries = 1;
+    GraphWorkflow llm_graph(fixture.context);
+    llm_graph.addNode(draft);
+    fixture.llm->fail_next = 1;
+    result = llm_graph.run("go");
+    check(result["response"] == "echo: Draft go", "an LLM node succeeds on a retry");
+    check(llm_retries.value() == before + 1, "an LLM node retry is counted per model");
+}
+
+void testInvalidGraphs() {
+    Fixture fixture;
+    GraphWorkflow cyclic(fixture.context);
+    cyclic.addLLMNode("a", "{b.response}");
+    cyclic.addLLMNode("b", "{a.response}");
+    bool threw = false;
+    try {
+        cyclic.run("x");
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    check(threw, "a cycle is rejected");
+
+    GraphWorkflow duplicate(fixture.context);
+    duplicate.addLLMNode("a", "{input}");
+    threw = false;
+    try {
+        duplicate.addLLMNode("a", "{input}");
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    check(threw, "a duplicate node name is rejected");
+}
+
+} // namespace
+
+int main() {
+    testTemplatesAndOrder();
+    testCacheSkipsToolNodesByDefault();
+    testCacheFollowsChangedInput();
+    testRetriesAndFailures();
+    testInvalidGraphs();
+    if (failures > 0) {
+        return EXIT_FAILURE;
+    }
+    std::cout << "graph_workflow_test passed" << std::endl;
+    return EXIT_SUCCESS;
+}
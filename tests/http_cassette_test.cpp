@@ -0,0 +1,322 @@
+/**
+ * @file http_cassette_test.cpp
+ * @brief HTTPCassette record and replay, through HTTPClient and the proxy, multipart matching and failing on bypassed requests
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025 Edge AI, LLC. All rights reserved.
+ *
+ */
+#include <agents-cpp/context.h>
+#include <agents-cpp/http_cassette.h>
+#include <agents-cpp/llm_interface.h>
+#include <agents-cpp/metrics.h>
+#include <agents-cpp/mock_llm_server.h>
+#include <agents-cpp/workflows/prompt_chaining_workflow.h>
+
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace agents;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << std::endl;
+        failures++;
+    }
+}
+
+const std::string kReply = "Recorded reply from the mock server.";
+
+template <typename Call>
+bool throws(Call&& call) {
+    try {
+        call();
+    } catch (const std::runtime_error&) {
+        return true;
+    }
+    return false;
+}
+
+double openConnections() {
+    return MetricsRegistry::global()
+        .gauge("agents_http_open_connections", "HTTP requests in flight over the network")
+        .value();
+}
+
+// Forwards to the cassette and notes whether the network was used and how
+// many connections were open while the request was being answered
+class Probe : public HTTPClient::Interceptor {
+public:
+    explicit Probe(std::shared_ptr<HTTPCassette> cassette) : cassette_(std::move(cassette)) {}
+
+    HTTPClient::Response handle(const HTTPClient::Request& request, const HTTPClient::WriteCallback& write_cb,
+                                const HTTPClient::Transport& send) override {
+        requests++;
+        open_at_entry = openConnections();
+        return cassette_->handle(request, write_cb, [&](const HTTPClient::WriteCallback& sink) {
+            sent++;
+            return send(sink);
+        });
+    }
+
+    int requests = 0;
+    int sent = 0;
+    double open_at_entry = -1;
+
+private:
+    std::shared_ptr<HTTPCassette> cassette_;
+};
+
+// Answers requests the cassette sends with a fixed response instead of the network
+class Offline : public HTTPClient::Interceptor {
+public:
+    explicit Offline(std::shared_ptr<HTTPCassette> cassette) : cassette_(std::move(cassette)) {}
+
+    HTTPClient::Response handle(const HTTPClient::Request& request, const HTTPClient::WriteCallback& write_cb,
+                                const HTTPClient::Transport&) override {
+        return cassette_->handle(request, write_cb, [this](const HTTPClient::WriteCallback&) {
+            sent++;
+            return HTTPClient::Response{200, "uploaded", false, "", {}};
+        });
+    }
+
+    int sent = 0;
+
+private:
+    std::shared_ptr<HTTPCassette> cassette_;
+};
+
+// An OpenAI chat completion sent through the header HTTPClient
+JsonObject chat(const std::string& api_base, const std::string& prompt) {
+    JsonObject body = {{"model", "mock-model"}, {"messages", {{{"role", "user"}, {"content", prompt}}}}};
+    HTTPClient::Response response = HTTPClient::post(
+        api_base + "/chat/completions",
+        {{"Content-Type", "application/json"}, {"Authorization", "Bearer test-key"}}, body.dump());
+    if (response.error || response.status_code != 200) return JsonObject::object();
+    return JsonObject::parse(response.text, nullptr, false);
+}
+
+std::string content(const JsonObject& completion) {
+    if (!completion.contains("choices")) return "";
+    return completion["choices"][0]["message"].value("content", "");
+}
+
+void testRecordThenReplay(const std::string& path) {
+    MockLLMServer::Options options;
+    options.default_content = kReply;
+    options.seed = 7;
+    MockLLMServer server(options);
+    server.start();
+    std::string api_base = server.apiBase("openai");
+
+    auto recorder = std::make_shared<HTTPCassette>(path, HTTPCassette::Mode::RECORD);
+    auto recording = std::make_shared<Probe>(recorder);
+    HTTPClient::setInterceptor(recording);
+    JsonObject recorded = chat(api_base, "What is the capital of France?");
+    HTTPClient::setInterceptor(nullptr);
+    recorder->save();
+    check(!throws([&]() { recorder->verify(); }), "a recording that saw its request verifies");
+
+    check(content(recorded) == kReply, "recorded chat returns the server's reply (got \"" + content(recorded) + "\")");
+    check(recording->requests == 1 && recording->sent == 1, "the request is recorded from the network");
+    check(recorder->size() == 1, "the cassette holds one interaction");
+
+    server.stop();
+
+    auto player = std::make_shared<HTTPCassette>(path, HTTPCassette::Mode::REPLAY);
+    auto replaying = std::make_shared<Probe>(player);
+    HTTPClient::setInterceptor(replaying);
+    JsonObject replayed = chat(api_base, "What is the capital of France?");
+    HTTPClient::setInterceptor(nullptr);
+
+    check(content(replayed) == kReply, "replayed chat returns the recorded reply (got \"" + content(replayed) + "\")");
+    check(replaying->requests == 1 && replaying->sent == 0, "replay answers without the network");
+    check(player->misses() == 0, "replay has no misses");
+    check(replaying->open_at_entry == 0, "replayed requests do not count as open connections");
+    check(replayed == recorded, "the replayed response matches the recording");
+    check(!throws([&]() { player->verify(); }), "a replay that used every recording verifies");
+}
+
+// What a prebuilt provider and a workflow on it return through a proxy
+struct ProviderRun {
+    std::string chat;
+    std::string streamed;
+    size_t stream_chunks = 0;
+    JsonObject workflow;
+};
+
+ProviderRun runProvider(const std::string& api_base) {
+    ProviderRun run;
+    auto llm = createLLM("openai", "test-key", "mock-model");
+    llm->setApiBase(api_base);
+    run.chat = llm->chat("What is the capital of France?").content;
+    llm->streamChat(std::vector<Message>{Message{Message::Role::USER, "Count to three."}},
+                    [&run](const std::string& chunk, bool) {
+                        run.streamed += chunk;
+                        if (!chunk.empty()) run.stream_chunks++;
+                    });
+
+    auto context = std::make_shared<Context>();
+    context->setLLM(llm);
+    workflows::PromptChainingWorkflow chain(context);
+    chain.addStep("outline", "Write an outline for: {input}");
+    chain.addStep("draft", "Expand this outline: {outline.response}");
+    run.workflow = chain.run("solar power");
+    return run;
+}
+
+// The prebuilt providers reach a cassette through its proxy, so a provider
+// and a workflow on it record once and then run without the network
+void testProviderThroughProxy(const std::string& path) {
+    MockLLMServer::Options options;
+    options.default_content = kReply;
+    options.seed = 7;
+    MockLLMServer server(options);
+    server.start();
+    const std::string upstream = server.apiBase("openai");
+
+    ProviderRun recorded;
+    {
+        HTTPCassette recorder(path, HTTPCassette::Mode::RECORD);
+        recorder.start(upstream);
+        check(recorder.apiBase().rfind("http://127.0.0.1:", 0) == 0 && recorder.apiBase().find("/v1") != std::string::npos,
+              "the proxy's API base keeps the upstream path (got " + recorder.apiBase() + ")");
+        recorded = runProvider(recorder.apiBase());
+        recorder.stop();
+        recorder.save();
+        check(!throws([&]() { recorder.verify(); }), "a proxied recording verifies");
+        check(recorder.size() >= 4, "the chat, the stream and the workflow's calls are recorded");
+        std::vector<HTTPCassette::Interaction> interactions = recorder.interactions();
+        check(!interactions.empty() && interactions[0].request.url.rfind(upstream, 0) == 0,
+              "recordings name the upstream URL, not the proxy");
+        bool redacted = false;
+        for (const auto& [name, value] : interactions.empty() ? std::map<std::string, std::string>()
+                                                              : interactions[0].request.headers) {
+            if (Utils::toLower(name) == "authorization") redacted = value == "REDACTED";
+        }
+        check(redacted, "the provider's API key is redacted");
+    }
+    check(recorded.chat == kReply, "a provider chat through the proxy returns the server's reply (got \"" +
+          recorded.chat + "\")");
+    check(recorded.streamed == kReply && recorded.stream_chunks > 1,
+          "a provider stream through the proxy arrives in chunks (got \"" + recorded.streamed + "\")");
+    const uint64_t served = server.requestCount();
+    server.stop();
+
+    HTTPCassette player(path, HTTPCassette::Mode::REPLAY);
+    player.start(upstream);
+    ProviderRun replayed = runProvider(player.apiBase());
+    player.stop();
+
+    check(replayed.chat == recorded.chat, "the provider chat replays");
+    check(replayed.streamed == recorded.streamed && replayed.stream_chunks == recorded.stream_chunks,
+          "the provider stream replays chunk by chunk");
+    check(replayed.workflow == recorded.workflow, "the workflow replays: " + replayed.workflow.dump());
+    check(player.misses() == 0, "every proxied request found its recording");
+    check(!throws([&]() { player.verify(); }), "a proxied replay verifies");
+    check(server.requestCount() == served, "replay does not reach the server");
+}
+
+// Each multipart request has its own boundary, which matching ignores
+void testMultipartBoundaries(const std::string& path) {
+    auto cassette = std::make_shared<HTTPCassette>(path, HTTPCassette::Mode::REPLAY_OR_RECORD);
+    auto offline = std::make_shared<Offline>(cassette);
+    std::vector<httplib::MultipartFormData> parts{{"file", "audio bytes", "clip.wav", "audio/wav"},
+                                                  {"model", "whisper-1", "", ""}};
+    const std::string url = "http://127.0.0.1:1/v1/audio/transcriptions";
+    HTTPClient::setInterceptor(offline);
+    HTTPClient::Response first = HTTPClient::post(url, {}, "", 30000, nullptr, parts);
+    HTTPClient::Response second = HTTPClient::post(url, {}, "", 30000, nullptr, parts);
+    parts[0].content = "other audio bytes";
+    HTTPClient::post(url, {}, "", 30000, nullptr, parts);
+    HTTPClient::setInterceptor(nullptr);
+
+    check(first.text == "uploaded" && second.text == "uploaded", "multipart requests are answered");
+    check(offline->sent == 2, "a repeated multipart request replays; changed parts are recorded again");
+    std::vector<HTTPCassette::Interaction> interactions = cassette->interactions();
+    check(interactions.size() == 2, "the cassette holds the two distinct uploads");
+    if (interactions.size() == 2) {
+        const auto& request = interactions[0].request;
+        auto type = request.headers.find("Content-Type");
+        std::string boundary = type == request.headers.end() ? "" : type->second.substr(type->second.find('=') + 1);
+        check(!boundary.empty() && request.body.rfind("--" + boundary + "\r\n", 0) == 0,
+              "the body uses the boundary given in its Content-Type");
+        const auto& other = interactions[1].request;
+        auto other_type = other.headers.find("Content-Type");
+        check(other_type != other.headers.end() && other_type->second != type->second,
+              "every request gets its own boundary");
+    }
+}
+
+// The prebuilt providers do not send through the header HTTPClient, so a
+// cassette installed only as an interceptor does not see them
+void testBypassedRequestsFail(const std::string& path) {
+    auto recorder = std::make_shared<HTTPCassette>(path, HTTPCassette::Mode::RECORD);
+    HTTPClient::setInterceptor(recorder);
+    try {
+        auto llm = createLLM("openai", "test-key", "mock-model");
+        llm->setApiBase("http://127.0.0.1:1/v1");
+        llm->chat("Hello?");
+    } catch (const std::exception&) {
+    }
+    HTTPClient::setInterceptor(nullptr);
+    check(recorder->requests() == 0, "a prebuilt provider's request does not reach the cassette");
+    check(throws([&]() { recorder->save(); }), "save() refuses a recording that no request reached");
+    check(!std::filesystem::exists(path), "no empty cassette is written");
+    check(throws([&]() { recorder->verify(); }), "verify() fails when no request reached the cassette");
+
+    // Two recordings, of which the run only replays one
+    {
+        auto cassette = std::make_shared<HTTPCassette>(path, HTTPCassette::Mode::RECORD);
+        auto offline = std::make_shared<Offline>(cassette);
+        HTTPClient::setInterceptor(offline);
+        HTTPClient::get("http://127.0.0.1:1/models", {});
+        HTTPClient::post("http://127.0.0.1:1/chat", {}, "{}");
+        HTTPClient::setInterceptor(nullptr);
+        cassette->save();
+    }
+    auto player = std::make_shared<HTTPCassette>(path, HTTPCassette::Mode::REPLAY);
+    HTTPClient::setInterceptor(player);
+    HTTPClient::get("http://127.0.0.1:1/models", {});
+    HTTPClient::setInterceptor(nullptr);
+    check(throws([&]() { player->verify(); }), "verify() fails when a recording was never replayed");
+
+    HTTPClient::setInterceptor(player);
+    HTTPClient::Response missed = HTTPClient::get("http://127.0.0.1:1/other", {});
+    HTTPClient::post("http://127.0.0.1:1/chat", {}, "{}");
+    HTTPClient::setInterceptor(nullptr);
+    check(missed.error && player->misses() == 1, "an unrecorded request fails in REPLAY mode");
+    check(throws([&]() { player->verify(); }), "verify() fails when a request found no recording");
+}
+
+} // namespace
+
+int main() {
+    std::string path = (std::filesystem::temp_directory_path() / "http_cassette_test.cassette").string();
+    testRecordThenReplay(path);
+    std::filesystem::remove(path);
+    testProviderThroughProxy(path);
+    std::filesystem::remove(path);
+    testMultipartBoundaries(path);
+    std::filesystem::remove(path);
+    testBypassedRequestsFail(path);
+    std::filesystem::remove(path);
+    if (failures > 0) {
+        return EXIT_FAILURE;
+    }
+    std::cout << "http_cassette_test passed" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,160 @@
+/**
+ * @file logger_test.cpp
+ * @brief Async logging: FieldScope fields on each record, structured loggers and flush
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025 Edge AI, LLC. All rights reserved.
+ *
+ */
+#include <agents-cpp/logger.h>
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace agents;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << std::endl;
+        failures++;
+    }
+}
+
+// Flushes the logger and returns the file's records by message
+std::vector<JsonObject> records(const std::filesystem::path& path) {
+    Logger::flush();
+    std::vector<JsonObject> parsed;
+    std::ifstream in(path);
+    std::string line;
+    while (std::getline(in, line)) {
+        JsonObject record = JsonObject::parse(line, nullptr, false);
+        check(!record.is_discarded(), "every line is a JSON object: " + line);
+        if (!record.is_discarded()) parsed.push_back(std::move(record));
+    }
+    return parsed;
+}
+
+const JsonObject* find(const std::vector<JsonObject>& all, const std::string& message) {
+    for (const auto& record : all) {
+        if (record.value("msg", "") == message) return &record;
+    }
+    return nullptr;
+}
+
+void testJsonScopes(const std::filesystem::path& path) {
+    Logger::AsyncOptions options;
+    options.console = false;
+    options.json = true;
+    options.file_path = path.string();
+    options.fields = JsonObject{{"session_id", "s1"}};
+    Logger::initAsync(options);
+
+    {
+        Logger::FieldScope run("run-7", JsonObject{{"run_id", 7}});
+        Logger::info("in run");
+        {
+            Logger::FieldScope step("run-7/plan", JsonObject{{"run_id", 7}, {"step", "plan"}});
+            Logger::info("in step");
+        }
+        Logger::info("back in run");
+    }
+    Logger::info("outside");
+
+    // Concurrent threads, each with its own scope
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([t]() {
+            Logger::FieldScope scope("worker-" + std::to_string(t), JsonObject{{"worker", t}});
+            for (int i = 0; i < 100; ++i) Logger::info("w{}-{}", t, i);
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    auto tagged = Logger::structuredLogger("agent-a", JsonObject{{"agent_id", "a"}});
+    tagged->info("from agent");
+
+    std::vector<JsonObject> all = records(path);
+    const JsonObject* in_run = find(all, "in run");
+    check(in_run && (*in_run)["logger"] == "run-7" && (*in_run)["run_id"] == 7 && (*in_run)["session_id"] == "s1",
+          "a scoped record carries the scope's name, its fields and the shared fields");
+    const JsonObject* in_step = find(all, "in step");
+    check(in_step && (*in_step)["logger"] == "run-7/plan" && (*in_step)["step"] == "plan", "scopes nest");
+    const JsonObject* back = find(all, "back in run");
+    check(back && (*back)["logger"] == "run-7" && !back->contains("step"), "the enclosing scope is restored");
+    const JsonObject* outside = find(all, "outside");
+    check(outside && (*outside)["logger"] == "agents" && !outside->contains("run_id"),
+          "records after the scope carry no scope fields");
+
+    bool threads_tagged = true;
+    for (int t = 0; t < 4; ++t) {
+        for (int i = 0; i < 100; ++i) {
+            const JsonObject* record = find(all, "w" + std::to_string(t) + "-" + std::to_string(i));
+            threads_tagged = threads_tagged && record && (*record)["worker"] == t &&
+                             (*record)["logger"] == "worker-" + std::to_string(t);
+        }
+    }
+    check(threads_tagged, "each thread's records carry its own scope");
+
+    const JsonObject* agent = find(all, "from agent");
+    check(agent && (*agent)["logger"] == "agent-a" && (*agent)["agent_id"] == "a", "a structured logger tags its records");
+}
+
+void testPlainTextScopes(const std::filesystem::path& path) {
+    Logger::AsyncOptions options;
+    options.console = false;
+    options.file_path = path.string();
+    Logger::initAsync(options);
+    {
+        Logger::FieldScope scope("run-8", JsonObject{{"run_id", 8}});
+        Logger::info("plain scoped");
+    }
+    Logger::flush();
+    std::ifstream in(path);
+    std::string line, found;
+    while (std::getline(in, line)) {
+        if (line.find("plain scoped") != std::string::npos) found = line;
+    }
+    check(found.find("[run-8]") != std::string::npos, "plain text records show the scope name");
+    check(found.find("run_id") == std::string::npos && found.find('\x1f') == std::string::npos,
+          "plain text records do not carry the fields");
+}
+
+void testFlushWaitsForQueue(const std::filesystem::path& path) {
+    Logger::AsyncOptions options;
+    options.console = false;
+    options.json = true;
+    options.file_path = path.string();
+    options.queue_size = 256;
+    Logger::initAsync(options);
+    for (int i = 0; i < 5000; ++i) Logger::info("bulk {}", i);
+    std::vector<JsonObject> all = records(path);
+    check(all.size() == 5000 && all.back()["msg"] == "bulk 4999", "flush() returns once every queued record is written");
+}
+
+} // namespace
+
+int main() {
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "logger_test";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    testJsonScopes(directory / "json.log");
+    testPlainTextScopes(directory / "plain.log");
+    testFlushWaitsForQueue(directory / "bulk.log");
+    Logger::init();
+    std::filesystem::remove_all(directory);
+    if (failures > 0) {
+        return EXIT_FAILURE;
+    }
+    std::cout << "logger_test passed" << std::endl;
+    return EXIT_SUCCESS;
+}
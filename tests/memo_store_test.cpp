@@ -0,0 +1,211 @@
+/**
+ * @file memo_store_test.cpp
+ * @brief MemoStore keys, the in-memory and file stores, and the MemoizingLLM decorator
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025 Edge AI, LLC. All rights reserved.
+ *
+ */
+#include <agents-cpp/memo_store.h>
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace agents;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << std::endl;
+        failures++;
+    }
+}
+
+std::string keyOf(const std::vector<Message>& messages, const LLMOptions& options = LLMOptions(),
+                  const std::vector<std::string>& tools = {}) {
+    return MemoStore::makeKey("wf", "step", messages, "model", options, tools);
+}
+
+// Conversation after the model asked for a tool and the tool answered
+std::vector<Message> toolConversation() {
+    Message call{Message::Role::ASSISTANT, ""};
+    call.tool_calls = {{"weather", JsonObject{{"city", "Paris"}}}};
+    Message answer{Message::Role::TOOL, "sunny"};
+    answer.tool_call_id = "call-1";
+    answer.name = "weather";
+    return {Message{Message::Role::USER, "Weather?"}, call, answer};
+}
+
+void testKeysCoverEveryMessageField() {
+    const std::vector<Message> base = toolConversation();
+    const std::string key = keyOf(base);
+    check(keyOf(toolConversation()) == key, "equal messages give equal keys");
+
+    std::vector<Message> other_city = base;
+    other_city[1].tool_calls[0].second["city"] = "Rome";
+    check(keyOf(other_city) != key, "tool call parameters are part of the key");
+
+    std::vector<Message> other_tool = base;
+    other_tool[1].tool_calls[0].first = "forecast";
+    check(keyOf(other_tool) != key, "tool call names are part of the key");
+
+    std::vector<Message> other_id = base;
+    other_id[2].tool_call_id = "call-2";
+    check(keyOf(other_id) != key, "tool_call_id is part of the key");
+
+    std::vector<Message> no_id = base;
+    no_id[2].tool_call_id.reset();
+    check(keyOf(no_id) != key, "a missing tool_call_id differs from a set one");
+
+    std::vector<Message> other_name = base;
+    other_name[2].name = "forecast";
+    check(keyOf(other_name) != key, "the message name is part of the key");
+
+    std::vector<Message> other_role = base;
+    other_role[0].role = Message::Role::SYSTEM;
+    check(keyOf(other_role) != key, "the role is part of the key");
+
+    LLMOptions warmer;
+    warmer.temperature = 1.0;
+    check(keyOf(base, warmer) != key, "generation options are part of the key");
+    check(keyOf(base, LLMOptions(), {"weather"}) != key, "offered tools are part of the key");
+    check(MemoStore::makeKey("other", "step", base, "model", LLMOptions()) != key, "the workflow id is part of the key");
+    check(MemoStore::makeKey("wf", "step", base, "other-model", LLMOptions()) != key, "the model is part of the key");
+}
+
+LLMResponse sampleResponse() {
+    LLMResponse response;
+    response.content = "It is sunny.";
+    response.tool_calls = {{"weather", JsonObject{{"city", "Paris"}}}};
+    response.usage_metrics = {{"input_tokens", 12}, {"output_tokens", 4}};
+    return response;
+}
+
+bool sameResponse(const LLMResponse& a, const LLMResponse& b) {
+    return a.content == b.content && a.tool_calls == b.tool_calls && a.usage_metrics == b.usage_metrics;
+}
+
+void testInMemoryStore() {
+    InMemoryMemoStore store;
+    check(!store.get("k").has_value(), "an empty store misses");
+    store.put("k", sampleResponse());
+    auto stored = store.get("k");
+    check(stored && sameResponse(*stored, sampleResponse()), "a stored response is returned unchanged");
+    check(store.size() == 1, "the store holds one entry");
+    store.clear();
+    check(store.size() == 0 && !store.get("k"), "clear() removes every entry");
+}
+
+void testFileStore(const std::filesystem::path& directory) {
+    const std::string key = keyOf(toolConversation());
+    {
+        FileMemoStore store(directory);
+        store.put(key, sampleResponse());
+        store.put("not a hex key/../x", sampleResponse());
+    }
+    FileMemoStore reopened(directory);
+    auto stored = reopened.get(key);
+    check(stored && sameResponse(*stored, sampleResponse()), "entries survive reopening the store");
+    check(reopened.get("not a hex key/../x").has_value(), "any key maps to a file inside the directory");
+
+    std::ofstream(directory / (key + ".json.tmp7")) << "{\"content\": \"trunc";
+    std::ofstream(directory / "0123abcd.json") << "not json";
+    check(!reopened.get("0123abcd").has_value(), "an unreadable entry is a miss");
+
+    reopened.clear();
+    check(std::filesystem::is_empty(directory), "clear() removes entries and interrupted writes");
+}
+
+// Counts the calls that reach the model
+class CountingLLM : public LLMInterface {
+public:
+    std::vector<std::string> getAvailableModels() override { return {"counting"}; }
+    void setModel(const std::string&) override {}
+    std::string getModel() const override { return "counting"; }
+    void setApiKey(const std::string&) override {}
+    void setApiBase(const std::string&) override {}
+    void setOptions(const LLMOptions& options) override { options_ = options; }
+    LLMOptions getOptions() const override { return options_; }
+
+    LLMResponse chat(const std::string& prompt) override {
+        return chat(std::vector<Message>{Message{Message::Role::USER, prompt}});
+    }
+
+    LLMResponse chat(const std::vector<Message>& messages) override {
+        calls++;
+        LLMResponse response;
+        response.content = "answer " + std::to_string(calls) + " to " + messages.back().content;
+        return response;
+    }
+
+    LLMResponse chatWithTools(const std::vector<Message>& messages,
+                              const std::vector<std::shared_ptr<Tool>>&) override {
+        return chat(messages);
+    }
+
+    void streamChat(const std::vector<Message>& messages,
+                    std::function<void(const std::string&, bool)> callback) override {
+        callback(chat(messages).content, true);
+    }
+
+    int calls = 0;
+
+private:
+    LLMOptions options_;
+};
+
+void testMemoizingLLM() {
+    auto model = std::make_shared<CountingLLM>();
+    auto store = std::make_shared<InMemoryMemoStore>();
+    MemoizingLLM outline(model, Memoization{store, "article"}, "outline");
+    auto draft = outline.forStep("draft");
+
+    std::string first = outline.chat("Tea").content;
+    check(outline.chat("Tea").content == first && model->calls == 1, "a repeated call is served from the store");
+    draft->chat("Tea");
+    check(model->calls == 2, "another step with the same prompt has its own entry");
+
+    std::vector<Message> asked = toolConversation();
+    std::vector<Message> asked_again = toolConversation();
+    asked_again[2].tool_call_id = "call-2";
+    outline.chat(asked);
+    outline.chat(asked_again);
+    check(model->calls == 4, "a conversation with a different tool call id is not served from the store");
+
+    LLMOptions colder = model->getOptions();
+    colder.temperature = 0.0;
+    outline.setOptions(colder);
+    outline.chat("Tea");
+    check(model->calls == 5, "changed options miss the store");
+
+    check(outline.hits() == 1 && outline.misses() == 5, "hits and misses are counted");
+    check(draft->hits() == outline.hits() && draft->misses() == outline.misses(),
+          "decorators made by forStep() share their counts");
+    check(outline.statsToJson()["hit_rate"].get<double>() == 1.0 / 6.0, "the hit rate is reported");
+}
+
+} // namespace
+
+int main() {
+    testKeysCoverEveryMessageField();
+    testInMemoryStore();
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "memo_store_test";
+    std::filesystem::remove_all(directory);
+    testFileStore(directory);
+    std::filesystem::remove_all(directory);
+    testMemoizingLLM();
+    if (failures > 0) {
+        return EXIT_FAILURE;
+    }
+    std::cout << "memo_store_test passed" << std::endl;
+    return EXIT_SUCCESS;
+}
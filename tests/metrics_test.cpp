@@ -0,0 +1,202 @@
+/**
+ * @file metrics_test.cpp
+ * @brief Histogram bucket boundaries and percentiles, Prometheus exposition and the /metrics endpoint
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025 Edge AI, LLC. All rights reserved.
+ *
+ */
+#include <agents-cpp/metrics.h>
+#include <agents-cpp/metrics_server.h>
+
+#include <httplib.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace agents;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << std::endl;
+        failures++;
+    }
+}
+
+bool contains(const std::string& text, const std::string& line) {
+    return text.find(line) != std::string::npos;
+}
+
+HistogramOptions exact(std::vector<double> buckets = {}) {
+    HistogramOptions options;
+    options.unit = 1;
+    options.buckets = std::move(buckets);
+    return options;
+}
+
+void testBucketBoundaries() {
+    for (size_t i = 0; i < 128; ++i) {
+        if (Histogram::bucketLowest(i) != i) {
+            check(false, "bucket " + std::to_string(i) + " holds exactly its own index");
+            break;
+        }
+    }
+    check(Histogram::bucketLowest(128) == 128, "the first log-linear bucket starts at 128");
+    check(Histogram::bucketLowest(191) == 254 && Histogram::bucketLowest(192) == 256,
+          "each power of two is split into 64 buckets");
+    bool contiguous = true, narrow = true;
+    for (size_t i = 128; i + 1 < Histogram::kBuckets; ++i) {
+        uint64_t lowest = Histogram::bucketLowest(i);
+        uint64_t next = Histogram::bucketLowest(i + 1);
+        if (next <= lowest) contiguous = false;
+        if (next - lowest > lowest / 64) narrow = false;
+    }
+    check(contiguous, "bucket boundaries increase without gaps");
+    check(narrow, "no bucket is wider than 1/64 of its lowest value");
+    check(Histogram::bucketLowest(Histogram::kBuckets - 1) < (uint64_t{1} << Histogram::kMaxBits) &&
+          Histogram::bucketLowest(Histogram::kBuckets - 1) >= (uint64_t{1} << (Histogram::kMaxBits - 1)),
+          "the last bucket covers the top of the range");
+
+    for (uint64_t value : {uint64_t{0}, uint64_t{1}, uint64_t{127}}) {
+        Histogram histogram(exact());
+        histogram.observe(static_cast<double>(value));
+        check(histogram.percentile(100) == static_cast<double>(value),
+              "a value below 128 units reads back exactly: " + std::to_string(value));
+    }
+    for (uint64_t value : {uint64_t{128}, uint64_t{1000}, uint64_t{123456789}, uint64_t{1} << 39}) {
+        Histogram histogram(exact());
+        histogram.observe(static_cast<double>(value));
+        double read = histogram.percentile(100);
+        check(std::fabs(read - static_cast<double>(value)) <= static_cast<double>(value) / 64,
+              "a large value reads back within 1/64: " + std::to_string(value) + " -> " + std::to_string(read));
+    }
+    Histogram clamped(exact());
+    clamped.observe(-5.0);
+    clamped.observe(1e15);
+    check(clamped.percentile(0) == 0.0, "negative values count as 0");
+    check(clamped.percentile(100) < std::ldexp(1.0, Histogram::kMaxBits), "values past the range are clamped");
+}
+
+void testPercentiles() {
+    Histogram empty(exact());
+    check(empty.percentile(50) == 0.0 && empty.count() == 0, "an empty histogram reads 0");
+
+    Histogram histogram(exact());
+    for (int value = 100; value >= 1; --value) histogram.observe(static_cast<double>(value));
+    check(histogram.count() == 100, "every observation is counted");
+    check(histogram.percentile(0) == 1.0, "p0 is the smallest value");
+    check(histogram.percentile(50) == 50.0, "p50 is the nearest rank: " + std::to_string(histogram.percentile(50)));
+    check(histogram.percentile(99) == 99.0, "p99 is the nearest rank: " + std::to_string(histogram.percentile(99)));
+    check(histogram.percentile(100) == 100.0 && histogram.percentile(250) == 100.0,
+          "p100 and beyond are the largest value");
+    check(histogram.snapshot().sum == 5050.0, "the sum covers every observation");
+
+    HistogramOptions millis;
+    millis.unit = 1e-3;
+    Histogram seconds(millis);
+    seconds.observe(std::chrono::milliseconds(40));
+    check(std::fabs(seconds.percentile(50) - 0.04) < 1e-9, "durations are recorded in seconds");
+}
+
+void testExposition() {
+    MetricsRegistry registry;
+    registry.counter("requests_total", "Requests \\ served\nin total", {{"path", "/a\"b"}}).inc(3);
+    registry.gauge("temperature", "Current temperature").set(21.5);
+    double level = 2;
+    registry.gaugeCallback("level", "Read on render", {{"side", "left"}}, [&level]() { return level; });
+    Histogram& sizes = registry.histogram("sizes", "Sizes", {{"kind", "x"}}, exact({100, 10}));
+    for (double value : {10.0, 11.0, 100.0, 500.0}) sizes.observe(value);
+
+    std::string text = registry.renderPrometheus();
+    check(contains(text, "# HELP requests_total Requests \\\\ served\\nin total\n"), "help text is escaped");
+    check(contains(text, "# TYPE requests_total counter\n"), "counters are typed");
+    check(contains(text, "requests_total{path=\"/a\\\"b\"} 3\n"), "label values are escaped and quoted");
+    check(contains(text, "# TYPE temperature gauge\ntemperature 21.5\n"), "a gauge without labels has no braces");
+    check(contains(text, "level{side=\"left\"} 2\n"), "a gauge callback is read on render");
+    level = 7;
+    check(contains(registry.renderPrometheus(), "level{side=\"left\"} 7\n"), "each render reads the callback again");
+
+    check(contains(text, "# TYPE sizes histogram\n"), "histograms are typed");
+    check(contains(text, "sizes_bucket{kind=\"x\",le=\"10\"} 1\n"), "an observation equal to a bound is in that bucket");
+    check(contains(text, "sizes_bucket{kind=\"x\",le=\"100\"} 3\n"), "buckets are cumulative and sorted");
+    check(contains(text, "sizes_bucket{kind=\"x\",le=\"+Inf\"} 4\n"), "the +Inf bucket holds every observation");
+    check(contains(text, "sizes_sum{kind=\"x\"} 621\n") && contains(text, "sizes_count{kind=\"x\"} 4\n"),
+          "sum and count follow the buckets");
+
+    bool threw = false;
+    try {
+        registry.gauge("requests_total", "Not a counter");
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    check(threw, "a name cannot change type");
+    check(&registry.counter("requests_total", "", {{"path", "/a\"b"}}) == &registry.counter("requests_total", "", {{"path", "/a\"b"}}),
+          "a lookup returns the same series");
+}
+
+void testGlobalRegistry() {
+    Counter& retries = llmRetryCounter("m", MetricsRegistry::global());
+    uint64_t before = retries.value();
+    llmRetryCounter("m").inc();
+    check(retries.value() == before + 1, "llmRetryCounter() returns one series per model");
+    std::string text = MetricsRegistry::global().renderPrometheus();
+    check(contains(text, "agents_llm_retries_total{model=\"m\"} "), "the retry counter is exported");
+    check(contains(text, "agents_executor_queue_depth{executor=\"io\"} ") &&
+          contains(text, "agents_executor_queue_depth{executor=\"cpu\"} "),
+          "the global registry reports both executors' queue depth");
+}
+
+void testServer() {
+    MetricsRegistry registry;
+    registry.counter("scraped_total", "Scrapes").inc(5);
+    MetricsServer server(registry);
+    int port = server.start("127.0.0.1", 0);
+    check(port > 0 && server.running() && server.port() == port, "port 0 binds a free port");
+
+    httplib::Client client("http://127.0.0.1:" + std::to_string(port));
+    auto response = client.Get("/metrics");
+    check(response && response->status == 200, "GET /metrics succeeds");
+    if (response) {
+        check(response->get_header_value("Content-Type").rfind("text/plain; version=0.0.4", 0) == 0,
+              "the exposition content type is set");
+        check(contains(response->body, "# TYPE scraped_total counter\nscraped_total 5\n"), "the body is the registry's text");
+    }
+    auto missing = client.Get("/other");
+    check(missing && missing->status == 404, "other paths are not served");
+
+    bool threw = false;
+    try {
+        server.start("127.0.0.1", 0);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    check(threw, "starting twice throws");
+    server.stop();
+    check(!server.running() && server.port() == 0, "stop() resets the server");
+}
+
+} // namespace
+
+int main() {
+    testBucketBoundaries();
+    testPercentiles();
+    testExposition();
+    testGlobalRegistry();
+    testServer();
+    if (failures > 0) {
+        return EXIT_FAILURE;
+    }
+    std::cout << "metrics_test passed" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,291 @@
+/**
+ * @file mock_llm_server_test.cpp
+ * @brief MockLLMServer wire formats: each provider's response and streaming shape, tool calls and errors
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025 Edge AI, LLC. All rights reserved.
+ *
+ */
+#include <agents-cpp/http_client.h>
+#include <agents-cpp/mock_llm_server.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+using namespace agents;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << std::endl;
+        failures++;
+    }
+}
+
+const std::string kReply = "The mock says hello to you";
+
+struct Posted {
+    int status = -1;
+    std::string content_type;
+    std::string retry_after;
+    std::string body;
+    size_t writes = 0;
+};
+
+// Posts a JSON body; a streamed reply is read through the write callback
+Posted post(const std::string& url, const JsonObject& body, bool streamed = false) {
+    Posted posted;
+    HTTPClient::WriteCallback write = nullptr;
+    if (streamed) {
+        write = [&posted](std::string_view data) {
+            posted.body.append(data);
+            posted.writes++;
+            return true;
+        };
+    }
+    HTTPClient::Response response = HTTPClient::post(url, {{"Content-Type", "application/json"}}, body.dump(), 30000, write);
+    posted.status = response.status_code;
+    if (!streamed) posted.body = response.text;
+    auto header = [&response](const std::string& name) {
+        auto it = response.headers.find(name);
+        return it == response.headers.end() ? std::string() : it->second;
+    };
+    posted.content_type = header("Content-Type");
+    posted.retry_after = header("Retry-After");
+    return posted;
+}
+
+JsonObject parsed(const std::string& text) {
+    return JsonObject::parse(text, nullptr, false);
+}
+
+// SSE events as (event name, data); "[DONE]" data is kept as a string
+std::vector<std::pair<std::string, JsonObject>> events(const std::string& body) {
+    std::vector<std::pair<std::string, JsonObject>> out;
+    std::istringstream in(body);
+    std::string line, event;
+    while (std::getline(in, line)) {
+        if (line.rfind("event: ", 0) == 0) {
+            event = line.substr(7);
+        } else if (line.rfind("data: ", 0) == 0) {
+            std::string data = line.substr(6);
+            out.emplace_back(event, data == "[DONE]" ? JsonObject(data) : parsed(data));
+            event.clear();
+        }
+    }
+    return out;
+}
+
+std::vector<JsonObject> lines(const std::string& body) {
+    std::vector<JsonObject> out;
+    std::istringstream in(body);
+    std::string line;
+    while (std::getline(in, line)) {
+        if (!line.empty()) out.push_back(parsed(line));
+    }
+    return out;
+}
+
+JsonObject userMessages(const std::string& prompt) {
+    return JsonObject::array({{{"role", "user"}, {"content", prompt}}});
+}
+
+void testOpenAI(const std::string& base) {
+    Posted reply = post(base + "/chat/completions", {{"model", "gpt-test"}, {"messages", userMessages("hi")}});
+    JsonObject body = parsed(reply.body);
+    check(reply.status == 200 && reply.content_type.rfind("application/json", 0) == 0, "openai: a JSON reply");
+    check(body.value("object", "") == "chat.completion" && body.value("model", "") == "gpt-test",
+          "openai: a chat completion for the requested model: " + reply.body);
+    check(body["choices"][0]["message"].value("content", "") == kReply &&
+          body["choices"][0].value("finish_reason", "") == "stop", "openai: the reply text with a stop reason");
+    check(body["usage"].value("completion_tokens", 0) == 6 && body["usage"].value("prompt_tokens", 0) > 0 &&
+          body["usage"].value("total_tokens", 0) == body["usage"].value("prompt_tokens", 0) + 6,
+          "openai: usage counts one token per word");
+
+    Posted stream = post(base + "/chat/completions",
+                         {{"model", "gpt-test"}, {"stream", true}, {"stream_options", {{"include_usage", true}}},
+                          {"messages", userMessages("hi")}}, true);
+    auto chunks = events(stream.body);
+    check(stream.status == 200 && stream.content_type.rfind("text/event-stream", 0) == 0, "openai: streams SSE");
+    check(stream.writes > 1, "openai: the stream arrives in several writes");
+    check(!chunks.empty() && chunks.back().second == "[DONE]", "openai: the stream ends with [DONE]");
+    std::string text;
+    size_t stops = 0;
+    bool usage = false;
+    for (const auto& [event, chunk] : chunks) {
+        if (!chunk.is_object()) continue;
+        if (chunk.value("object", "") != "chat.completion.chunk") check(false, "openai: every event is a completion chunk");
+        if (!chunk["choices"].empty()) {
+            text += chunk["choices"][0]["delta"].value("content", "");
+            if (chunk["choices"][0]["finish_reason"] == "stop") stops++;
+        } else if (chunk.contains("usage")) {
+            usage = chunk["usage"].value("completion_tokens", 0) == 6;
+        }
+    }
+    check(text == kReply && stops == 1, "openai: the deltas add up to the reply and one chunk stops");
+    check(usage, "openai: include_usage adds a usage chunk");
+}
+
+void testAnthropic(const std::string& base) {
+    JsonObject request = {{"model", "claude-test"}, {"max_tokens", 64}, {"messages", userMessages("hi")}};
+    Posted reply = post(base + "/v1/messages", request);
+    JsonObject body = parsed(reply.body);
+    check(reply.status == 200 && body.value("type", "") == "message" && body.value("role", "") == "assistant",
+          "anthropic: a message: " + reply.body);
+    check(body["content"].size() == 1 && body["content"][0].value("type", "") == "text" &&
+          body["content"][0].value("text", "") == kReply, "anthropic: one text block with the reply");
+    check(body.value("stop_reason", "") == "end_turn" && body["usage"].value("output_tokens", 0) == 6,
+          "anthropic: end_turn with usage");
+
+    request["stream"] = true;
+    Posted stream = post(base + "/v1/messages", request, true);
+    auto chunks = events(stream.body);
+    check(stream.content_type.rfind("text/event-stream", 0) == 0, "anthropic: streams SSE");
+    std::vector<std::string> order;
+    std::string text;
+    bool named = true;
+    for (const auto& [event, data] : chunks) {
+        if (event != data.value("type", "")) named = false;
+        if (order.empty() || order.back() != event) order.push_back(event);
+        if (event == "content_block_delta") text += data["delta"].value("text", "");
+    }
+    check(named, "anthropic: each event is named after its type");
+    check(order == std::vector<std::string>{"message_start", "content_block_start", "content_block_delta",
+                                            "content_block_stop", "message_delta", "message_stop"},
+          "anthropic: the events come in the protocol's order");
+    check(text == kReply, "anthropic: the text deltas add up to the reply");
+}
+
+void testGemini(const std::string& base) {
+    JsonObject request = {{"contents", JsonObject::array({{{"role", "user"}, {"parts", {{{"text", "hi"}}}}}})}};
+    Posted reply = post(base + "/models/gemini-test:generateContent", request);
+    JsonObject body = parsed(reply.body);
+    check(reply.status == 200 && body["candidates"][0]["content"]["parts"][0].value("text", "") == kReply,
+          "gemini: the reply in the first candidate's parts: " + reply.body);
+    check(body["candidates"][0].value("finishReason", "") == "STOP" && body.value("modelVersion", "") == "gemini-test" &&
+          body["usageMetadata"].value("candidatesTokenCount", 0) == 6, "gemini: STOP with usage metadata");
+
+    Posted sse = post(base + "/models/gemini-test:streamGenerateContent?alt=sse", request, true);
+    auto chunks = events(sse.body);
+    std::string text;
+    for (const auto& [event, chunk] : chunks) text += chunk["candidates"][0]["content"]["parts"][0].value("text", "");
+    check(sse.content_type.rfind("text/event-stream", 0) == 0 && text == kReply, "gemini: alt=sse streams the reply");
+    check(chunks.size() == 6 && chunks.back().second["candidates"][0].value("finishReason", "") == "STOP" &&
+          !chunks.front().second["candidates"][0].contains("finishReason"), "gemini: only the last chunk finishes");
+
+    Posted array = post(base + "/models/gemini-test:streamGenerateContent", request, true);
+    JsonObject items = parsed(array.body);
+    check(array.content_type.rfind("application/json", 0) == 0 && items.is_array() && items.size() == 6,
+          "gemini: without alt=sse the stream is one JSON array");
+}
+
+void testOllama(const std::string& base) {
+    Posted stream = post(base + "/chat", {{"model", "llama-test"}, {"messages", userMessages("hi")}}, true);
+    auto chunks = lines(stream.body);
+    check(stream.content_type.rfind("application/x-ndjson", 0) == 0, "ollama: chat streams NDJSON by default");
+    std::string text;
+    for (const auto& chunk : chunks) text += chunk["message"].value("content", "");
+    check(text == kReply && !chunks.empty() && chunks.back().value("done", false) &&
+          chunks.back().value("eval_count", 0) == 6, "ollama: the lines add up to the reply and the last one is done");
+    check(chunks.size() > 1 && !chunks.front().value("done", true), "ollama: earlier lines are not done");
+
+    Posted whole = post(base + "/chat", {{"model", "llama-test"}, {"stream", false}, {"messages", userMessages("hi")}});
+    JsonObject body = parsed(whole.body);
+    check(body.value("done", false) && body["message"].value("content", "") == kReply, "ollama: stream false sends one object");
+
+    Posted generated = post(base + "/generate", {{"model", "llama-test"}, {"stream", false}, {"prompt", "hi"}});
+    check(parsed(generated.body).value("response", "") == kReply, "ollama: generate replies in the response field");
+}
+
+MockLLMServer::ScriptedResponse weatherCall() {
+    MockLLMServer::ScriptedResponse script;
+    script.match = "weather";
+    script.tool_calls.emplace_back("get_weather", JsonObject{{"city", "Paris"}});
+    return script;
+}
+
+void testToolCallsAndErrors(MockLLMServer& server) {
+    server.addScript(weatherCall());
+    Posted tool = post(server.apiBase("openai") + "/chat/completions", {{"model", "gpt-test"}, {"messages", userMessages("weather?")}});
+    JsonObject message = parsed(tool.body)["choices"][0]["message"];
+    check(message["content"].is_null() && message["tool_calls"].size() == 1 &&
+          message["tool_calls"][0]["function"].value("name", "") == "get_weather" &&
+          parsed(message["tool_calls"][0]["function"].value("arguments", "")) == JsonObject{{"city", "Paris"}},
+          "openai: a scripted tool call has null content and JSON-string arguments: " + tool.body);
+    check(parsed(tool.body)["choices"][0].value("finish_reason", "") == "tool_calls", "openai: a tool call finishes with tool_calls");
+
+    server.addScript(weatherCall());
+    Posted anthropic = post(server.apiBase("anthropic") + "/v1/messages",
+                            {{"model", "claude-test"}, {"max_tokens", 64}, {"messages", userMessages("weather?")}});
+    JsonObject block = parsed(anthropic.body)["content"][0];
+    check(block.value("type", "") == "tool_use" && block["input"] == JsonObject{{"city", "Paris"}} &&
+          parsed(anthropic.body).value("stop_reason", "") == "tool_use", "anthropic: a scripted tool call is a tool_use block");
+
+    MockLLMServer::ScriptedResponse limited;
+    limited.content = "slow down";
+    limited.status = 429;
+    server.addScript(limited);
+    Posted error = post(server.apiBase("openai") + "/chat/completions", {{"model", "gpt-test"}, {"messages", userMessages("hi")}});
+    check(error.status == 429 && !error.retry_after.empty() &&
+          parsed(error.body)["error"].value("type", "") == "rate_limit_exceeded" &&
+          parsed(error.body)["error"].value("message", "") == "slow down",
+          "openai: a scripted 429 has Retry-After and an OpenAI error body: " + error.body);
+
+    HTTPClient::Response invalid = HTTPClient::post(server.apiBase("anthropic") + "/v1/messages",
+                                                    {{"Content-Type", "application/json"}}, "{not json");
+    check(invalid.status_code == 400 && parsed(invalid.text).value("type", "") == "error",
+          "anthropic: an unparsable body is a 400 in Anthropic's error shape");
+
+    Posted after = post(server.apiBase("openai") + "/chat/completions", {{"model", "gpt-test"}, {"messages", userMessages("weather?")}});
+    check(parsed(after.body)["choices"][0]["message"].value("content", "") == kReply, "a consumed script is not used again");
+}
+
+void testModelLists(MockLLMServer& server) {
+    HTTPClient::Response openai = HTTPClient::get(server.apiBase("openai") + "/models", {});
+    JsonObject list = parsed(openai.text);
+    check(list["data"].size() == 1 && list["data"][0].value("id", "") == "mock-model" &&
+          list["models"][0].value("name", "") == "models/mock-model", "/v1/models lists the models in OpenAI and Gemini shape");
+    HTTPClient::Response ollama = HTTPClient::get(server.apiBase("ollama") + "/tags", {});
+    check(parsed(ollama.text)["models"][0].value("name", "") == "mock-model", "/api/tags lists the models");
+}
+
+} // namespace
+
+int main() {
+    MockLLMServer::Options options;
+    options.default_content = kReply;
+    options.tokens_per_second = 200;
+    options.seed = 11;
+    MockLLMServer server(options);
+    int port = server.start();
+    check(port > 0 && server.port() == port, "the server binds a free port");
+    check(server.apiBase("openai") == "http://127.0.0.1:" + std::to_string(port) + "/v1" &&
+          server.apiBase("anthropic") == "http://127.0.0.1:" + std::to_string(port) &&
+          server.apiBase("ollama") == "http://127.0.0.1:" + std::to_string(port) + "/api",
+          "apiBase() gives each provider's root");
+
+    testOpenAI(server.apiBase("openai"));
+    testAnthropic(server.apiBase("anthropic"));
+    testGemini(server.apiBase("google"));
+    testOllama(server.apiBase("ollama"));
+    testToolCallsAndErrors(server);
+    testModelLists(server);
+    check(server.requestCount() == 14, "every chat request is counted: " + std::to_string(server.requestCount()));
+
+    server.stop();
+    check(server.port() == 0, "stop() releases the port");
+    if (failures > 0) {
+        return EXIT_FAILURE;
+    }
+    std::cout << "mock_llm_server_test passed" << std::endl;
+    return EXIT_SUCCESS;
+}
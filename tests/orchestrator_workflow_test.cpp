@@ -0,0 +1,206 @@
+/**
+ * @file orchestrator_workflow_test.cpp
+ * @brief OrchestratorWorkflow::runParallel() dependency scheduling and cycle handling
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025 Edge AI, LLC. All rights reserved.
+ *
+ */
+#include <agents-cpp/context.h>
+#include <agents-cpp/workflows/orchestrator_workflow.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace agents;
+using namespace agents::workflows;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << std::endl;
+        failures++;
+    }
+}
+
+// Answers every request with a fixed plan
+class PlanLLM : public LLMInterface {
+public:
+    explicit PlanLLM(JsonObject plan) : plan_(std::move(plan)) {}
+
+    std::vector<std::string> getAvailableModels() override { return {"plan"}; }
+    void setModel(const std::string&) override {}
+    std::string getModel() const override { return "plan"; }
+    void setApiKey(const std::string&) override {}
+    void setApiBase(const std::string&) override {}
+    void setOptions(const LLMOptions& options) override { options_ = options; }
+    LLMOptions getOptions() const override { return options_; }
+
+    LLMResponse chat(const std::string& prompt) override {
+        return chat(std::vector<Message>{Message{Message::Role::USER, prompt}});
+    }
+
+    LLMResponse chat(const std::vector<Message>&) override {
+        LLMResponse response;
+        response.content = JsonObject{{"plan", plan_}}.dump();
+        return response;
+    }
+
+    LLMResponse chatWithTools(const std::vector<Message>& messages,
+                              const std::vector<std::shared_ptr<Tool>>&) override {
+        return chat(messages);
+    }
+
+    void streamChat(const std::vector<Message>& messages,
+                    std::function<void(const std::string&, bool)> callback) override {
+        callback(chat(messages).content, true);
+    }
+
+private:
+    JsonObject plan_;
+    LLMOptions options_;
+};
+
+// Start and finish events of the workers, in the order they happened
+class EventLog {
+public:
+    void add(const std::string& event) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        events_.push_back(event);
+    }
+
+    // Position of an event, or -1 when it did not happen
+    long position(const std::string& event) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (size_t i = 0; i < events_.size(); ++i) {
+            if (events_[i] == event) return static_cast<long>(i);
+        }
+        return -1;
+    }
+
+    bool before(const std::string& first, const std::string& second) const {
+        long a = position(first), b = position(second);
+        return a >= 0 && b >= 0 && a < b;
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::vector<std::string> events_;
+};
+
+struct Run {
+    std::vector<JsonObject> results;
+    std::shared_ptr<EventLog> events = std::make_shared<EventLog>();
+};
+
+// Runs a plan whose items name the worker "step"; the worker echoes its task
+// and the tasks of its prerequisites. A run that does not finish within the
+// deadline fails the whole test, since the stuck thread cannot be joined.
+Run runPlan(const JsonObject& plan, size_t max_parallel, const std::string& name) {
+    Run run;
+    auto context = std::make_shared<Context>();
+    context->setLLM(std::make_shared<PlanLLM>(plan));
+    auto workflow = std::make_shared<OrchestratorWorkflow>(context);
+    auto events = run.events;
+    workflow->addWorker(OrchestratorWorkflow::Worker("step", "Runs one step", "", nullptr,
+        [events](const std::string& task, const JsonObject& task_context) {
+            events->add("start " + task);
+            JsonObject inputs = JsonObject::array();
+            for (const auto& prerequisite : task_context.value("prerequisites", JsonObject::array())) {
+                inputs.push_back(prerequisite.value("output", ""));
+            }
+            events->add("finish " + task);
+            return JsonObject{{"output", task}, {"inputs", inputs}};
+        }));
+    auto results = std::make_shared<std::vector<JsonObject>>();
+    workflow->setSynthesizer([results](const std::vector<JsonObject>& all) {
+        *results = all;
+        return JsonObject{{"answer", "done"}};
+    });
+
+    auto finished = std::async(std::launch::async, [workflow, max_parallel]() {
+        return workflow->runParallel("input", max_parallel);
+    });
+    if (finished.wait_for(std::chrono::seconds(30)) != std::future_status::ready) {
+        std::cerr << "FAILED: " << name << ": runParallel() did not return" << std::endl;
+        std::_Exit(EXIT_FAILURE);
+    }
+    finished.get();
+    run.results = *results;
+    return run;
+}
+
+JsonObject item(const std::string& id, const JsonObject& depends_on = JsonObject::array()) {
+    return JsonObject{{"id", id}, {"worker", "step"}, {"task", id}, {"depends_on", depends_on}};
+}
+
+void testAllCyclic() {
+    JsonObject plan = JsonObject::array({item("a", {"b"}), item("b", {"a"})});
+    Run run = runPlan(plan, 4, "all-cyclic plan");
+    check(run.results.size() == 2, "all-cyclic plan: one result per item");
+    for (const auto& result : run.results) {
+        check(result.value("error", "") == "Dependency cycle", "all-cyclic plan: every item fails: " + result.dump());
+    }
+    check(run.events->position("start a") < 0 && run.events->position("start b") < 0,
+          "all-cyclic plan: no worker runs");
+}
+
+void testCycleBehindReadyItem() {
+    JsonObject plan = JsonObject::array({item("a"), item("b", {"a", "c"}), item("c", {"b"})});
+    Run run = runPlan(plan, 1, "cycle behind a ready item");
+    check(run.results.size() == 3, "cycle behind a ready item: one result per item");
+    if (run.results.size() != 3) return;
+    check(run.results[0].value("output", "") == "a", "cycle behind a ready item: the ready item runs");
+    check(run.results[1].value("error", "") == "Dependency cycle", "cycle behind a ready item: b fails");
+    check(run.results[2].value("error", "") == "Dependency cycle", "cycle behind a ready item: c fails");
+}
+
+void testDiamond() {
+    JsonObject plan = JsonObject::array({
+        item("top"),
+        item("left", {"top"}),
+        item("right", {"top"}),
+        item("bottom", {"left", "right"})
+    });
+    for (size_t max_parallel : {size_t{0}, size_t{1}, size_t{4}}) {
+        const std::string name = "diamond plan (max_parallel " + std::to_string(max_parallel) + ")";
+        Run run = runPlan(plan, max_parallel, name);
+        check(run.results.size() == 4, name + ": one result per item");
+        if (run.results.size() != 4) continue;
+        const char* tasks[] = {"top", "left", "right", "bottom"};
+        for (size_t i = 0; i < 4; ++i) {
+            check(run.results[i].value("output", "") == tasks[i] && !run.results[i].contains("error"),
+                  name + ": results are in plan order: " + run.results[i].dump());
+        }
+        check(run.events->before("finish top", "start left") && run.events->before("finish top", "start right"),
+              name + ": the branches start after their prerequisite finishes");
+        check(run.events->before("finish left", "start bottom") && run.events->before("finish right", "start bottom"),
+              name + ": the join starts after both branches finish");
+        check(run.results[3]["inputs"] == JsonObject::array({"left", "right"}),
+              name + ": the join receives both branch outputs: " + run.results[3].dump());
+        check(run.results[1]["inputs"] == JsonObject::array({"top"}), name + ": a branch receives the top output");
+    }
+}
+
+} // namespace
+
+int main() {
+    testAllCyclic();
+    testCycleBehindReadyItem();
+    testDiamond();
+    if (failures > 0) {
+        return EXIT_FAILURE;
+    }
+    std::cout << "orchestrator_workflow_test passed" << std::endl;
+    return EXIT_SUCCESS;
+}
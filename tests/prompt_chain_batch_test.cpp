@@ -0,0 +1,300 @@
+/**
+ * @file prompt_chain_batch_test.cpp
+ * @brief PromptChainingWorkflow::runBatch() matches run() per input, and its ordering, stage limits and pipelining
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025 Edge AI, LLC. All rights reserved.
+ *
+ */
+#include <agents-cpp/context.h>
+#include <agents-cpp/memo_store.h>
+#include <agents-cpp/workflows/prompt_chaining_workflow.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace agents;
+using namespace agents::workflows;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << std::endl;
+        failures++;
+    }
+}
+
+// Replies "<prompt>!" after a delay; a prompt ending in "slow" takes longer.
+// Prompts start with a "[step]" tag, which is used to track the calls in
+// flight per step and the order in which calls start and finish.
+class EchoLLM : public LLMInterface {
+public:
+    std::vector<std::string> getAvailableModels() override { return {"echo"}; }
+    void setModel(const std::string&) override {}
+    std::string getModel() const override { return "echo"; }
+    void setApiKey(const std::string&) override {}
+    void setApiBase(const std::string&) override {}
+    void setOptions(const LLMOptions& options) override { options_ = options; }
+    LLMOptions getOptions() const override { return options_; }
+
+    LLMResponse chat(const std::string& prompt) override {
+        return chat(std::vector<Message>{Message{Message::Role::USER, prompt}});
+    }
+
+    LLMResponse chat(const std::vector<Message>& messages) override {
+        const std::string& prompt = messages.back().content;
+        std::string step = prompt.substr(0, prompt.find(']') + 1);
+        std::string request;
+        for (const auto& message : messages) {
+            request += std::to_string(static_cast<int>(message.role)) + ":" + message.content + "\n";
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            int running = ++active_[step];
+            peak_[step] = std::max(peak_[step], running);
+            log_.push_back("start " + prompt);
+            requests_.push_back(request);
+        }
+        calls++;
+        bool slow = prompt.size() >= 4 && prompt.compare(prompt.size() - 4, 4, "slow") == 0;
+        std::this_thread::sleep_for(std::chrono::milliseconds(slow ? 80 : 10));
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            --active_[step];
+            log_.push_back("finish " + prompt);
+        }
+        LLMResponse response;
+        response.content = prompt + "!";
+        return response;
+    }
+
+    LLMResponse chatWithTools(const std::vector<Message>& messages,
+                              const std::vector<std::shared_ptr<Tool>>&) override {
+        return chat(messages);
+    }
+
+    void streamChat(const std::vector<Message>& messages,
+                    std::function<void(const std::string&, bool)> callback) override {
+        callback(chat(messages).content, true);
+    }
+
+    int peak(const std::string& step) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return peak_[step];
+    }
+
+    // Position of the first log entry starting with `prefix`, or -1
+    long first(const std::string& prefix) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (size_t i = 0; i < log_.size(); ++i) {
+            if (log_[i].rfind(prefix, 0) == 0) return static_cast<long>(i);
+        }
+        return -1;
+    }
+
+    // Position of the last log entry starting with `prefix`, or -1
+    long last(const std::string& prefix) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (size_t i = log_.size(); i-- > 0;) {
+            if (log_[i].rfind(prefix, 0) == 0) return static_cast<long>(i);
+        }
+        return -1;
+    }
+
+    // The requests sent so far, sorted, as batches send them in any order
+    std::vector<std::string> requests() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<std::string> sorted = requests_;
+        std::sort(sorted.begin(), sorted.end());
+        return sorted;
+    }
+
+    std::atomic<int> calls{0};
+
+private:
+    std::mutex mutex_;
+    std::vector<std::string> requests_;
+    std::map<std::string, int> active_;
+    std::map<std::string, int> peak_;
+    std::vector<std::string> log_;
+    LLMOptions options_;
+};
+
+// Step outputs carry a timestamp, which differs between any two runs
+JsonObject withoutTimestamps(JsonObject value) {
+    if (value.is_object()) {
+        value.erase("timestamp");
+        for (auto& [key, item] : value.items()) item = withoutTimestamps(item);
+    } else if (value.is_array()) {
+        for (auto& item : value) item = withoutTimestamps(item);
+    }
+    return value;
+}
+
+using Setup = std::function<void(PromptChainingWorkflow&)>;
+
+struct Chain {
+    std::shared_ptr<EchoLLM> llm = std::make_shared<EchoLLM>();
+    std::shared_ptr<Context> context = std::make_shared<Context>();
+    std::shared_ptr<PromptChainingWorkflow> workflow;
+    std::mutex mutex;
+    std::vector<std::string> callbacks;
+
+    explicit Chain(const Setup& setup = nullptr) {
+        context->setLLM(llm);
+        context->addMessage(Message{Message::Role::USER, "earlier question"});
+        context->addMessage(Message{Message::Role::ASSISTANT, "earlier answer"});
+        workflow = std::make_shared<PromptChainingWorkflow>(context);
+        if (setup) setup(*workflow);
+        workflow->setStepCallback([this](const std::string& description, const JsonObject& result) {
+            std::lock_guard<std::mutex> lock(mutex);
+            callbacks.push_back(description + " " + withoutTimestamps(result).dump());
+        });
+    }
+
+    // Step callbacks so far, sorted, as batches interleave them
+    std::vector<std::string> sortedCallbacks() {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<std::string> sorted = callbacks;
+        std::sort(sorted.begin(), sorted.end());
+        return sorted;
+    }
+};
+
+void placeholderChain(PromptChainingWorkflow& workflow) {
+    workflow.addStep("outline", "[outline] {step_name} {step_index}/{total_steps}: {input}",
+        [](const JsonObject& output) { return output.dump().find("bad") == std::string::npos; },
+        [](const JsonObject& output) {
+            JsonObject transformed = output;
+            transformed["checked"] = true;
+            return transformed;
+        });
+    workflow.addStep("draft", "[draft] {step_name} {step_index}/{total_steps}: {context} for {input}");
+}
+
+// Each batch element must be what run(input) returns on a fresh copy of the
+// chain, after sending the same requests and making the same step callbacks
+void checkMatchesRun(const Setup& setup, const std::vector<std::string>& inputs, const std::string& name) {
+    std::vector<JsonObject> expected;
+    std::vector<std::string> expected_requests, expected_callbacks;
+    for (const auto& input : inputs) {
+        Chain single(setup);
+        expected.push_back(withoutTimestamps(single.workflow->run(input)));
+        for (auto& request : single.llm->requests()) expected_requests.push_back(std::move(request));
+        for (auto& callback : single.sortedCallbacks()) expected_callbacks.push_back(std::move(callback));
+    }
+    std::sort(expected_requests.begin(), expected_requests.end());
+    std::sort(expected_callbacks.begin(), expected_callbacks.end());
+
+    Chain batch(setup);
+    const size_t history = batch.context->getMessages().size();
+    std::vector<JsonObject> results = batch.workflow->runBatch(inputs);
+    check(results.size() == inputs.size(), name + ": one result per input");
+    for (size_t i = 0; i < inputs.size() && i < results.size(); ++i) {
+        check(withoutTimestamps(results[i]) == expected[i], name + ": runBatch() returns what run() returns for " +
+              inputs[i] + "\n  run():      " + expected[i].dump() + "\n  runBatch(): " + withoutTimestamps(results[i]).dump());
+    }
+    check(batch.llm->requests() == expected_requests, name + ": runBatch() sends the requests run() sends");
+    check(batch.sortedCallbacks() == expected_callbacks, name + ": runBatch() makes the step callbacks run() makes");
+    check(batch.context->getMessages().size() == history, name + ": the batch leaves the context's conversation unchanged");
+}
+
+void testMatchesRun() {
+    checkMatchesRun(placeholderChain, {"a slow", "bad", "c"}, "placeholders, validation and transformers");
+    checkMatchesRun([](PromptChainingWorkflow& workflow) {
+        workflow.addStep("only", "[only] {input}");
+    }, {"x", "y slow"}, "one step");
+    checkMatchesRun(nullptr, {"only"}, "no steps");
+}
+
+void testOrder() {
+    Chain chain(placeholderChain);
+    std::vector<std::string> inputs{"a slow", "b", "c slow", "d"};
+    std::vector<size_t> emitted;
+    PromptChainingWorkflow::BatchOptions options;
+    options.on_result = [&emitted](size_t index, const JsonObject&) { emitted.push_back(index); };
+    std::vector<JsonObject> results = chain.workflow->runBatch(inputs, options);
+    check(emitted == std::vector<size_t>{0, 1, 2, 3}, "on_result is called in input order despite slow inputs");
+    check(chain.workflow->runBatch({}).empty(), "no inputs give no results");
+}
+
+void testStageLimitsAndPipelining() {
+    Chain chain([](PromptChainingWorkflow& workflow) {
+        workflow.addStep("first", "[first] {input}");
+        workflow.addStep("second", "[second] {input}");
+    });
+    PromptChainingWorkflow::BatchOptions options;
+    options.concurrency = 3;
+    options.step_concurrency["first"] = 1;
+    std::vector<std::string> inputs;
+    for (int i = 0; i < 8; ++i) inputs.push_back("x" + std::to_string(i));
+    chain.workflow->runBatch(inputs, options);
+
+    check(chain.llm->peak("[first]") == 1, "a per-step limit caps that step's calls in flight");
+    check(chain.llm->peak("[second]") <= 3, "other steps use the default limit");
+    check(chain.llm->first("start [second]") >= 0 &&
+          chain.llm->first("start [second]") < chain.llm->last("finish [first]"),
+          "the second step of early inputs overlaps the first step of later ones");
+}
+
+void testNotOnCaller() {
+    std::atomic<bool> on_caller{false};
+    const auto caller = std::this_thread::get_id();
+    Chain chain([&](PromptChainingWorkflow& workflow) {
+        workflow.addStep("check", "[check] {input}", [&](const JsonObject&) {
+            if (std::this_thread::get_id() == caller) on_caller = true;
+            return true;
+        });
+    });
+    chain.workflow->runBatch({"a", "b"});
+    check(!on_caller, "validators do not run on the calling thread");
+}
+
+void testMemoization() {
+    auto store = std::make_shared<InMemoryMemoStore>();
+    PromptChainingWorkflow::BatchOptions options;
+    options.memo = Memoization{store, "batch"};
+    std::vector<std::string> inputs{"one", "two"};
+
+    Chain cold(placeholderChain);
+    std::vector<JsonObject> first = cold.workflow->runBatch(inputs, options);
+    check(cold.llm->calls.load() == 4, "a cold store sends every call");
+
+    Chain warm(placeholderChain);
+    std::vector<JsonObject> second = warm.workflow->runBatch(inputs, options);
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        check(withoutTimestamps(second[i]) == withoutTimestamps(first[i]), "a warm store returns the same results");
+    }
+    check(warm.llm->calls.load() == 0, "a warm store sends no calls");
+    check(!warm.callbacks.empty() && warm.callbacks.back().rfind("Memo ", 0) == 0,
+          "the step callback receives the Memo entry last");
+}
+
+} // namespace
+
+int main() {
+    testMatchesRun();
+    testOrder();
+    testStageLimitsAndPipelining();
+    testNotOnCaller();
+    testMemoization();
+    if (failures > 0) {
+        return EXIT_FAILURE;
+    }
+    std::cout << "prompt_chain_batch_test passed" << std::endl;
+    return EXIT_SUCCESS;
+}
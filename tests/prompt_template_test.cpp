@@ -0,0 +1,110 @@
+/**
+ * @file prompt_template_test.cpp
+ * @brief PromptTemplate compilation of slots and literals, and rendering
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025 Edge AI, LLC. All rights reserved.
+ *
+ */
+#include <agents-cpp/prompt_template.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <string>
+
+using namespace agents;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << std::endl;
+        failures++;
+    }
+}
+
+void testCompile() {
+    PromptTemplate tmpl("Use {input} and {outline.sections[1].title}.");
+    check(tmpl.variables() == std::set<std::string>{"input", "outline"}, "slot names are the referenced variables");
+    check(tmpl.source() == "Use {input} and {outline.sections[1].title}.", "the source is kept");
+
+    const std::string literal = R"(Reply as {"key": 1}, not {a b}, {e.g.}, {items[]}, {1st} or { spaced }.)";
+    PromptTemplate literals(literal);
+    check(literals.variables().empty(), "braces that are not slots stay literal");
+    check(literals.render(JsonObject::object()) == literal, "literal braces render unchanged");
+
+    PromptTemplate unclosed("Open {input and {done}");
+    check(unclosed.variables() == std::set<std::string>{"done"}, "a brace without a valid slot does not swallow the next slot");
+
+    bool threw = false;
+    try {
+        PromptTemplate("Hello {nmae}", {"name"});
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    check(threw, "an unknown variable throws when the allowed set is given");
+    PromptTemplate allowed("Hello {name.first}", {"name"});
+    check(allowed.variables() == std::set<std::string>{"name"}, "a path into an allowed variable compiles");
+
+    check(PromptTemplate().render(JsonObject::object()).empty(), "an empty template renders empty");
+}
+
+void testRenderJson() {
+    PromptTemplate tmpl("[{text}] [{count}] [{list}] [{nested.items[1].name}] [{missing}] [{nothing}] [{text.key}]");
+    JsonObject variables{
+        {"text", "verbatim \"quotes\""},
+        {"count", 3},
+        {"list", {1, 2}},
+        {"nested", {{"items", JsonObject::array({{{"name", "a"}}, {{"name", "b"}}})}}},
+        {"nothing", nullptr}
+    };
+    check(tmpl.render(variables) == R"([verbatim "quotes"] [3] [[1,2]] [b] [] [] [])",
+          "strings insert verbatim, other values serialize, missing and null values render empty: " +
+          tmpl.render(variables));
+
+    PromptTemplate twice("{value} and {value}");
+    check(twice.render(JsonObject{{"value", {{"a", 1}}}}) == R"({"a":1} and {"a":1})",
+          "a non-string value referenced twice is serialized for each slot");
+
+    PromptTemplate::Lookup lookup = [](const std::string& name) -> const JsonObject* {
+        static const JsonObject value = "looked up";
+        return name == "known" ? &value : nullptr;
+    };
+    check(PromptTemplate("{known}/{unknown}").render(lookup) == "looked up/", "a lookup resolves each variable");
+
+    check(PromptTemplate("{x}").render(JsonObject::array()) == "", "variables that are not an object resolve nothing");
+}
+
+void testRenderStrings() {
+    PromptTemplate tmpl("Dear {name}, re: {topic}. {name.first}");
+    std::map<std::string, std::string> variables{{"name", "Ada"}, {"topic", "engines"}};
+    check(tmpl.render(variables) == "Dear Ada, re: engines. ", "string variables fill plain slots and not path slots");
+}
+
+void testRenderJsonKeepsType() {
+    JsonObject variables{{"search", {{"data", {1, 2, 3}}}}, {"name", "tea"}};
+    check(PromptTemplate("{search.data}").renderJson(variables) == JsonObject({1, 2, 3}),
+          "a single-slot template yields the referenced value");
+    check(PromptTemplate("{search.missing}").renderJson(variables).is_null(), "a missing single slot yields null");
+    check(PromptTemplate("About {name}").renderJson(variables) == "About tea", "any other template renders to a string");
+}
+
+} // namespace
+
+int main() {
+    testCompile();
+    testRenderJson();
+    testRenderStrings();
+    testRenderJsonKeepsType();
+    if (failures > 0) {
+        return EXIT_FAILURE;
+    }
+    std::cout << "prompt_template_test passed" << std::endl;
+    return EXIT_SUCCESS;
+}
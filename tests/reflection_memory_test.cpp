@@ -0,0 +1,205 @@
+/**
+ * @file reflection_memory_test.cpp
+ * @brief ReflectionMemory retrieval, run hooks, chained step callback, critiques and compact persistence
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025 Edge AI, LLC. All rights reserved.
+ *
+ */
+#include <agents-cpp/reflection_memory.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace agents;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << std::endl;
+        failures++;
+    }
+}
+
+// Replies with a fixed critique, or throws when none is set; keeps the last request
+class CriticLLM : public LLMInterface {
+public:
+    explicit CriticLLM(std::optional<std::string> reply) : reply_(std::move(reply)) {}
+
+    std::vector<std::string> getAvailableModels() override { return {"critic"}; }
+    void setModel(const std::string&) override {}
+    std::string getModel() const override { return "critic"; }
+    void setApiKey(const std::string&) override {}
+    void setApiBase(const std::string&) override {}
+    void setOptions(const LLMOptions& options) override { options_ = options; }
+    LLMOptions getOptions() const override { return options_; }
+
+    LLMResponse chat(const std::string& prompt) override {
+        return chat(std::vector<Message>{Message{Message::Role::USER, prompt}});
+    }
+
+    LLMResponse chat(const std::vector<Message>& messages) override {
+        request = messages.back().content;
+        if (!reply_) throw std::runtime_error("critic unavailable");
+        LLMResponse response;
+        response.content = *reply_;
+        return response;
+    }
+
+    LLMResponse chatWithTools(const std::vector<Message>& messages,
+                              const std::vector<std::shared_ptr<Tool>>&) override {
+        return chat(messages);
+    }
+
+    void streamChat(const std::vector<Message>& messages,
+                    std::function<void(const std::string&, bool)> callback) override {
+        callback(chat(messages).content, true);
+    }
+
+    Task<LLMResponse> chatAsync(const std::vector<Message>& messages) override {
+        co_return chat(messages);
+    }
+
+    std::string request;
+
+private:
+    std::optional<std::string> reply_;
+    LLMOptions options_;
+};
+
+AutonomousAgent::Step failedStep(const std::string& description, const std::string& error) {
+    AutonomousAgent::Step step;
+    step.description = description;
+    step.status = "Failed: " + error;
+    step.result = {{"error", error}};
+    step.success = false;
+    return step;
+}
+
+void testRetrieval() {
+    ReflectionMemory lessons;
+    lessons.addReflection("summarize the quarterly sales report", "Read the totals table first");
+    lessons.addReflection("summarize the quarterly sales report", "Read the totals table first");
+    lessons.addReflection("translate a poem into French", "Keep the rhyme scheme");
+    check(lessons.size() == 2, "exact duplicates are stored once");
+
+    auto found = lessons.retrieve("summarize the annual sales report", 5);
+    check(found.size() == 1 && found[0].first.lesson == "Read the totals table first",
+          "only lessons from similar tasks are retrieved");
+
+    std::string section = lessons.buildPromptSection("summarize the annual sales report");
+    check(section.find("- Read the totals table first") != std::string::npos, "the section lists the lesson");
+    check(lessons.buildPromptSection("bake bread").empty(), "no similar task gives no section");
+    check(lessons.buildPromptSection("summarize the annual sales report", 5, 5).empty(),
+          "a lesson over the token budget is left out");
+}
+
+void testRunHooksAndChainedCallback() {
+    ReflectionMemory lessons;
+    lessons.addReflection("book a flight to Paris", "Check the baggage allowance");
+    size_t chained = 0;
+    auto callback = lessons.stepCallback([&chained](const AutonomousAgent::Step&) { chained++; });
+
+    callback(failedStep("1. Search flights", "timeout"));
+    check(lessons.size() == 1 && chained == 1, "outside a run steps are passed on but not harvested");
+
+    std::string section = lessons.beginRun("book a flight to Rome");
+    check(section.find("Check the baggage allowance") != std::string::npos,
+          "beginRun() returns the lessons for the task to inject into the prompt");
+
+    callback(failedStep("2. Pay for the ticket", "card declined"));
+    AutonomousAgent::Step ok;
+    ok.description = "3. Print the ticket";
+    ok.status = "Completed";
+    ok.result = {{"output", "done"}};
+    ok.success = true;
+    callback(ok);
+    check(chained == 3, "the chained callback sees every step");
+    auto found = lessons.retrieve("book a flight to Rome", 10);
+    bool stored = false;
+    for (const auto& [reflection, similarity] : found) {
+        if (reflection.lesson == "Step \"Pay for the ticket\" failed: card declined") stored = true;
+    }
+    check(stored && lessons.size() == 2, "a failed step of the run is stored against the run's task");
+
+    size_t added = blockingWait(lessons.endRun("book a flight to Rome", JsonObject{{"error", "gave up"}}));
+    check(added == 1, "endRun() stores the run's error");
+    callback(failedStep("4. Retry", "timeout"));
+    check(lessons.size() == 3 && chained == 4, "after endRun() steps are no longer harvested");
+}
+
+void testReflect() {
+    ReflectionMemory lessons;
+    auto critic = std::make_shared<CriticLLM>(std::string("  Confirm the date before booking.\n"));
+    JsonObject result{{"answer", "booked"}, {"steps", JsonObject::array()}};
+    check(blockingWait(lessons.reflect("book a table", result, critic)), "a critique is stored");
+    check(critic->request.find("book a table") != std::string::npos &&
+          critic->request.find("booked") != std::string::npos, "the critic sees the task and the outcome");
+    auto found = lessons.retrieve("book a table");
+    check(found.size() == 1 && found[0].first.lesson == "Confirm the date before booking." &&
+          found[0].first.metadata.value("source", "") == "reflexion" && found[0].first.metadata.value("success", false),
+          "the critique is stored trimmed, marked as a reflexion lesson");
+
+    auto silent = std::make_shared<CriticLLM>(std::string(" \n"));
+    check(!blockingWait(lessons.reflect("book a table", result, silent)), "an empty critique is not stored");
+
+    auto failing = std::make_shared<CriticLLM>(std::nullopt);
+    size_t added = blockingWait(lessons.endRun("order food", JsonObject{{"error", "closed"}}, failing));
+    check(added == 1 && lessons.size() == 2, "a failing critic does not fail endRun()");
+}
+
+void testCompactPersistence(const std::string& path) {
+    {
+        ReflectionMemory lessons(path);
+        lessons.addReflection("summarize the quarterly sales report", "Read the totals table first");
+    }
+    std::ifstream in(path);
+    std::string line;
+    std::getline(in, line);
+    check(line.size() < 1024, "a HashingEmbedder lesson is stored in under 1 KiB: " + std::to_string(line.size()));
+
+    {
+        // A line from before the compact encoding, with the dense vector
+        std::ofstream out(path, std::ios::app);
+        out << JsonObject{{"task", "translate a poem into French"}, {"lesson", "Keep the rhyme scheme"},
+                          {"metadata", JsonObject::object()}, {"created_at", 0},
+                          {"embedding", HashingEmbedder()("translate a poem into French")}}.dump() << '\n';
+    }
+
+    ReflectionMemory reloaded(path);
+    check(reloaded.size() == 2, "both lessons load");
+    auto sales = reloaded.retrieve("summarize the quarterly sales report", 1);
+    check(sales.size() == 1 && sales[0].second > 0.99f, "the compact embedding reads back unchanged");
+    auto poem = reloaded.retrieve("translate a poem into French", 1);
+    check(poem.size() == 1 && poem[0].first.lesson == "Keep the rhyme scheme" && poem[0].second > 0.99f,
+          "a dense embedding still loads");
+}
+
+} // namespace
+
+int main() {
+    const std::string path = (std::filesystem::temp_directory_path() / "reflection_memory_test.jsonl").string();
+    std::remove(path.c_str());
+    testRetrieval();
+    testRunHooksAndChainedCallback();
+    testReflect();
+    testCompactPersistence(path);
+    std::remove(path.c_str());
+    if (failures > 0) {
+        return EXIT_FAILURE;
+    }
+    std::cout << "reflection_memory_test passed" << std::endl;
+    return EXIT_SUCCESS;
+}
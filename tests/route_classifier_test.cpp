@@ -0,0 +1,144 @@
+/**
+ * @file route_classifier_test.cpp
+ * @brief RouteClassifier accuracy on realistic support queries
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025 Edge AI, LLC. All rights reserved.
+ *
+ */
+#include <agents-cpp/workflows/route_classifier.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace agents::workflows;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << std::endl;
+        failures++;
+    }
+}
+
+using Labelled = std::vector<std::pair<std::string, std::string>>;
+
+// Seeds a classifier the way RoutingWorkflow does: route descriptions, then
+// a few examples learned from LLM router decisions
+void seedSupportRoutes(RouteClassifier& classifier) {
+    classifier.addRoute("billing", "Questions about invoices, charges, refunds, payment methods and subscription plans");
+    classifier.addRoute("technical", "Technical support for errors, crashes, installation problems, bugs and API integration");
+    classifier.addRoute("account", "Account management: login, password reset, changing email, deleting the account");
+    classifier.addRoute("general", "General questions about the company, product features and pricing information");
+    const Labelled examples = {
+        {"billing", "I want a refund for the charge on my card"},
+        {"billing", "my invoice shows the wrong amount"},
+        {"billing", "how do I cancel my subscription plan"},
+        {"technical", "the application crashes on startup"},
+        {"technical", "I get an error when I call the API endpoint"},
+        {"technical", "the installer fails on windows"},
+        {"account", "I can't log in to my account"},
+        {"account", "how do I reset my password"},
+        {"account", "change the email on my account"},
+        {"general", "what features do you offer"},
+        {"general", "where is your company located"},
+        {"general", "how much does the product cost"},
+    };
+    for (const auto& [route, text] : examples) {
+        classifier.addExample(route, text);
+    }
+}
+
+const Labelled kQueries = {
+    {"billing", "I was charged twice for my subscription this month"},
+    {"billing", "How do I get a refund for my last invoice?"},
+    {"billing", "Can I change my payment method to PayPal"},
+    {"billing", "why is there an extra charge on my credit card"},
+    {"technical", "The app crashes every time I open it on Android"},
+    {"technical", "I get a 500 error when calling the API"},
+    {"technical", "Installation fails with a permission error on Windows"},
+    {"technical", "your SDK throws an exception when uploading files"},
+    {"account", "I forgot my password and can't log in"},
+    {"account", "How do I change the email address on my account?"},
+    {"account", "Please delete my account and all my data"},
+    {"account", "I can't sign in, it says my login is locked"},
+    {"general", "What features does the pro version include?"},
+    {"general", "Do you have an office in Europe?"},
+    {"general", "What is the pricing for teams"},
+    {"general", "Tell me about your company"},
+};
+
+// Returns (confident, confident and correct)
+std::pair<size_t, size_t> score(const RouteClassifier& classifier) {
+    size_t confident = 0, correct = 0;
+    for (const auto& [route, query] : kQueries) {
+        RouteClassifier::Prediction prediction = classifier.classify(query);
+        if (prediction.confident) {
+            confident++;
+            correct += prediction.route == route;
+        }
+    }
+    return {confident, correct};
+}
+
+void testDefaultThresholds() {
+    RouteClassifier classifier;
+    seedSupportRoutes(classifier);
+    auto [confident, correct] = score(classifier);
+    check(confident >= 10, "default thresholds route most clear queries locally (" + std::to_string(confident) + "/16)");
+    check(correct == confident, "every confident default prediction is correct");
+}
+
+void testClearMatchIsConfident() {
+    RouteClassifier classifier;
+    seedSupportRoutes(classifier);
+    RouteClassifier::Prediction prediction = classifier.classify("How do I change the email address on my account?");
+    check(prediction.route == "account" && prediction.confident, "clear account query is confident");
+}
+
+void testDescriptionsOnlyStayCautious() {
+    RouteClassifier classifier;
+    classifier.addRoute("billing", "Questions about invoices, charges, refunds, payment methods and subscription plans");
+    classifier.addRoute("technical", "Technical support for errors, crashes, installation problems, bugs and API integration");
+    classifier.addRoute("account", "Account management: login, password reset, changing email, deleting the account");
+    classifier.addRoute("general", "General questions about the company, product features and pricing information");
+    for (const auto& [route, query] : kQueries) {
+        RouteClassifier::Prediction prediction = classifier.classify(query);
+        check(!prediction.confident || prediction.route == route, "no confident misroute without examples: " + query);
+    }
+}
+
+void testCalibrate() {
+    RouteClassifier classifier;
+    seedSupportRoutes(classifier);
+    classifier.setThresholds(0.1f, 1.0f);
+    float margin = classifier.calibrate(kQueries, 0.95f);
+    auto [confident, correct] = score(classifier);
+    check(margin > 0.0f && margin < 0.2f, "calibrated margin is in range (" + std::to_string(margin) + ")");
+    check(confident >= 12 && correct == confident, "calibrated thresholds keep full precision on the calibration set");
+
+    float strict = classifier.calibrate({{"billing", "Tell me about your company"}}, 1.0f);
+    check(!classifier.classify("Tell me about your company").confident, "unreachable precision disables the fast path");
+    check(strict > 0.0f, "unreachable precision sets a threshold above the observed margins");
+}
+
+} // namespace
+
+int main() {
+    testDefaultThresholds();
+    testClearMatchIsConfident();
+    testDescriptionsOnlyStayCautious();
+    testCalibrate();
+    if (failures > 0) {
+        return EXIT_FAILURE;
+    }
+    std::cout << "route_classifier_test passed" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,110 @@
+/**
+ * @file step_history_test.cpp
+ * @brief StepHistory ring bounds and reading spilled steps back from disk
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025 Edge AI, LLC. All rights reserved.
+ *
+ */
+#include <agents-cpp/agents/step_history.h>
+#include <agents-cpp/context.h>
+
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace agents;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << std::endl;
+        failures++;
+    }
+}
+
+AutonomousAgent::Step makeStep(size_t index) {
+    AutonomousAgent::Step step;
+    step.description = "step " + std::to_string(index);
+    step.status = index % 2 == 0 ? "done" : "retry";
+    step.result = {{"index", index}, {"text", std::string(64, static_cast<char>('a' + index % 26))}};
+    step.success = index % 3 != 0;
+    return step;
+}
+
+bool sameStep(const AutonomousAgent::Step& step, size_t index) {
+    AutonomousAgent::Step expected = makeStep(index);
+    return step.description == expected.description && step.status == expected.status &&
+           step.result == expected.result && step.success == expected.success;
+}
+
+void testSpillAndReadBack(const std::string& path) {
+    AutonomousAgent agent(std::make_shared<Context>());
+    size_t chained = 0;
+    StepHistory history(agent, 4, path, [&chained](const AutonomousAgent::Step&) { chained++; });
+
+    const size_t total = 25;
+    for (size_t i = 0; i < total; ++i) {
+        history.record(makeStep(i));
+    }
+    check(history.size() == total, "size counts every recorded step");
+    check(history.firstAvailable() == 0, "spilled steps stay retrievable");
+    check(std::filesystem::file_size(path) > 0, "evicted steps are written to the spill file");
+
+    std::vector<AutonomousAgent::Step> all = history.getRange(0, total);
+    check(all.size() == total, "getRange returns spilled and in-memory steps");
+    for (size_t i = 0; i < all.size(); ++i) {
+        check(sameStep(all[i], i), "step " + std::to_string(i) + " reads back unchanged");
+    }
+
+    std::vector<AutonomousAgent::Step> middle = history.getRange(19, 3);
+    check(middle.size() == 3 && sameStep(middle[0], 19) && sameStep(middle[2], 21),
+          "a range across the spill boundary keeps execution order");
+
+    std::vector<AutonomousAgent::Step> recent = history.getRecent(4);
+    check(recent.size() == 4 && sameStep(recent.front(), 21) && sameStep(recent.back(), 24),
+          "getRecent returns the ring in execution order");
+
+    size_t visited = 0;
+    history.forEach(2, 100, [&visited](size_t index, const AutonomousAgent::Step& step) {
+        visited++;
+        return sameStep(step, index) && index < 10;
+    });
+    check(visited == 9, "forEach stops when the visitor returns false");
+    check(agent.getSteps().size() <= 4, "the agent's own step list stays within the capacity");
+    check(chained == 0, "record() does not invoke the chained callback");
+}
+
+void testDropWithoutSpillFile() {
+    AutonomousAgent agent(std::make_shared<Context>());
+    StepHistory history(agent, 3);
+    for (size_t i = 0; i < 10; ++i) {
+        history.record(makeStep(i));
+    }
+    check(history.size() == 10, "dropped steps are still counted");
+    check(history.firstAvailable() == 7, "only the ring is retrievable without a spill file");
+    std::vector<AutonomousAgent::Step> all = history.getRange(0, 10);
+    check(all.size() == 3 && sameStep(all.front(), 7) && sameStep(all.back(), 9),
+          "getRange skips dropped steps");
+}
+
+} // namespace
+
+int main() {
+    std::string path = (std::filesystem::temp_directory_path() / "step_history_test.bin").string();
+    testSpillAndReadBack(path);
+    testDropWithoutSpillFile();
+    std::filesystem::remove(path);
+    if (failures > 0) {
+        return EXIT_FAILURE;
+    }
+    std::cout << "step_history_test passed" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,151 @@
+/**
+ * @file streaming_agent_test.cpp
+ * @brief ReActStreamParser events, markers and chunk-boundary independence
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025 Edge AI, LLC. All rights reserved.
+ *
+ */
+#include <agents-cpp/agents/streaming_agent.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace agents;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << std::endl;
+        failures++;
+    }
+}
+
+struct Parsed {
+    std::vector<AgentEvent> events;
+    std::string thought;
+    std::string answer;
+    std::string tool_name;
+    JsonObject tool_input;
+    std::string transcript;
+    bool action_complete = false;
+    bool final_answer = false;
+};
+
+// Feeds the text in chunks of `chunk` characters (the whole text when 0)
+Parsed parse(const std::string& text, size_t chunk) {
+    ReActStreamParser parser;
+    Parsed parsed;
+    size_t step = chunk == 0 ? std::max<size_t>(text.size(), 1) : chunk;
+    for (size_t pos = 0; pos < text.size() && !parser.actionComplete(); pos += step) {
+        parser.feed(text.substr(pos, step), parsed.events);
+    }
+    parser.finish(parsed.events);
+    parsed.thought = parser.thought();
+    parsed.answer = parser.answer();
+    parsed.tool_name = parser.toolName();
+    parsed.tool_input = parser.toolInput();
+    parsed.transcript = parser.transcript();
+    parsed.action_complete = parser.actionComplete();
+    parsed.final_answer = parser.hasFinalAnswer();
+    return parsed;
+}
+
+size_t count(const Parsed& parsed, AgentEvent::Type type) {
+    return static_cast<size_t>(std::count_if(parsed.events.begin(), parsed.events.end(),
+        [type](const AgentEvent& event) { return event.type == type; }));
+}
+
+std::string deltas(const Parsed& parsed, bool is_answer) {
+    std::string text;
+    for (const auto& event : parsed.events) {
+        if (event.type == AgentEvent::Type::TEXT_DELTA && event.is_answer == is_answer) text += event.text;
+    }
+    return text;
+}
+
+// The same output split at any boundary must parse the same way
+void checkEveryChunking(const std::string& text, const std::string& name, void (*verify)(const Parsed&, const std::string&)) {
+    for (size_t chunk : {size_t{0}, size_t{1}, size_t{2}, size_t{3}, size_t{7}}) {
+        verify(parse(text, chunk), name + " (chunk " + std::to_string(chunk) + ")");
+    }
+}
+
+void testToolCall() {
+    const std::string text =
+        "Thought: I need the weather.\n"
+        "Action: weather\n"
+        "Action Input: {\"city\": \"Paris\", \"note\": \"a } in a string\"}\n"
+        "Observation: sunny";
+    checkEveryChunking(text, "tool call", [](const Parsed& parsed, const std::string& name) {
+        check(parsed.action_complete, name + ": the call is complete");
+        check(parsed.tool_name == "weather", name + ": the tool name is parsed: " + parsed.tool_name);
+        check(parsed.tool_input == JsonObject({{"city", "Paris"}, {"note", "a } in a string"}}),
+              name + ": JSON arguments are parsed across braces in strings: " + parsed.tool_input.dump());
+        check(count(parsed, AgentEvent::Type::TOOL_CALL_START) == 1 && count(parsed, AgentEvent::Type::TOOL_CALL_END) == 1,
+              name + ": one start and one end event");
+        check(deltas(parsed, false) == "Thought: I need the weather.\n", name + ": the thought is streamed: " + deltas(parsed, false));
+        check(parsed.transcript.find("Observation") == std::string::npos, name + ": the transcript stops at the end of the call");
+        check(!parsed.final_answer, name + ": no final answer");
+    });
+}
+
+void testPlainInput() {
+    checkEveryChunking("Action: search\nAction Input: capital of France\nmore text", "plain input",
+        [](const Parsed& parsed, const std::string& name) {
+            check(parsed.action_complete && parsed.tool_name == "search", name + ": the call is complete");
+            check(parsed.tool_input == JsonObject({{"input", "capital of France"}}),
+                  name + ": plain input ends at the line and is wrapped: " + parsed.tool_input.dump());
+        });
+    checkEveryChunking("Action: search\ncapital of France", "input without its marker",
+        [](const Parsed& parsed, const std::string& name) {
+            check(parsed.action_complete, name + ": the call completes at the end of the stream");
+            check(parsed.tool_input == JsonObject({{"input", "capital of France"}}), name + ": " + parsed.tool_input.dump());
+        });
+}
+
+void testFinalAnswer() {
+    checkEveryChunking("Thought: easy.\nFinal Answer: Paris is the capital.\nIt is in France.", "final answer",
+        [](const Parsed& parsed, const std::string& name) {
+            check(parsed.final_answer, name + ": the answer marker is recognised");
+            check(parsed.answer == "Paris is the capital.\nIt is in France.", name + ": the answer text: " + parsed.answer);
+            check(deltas(parsed, true) == parsed.answer, name + ": answer deltas are flagged as answer text");
+            check(parsed.thought == "Thought: easy.\n", name + ": the thought excludes the answer: " + parsed.thought);
+            check(!parsed.action_complete && count(parsed, AgentEvent::Type::TOOL_CALL_START) == 0, name + ": no tool call");
+        });
+}
+
+void testMarkerPrefixes() {
+    checkEveryChunking("Act naturally.\nFinal thoughts: none\nObserving", "marker prefixes",
+        [](const Parsed& parsed, const std::string& name) {
+            check(parsed.thought == "Act naturally.\nFinal thoughts: none\nObserving",
+                  name + ": lines that only start like a marker stay text: " + parsed.thought);
+            check(!parsed.final_answer && !parsed.action_complete, name + ": no marker is recognised");
+        });
+    checkEveryChunking("Thinking...\nObservation: made up\nFinal Answer: never", "hallucinated observation",
+        [](const Parsed& parsed, const std::string& name) {
+            check(parsed.thought == "Thinking...\n", name + ": text after an Observation marker is dropped: " + parsed.thought);
+            check(!parsed.final_answer, name + ": nothing after the observation is parsed");
+        });
+}
+
+} // namespace
+
+int main() {
+    testToolCall();
+    testPlainInput();
+    testFinalAnswer();
+    testMarkerPrefixes();
+    if (failures > 0) {
+        return EXIT_FAILURE;
+    }
+    std::cout << "streaming_agent_test passed" << std::endl;
+    return EXIT_SUCCESS;
+}
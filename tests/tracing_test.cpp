@@ -0,0 +1,239 @@
+/**
+ * @file tracing_test.cpp
+ * @brief Span parenting across offload(), whenAll() and TracingLLM streams
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025 Edge AI, LLC. All rights reserved.
+ *
+ */
+#include <agents-cpp/coroutine_utils.h>
+#include <agents-cpp/instrumentation.h>
+#include <agents-cpp/tracing.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace agents;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << std::endl;
+        failures++;
+    }
+}
+
+// Keeps every exported span
+class CollectingExporter : public SpanExporter {
+public:
+    void exportSpans(const std::vector<SpanData>& spans) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        spans_.insert(spans_.end(), spans.begin(), spans.end());
+    }
+
+    // Flushes the tracer and returns the spans exported so far, then forgets them
+    std::vector<SpanData> take() {
+        Tracer::flush();
+        std::lock_guard<std::mutex> lock(mutex_);
+        return std::exchange(spans_, {});
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<SpanData> spans_;
+};
+
+std::shared_ptr<CollectingExporter> exporter = std::make_shared<CollectingExporter>();
+
+std::vector<const SpanData*> named(const std::vector<SpanData>& spans, const std::string& name) {
+    std::vector<const SpanData*> found;
+    for (const auto& span : spans) {
+        if (span.name == name) found.push_back(&span);
+    }
+    return found;
+}
+
+bool childOf(const SpanData* child, const SpanData* parent) {
+    return child && parent && child->parent_span_id == parent->context.span_id &&
+           child->context.trace_id_low == parent->context.trace_id_low &&
+           child->context.trace_id_high == parent->context.trace_id_high;
+}
+
+bool onlyChildOf(const std::vector<const SpanData*>& children, const SpanData* parent, size_t count) {
+    if (children.size() != count) return false;
+    for (const auto* child : children) {
+        if (!childOf(child, parent)) return false;
+    }
+    return true;
+}
+
+Task<int> offloadedChild() {
+    Span span("root");
+    int result = co_await offload([]() {
+        Span child("offloaded");
+        return 7;
+    });
+    Span after("after");
+    co_return result;
+}
+
+void testOffload() {
+    const auto caller = std::this_thread::get_id();
+    check(blockingWait(offloadedChild()) == 7, "the offloaded result is returned");
+    std::vector<SpanData> spans = exporter->take();
+    auto root = named(spans, "root");
+    check(root.size() == 1 && root[0]->parent_span_id == 0, "the coroutine's span is a root");
+    if (root.size() != 1) return;
+    check(onlyChildOf(named(spans, "offloaded"), root[0], 1), "a span on the executor thread is a child of the awaiting span");
+    check(onlyChildOf(named(spans, "after"), root[0], 1), "after resuming on the executor thread the span is still current");
+    check(std::this_thread::get_id() == caller && TraceContext::current().span_id == 0,
+          "the caller's context is untouched");
+}
+
+Task<int> branch(int value) {
+    Span span("branch");
+    co_await offload([]() {
+        Span leaf("leaf");
+    });
+    co_return value;
+}
+
+Task<int> fanOut() {
+    Span span("fan_out");
+    std::vector<Task<int>> tasks;
+    for (int i = 0; i < 4; ++i) tasks.push_back(branch(i));
+    std::vector<int> results = co_await whenAll(std::move(tasks));
+    Span joined("joined");
+    int sum = 0;
+    for (int result : results) sum += result;
+    co_return sum;
+}
+
+void testWhenAll() {
+    check(blockingWait(fanOut()) == 6, "whenAll() returns every result");
+    std::vector<SpanData> spans = exporter->take();
+    auto root = named(spans, "fan_out");
+    check(root.size() == 1, "one fan-out span");
+    if (root.size() != 1) return;
+    auto branches = named(spans, "branch");
+    check(onlyChildOf(branches, root[0], 4), "each task's span is a child of the span that started whenAll()");
+    auto leaves = named(spans, "leaf");
+    check(leaves.size() == 4, "one leaf per task");
+    std::map<uint64_t, int> per_branch;
+    for (const auto* leaf : leaves) {
+        for (const auto* parent : branches) {
+            if (childOf(leaf, parent)) per_branch[parent->context.span_id]++;
+        }
+    }
+    check(per_branch.size() == 4, "each leaf is a child of its own task's span, not a sibling's");
+    check(onlyChildOf(named(spans, "joined"), root[0], 1),
+          "after whenAll() resumes on the last task's thread the awaiting span is current again");
+}
+
+// Streams three chunks, opening a span for each as a provider would for its request
+class SpanningLLM : public LLMInterface {
+public:
+    std::vector<std::string> getAvailableModels() override { return {"spanning"}; }
+    void setModel(const std::string&) override {}
+    std::string getModel() const override { return "spanning"; }
+    void setApiKey(const std::string&) override {}
+    void setApiBase(const std::string&) override {}
+    void setOptions(const LLMOptions& options) override { options_ = options; }
+    LLMOptions getOptions() const override { return options_; }
+
+    LLMResponse chat(const std::string& prompt) override {
+        return chat(std::vector<Message>{Message{Message::Role::USER, prompt}});
+    }
+
+    LLMResponse chat(const std::vector<Message>&) override {
+        Span span("provider");
+        LLMResponse response;
+        response.content = "reply";
+        return response;
+    }
+
+    LLMResponse chatWithTools(const std::vector<Message>& messages,
+                              const std::vector<std::shared_ptr<Tool>>&) override {
+        return chat(messages);
+    }
+
+    void streamChat(const std::vector<Message>& messages,
+                    std::function<void(const std::string&, bool)> callback) override {
+        callback(chat(messages).content, true);
+    }
+
+    AsyncGenerator<std::string> streamChatAsync(const std::vector<Message>&,
+                                                const std::vector<std::shared_ptr<Tool>>&) override {
+        for (const char* chunk : {"a", "b", "c"}) {
+            Span span("provider");
+            span.end();
+            co_yield std::string(chunk);
+        }
+    }
+
+private:
+    LLMOptions options_;
+};
+
+void testStream() {
+    TracingLLM llm(std::make_shared<SpanningLLM>(), "test");
+    std::vector<Message> messages{Message{Message::Role::USER, "question"}};
+    std::string received;
+    {
+        Span root("consumer");
+        auto stream = llm.streamChatAsync(messages, {});
+        while (auto chunk = blockingWait(stream.next())) {
+            Span between("between");
+            received += *chunk;
+        }
+    }
+    check(received == "abc", "the traced stream yields every chunk");
+    std::vector<SpanData> spans = exporter->take();
+    auto root = named(spans, "consumer");
+    auto streamed = named(spans, "llm.stream_chat");
+    check(root.size() == 1 && onlyChildOf(streamed, root[0], 1), "the stream span is a child of the consumer's span");
+    if (root.size() != 1 || streamed.size() != 1) return;
+    check(onlyChildOf(named(spans, "provider"), streamed[0], 3), "the wrapped stream's spans are children of the stream span");
+    check(onlyChildOf(named(spans, "between"), root[0], 3), "the consumer's spans between chunks are not");
+    check(streamed[0]->attributes.value("gen_ai.response.chunks", 0) == 3, "the chunks are counted");
+    check(streamed[0]->attributes.contains("gen_ai.response.ttft_ms") && streamed[0]->events.size() == 1,
+          "the first token is recorded");
+
+    {
+        Span root("abandoning");
+        const uint64_t active = TraceContext::current().span_id;
+        {
+            auto stream = llm.streamChatAsync(messages, {});
+            blockingWait(stream.next());
+            Span inner("inner");
+        }
+        check(TraceContext::current().span_id == active, "an abandoned stream leaves the consumer's span current");
+    }
+    spans = exporter->take();
+    check(named(spans, "llm.stream_chat").size() == 1, "an abandoned stream still ends its span");
+}
+
+} // namespace
+
+int main() {
+    Tracer::setExporter(exporter);
+    testOffload();
+    testWhenAll();
+    testStream();
+    Tracer::shutdown();
+    if (failures > 0) {
+        return EXIT_FAILURE;
+    }
+    std::cout << "tracing_test passed" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,289 @@
+/**
+ * @file workflow_tasks_test.cpp
+ * @brief runTask() returns what run() returns, through the concrete type, a Workflow reference or memoized
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025 Edge AI, LLC. All rights reserved.
+ *
+ */
+#include <agents-cpp/context.h>
+#include <agents-cpp/memo_store.h>
+#include <agents-cpp/workflows/evaluator_workflow.h>
+#include <agents-cpp/workflows/orchestrator_workflow.h>
+#include <agents-cpp/workflows/parallelization_workflow.h>
+#include <agents-cpp/workflows/prompt_chaining_workflow.h>
+#include <agents-cpp/workflows/routing_workflow.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace agents;
+using namespace agents::workflows;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << std::endl;
+        failures++;
+    }
+}
+
+bool contains(const std::string& text, const std::string& part) {
+    return text.find(part) != std::string::npos;
+}
+
+// Answers deterministically from the request and records every request, so
+// two runs can be compared call for call
+class ScriptedLLM : public LLMInterface {
+public:
+    std::vector<std::string> getAvailableModels() override { return {"scripted"}; }
+    void setModel(const std::string&) override {}
+    std::string getModel() const override { return "scripted"; }
+    void setApiKey(const std::string&) override {}
+    void setApiBase(const std::string&) override {}
+    void setOptions(const LLMOptions& options) override { options_ = options; }
+    LLMOptions getOptions() const override { return options_; }
+
+    LLMResponse chat(const std::string& prompt) override {
+        return chat(std::vector<Message>{Message{Message::Role::USER, prompt}});
+    }
+
+    LLMResponse chat(const std::vector<Message>& messages) override {
+        std::string system, user;
+        for (const auto& message : messages) {
+            (message.role == Message::Role::SYSTEM ? system : user) += message.content + "\n";
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            requests_.push_back(system + "|" + user);
+        }
+        LLMResponse response;
+        if (contains(system, "[ROUTER]")) {
+            response.content = contains(user, "chain") ? R"({"route": "chain", "reason": "asks for a chain"})"
+                                                       : R"({"route": "answer", "reason": "direct question"})";
+        } else if (contains(system, "[PLANNER]")) {
+            response.content = R"({"plan": [{"worker": "researcher", "task": "collect facts"},)"
+                               R"( {"worker": "writer", "task": "write the summary"}]})";
+        } else if (contains(system, "[EVALUATOR]")) {
+            response.content = contains(user, "Previous response") ? R"({"score": 0.9, "feedback": "good"})"
+                                                                   : R"({"score": 0.4, "feedback": "expand it"})";
+        } else {
+            response.content = "reply " + std::to_string(user.size());
+        }
+        return response;
+    }
+
+    LLMResponse chatWithTools(const std::vector<Message>& messages,
+                              const std::vector<std::shared_ptr<Tool>>&) override {
+        return chat(messages);
+    }
+
+    void streamChat(const std::vector<Message>& messages,
+                    std::function<void(const std::string&, bool)> callback) override {
+        callback(chat(messages).content, true);
+    }
+
+    // Requests since the last call, in a stable order
+    std::vector<std::string> takeRequests() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<std::string> requests;
+        requests.swap(requests_);
+        std::sort(requests.begin(), requests.end());
+        return requests;
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<std::string> requests_;
+    LLMOptions options_;
+};
+
+// Timings differ between any two runs
+JsonObject withoutTimings(JsonObject value) {
+    if (value.is_object()) {
+        value.erase("latency_ms");
+        for (auto& [key, item] : value.items()) item = withoutTimings(item);
+    } else if (value.is_array()) {
+        for (auto& item : value) item = withoutTimings(item);
+    }
+    return value;
+}
+
+std::shared_ptr<Context> contextWith(const std::shared_ptr<ScriptedLLM>& llm) {
+    auto context = std::make_shared<Context>();
+    context->setLLM(llm);
+    return context;
+}
+
+// Workflows may keep state across runs (the chain adds to its context), so
+// each run gets a freshly built workflow and LLM
+template <typename W>
+struct Setup {
+    std::shared_ptr<ScriptedLLM> llm = std::make_shared<ScriptedLLM>();
+    std::shared_ptr<W> workflow;
+};
+
+template <typename W>
+using Build = std::function<std::shared_ptr<W>(const std::shared_ptr<Context>&)>;
+
+template <typename W>
+Setup<W> setUp(const Build<W>& build) {
+    Setup<W> setup;
+    setup.workflow = build(contextWith(setup.llm));
+    return setup;
+}
+
+// runTask() must send the same requests and return the same result as run(),
+// whether it is called on the concrete type or through a Workflow reference
+template <typename W>
+void checkEquivalent(const Build<W>& build, const std::string& input, const std::string& name) {
+    Setup<W> blocking = setUp(build);
+    JsonObject expected = withoutTimings(blocking.workflow->run(input));
+    std::vector<std::string> expected_requests = blocking.llm->takeRequests();
+    check(!expected_requests.empty(), name + ": the workflow calls the LLM");
+
+    Setup<W> direct = setUp(build);
+    JsonObject direct_result = withoutTimings(blockingWait(direct.workflow->runTask(input)));
+    check(direct_result == expected, name + ": runTask() returns what run() returns\n  run():     " +
+          expected.dump() + "\n  runTask(): " + direct_result.dump());
+    check(direct.llm->takeRequests() == expected_requests, name + ": runTask() sends the requests run() sends");
+
+    Setup<W> base = setUp(build);
+    Workflow& workflow = *base.workflow;
+    JsonObject base_result = withoutTimings(blockingWait(workflow.runTask(input)));
+    check(base_result == expected, name + ": runTask() through a Workflow reference returns what run() returns");
+    check(base.llm->takeRequests() == expected_requests,
+          name + ": runTask() through a Workflow reference sends the requests run() sends");
+}
+
+// The memoizing runTask() must send run()'s requests and return run()'s
+// result on a cold store, and the same result without any request on a warm one
+template <typename W>
+void checkMemoized(const Build<W>& build, const std::string& input, const std::string& name) {
+    Setup<W> blocking = setUp(build);
+    JsonObject expected = withoutTimings(blocking.workflow->run(input));
+    std::vector<std::string> expected_requests = blocking.llm->takeRequests();
+
+    auto store = std::make_shared<InMemoryMemoStore>();
+    Setup<W> cold = setUp(build);
+    JsonObject memo_entry;
+    cold.workflow->setStepCallback([&memo_entry](const std::string& description, const JsonObject& result) {
+        if (description == "Memo") memo_entry = result;
+    });
+    JsonObject cold_result = withoutTimings(blockingWait(cold.workflow->runTask(input, Memoization{store, "wf"})));
+    check(cold_result == expected, name + ": memoized runTask() returns what run() returns\n  run():     " +
+          expected.dump() + "\n  runTask(): " + cold_result.dump());
+    std::vector<std::string> cold_requests = cold.llm->takeRequests();
+    check(!cold_requests.empty() && cold_requests.size() <= expected_requests.size(),
+          name + ": a cold store sends at most the requests run() sends");
+    check(!memo_entry.is_null(), name + ": the step callback receives the Memo entry");
+
+    Setup<W> warm = setUp(build);
+    JsonObject warm_result = withoutTimings(blockingWait(warm.workflow->runTask(input, Memoization{store, "wf"})));
+    check(warm_result == expected, name + ": a warm store returns what run() returns");
+    check(warm.llm->takeRequests().empty(), name + ": a warm store sends no requests");
+}
+
+std::shared_ptr<PromptChainingWorkflow> makeChain(const std::shared_ptr<Context>& context) {
+    auto chain = std::make_shared<PromptChainingWorkflow>(context);
+    chain->addStep("outline", "Write an outline for: {input}");
+    chain->addStep("draft", "Expand this outline: {outline.response}");
+    return chain;
+}
+
+void testPromptChaining() {
+    checkEquivalent<PromptChainingWorkflow>(makeChain, "solar power", "PromptChainingWorkflow");
+    checkMemoized<PromptChainingWorkflow>(makeChain, "solar power", "PromptChainingWorkflow");
+}
+
+void testParallelization() {
+    checkEquivalent<ParallelizationWorkflow>([](const std::shared_ptr<Context>& context) {
+        auto sectioning = std::make_shared<ParallelizationWorkflow>(context);
+        sectioning->addTask("pros", "List the advantages.");
+        sectioning->addTask("cons", "List the disadvantages.");
+        return sectioning;
+    }, "remote work", "ParallelizationWorkflow (sectioning)");
+
+    checkEquivalent<ParallelizationWorkflow>([](const std::shared_ptr<Context>& context) {
+        auto voting = std::make_shared<ParallelizationWorkflow>(context, ParallelizationWorkflow::Strategy::VOTING);
+        voting->addTask("first", "Answer yes or no.");
+        voting->addTask("second", "Answer yes or no.");
+        voting->addTask("third", "Answer yes or no, briefly.");
+        return voting;
+    }, "Is water wet?", "ParallelizationWorkflow (voting)");
+}
+
+void testOrchestrator() {
+    checkEquivalent<OrchestratorWorkflow>([](const std::shared_ptr<Context>& context) {
+        auto orchestrator = std::make_shared<OrchestratorWorkflow>(context);
+        orchestrator->setOrchestratorPrompt("[PLANNER] Split the task between the workers.");
+        orchestrator->addWorker("researcher", "Finds facts", "You collect facts.");
+        orchestrator->addWorker("writer", "Writes text", "You write summaries.");
+        return orchestrator;
+    }, "Summarize the history of tea", "OrchestratorWorkflow");
+}
+
+void testEvaluator() {
+    Build<EvaluatorWorkflow> build = [](const std::shared_ptr<Context>& context) {
+        auto evaluator = std::make_shared<EvaluatorWorkflow>(context, "You answer questions.",
+                                                             "[EVALUATOR] Grade the response.");
+        evaluator->setMaxIterations(3);
+        evaluator->setImprovementThreshold(0.8);
+        return evaluator;
+    };
+    checkEquivalent(build, "Explain tides", "EvaluatorWorkflow");
+    checkMemoized(build, "Explain tides", "EvaluatorWorkflow");
+}
+
+void testRouting() {
+    Build<RoutingWorkflow> build = [](const std::shared_ptr<Context>& context) {
+        auto router = std::make_shared<RoutingWorkflow>(context, "[ROUTER] Pick the best route.");
+        router->addRouteHandler("answer", "Answers questions directly", "You answer briefly.");
+        router->addRouteHandler("chain", "Runs a prompt chain", "", nullptr, makeChain(context));
+        return router;
+    };
+    checkEquivalent(build, "What is the boiling point of water?", "RoutingWorkflow (LLM route)");
+    checkEquivalent(build, "Use the chain for this", "RoutingWorkflow (nested workflow)");
+}
+
+// A subclass that overrides run() gets its own run() from runTask()
+class ShoutingChain : public PromptChainingWorkflow {
+public:
+    using PromptChainingWorkflow::PromptChainingWorkflow;
+    JsonObject run(const std::string& input) override { return JsonObject{{"answer", input + "!"}}; }
+};
+
+void testOverriddenRun() {
+    auto llm = std::make_shared<ScriptedLLM>();
+    ShoutingChain shouting(contextWith(llm));
+    shouting.addStep("unused", "{input}");
+    JsonObject result = blockingWait(shouting.runTask("hello"));
+    check(result.value("answer", "") == "hello!", "runTask() runs the subclass's run()");
+    check(llm->takeRequests().empty(), "runTask() does not run the base chain");
+}
+
+} // namespace
+
+int main() {
+    testPromptChaining();
+    testParallelization();
+    testOrchestrator();
+    testEvaluator();
+    testRouting();
+    testOverriddenRun();
+    if (failures > 0) {
+        return EXIT_FAILURE;
+    }
+    std::cout << "workflow_tasks_test passed" << std::endl;
+    return EXIT_SUCCESS;
+}